@@ -0,0 +1,70 @@
+// Run artefacts with and without the blob store: 1 000 run directories each receive the same scenario.yaml, written
+// as a copy per run ("copy") or linked to one blob ("blob"). Reports wall time per run and the disk space the files
+// occupy, counting each inode once.
+
+#include "trdp_simulator/simulation/BlobStore.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <string>
+
+#include <sys/stat.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Bytes allocated to the regular files under @p root, counting hard-linked files once.
+std::uintmax_t diskUsage(const std::filesystem::path &root) {
+    std::set<std::pair<dev_t, ino_t>> seen;
+    std::uintmax_t bytes = 0;
+    for (const auto &entry : std::filesystem::recursive_directory_iterator{root}) {
+        struct stat info {};
+        if (!entry.is_regular_file() || ::stat(entry.path().c_str(), &info) != 0) {
+            continue;
+        }
+        if (seen.emplace(info.st_dev, info.st_ino).second) {
+            bytes += static_cast<std::uintmax_t>(info.st_blocks) * 512;
+        }
+    }
+    return bytes;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const int runs = argc > 1 ? std::atoi(argv[1]) : 1000;
+    std::string scenario = "scenario: bench\ndevice: device1\nevents:\n";
+    for (int i = 0; i < 200; ++i) {
+        scenario += "  - type: pd\n    label: event-" + std::to_string(i) +
+                    "\n    com_id: 1000\n    dataset_id: 1\n    payload: 0x0102030405060708\n    delay_ms: 10\n";
+    }
+
+    const auto dir = std::filesystem::temp_directory_path() / "trdp-bench-blob-store";
+    std::filesystem::remove_all(dir);
+    for (const bool useBlobs : {false, true}) {
+        const auto root = dir / (useBlobs ? "blob" : "copy");
+        std::filesystem::create_directories(root);
+        trdp::simulation::BlobStore blobs{root / "blobs"};
+        const auto start = Clock::now();
+        for (int i = 0; i < runs; ++i) {
+            const auto run = root / "runs" / ("run-" + std::to_string(i));
+            std::filesystem::create_directories(run);
+            if (useBlobs) {
+                (void)blobs.storeContents(scenario, run / "scenario.yaml");
+            } else {
+                std::ofstream stream{run / "scenario.yaml", std::ios::trunc};
+                stream << scenario;
+            }
+        }
+        const auto elapsed = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        std::cout << (useBlobs ? "blob" : "copy") << "  runs " << runs << "  scenario_bytes " << scenario.size()
+                  << "  us_per_run " << elapsed / runs << "  disk_kb " << diskUsage(root) / 1024 << '\n';
+    }
+    std::filesystem::remove_all(dir);
+    return 0;
+}
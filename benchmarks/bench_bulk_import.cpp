@@ -0,0 +1,137 @@
+// Bulk import of a catalogue: device profiles and scenarios registered one file at a time, as the CLI did, against
+// registerProfiles() and importScenarios() with one thread and with one thread per core.
+//
+// Each profile is device1.xml with a distinct trailing comment, so none is a duplicate; each scenario has its own
+// id and 10 events. Manifests use the default journal options (fsync per append). Arguments: scenario count
+// (default 10 000), profile count (default 1 000) and batch threads (default one per core).
+
+#include "trdp_simulator/device/DeviceProfileRepository.hpp"
+#include "trdp_simulator/device/XmlValidator.hpp"
+#include "trdp_simulator/simulation/BulkImport.hpp"
+#include "trdp_simulator/simulation/ScenarioRepository.hpp"
+#include "trdp_simulator/simulation/ScenarioSchemaValidator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using trdp::device::DeviceProfileRepository;
+using trdp::device::XmlValidator;
+using trdp::simulation::ScenarioRepository;
+using trdp::simulation::ScenarioSchemaValidator;
+
+const std::filesystem::path kRepoRoot = std::filesystem::path{__FILE__}.parent_path().parent_path();
+
+std::vector<std::filesystem::path> writeProfiles(const std::filesystem::path &dir, int count) {
+    std::ifstream source{kRepoRoot / "resources/trdp/device1.xml", std::ios::binary};
+    const std::string xml{std::istreambuf_iterator<char>{source}, std::istreambuf_iterator<char>{}};
+    std::filesystem::create_directories(dir);
+    for (int i = 0; i < count; ++i) {
+        std::ofstream stream{dir / ("device-" + std::to_string(i) + ".xml"), std::ios::binary};
+        stream << xml << "<!-- profile " << i << " -->\n";
+    }
+    return trdp::simulation::importFiles(dir, {".xml"});
+}
+
+std::vector<std::filesystem::path> writeScenarios(const std::filesystem::path &dir, int count) {
+    std::filesystem::create_directories(dir);
+    for (int i = 0; i < count; ++i) {
+        std::ofstream stream{dir / ("scenario-" + std::to_string(i) + ".yaml")};
+        stream << "scenario: scenario-" << i << "\ndevice: device1\nevents:\n";
+        for (int event = 0; event < 10; ++event) {
+            stream << "  - type: pd\n    label: event-" << event
+                   << "\n    com_id: 1000\n    dataset_id: 1\n    payload: 0x0102\n    delay_ms: 10\n";
+        }
+    }
+    return trdp::simulation::importFiles(dir, {".yaml"});
+}
+
+template <typename Import>
+void report(const char *kind, const char *mode, std::size_t threads, std::size_t files, Import &&import) {
+    const auto start = Clock::now();
+    const auto failed = import();
+    const auto seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    if (failed != 0) {
+        std::cerr << failed << " files failed to import\n";
+        std::exit(1);
+    }
+    std::cout << kind << "  " << mode << "  threads " << threads << "  files " << files << "  seconds " << seconds
+              << "  files_per_s " << static_cast<double>(files) / seconds << '\n';
+}
+
+std::size_t failures(const std::vector<trdp::simulation::ImportOutcome> &outcomes) {
+    return static_cast<std::size_t>(std::count_if(outcomes.begin(), outcomes.end(), [](const auto &outcome) {
+        return !outcome.ok();
+    }));
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const int scenarioCount = argc > 1 ? std::atoi(argv[1]) : 10000;
+    const int profileCount = argc > 2 ? std::atoi(argv[2]) : 1000;
+    const std::size_t cores =
+        argc > 3 ? static_cast<std::size_t>(std::atoi(argv[3])) : std::max(1u, std::thread::hardware_concurrency());
+
+    const auto dir = std::filesystem::temp_directory_path() / "trdp-bench-bulk-import";
+    std::filesystem::remove_all(dir);
+    const auto profiles = writeProfiles(dir / "source" / "devices", profileCount);
+    const auto scenarios = writeScenarios(dir / "source" / "scenarios", scenarioCount);
+
+    XmlValidator validator{kRepoRoot / "resources/trdp/trdp-config.xsd"};
+    ScenarioSchemaValidator scenarioValidator{kRepoRoot / "resources/scenarios/scenario.schema.yaml"};
+    std::cout << std::fixed << std::setprecision(2);
+
+    std::vector<std::size_t> threadCounts{1};
+    if (cores > 1) {
+        threadCounts.push_back(cores);
+    }
+    int round = 0;
+    const auto freshRoot = [&] { return dir / ("store-" + std::to_string(round++)); };
+
+    {
+        DeviceProfileRepository repository{freshRoot(), validator};
+        report("profiles", "one-at-a-time", 1, profiles.size(), [&] {
+            for (const auto &path : profiles) {
+                (void)repository.registerProfile(path);
+            }
+            return std::size_t{0};
+        });
+    }
+    for (const auto threads : threadCounts) {
+        DeviceProfileRepository repository{freshRoot(), validator};
+        report("profiles", "batch", threads, profiles.size(),
+               [&] { return failures(repository.registerProfiles(profiles, threads)); });
+    }
+
+    const auto deviceRoot = freshRoot();
+    DeviceProfileRepository devices{deviceRoot, validator};
+    (void)devices.registerProfile(kRepoRoot / "resources/trdp/device1.xml");
+    {
+        ScenarioRepository repository{freshRoot(), devices, scenarioValidator};
+        report("scenarios", "one-at-a-time", 1, scenarios.size(), [&] {
+            for (const auto &path : scenarios) {
+                (void)repository.importScenario(path);
+            }
+            return std::size_t{0};
+        });
+    }
+    for (const auto threads : threadCounts) {
+        ScenarioRepository repository{freshRoot(), devices, scenarioValidator};
+        report("scenarios", "batch", threads, scenarios.size(),
+               [&] { return failures(repository.importScenarios(scenarios, threads)); });
+    }
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
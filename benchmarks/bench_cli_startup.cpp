@@ -0,0 +1,125 @@
+// Wall time of short trdp_sim_cli invocations against large catalogues, as scripts calling the CLI see it.
+//
+// The catalogue holds the given number of device profiles, scenarios and runs (synthetic manifest entries next to
+// one real device and scenario). Each command is spawned with HOME pointing at the catalogue and its output
+// discarded; the table shows the median of eleven invocations after one warm-up.
+
+#include "trdp_simulator/device/DeviceProfileRepository.hpp"
+#include "trdp_simulator/device/XmlValidator.hpp"
+#include "trdp_simulator/simulation/ScenarioRepository.hpp"
+#include "trdp_simulator/simulation/ScenarioSchemaValidator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+
+extern char **environ;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+void appendEntries(const std::filesystem::path &manifest, int count, const std::string &prefix,
+                   const std::string &fields) {
+    std::ofstream stream{manifest, std::ios::app};
+    for (int i = 0; i < count; ++i) {
+        stream << prefix << i << '|' << fields << '\n';
+    }
+}
+
+trdp::simulation::RunRecord makeRun(int index) {
+    trdp::simulation::RunRecord record{};
+    record.id = "bench-run-" + std::to_string(index);
+    record.scenarioId = "bench-scenario-" + std::to_string(index % 1000);
+    record.artefactPath = "/var/lib/trdp-simulator/runs/bench-run-" + std::to_string(index);
+    record.startedAt = "2024-01-01T00:00:00Z";
+    record.completedAt = "2024-01-01T00:00:01Z";
+    record.success = index % 3 != 0;
+    record.detail = "Run completed";
+    record.expectations.push_back({"heard", true, {}});
+    return record;
+}
+
+double medianMs(const std::vector<std::string> &args) {
+    std::vector<char *> argv;
+    for (const auto &arg : args) {
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, 1, "/dev/null", O_WRONLY, 0);
+
+    std::vector<double> samples;
+    for (int round = 0; round < 12; ++round) {
+        const auto start = Clock::now();
+        pid_t pid = 0;
+        int status = 0;
+        if (posix_spawn(&pid, argv[0], &actions, nullptr, argv.data(), environ) != 0 || waitpid(pid, &status, 0) < 0 ||
+            !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            std::cerr << "command failed: " << args[1] << '\n';
+            std::exit(1);
+        }
+        if (round > 0) {
+            samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        }
+    }
+    posix_spawn_file_actions_destroy(&actions);
+    std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+    return samples[samples.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const int entries = argc > 1 ? std::atoi(argv[1]) : 100'000;
+    const auto repoRoot = std::filesystem::path(__FILE__).parent_path().parent_path();
+    const auto home = std::filesystem::temp_directory_path() / "trdp-bench-cli-startup";
+    const auto config = home / ".trdp-simulator";
+    std::filesystem::remove_all(home);
+    std::filesystem::create_directories(home);
+
+    {
+        trdp::device::XmlValidator validator{repoRoot / "resources/trdp/trdp-config.xsd"};
+        trdp::device::DeviceProfileRepository devices{config / "devices", validator};
+        trdp::simulation::ScenarioSchemaValidator schema{repoRoot / "resources/scenarios/scenario.schema.yaml"};
+        trdp::simulation::ScenarioRepository scenarios{config / "scenarios", devices, schema, 0, {.sync = false}};
+        (void)devices.registerProfile(repoRoot / "resources/trdp/device1.xml");
+        (void)scenarios.importScenario(repoRoot / "resources/trdp/loopback.yaml");
+        std::vector<trdp::simulation::RunRecord> runs;
+        for (int i = 0; i < entries; ++i) {
+            runs.push_back(makeRun(i));
+        }
+        scenarios.recordRuns(std::move(runs));
+        scenarios.compactManifests();
+    }
+    appendEntries(config / "devices/manifest.db", entries, "bench-device-",
+                  "/var/lib/trdp-simulator/devices/bench.xml|/srv/devices/bench.xml|"
+                  "0123456789abcdef0123456789abcdef|2024-01-01T00:00:00Z");
+    appendEntries(config / "scenarios/manifest.db", entries, "bench-scenario-",
+                  "/var/lib/trdp-simulator/scenarios/bench.yaml|device1|0123456789abcdef0123456789abcdef|"
+                  "2024-01-01T00:00:00Z|2024-01-01T00:00:00Z");
+    setenv("HOME", home.c_str(), 1);
+
+    const std::string cli = TRDP_SIM_CLI_PATH;
+    const auto scenario = (repoRoot / "resources/trdp/loopback.yaml").string();
+    const auto exported = (home / "export.yaml").string();
+    std::cout << "entries " << entries << '\n';
+    std::cout << "no_run_ms " << medianMs({cli, "--no-run"}) << '\n';
+    std::cout << "validate_ms " << medianMs({cli, "--validate-scenario", scenario, "--no-run"}) << '\n';
+    std::cout << "list_runs_page_ms " << medianMs({cli, "--list-runs", "--runs-limit", "20", "--no-run"}) << '\n';
+    std::cout << "export_ms " << medianMs({cli, "--export-scenario", "loopback-demo", exported, "--no-run"}) << '\n';
+    std::cout << "run_scenario_ms " << medianMs({cli, "loopback-demo"}) << '\n';
+
+    std::filesystem::remove_all(home);
+    return 0;
+}
@@ -0,0 +1,124 @@
+// Scenario load latency from the stored YAML against its compiled copy, for large generated scenarios.
+//
+// "yaml" validates and parses the stored file, which is what ScenarioRepository::load did before compiled copies.
+// "compiled" loads through a fresh ScenarioRepository, as in a new CLI process, so the parsed-scenario cache never
+// hits and the .tsc is mapped and copied out. Cold rounds first drop both files from the page cache with
+// posix_fadvise, where the platform has it.
+
+#include "trdp_simulator/device/DeviceProfileRepository.hpp"
+#include "trdp_simulator/device/XmlValidator.hpp"
+#include "trdp_simulator/simulation/CompiledScenario.hpp"
+#include "trdp_simulator/simulation/ScenarioParser.hpp"
+#include "trdp_simulator/simulation/ScenarioRepository.hpp"
+#include "trdp_simulator/simulation/ScenarioSchemaValidator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#if defined(__unix__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+void writeScenario(const std::filesystem::path &path, const std::string &deviceId, int events) {
+    std::ofstream stream{path};
+    stream << "scenario: bench\n";
+    stream << "device: " << deviceId << "\n";
+    stream << "events:\n";
+    for (int i = 0; i < events; ++i) {
+        stream << "  - type: pd\n";
+        stream << "    label: event-" << i % 1000 << "\n";
+        stream << "    com_id: " << 1000 + i % 64 << "\n";
+        stream << "    dataset_id: " << 1000 + i % 64 << "\n";
+        stream << "    payload: 0x000102030405060708090a0b0c0d0e0f\n";
+        stream << "    delay_ms: " << i % 10 << "\n";
+        if (i % 10 == 0) {
+            stream << "    repeat: 100\n";
+            stream << "    period_ms: 10\n";
+        }
+    }
+}
+
+void dropFromPageCache(const std::filesystem::path &path) {
+#if defined(__unix__)
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        ::fdatasync(fd);
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        ::close(fd);
+    }
+#else
+    (void)path;
+#endif
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const int rounds = argc > 1 ? std::atoi(argv[1]) : 5;
+    const auto repoRoot = std::filesystem::path(__FILE__).parent_path().parent_path();
+    const auto dir = std::filesystem::temp_directory_path() / "trdp-bench-compiled-scenario";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    trdp::device::XmlValidator validator{repoRoot / "resources/trdp/trdp-config.xsd"};
+    trdp::device::DeviceProfileRepository devices{dir / "devices", validator};
+    const auto deviceId = devices.registerProfile(repoRoot / "resources/trdp/device1.xml");
+    trdp::simulation::ScenarioSchemaValidator schema{repoRoot / "resources/scenarios/scenario.schema.yaml"};
+
+    std::cout << "events  yaml_mb  tsc_mb  yaml_cold_ms  tsc_cold_ms  yaml_warm_ms  tsc_warm_ms\n";
+    for (const int events : {10'000, 100'000, 1'000'000}) {
+        const auto source = dir / ("bench-" + std::to_string(events) + ".yaml");
+        writeScenario(source, deviceId, events);
+        const auto root = dir / ("store-" + std::to_string(events));
+        std::string id;
+        {
+            trdp::simulation::ScenarioRepository repository{root, devices, schema};
+            id = repository.importScenario(source);
+        }
+        const auto yaml = root / (id + ".yaml");
+        auto compiled = yaml;
+        compiled.replace_extension(trdp::simulation::kCompiledScenarioExtension);
+        const auto yamlBytes = static_cast<double>(std::filesystem::file_size(yaml));
+        const auto compiledBytes = static_cast<double>(std::filesystem::file_size(compiled));
+
+        const auto timeLoad = [&](bool fromYaml, bool cold) {
+            if (cold) {
+                dropFromPageCache(yaml);
+                dropFromPageCache(compiled);
+            }
+            trdp::simulation::ScenarioRepository repository{root, devices, schema};
+            const auto start = Clock::now();
+            const auto loaded = fromYaml ? trdp::simulation::ScenarioParser::parse(yaml, devices, schema).events.size()
+                                         : repository.loadShared(id)->events.size();
+            const auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            if (loaded != static_cast<std::size_t>(events)) {
+                std::abort();
+            }
+            return elapsed;
+        };
+        double yamlCold = 1e300;
+        double compiledCold = 1e300;
+        double yamlWarm = 1e300;
+        double compiledWarm = 1e300;
+        for (int round = 0; round < rounds; ++round) {
+            yamlCold = std::min(yamlCold, timeLoad(true, true));
+            compiledCold = std::min(compiledCold, timeLoad(false, true));
+            yamlWarm = std::min(yamlWarm, timeLoad(true, false));
+            compiledWarm = std::min(compiledWarm, timeLoad(false, false));
+        }
+        std::cout << events << "  " << yamlBytes / 1e6 << "  " << compiledBytes / 1e6 << "  " << yamlCold * 1e3
+                  << "  " << compiledCold * 1e3 << "  " << yamlWarm * 1e3 << "  " << compiledWarm * 1e3 << '\n';
+    }
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,88 @@
+// Import copy-and-hash: std::filesystem::copy_file followed by the former FNV-1a checksum (byte at a time over 4 KB
+// ifstream reads) against copyFileWithChecksum, which hashes XXH64 from a mapping and copies with copy_file_range.
+//
+// Files are in the page cache, so the figures show CPU cost rather than disk speed. Each size is copied until about
+// 256 MB have passed; figures are source megabytes per second.
+
+#include "trdp_simulator/simulation/ContentHash.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::string fnv1aChecksum(const std::filesystem::path &path) {
+    std::ifstream stream{path, std::ios::binary};
+    std::uint64_t hash = 1469598103934665603ull;
+    char buffer[4096];
+    while (stream.read(buffer, sizeof(buffer)) || stream.gcount() > 0) {
+        const std::streamsize count = stream.gcount();
+        for (std::streamsize i = 0; i < count; ++i) {
+            hash ^= static_cast<unsigned char>(buffer[i]);
+            hash *= 1099511628211ull;
+        }
+    }
+    std::ostringstream oss;
+    oss << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return oss.str();
+}
+
+template <typename Run>
+double megabytesPerSecond(std::size_t bytes, Run &&run) {
+    const auto rounds = std::max<std::size_t>(3, (std::size_t{256} << 20U) / bytes);
+    std::size_t sink = 0;
+    const auto start = Clock::now();
+    for (std::size_t i = 0; i < rounds; ++i) {
+        sink += run().size();
+    }
+    const auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    if (sink == 0) {
+        std::abort();
+    }
+    return static_cast<double>(bytes * rounds) / 1e6 / elapsed;
+}
+
+} // namespace
+
+int main() {
+    const auto dir = std::filesystem::temp_directory_path() / "trdp-bench-content-hash";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    const auto copy = dir / "copy.xml";
+
+    std::cout << std::fixed << std::setprecision(0);
+    std::cout << "bytes  copy_file+fnv1a_MBps  copyFileWithChecksum_MBps  fnv1a_hash_MBps  xxh64_hash_MBps\n";
+    for (const std::size_t bytes : {std::size_t{16} << 10U, std::size_t{1} << 20U, std::size_t{64} << 20U}) {
+        const auto source = dir / ("source-" + std::to_string(bytes) + ".xml");
+        {
+            std::ofstream stream{source, std::ios::binary};
+            std::string line = "  <process-data com-id=\"1000\" cycle=\"100\" dataset=\"telemetry\"/>\n";
+            for (std::size_t written = 0; written < bytes; written += line.size()) {
+                stream.write(line.data(), static_cast<std::streamsize>(std::min(line.size(), bytes - written)));
+            }
+        }
+        const auto before = megabytesPerSecond(bytes, [&] {
+            std::filesystem::copy_file(source, copy, std::filesystem::copy_options::overwrite_existing);
+            return fnv1aChecksum(copy);
+        });
+        const auto after = megabytesPerSecond(bytes, [&] {
+            return trdp::simulation::copyFileWithChecksum(source, copy);
+        });
+        const auto fnvHash = megabytesPerSecond(bytes, [&] { return fnv1aChecksum(source); });
+        const auto xxhHash = megabytesPerSecond(bytes, [&] { return trdp::simulation::fileChecksum(source); });
+        std::cout << bytes << "  " << before << "  " << after << "  " << fnvHash << "  " << xxhHash << '\n';
+    }
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,99 @@
+// Hex payload decoding and encoding: each codec kernel against the per-byte code it replaced.
+//
+// "substr+stoul" is the former scenario_yaml::parsePayload loop (one std::string per byte) and "ostringstream" the
+// former payloadToString in Engine.cpp. Figures are payload bytes per second, so decode and encode are comparable.
+
+#include "trdp_simulator/simulation/HexCodec.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace hex = trdp::simulation::hex;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::vector<std::uint8_t> substrStoul(const std::string &digits) {
+    std::vector<std::uint8_t> payload;
+    payload.reserve(digits.size() / 2);
+    for (std::size_t i = 0; i < digits.size(); i += 2) {
+        payload.push_back(static_cast<std::uint8_t>(std::stoul(digits.substr(i, 2), nullptr, 16)));
+    }
+    return payload;
+}
+
+std::string ostringstreamHex(const std::vector<std::uint8_t> &payload) {
+    std::ostringstream oss;
+    oss << std::hex << std::setfill('0');
+    for (std::uint8_t byte : payload) {
+        oss << std::setw(2) << static_cast<int>(byte);
+    }
+    return oss.str();
+}
+
+/// Payload megabytes per second of @p run over @p bytes, repeated until about 64 MB have been processed.
+template <typename Run>
+double megabytesPerSecond(std::size_t bytes, Run &&run) {
+    const auto rounds = std::max<std::size_t>(1, (std::size_t{64} << 20U) / bytes);
+    std::size_t sink = 0;
+    const auto start = Clock::now();
+    for (std::size_t i = 0; i < rounds; ++i) {
+        sink += run();
+    }
+    const auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    if (sink == 0) {
+        std::abort();
+    }
+    return static_cast<double>(bytes * rounds) / 1e6 / elapsed;
+}
+
+} // namespace
+
+int main() {
+    const auto kernels = {hex::Kernel::Scalar, hex::Kernel::Sse2, hex::Kernel::Avx2};
+    std::cout << "active kernel: " << hex::kernelName(hex::activeKernel()) << "\n\n";
+    for (const bool decoding : {true, false}) {
+        std::cout << (decoding ? "decode" : "encode") << " MB/s\npayload_bytes  "
+                  << (decoding ? "substr+stoul" : "ostringstream");
+        for (const auto kernel : kernels) {
+            std::cout << "  " << hex::kernelName(kernel);
+        }
+        std::cout << '\n';
+        for (const std::size_t size : {16U, 256U, 4096U}) {
+            std::vector<std::uint8_t> payload(size);
+            for (std::size_t i = 0; i < size; ++i) {
+                payload[i] = static_cast<std::uint8_t>(i * 151 + 7);
+            }
+            const auto digits = hex::encode(payload);
+            std::vector<std::uint8_t> decoded(size);
+            std::string encoded(2 * size, '\0');
+
+            std::cout << size << "  "
+                      << (decoding ? megabytesPerSecond(size, [&] { return substrStoul(digits).back() + 1U; })
+                                   : megabytesPerSecond(size, [&] { return ostringstreamHex(payload).size(); }));
+            for (const auto kernel : kernels) {
+                if (!hex::kernelSupported(kernel)) {
+                    std::cout << "  -";
+                    continue;
+                }
+                const auto decode = [&] { return hex::decode(digits, decoded.data(), kernel); };
+                const auto encode = [&] {
+                    hex::encode(payload, encoded.data(), kernel);
+                    return static_cast<std::size_t>(encoded[size]);
+                };
+                std::cout << "  " << (decoding ? megabytesPerSecond(size, decode) : megabytesPerSecond(size, encode));
+            }
+            std::cout << '\n';
+        }
+        std::cout << '\n';
+    }
+    return 0;
+}
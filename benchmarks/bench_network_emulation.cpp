@@ -0,0 +1,133 @@
+// Sustained telegram rate through NetworkEmulationAdapter, and its timing wheel against a binary heap.
+//
+// Telegrams are offered on a virtual clock at a fixed rate (so many are in flight at once) and released every
+// 100 us of virtual time; the figure reported is real telegrams per second of CPU spent in the adapter.
+
+#include "trdp_simulator/communication/NetworkEmulationAdapter.hpp"
+#include "trdp_simulator/communication/TimingWheel.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <random>
+#include <vector>
+
+using trdp::communication::LatencyDistribution;
+using trdp::communication::LinkProfile;
+using trdp::communication::MessageDataAck;
+using trdp::communication::MessageDataHandler;
+using trdp::communication::MessageDataMessage;
+using trdp::communication::NetworkEmulationAdapter;
+using trdp::communication::ProcessDataHandler;
+using trdp::communication::ProcessDataMessage;
+using trdp::communication::StackAdapter;
+using trdp::communication::TimingWheel;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using namespace std::chrono_literals;
+
+class CountingAdapter final : public StackAdapter {
+public:
+    void openSession(const std::string &) override {}
+    void closeSession() override {}
+    void registerProcessDataHandler(ProcessDataHandler) override {}
+    void registerMessageDataHandler(MessageDataHandler) override {}
+    void publishProcessData(const ProcessDataMessage &) override { ++delivered; }
+    MessageDataAck sendMessageData(const MessageDataMessage &) override { return {}; }
+    void poll() override {}
+
+    std::uint64_t delivered{0};
+};
+
+double adapterPacketsPerSecond(const LinkProfile &link, int packets, std::chrono::nanoseconds interval) {
+    auto inner = std::make_shared<CountingAdapter>();
+    NetworkEmulationAdapter network{inner, {link}, 1};
+    const ProcessDataMessage message{"bench", 1001, 1001, std::vector<std::uint8_t>(64, 0xA5)};
+    auto now = Clock::now();
+    auto nextRelease = now;
+    const auto start = Clock::now();
+    for (int i = 0; i < packets; ++i) {
+        network.transmit(message, now);
+        now += interval;
+        if (now >= nextRelease) {
+            network.release(now);
+            nextRelease = now + 100us;
+        }
+    }
+    network.closeSession();
+    const auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    if (inner->delivered + network.stats().queueDrops != static_cast<std::uint64_t>(packets)) {
+        std::abort();
+    }
+    return packets / elapsed;
+}
+
+/// Schedules @p items with random delays around @p spread and fires them in 100 us steps.
+template <typename Schedule, typename Fire>
+double schedulerNsPerItem(int items, std::chrono::microseconds spread, Schedule &&schedule, Fire &&fire) {
+    std::mt19937_64 random{7};
+    const auto origin = Clock::now();
+    auto now = origin;
+    std::uint64_t fired = 0;
+    const auto start = Clock::now();
+    for (int i = 0; i < items; ++i) {
+        schedule(now + std::chrono::microseconds{random() % spread.count()});
+        now += 1us;
+        if (i % 100 == 0) {
+            fired += fire(now);
+        }
+    }
+    fired += fire(now + 2 * spread);
+    const auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    if (fired != static_cast<std::uint64_t>(items)) {
+        std::abort();
+    }
+    return elapsed / items;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const int packets = argc > 1 ? std::atoi(argv[1]) : 1'000'000;
+
+    std::cout << "link  offered_pps  emulated_pps\n";
+    const struct {
+        const char *name;
+        LinkProfile link;
+    } links[] = {
+        {"constant", LinkProfile{1001, LatencyDistribution::Constant, 2000us}},
+        {"normal", LinkProfile{1001, LatencyDistribution::Normal, 2000us, 500us}},
+        {"pareto", LinkProfile{1001, LatencyDistribution::Pareto, 2000us, 500us}},
+        {"100mbit+q256", LinkProfile{1001, LatencyDistribution::Normal, 2000us, 500us, 100'000'000, 256}},
+    };
+    for (const auto &[name, link] : links) {
+        std::cout << name << "  100000  " << adapterPacketsPerSecond(link, packets, 10us) << '\n';
+    }
+
+    std::cout << "\nspread_us  wheel_ns_per_item  heap_ns_per_item\n";
+    for (const auto spread : {1000us, 10000us, 100000us}) {
+        TimingWheel<std::uint64_t> wheel{20us, 4096};
+        const auto wheelNs = schedulerNsPerItem(
+            packets, spread, [&](Clock::time_point due) { wheel.schedule(due, 0); },
+            [&](Clock::time_point now) { return wheel.advance(now, [](std::uint64_t &&) {}); });
+
+        std::priority_queue<Clock::time_point, std::vector<Clock::time_point>, std::greater<>> heap;
+        const auto heapNs = schedulerNsPerItem(
+            packets, spread, [&](Clock::time_point due) { heap.push(due); },
+            [&](Clock::time_point now) {
+                std::size_t fired = 0;
+                for (; !heap.empty() && heap.top() <= now; ++fired) {
+                    heap.pop();
+                }
+                return fired;
+            });
+        std::cout << spread.count() << "  " << wheelNs << "  " << heapNs << '\n';
+    }
+    return 0;
+}
@@ -0,0 +1,107 @@
+// Run-to-run diff throughput over two captures, and the word-wise payload comparison against a byte loop.
+//
+// Both captures hold the same periodic traffic over 16 comIds; the second changes one payload in a thousand and
+// drops one telegram in ten thousand. The figure reported is capture bytes (both files) diffed per second.
+
+#include "trdp_simulator/simulation/RunCapture.hpp"
+#include "trdp_simulator/simulation/RunDiff.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <span>
+#include <vector>
+
+using trdp::simulation::CaptureDirection;
+using trdp::simulation::CaptureReader;
+using trdp::simulation::CaptureType;
+using trdp::simulation::CaptureWriter;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+void writeCapture(const std::filesystem::path &path, int records, std::size_t payloadSize, bool modified) {
+    CaptureWriter writer{path};
+    std::vector<std::uint8_t> payload(payloadSize);
+    for (int i = 0; i < records; ++i) {
+        for (std::size_t b = 0; b < payload.size(); ++b) {
+            payload[b] = static_cast<std::uint8_t>(i * 31 + b);
+        }
+        if (modified && i % 10'000 == 5'000) {
+            continue;
+        }
+        if (modified && i % 1'000 == 500) {
+            payload[payload.size() / 2] ^= 0x10;
+        }
+        const auto comId = 1000 + static_cast<std::uint32_t>(i % 16);
+        writer.append(std::int64_t{i} * 62'500, i % 2 == 0 ? CaptureDirection::Sent : CaptureDirection::Received,
+                      CaptureType::ProcessData, comId, comId, payload);
+    }
+}
+
+std::size_t byteLoop(std::span<const std::uint8_t> a, std::span<const std::uint8_t> b) {
+    std::size_t differing = 0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        differing += a[i] != b[i] ? 1 : 0;
+    }
+    return differing;
+}
+
+template <typename Count>
+double comparisonNsPerPayload(std::size_t payloadSize, Count &&count) {
+    constexpr int kRounds = 200'000;
+    std::vector<std::uint8_t> a(payloadSize, 0x33);
+    auto b = a;
+    b[payloadSize - 1] = 0;
+    std::size_t total = 0;
+    const auto start = Clock::now();
+    for (int i = 0; i < kRounds; ++i) {
+        b[static_cast<std::size_t>(i) % payloadSize] ^= 1;
+        total += count(std::span<const std::uint8_t>{a}, std::span<const std::uint8_t>{b});
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    if (total == 0) {
+        std::abort();
+    }
+    return elapsed / kRounds;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const int records = argc > 1 ? std::atoi(argv[1]) : 2'000'000;
+    const auto dir = std::filesystem::temp_directory_path() / "trdp-bench-run-diff";
+    std::filesystem::create_directories(dir);
+
+    std::cout << "payload_bytes  records  capture_mb  diff_mb_per_s  diff_records_per_s\n";
+    for (const std::size_t payloadSize : {64U, 256U, 1024U}) {
+        const int count = static_cast<int>(records * 64 / payloadSize);
+        writeCapture(dir / "a.trc", count, payloadSize, false);
+        writeCapture(dir / "b.trc", count, payloadSize, true);
+        const auto bytes = std::filesystem::file_size(dir / "a.trc") + std::filesystem::file_size(dir / "b.trc");
+        const auto start = Clock::now();
+        const CaptureReader a{dir / "a.trc"};
+        const CaptureReader b{dir / "b.trc"};
+        const auto report = trdp::simulation::diffCaptures(a, b);
+        const auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        if (report.equivalent()) {
+            std::abort();
+        }
+        std::cout << payloadSize << "  " << count << "  " << bytes / 1e6 << "  " << bytes / 1e6 / elapsed << "  "
+                  << (report.recordsA + report.recordsB) / elapsed << '\n';
+    }
+    std::filesystem::remove_all(dir);
+
+    std::cout << "\npayload_bytes  words_ns  byte_loop_ns\n";
+    for (const std::size_t payloadSize : {64U, 256U, 1024U}) {
+        const auto words = comparisonNsPerPayload(payloadSize, [](auto a, auto b) {
+            return trdp::simulation::countDifferingBytes(a, b);
+        });
+        const auto bytes = comparisonNsPerPayload(payloadSize, [](auto a, auto b) { return byteLoop(a, b); });
+        std::cout << payloadSize << "  " << words << "  " << bytes << '\n';
+    }
+    return 0;
+}
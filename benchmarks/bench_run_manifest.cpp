@@ -0,0 +1,73 @@
+// Cost of ScenarioRepository::recordRun as the run manifest grows, and of reopening the repository afterwards.
+//
+// Runs are recorded one at a time with the repository's default (durable) journal options; the per-run column is
+// the mean over each slice of runs, so a manifest rewritten per run shows up as a per-run cost that grows with the
+// slice number.
+
+#include "trdp_simulator/device/DeviceProfileRepository.hpp"
+#include "trdp_simulator/device/XmlValidator.hpp"
+#include "trdp_simulator/simulation/ScenarioRepository.hpp"
+#include "trdp_simulator/simulation/ScenarioSchemaValidator.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+trdp::simulation::RunRecord makeRun(int index) {
+    trdp::simulation::RunRecord record{};
+    record.id = "bench-" + std::to_string(index);
+    record.scenarioId = "bench";
+    record.artefactPath = "/var/lib/trdp-simulator/runs/bench-" + std::to_string(index);
+    record.startedAt = "2024-01-01T00:00:00Z";
+    record.completedAt = "2024-01-01T00:00:01Z";
+    record.success = true;
+    record.detail = "Run completed";
+    record.expectations.push_back({"heard", true, {}});
+    return record;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const int runs = argc > 1 ? std::atoi(argv[1]) : 5'000;
+    const int slices = 5;
+    const auto repoRoot = std::filesystem::path(__FILE__).parent_path().parent_path();
+    const auto dir = std::filesystem::temp_directory_path() / "trdp-bench-run-manifest";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    trdp::device::XmlValidator validator{repoRoot / "resources/trdp/trdp-config.xsd"};
+    trdp::device::DeviceProfileRepository devices{dir / "devices", validator};
+    trdp::simulation::ScenarioSchemaValidator schema{repoRoot / "resources/scenarios/scenario.schema.yaml"};
+
+    std::cout << "runs_recorded  per_run_us\n";
+    double total = 0;
+    {
+        trdp::simulation::ScenarioRepository repository{dir / "scenarios", devices, schema};
+        const int perSlice = runs / slices;
+        for (int slice = 0; slice < slices; ++slice) {
+            const auto start = Clock::now();
+            for (int i = slice * perSlice; i < (slice + 1) * perSlice; ++i) {
+                repository.recordRun(makeRun(i));
+            }
+            const auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            total += elapsed;
+            std::cout << (slice + 1) * perSlice << "  " << elapsed / perSlice * 1e6 << '\n';
+        }
+    }
+    const auto reopenStart = Clock::now();
+    trdp::simulation::ScenarioRepository reopened{dir / "scenarios", devices, schema};
+    const auto reopen = std::chrono::duration<double>(Clock::now() - reopenStart).count();
+    if (reopened.listRuns().size() != static_cast<std::size_t>(runs / slices * slices)) {
+        std::abort();
+    }
+    std::cout << "total_ms " << total * 1e3 << "  reopen_ms " << reopen * 1e3 << '\n';
+    std::filesystem::remove_all(dir);
+    return 0;
+}
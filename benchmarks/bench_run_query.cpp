@@ -0,0 +1,114 @@
+// Latency of run catalogue queries against a large run manifest.
+//
+// Runs are spread over 100 scenarios, one every ten seconds, and a third of them fail. The listing rows copy the
+// whole catalogue (or one scenario's share of it) as listRuns and listRunsForScenario do; the query rows fetch one
+// CLI-sized page of 50 runs through ScenarioRepository::queryRuns. Each row is the best of five rounds.
+
+#include "trdp_simulator/device/DeviceProfileRepository.hpp"
+#include "trdp_simulator/device/XmlValidator.hpp"
+#include "trdp_simulator/simulation/ScenarioRepository.hpp"
+#include "trdp_simulator/simulation/ScenarioSchemaValidator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::string timestamp(int seconds) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "2024-01-%02dT%02d:%02d:%02dZ", 1 + seconds / 86'400,
+                  seconds / 3'600 % 24, seconds / 60 % 60, seconds % 60);
+    return buffer;
+}
+
+trdp::simulation::RunRecord makeRun(int index) {
+    trdp::simulation::RunRecord record{};
+    record.id = "bench-" + std::to_string(index);
+    record.scenarioId = "scenario-" + std::to_string(index % 100);
+    record.artefactPath = "/var/lib/trdp-simulator/runs/bench-" + std::to_string(index);
+    record.startedAt = timestamp(index * 10);
+    record.completedAt = timestamp(index * 10 + 5);
+    record.success = index % 3 != 0;
+    record.detail = "Run completed";
+    record.expectations.push_back({"heard", true, {}});
+    return record;
+}
+
+double bestMs(const std::function<std::size_t()> &body) {
+    double best = std::numeric_limits<double>::max();
+    for (int round = 0; round < 5; ++round) {
+        const auto start = Clock::now();
+        if (body() == 0) {
+            std::abort();
+        }
+        best = std::min(best, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+    return best;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const int runs = argc > 1 ? std::atoi(argv[1]) : 100'000;
+    const auto repoRoot = std::filesystem::path(__FILE__).parent_path().parent_path();
+    const auto dir = std::filesystem::temp_directory_path() / "trdp-bench-run-query";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    trdp::device::XmlValidator validator{repoRoot / "resources/trdp/trdp-config.xsd"};
+    trdp::device::DeviceProfileRepository devices{dir / "devices", validator};
+    trdp::simulation::ScenarioSchemaValidator schema{repoRoot / "resources/scenarios/scenario.schema.yaml"};
+    const trdp::simulation::ManifestJournal::Options journal{.sync = false};
+    {
+        trdp::simulation::ScenarioRepository repository{dir / "scenarios", devices, schema, 0, journal};
+        std::vector<trdp::simulation::RunRecord> records;
+        for (int i = 0; i < runs; ++i) {
+            records.push_back(makeRun(i));
+        }
+        repository.recordRuns(std::move(records));
+        repository.compactManifests();
+    }
+
+    const auto reopenStart = Clock::now();
+    trdp::simulation::ScenarioRepository repository{dir / "scenarios", devices, schema, 0, journal};
+    // The run manifest is replayed on first use.
+    (void)repository.queryRuns(trdp::simulation::RunQuery{.limit = 1});
+    const auto reopen = std::chrono::duration<double, std::milli>(Clock::now() - reopenStart).count();
+
+    std::cout << "runs " << runs << "  reopen_ms " << reopen << '\n';
+    std::cout << "list_all_ms " << bestMs([&] { return repository.listRuns().size(); }) << '\n';
+    std::cout << "list_scenario_ms " << bestMs([&] { return repository.listRunsForScenario("scenario-7").size(); })
+              << '\n';
+
+    trdp::simulation::RunQuery newest{.limit = 50};
+    std::cout << "page_newest_ms " << bestMs([&] { return repository.queryRuns(newest).runs.size(); }) << '\n';
+    auto scenario = newest;
+    scenario.scenarioId = "scenario-7";
+    std::cout << "page_scenario_ms " << bestMs([&] { return repository.queryRuns(scenario).runs.size(); }) << '\n';
+    auto failedInWindow = newest;
+    failedInWindow.success = false;
+    failedInWindow.startedFrom = timestamp(runs * 5);
+    failedInWindow.startedUntil = timestamp(runs * 5 + 3'600);
+    std::cout << "page_failed_hour_ms "
+              << bestMs([&] { return repository.queryRuns(failedInWindow).runs.size(); }) << '\n';
+    auto deep = newest;
+    deep.order = trdp::simulation::RunOrder::OldestFirst;
+    deep.after = timestamp(runs * 9) + "|";
+    std::cout << "page_cursor_ms " << bestMs([&] { return repository.queryRuns(deep).runs.size(); }) << '\n';
+    auto offset = newest;
+    offset.offset = static_cast<std::size_t>(runs) * 9 / 10;
+    std::cout << "page_offset_ms " << bestMs([&] { return repository.queryRuns(offset).runs.size(); }) << '\n';
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
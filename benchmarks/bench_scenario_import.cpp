@@ -0,0 +1,122 @@
+// Scenario catalogue import and load through ScenarioRepository, which validates each file against the schema and
+// parses it.
+//
+// The catalogue holds generated scenarios of pd events plus a trigger, an expectation and a fault each. Import
+// copies every file into the repository and rewrites its manifest; load is validation and parsing alone. The
+// validate column times ScenarioSchemaValidator::validate over the catalogue for comparison. Reload repeats the
+// loads through loadShared(), which the parsed-scenario cache serves without touching the files.
+
+#include "trdp_simulator/device/DeviceProfileRepository.hpp"
+#include "trdp_simulator/device/XmlValidator.hpp"
+#include "trdp_simulator/simulation/ScenarioRepository.hpp"
+#include "trdp_simulator/simulation/ScenarioSchemaValidator.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+void writeScenario(const std::filesystem::path &path, const std::string &id, const std::string &deviceId,
+                   int events) {
+    std::ofstream stream{path};
+    stream << "scenario: " << id << "\n";
+    stream << "device: " << deviceId << "\n";
+    stream << "seed: 42\n";
+    stream << "events:\n";
+    for (int i = 0; i < events; ++i) {
+        stream << "  - type: " << (i % 4 == 3 ? "md" : "pd") << "\n";
+        stream << "    label: event-" << i << "\n";
+        stream << "    com_id: " << 1000 + i % 64 << "\n";
+        stream << "    dataset_id: " << 1000 + i % 64 << "\n";
+        stream << "    payload: 0x000102030405060708090a0b0c0d0e0f\n";
+        stream << "    delay_ms: " << i % 10 << "\n";
+    }
+    stream << "triggers:\n";
+    stream << "  - label: echo\n    on_type: pd\n    on_com_id: 1001\n    type: pd\n    com_id: 1002\n";
+    stream << "    payload: 0x01\n";
+    stream << "expect:\n";
+    stream << "  - label: heard\n    com_id: 1001\n    min_count: 1\n    field_offset: 0\n    field_width: 1\n";
+    stream << "    field_op: ge\n    field_value: 0\n";
+    stream << "faults:\n";
+    stream << "  - com_id: 1001\n    loss: 0.01\n";
+}
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const int scenarios = argc > 1 ? std::atoi(argv[1]) : 1'000;
+    const int events = argc > 2 ? std::atoi(argv[2]) : 200;
+    const std::size_t cacheMb = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 128;
+    const auto repoRoot = std::filesystem::path(__FILE__).parent_path().parent_path();
+    const auto dir = std::filesystem::temp_directory_path() / "trdp-bench-scenario-import";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir / "catalogue");
+
+    trdp::device::XmlValidator validator{repoRoot / "resources/trdp/trdp-config.xsd"};
+    trdp::device::DeviceProfileRepository devices{dir / "devices", validator};
+    const auto deviceId = devices.registerProfile(repoRoot / "resources/trdp/device1.xml");
+    trdp::simulation::ScenarioSchemaValidator schema{repoRoot / "resources/scenarios/scenario.schema.yaml"};
+
+    std::vector<std::filesystem::path> files;
+    std::uintmax_t bytes = 0;
+    for (int i = 0; i < scenarios; ++i) {
+        const auto id = "scenario-" + std::to_string(i);
+        files.push_back(dir / "catalogue" / (id + ".yaml"));
+        writeScenario(files.back(), id, deviceId, events);
+        bytes += std::filesystem::file_size(files.back());
+    }
+
+    const auto validateStart = Clock::now();
+    for (const auto &file : files) {
+        schema.validate(file);
+    }
+    const auto validate = secondsSince(validateStart);
+
+    trdp::simulation::ScenarioRepository repository{dir / "scenarios", devices, schema, cacheMb << 20U};
+    std::vector<std::string> ids;
+    const auto importStart = Clock::now();
+    for (const auto &file : files) {
+        ids.push_back(repository.importScenario(file));
+    }
+    const auto import = secondsSince(importStart);
+
+    std::size_t loaded = 0;
+    const auto loadStart = Clock::now();
+    for (const auto &id : ids) {
+        loaded += repository.load(id).events.size();
+    }
+    const auto load = secondsSince(loadStart);
+
+    std::size_t reloaded = 0;
+    const auto reloadStart = Clock::now();
+    for (const auto &id : ids) {
+        reloaded += repository.loadShared(id)->events.size();
+    }
+    const auto reload = secondsSince(reloadStart);
+    if (reloaded != loaded) {
+        std::abort();
+    }
+    if (loaded != static_cast<std::size_t>(scenarios) * static_cast<std::size_t>(events)) {
+        std::abort();
+    }
+
+    const auto cache = repository.cacheStats();
+    std::cout << "scenarios  events_each  catalogue_mb  validate_ms  import_ms  load_ms  load_mb_per_s  reload_ms  "
+                 "cache_hits  cache_mb\n";
+    std::cout << scenarios << "  " << events << "  " << bytes / 1e6 << "  " << validate * 1e3 << "  " << import * 1e3
+              << "  " << load * 1e3 << "  " << bytes / 1e6 / load << "  " << reload * 1e3 << "  " << cache.hits << "  "
+              << cache.bytes / 1e6 << '\n';
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,93 @@
+// ScenarioParser::parse throughput and heap allocations on large generated scenario files.
+//
+// Each file holds the given number of pd events with a label, com_id, dataset_id, delay and a 16-byte hex payload,
+// every tenth one also a repeat/period generator. Allocations are counted through the global operator new; the
+// Scenario itself needs two per event (label and payload), everything above that is parser overhead.
+
+#include "trdp_simulator/device/DeviceProfileRepository.hpp"
+#include "trdp_simulator/device/XmlValidator.hpp"
+#include "trdp_simulator/simulation/ScenarioParser.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <string>
+
+namespace {
+
+std::atomic<std::size_t> g_allocations{0};
+
+using Clock = std::chrono::steady_clock;
+
+void writeScenario(const std::filesystem::path &path, const std::string &deviceId, int events) {
+    std::ofstream stream{path};
+    stream << "scenario: bench\n";
+    stream << "device: " << deviceId << "\n";
+    stream << "events:\n";
+    for (int i = 0; i < events; ++i) {
+        stream << "  - type: pd\n";
+        stream << "    label: event-" << i << "\n";
+        stream << "    com_id: " << 1000 + i % 64 << "\n";
+        stream << "    dataset_id: " << 1000 + i % 64 << "\n";
+        stream << "    payload: 0x000102030405060708090A0B0C0D0E" << std::hex << i % 16 << std::dec << "F\n";
+        stream << "    delay_ms: " << i % 10 << "\n";
+        if (i % 10 == 0) {
+            stream << "    repeat: 100\n";
+            stream << "    period_ms: 10\n";
+        }
+    }
+}
+
+} // namespace
+
+void *operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void *memory) noexcept { std::free(memory); }
+void operator delete(void *memory, std::size_t) noexcept { std::free(memory); }
+
+int main(int argc, char **argv) {
+    const int rounds = argc > 1 ? std::atoi(argv[1]) : 5;
+    const auto repoRoot = std::filesystem::path(__FILE__).parent_path().parent_path();
+    const auto dir = std::filesystem::temp_directory_path() / "trdp-bench-scenario-parse";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    trdp::device::XmlValidator validator{repoRoot / "resources/trdp/trdp-config.xsd"};
+    trdp::device::DeviceProfileRepository repository{dir / "devices", validator};
+    const auto deviceId = repository.registerProfile(repoRoot / "resources/trdp/device1.xml");
+
+    std::cout << "events  file_mb  parse_ms  mb_per_s  events_per_s  allocations_per_event\n";
+    for (const int events : {10'000, 100'000}) {
+        const auto path = dir / ("bench-" + std::to_string(events) + ".yaml");
+        writeScenario(path, deviceId, events);
+        const auto bytes = static_cast<double>(std::filesystem::file_size(path));
+
+        double best = 1e300;
+        std::size_t allocations = 0;
+        for (int round = 0; round < rounds; ++round) {
+            const auto before = g_allocations.load(std::memory_order_relaxed);
+            const auto start = Clock::now();
+            const auto scenario = trdp::simulation::ScenarioParser::parse(path, repository);
+            const auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            allocations = g_allocations.load(std::memory_order_relaxed) - before;
+            if (scenario.events.size() != static_cast<std::size_t>(events)) {
+                std::abort();
+            }
+            best = std::min(best, elapsed);
+        }
+        std::cout << events << "  " << bytes / 1e6 << "  " << best * 1e3 << "  " << bytes / 1e6 / best << "  "
+                  << events / best << "  " << static_cast<double>(allocations) / events << '\n';
+    }
+    std::filesystem::remove_all(dir);
+    return 0;
+}
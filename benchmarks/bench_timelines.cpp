@@ -0,0 +1,90 @@
+// Per-event interleaving cost of coroutine timelines versus one thread per timeline.
+//
+// Every timeline emits its events strictly round-robin with the others, so each event costs one hand-off: a
+// coroutine resume through the TimelineScheduler, or a semaphore hand-off (and OS context switch) between threads.
+
+#include "trdp_simulator/simulation/TimelineScheduler.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <semaphore>
+#include <thread>
+#include <vector>
+
+using trdp::simulation::TimelineScheduler;
+using trdp::simulation::TimelineTask;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+TimelineTask timeline(TimelineScheduler &scheduler, int events, std::uint64_t &sink) {
+    for (int i = 0; i < events; ++i) {
+        co_await scheduler.sleepUntil(Clock::time_point{});
+        ++sink;
+    }
+}
+
+double coroutineNsPerEvent(int timelines, int events) {
+    TimelineScheduler scheduler;
+    std::uint64_t sink = 0;
+    for (int i = 0; i < timelines; ++i) {
+        scheduler.spawn(timeline(scheduler, events, sink));
+    }
+    const auto start = Clock::now();
+    scheduler.run();
+    const auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    if (sink != static_cast<std::uint64_t>(timelines) * events) {
+        std::abort();
+    }
+    return elapsed / static_cast<double>(sink);
+}
+
+double threadNsPerEvent(int timelines, int events) {
+    std::vector<std::unique_ptr<std::binary_semaphore>> turns;
+    turns.reserve(timelines);
+    for (int i = 0; i < timelines; ++i) {
+        turns.push_back(std::make_unique<std::binary_semaphore>(0));
+    }
+    std::uint64_t sink = 0;
+    std::vector<std::thread> threads;
+    threads.reserve(timelines);
+    for (int i = 0; i < timelines; ++i) {
+        threads.emplace_back([&, i] {
+            auto &next = *turns[(i + 1) % timelines];
+            for (int e = 0; e < events; ++e) {
+                turns[i]->acquire();
+                ++sink;
+                next.release();
+            }
+        });
+    }
+    const auto start = Clock::now();
+    turns[0]->release();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    if (sink != static_cast<std::uint64_t>(timelines) * events) {
+        std::abort();
+    }
+    return elapsed / static_cast<double>(sink);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const int events = argc > 1 ? std::atoi(argv[1]) : 200;
+    std::cout << "timelines  coroutine_ns_per_event  thread_ns_per_event\n";
+    for (const int timelines : {10, 100, 1000}) {
+        std::cout << timelines << "  " << coroutineNsPerEvent(timelines, events) << "  "
+                  << threadNsPerEvent(timelines, events) << '\n';
+    }
+    for (const int timelines : {10000, 100000}) {
+        std::cout << timelines << "  " << coroutineNsPerEvent(timelines, events) << "  -\n";
+    }
+    return 0;
+}
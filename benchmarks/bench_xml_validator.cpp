@@ -0,0 +1,87 @@
+// Device profile validation in a row: compiling trdp-config.xsd for every file, as XmlValidator used to, against the
+// validator's schema compiled once and pooled validation contexts, on one thread and on several.
+//
+// Arguments: number of profiles (default 2 000) and threads for the concurrent pass (default one per core).
+
+#include "trdp_simulator/device/XmlValidator.hpp"
+
+#include <libxml/parser.h>
+#include <libxml/xmlschemas.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const std::filesystem::path kRepoRoot = std::filesystem::path{__FILE__}.parent_path().parent_path();
+
+/// The former XmlValidator::validate: parse the schema, validate, free the schema.
+bool validateCompilingSchema(const std::filesystem::path &schemaPath, const std::filesystem::path &xmlPath) {
+    xmlSchemaParserCtxtPtr parser = xmlSchemaNewParserCtxt(schemaPath.c_str());
+    xmlSchemaPtr schema = xmlSchemaParse(parser);
+    xmlSchemaFreeParserCtxt(parser);
+    xmlDocPtr doc = xmlReadFile(xmlPath.c_str(), nullptr, 0);
+    xmlSchemaValidCtxtPtr context = xmlSchemaNewValidCtxt(schema);
+    const bool valid = xmlSchemaValidateDoc(context, doc) == 0;
+    xmlSchemaFreeValidCtxt(context);
+    xmlFreeDoc(doc);
+    xmlSchemaFree(schema);
+    return valid;
+}
+
+template <typename Validate>
+void report(const char *mode, std::size_t threads, int files, Validate &&validate) {
+    std::atomic<int> next{0};
+    std::atomic<int> failed{0};
+    const auto work = [&] {
+        for (int i = next++; i < files; i = next++) {
+            if (!validate()) {
+                ++failed;
+            }
+        }
+    };
+    const auto start = Clock::now();
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < threads; ++i) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    const auto elapsed = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    if (failed != 0) {
+        std::cerr << failed << " profiles failed validation\n";
+        std::exit(1);
+    }
+    std::cout << mode << "  threads " << threads << "  files " << files << "  us_per_file " << elapsed / files
+              << "  files_per_s " << files / (elapsed / 1e6) << '\n';
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const int files = argc > 1 ? std::atoi(argv[1]) : 2000;
+    const std::size_t threads =
+        argc > 2 ? static_cast<std::size_t>(std::atoi(argv[2])) : std::max(1u, std::thread::hardware_concurrency());
+    const auto schemaPath = kRepoRoot / "resources/trdp/trdp-config.xsd";
+    const auto profile = kRepoRoot / "resources/trdp/device1.xml";
+
+    const trdp::device::XmlValidator validator{schemaPath};
+    std::cout << std::fixed << std::setprecision(1);
+    report("compile-per-file", 1, files, [&] { return validateCompilingSchema(schemaPath, profile); });
+    report("cached-schema", 1, files, [&] { return validator.validate(profile).success; });
+    if (threads > 1) {
+        report("cached-schema", threads, files, [&] { return validator.validate(profile).success; });
+    }
+    return 0;
+}
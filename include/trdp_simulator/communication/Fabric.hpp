@@ -0,0 +1,62 @@
+#pragma once
+
+#include "trdp_simulator/communication/MpscQueue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace trdp::communication {
+
+struct FabricFrame {
+    enum class Kind {
+        ProcessData,
+        MessageData,
+    };
+
+    Kind kind{Kind::ProcessData};
+    std::size_t source{0};
+    std::string label;
+    std::uint32_t comId{0};
+    std::uint32_t datasetId{0};
+    std::vector<std::uint8_t> payload;
+    std::chrono::steady_clock::time_point sentAt{};
+};
+
+/// Routes telegrams by comId between ports; after seal() it is lock-free, and a full inbox drops the frame.
+class Fabric {
+public:
+    explicit Fabric(std::size_t inboxCapacity = 4096);
+
+    [[nodiscard]] std::size_t attach(std::string endpoint, const std::vector<std::uint32_t> &subscriptions);
+    void seal();
+
+    /// Routes @p frame from its source port; returns the number of inboxes it was queued on.
+    std::size_t send(FabricFrame frame);
+    [[nodiscard]] bool receive(std::size_t port, FabricFrame &frame);
+
+    [[nodiscard]] std::size_t ports() const noexcept { return m_ports.size(); }
+    [[nodiscard]] const std::string &endpoint(std::size_t port) const;
+    [[nodiscard]] std::uint64_t dropped() const noexcept { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Port {
+        Port(std::string name, std::size_t capacity) : endpoint(std::move(name)), inbox(capacity) {}
+
+        std::string endpoint;
+        MpscQueue<FabricFrame> inbox;
+    };
+
+    std::size_t m_inboxCapacity;
+    bool m_sealed{false};
+    std::vector<std::unique_ptr<Port>> m_ports;
+    std::unordered_map<std::uint32_t, std::vector<std::size_t>> m_routes;
+    std::atomic<std::uint64_t> m_dropped{0};
+};
+
+} // namespace trdp::communication
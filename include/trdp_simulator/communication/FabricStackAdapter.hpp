@@ -0,0 +1,47 @@
+#pragma once
+
+#include "trdp_simulator/communication/Fabric.hpp"
+#include "trdp_simulator/communication/LatencyHistogram.hpp"
+#include "trdp_simulator/communication/StackAdapter.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace trdp::communication {
+
+/// Received frames reach the handlers from poll(), on the thread that owns the adapter.
+class FabricStackAdapter final : public StackAdapter {
+public:
+    FabricStackAdapter(Fabric &fabric, std::size_t port);
+
+    void openSession(const std::string &endpoint) override;
+    void closeSession() override;
+
+    void registerProcessDataHandler(ProcessDataHandler handler) override;
+    void registerMessageDataHandler(MessageDataHandler handler) override;
+
+    void publishProcessData(const ProcessDataMessage &message) override;
+    MessageDataAck sendMessageData(const MessageDataMessage &message) override;
+
+    void poll() override;
+
+    [[nodiscard]] std::uint64_t sent() const noexcept { return m_sent; }
+    [[nodiscard]] std::uint64_t received() const noexcept { return m_received; }
+    [[nodiscard]] const LatencyHistogram &latency() const noexcept { return m_latency; }
+
+private:
+    void ensureOpen(const char *operation) const;
+
+    Fabric &m_fabric;
+    std::size_t m_port;
+    bool m_open{false};
+    ProcessDataHandler m_pdHandler;
+    MessageDataHandler m_mdHandler;
+    FabricFrame m_frame;
+    std::uint64_t m_sent{0};
+    std::uint64_t m_received{0};
+    LatencyHistogram m_latency;
+};
+
+} // namespace trdp::communication
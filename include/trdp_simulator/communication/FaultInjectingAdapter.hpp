@@ -0,0 +1,78 @@
+#pragma once
+
+#include "trdp_simulator/communication/FaultProfiles.hpp"
+#include "trdp_simulator/communication/StackAdapter.hpp"
+#include "trdp_simulator/communication/TimingWheel.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace trdp::communication {
+
+struct FaultStats {
+    std::uint64_t dropped{0};
+    std::uint64_t duplicated{0};
+    std::uint64_t reordered{0};
+    std::uint64_t corrupted{0};
+    std::uint64_t delayed{0};
+};
+
+/// Each comId draws from its own generator seeded from (seed, comId); delayed telegrams leave from poll().
+class FaultInjectingAdapter final : public StackAdapter {
+public:
+    FaultInjectingAdapter(std::shared_ptr<StackAdapter> inner, std::vector<FaultProfile> profiles,
+                          std::uint64_t seed);
+
+    void openSession(const std::string &endpoint) override;
+    void closeSession() override;
+
+    void registerProcessDataHandler(ProcessDataHandler handler) override;
+    void registerMessageDataHandler(MessageDataHandler handler) override;
+
+    void publishProcessData(const ProcessDataMessage &message) override;
+    MessageDataAck sendMessageData(const MessageDataMessage &message) override;
+
+    void poll() override;
+
+    [[nodiscard]] const FaultStats &stats() const noexcept { return m_stats; }
+    /// Telegrams currently held for delay or reordering.
+    [[nodiscard]] std::size_t pending() const noexcept;
+
+private:
+    struct ProfileState {
+        FaultProfile profile;
+        std::mt19937_64 random;
+        std::optional<ProcessDataMessage> held;
+    };
+
+    struct Draw {
+        bool lose;
+        bool duplicate;
+        bool reorder;
+        bool corrupt;
+        double jitter;
+        double bit;
+    };
+
+    [[nodiscard]] ProfileState *profileFor(std::uint32_t comId);
+    [[nodiscard]] static Draw draw(ProfileState &state);
+    void emit(ProfileState &state, const ProcessDataMessage &message, double jitter);
+    void releaseDue(TimingWheel<ProcessDataMessage>::Clock::time_point now);
+    void flush();
+
+    std::shared_ptr<StackAdapter> m_inner;
+    std::uint64_t m_seed;
+    /// Explicit profiles, plus one entry per comId that has fallen back to the comId 0 profile.
+    std::unordered_map<std::uint32_t, ProfileState> m_profiles;
+    std::optional<FaultProfile> m_wildcard;
+    TimingWheel<ProcessDataMessage> m_delayed;
+    FaultStats m_stats;
+};
+
+} // namespace trdp::communication
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace trdp::communication {
+
+/// A reordered PD telegram follows the next one of its comId; MD only sees loss, duplication and corruption.
+struct FaultProfile {
+    /// Zero applies the profile to every comId without a profile of its own.
+    std::uint32_t comId{0};
+    double loss{0.0};
+    double duplicate{0.0};
+    double reorder{0.0};
+    /// Probability of flipping one random payload bit.
+    double corrupt{0.0};
+    std::chrono::microseconds delay{0};
+    std::chrono::microseconds jitter{0};
+};
+
+enum class LatencyDistribution { Constant, Normal, Pareto };
+
+/// Parses "constant", "normal" or "pareto"; throws std::invalid_argument otherwise.
+[[nodiscard]] LatencyDistribution parseLatencyDistribution(std::string_view name);
+[[nodiscard]] std::string_view latencyDistributionName(LatencyDistribution distribution) noexcept;
+
+/// Telegrams serialise at @c bandwidth, then take a @c distribution delay; beyond @c queueLimit they are dropped.
+struct LinkProfile {
+    /// Zero is the shared default link for every comId without a link of its own.
+    std::uint32_t comId{0};
+    LatencyDistribution distribution{LatencyDistribution::Constant};
+    std::chrono::microseconds latency{0};
+    std::chrono::microseconds jitter{0};
+    /// Bits per second; zero leaves the link unlimited and without a queue.
+    std::uint64_t bandwidth{0};
+    /// Telegrams waiting for serialisation; zero is unbounded.
+    std::size_t queueLimit{0};
+};
+
+} // namespace trdp::communication
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace trdp::communication {
+
+/// Log-linear buckets: percentiles within about 6%, allocation-free recording, mergeable across threads.
+class LatencyHistogram {
+public:
+    void record(std::chrono::nanoseconds latency) noexcept;
+    void merge(const LatencyHistogram &other) noexcept;
+
+    [[nodiscard]] std::uint64_t count() const noexcept { return m_count; }
+    [[nodiscard]] std::chrono::nanoseconds max() const noexcept { return std::chrono::nanoseconds{m_max}; }
+    [[nodiscard]] std::chrono::nanoseconds mean() const noexcept;
+    /// Upper bound of the bucket holding the @p quantile (0..1) sample; zero when empty.
+    [[nodiscard]] std::chrono::nanoseconds percentile(double quantile) const noexcept;
+
+private:
+    static constexpr unsigned kSubBucketBits = 4;
+    static constexpr unsigned kSubBuckets = 1u << kSubBucketBits;
+    static constexpr unsigned kBuckets = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+    [[nodiscard]] static unsigned indexOf(std::uint64_t value) noexcept;
+    [[nodiscard]] static std::uint64_t upperBound(unsigned index) noexcept;
+
+    std::array<std::uint64_t, kBuckets> m_buckets{};
+    std::uint64_t m_count{0};
+    std::uint64_t m_total{0};
+    std::uint64_t m_max{0};
+};
+
+} // namespace trdp::communication
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace trdp::communication {
+
+/// Bounded lock-free MPSC queue after D. Vyukov; capacity is rounded up to a power of two.
+template <typename T>
+class MpscQueue {
+public:
+    explicit MpscQueue(std::size_t capacity)
+        : m_capacity(std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity)), m_mask(m_capacity - 1),
+          m_cells(std::make_unique<Cell[]>(m_capacity)) {
+        for (std::size_t i = 0; i < m_capacity; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    /// Returns false without blocking when the queue is full. Safe to call from any number of threads.
+    [[nodiscard]] bool tryPush(T value) {
+        std::size_t position = m_enqueue.load(std::memory_order_relaxed);
+        Cell *cell = nullptr;
+        while (true) {
+            cell = &m_cells[position & m_mask];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+            if (diff == 0) {
+                if (m_enqueue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                position = m_enqueue.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(value);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer side; must only be called from one thread at a time.
+    [[nodiscard]] bool tryPop(T &value) {
+        Cell &cell = m_cells[m_dequeue & m_mask];
+        const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(m_dequeue + 1) < 0) {
+            return false;
+        }
+        value = std::move(cell.value);
+        cell.sequence.store(m_dequeue + m_capacity, std::memory_order_release);
+        ++m_dequeue;
+        return true;
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return m_capacity; }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence{0};
+        T value{};
+    };
+
+    static constexpr std::size_t kCacheLine = 64;
+
+    std::size_t m_capacity;
+    std::size_t m_mask;
+    std::unique_ptr<Cell[]> m_cells;
+    alignas(kCacheLine) std::atomic<std::size_t> m_enqueue{0};
+    alignas(kCacheLine) std::size_t m_dequeue{0};
+};
+
+} // namespace trdp::communication
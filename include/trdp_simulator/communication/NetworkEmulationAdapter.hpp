@@ -0,0 +1,83 @@
+#pragma once
+
+#include "trdp_simulator/communication/FaultProfiles.hpp"
+#include "trdp_simulator/communication/StackAdapter.hpp"
+#include "trdp_simulator/communication/TimingWheel.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace trdp::communication {
+
+struct NetworkStats {
+    std::uint64_t delivered{0};
+    std::uint64_t queueDrops{0};
+    std::size_t peakQueueDepth{0};
+    /// Sum of queueing plus propagation delay of every delivered telegram.
+    std::chrono::nanoseconds totalDelay{0};
+};
+
+/// Holds outgoing PD until its delivery time and sends it from poll(); MD is forwarded immediately.
+class NetworkEmulationAdapter final : public StackAdapter {
+public:
+    using Clock = TimingWheel<ProcessDataMessage>::Clock;
+
+    /// Bytes added to every PD payload on the wire: TRDP PD header, UDP, IPv4 and Ethernet framing with gap.
+    static constexpr std::size_t kWireOverhead = 40 + 8 + 20 + 38;
+
+    NetworkEmulationAdapter(std::shared_ptr<StackAdapter> inner, std::vector<LinkProfile> links,
+                            std::uint64_t seed);
+
+    void openSession(const std::string &endpoint) override;
+    void closeSession() override;
+
+    void registerProcessDataHandler(ProcessDataHandler handler) override;
+    void registerMessageDataHandler(MessageDataHandler handler) override;
+
+    void publishProcessData(const ProcessDataMessage &message) override;
+    MessageDataAck sendMessageData(const MessageDataMessage &message) override;
+
+    void poll() override;
+
+    /// publishProcessData() with an explicit send time.
+    void transmit(const ProcessDataMessage &message, Clock::time_point now);
+    /// Delivers every telegram due at or before @p now; returns how many were delivered.
+    std::size_t release(Clock::time_point now);
+
+    [[nodiscard]] const NetworkStats &stats() const noexcept { return m_stats; }
+    /// Telegrams queued or in flight.
+    [[nodiscard]] std::size_t inFlight() const noexcept { return m_inFlight.size(); }
+
+private:
+    struct Link {
+        LinkProfile profile;
+        std::mt19937_64 random;
+        /// Serialisation end times of queued telegrams, oldest first.
+        std::deque<Clock::time_point> queue;
+        Clock::time_point busyUntil{};
+    };
+
+    struct InFlight {
+        ProcessDataMessage message;
+        Clock::time_point sentAt;
+    };
+
+    [[nodiscard]] Link *linkFor(std::uint32_t comId) noexcept;
+    [[nodiscard]] static std::chrono::nanoseconds propagation(Link &link);
+    void deliver(InFlight &&telegram, Clock::time_point now);
+
+    std::shared_ptr<StackAdapter> m_inner;
+    std::unordered_map<std::uint32_t, Link> m_links;
+    Link *m_default{nullptr};
+    TimingWheel<InFlight> m_inFlight;
+    NetworkStats m_stats;
+};
+
+} // namespace trdp::communication
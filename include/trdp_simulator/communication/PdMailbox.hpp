@@ -0,0 +1,64 @@
+#pragma once
+
+#include "trdp_simulator/communication/SeqlockBuffer.hpp"
+#include "trdp_simulator/communication/TelegramObserver.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace trdp::communication {
+
+struct PdSample {
+    std::uint32_t comId{0};
+    /// Number of telegrams received so far; zero when none has arrived yet.
+    std::uint64_t sequence{0};
+    std::chrono::steady_clock::time_point receivedAt{};
+    std::vector<std::uint8_t> payload;
+    /// The received payload was longer than the slot capacity and has been cut.
+    bool truncated{false};
+};
+
+/// Latest received payload per comId; one writer at a time, lock-free snapshots from any thread.
+class PdMailbox final : public TelegramObserver {
+public:
+    /// Largest PD payload TRDP allows.
+    static constexpr std::size_t kDefaultPayloadCapacity = 1432;
+
+    explicit PdMailbox(const std::vector<std::uint32_t> &comIds,
+                       std::size_t payloadCapacity = kDefaultPayloadCapacity);
+
+    PdMailbox(const PdMailbox &) = delete;
+    PdMailbox &operator=(const PdMailbox &) = delete;
+
+    void onProcessDataReceived(const ProcessDataMessage &message) override;
+
+    /// Stores @p payload as the latest value of @p comId; telegrams for other comIds are ignored.
+    void update(std::uint32_t comId, std::span<const std::uint8_t> payload,
+                std::chrono::steady_clock::time_point receivedAt) noexcept;
+
+    /// False when @p comId has no slot.
+    bool snapshot(std::uint32_t comId, PdSample &out) const;
+
+    /// ComIds with a slot, in construction order.
+    [[nodiscard]] std::vector<std::uint32_t> comIds() const;
+    [[nodiscard]] std::size_t payloadCapacity() const noexcept { return m_payloadCapacity; }
+
+private:
+    struct Slot {
+        std::uint32_t comId;
+        /// Only touched by the receive path.
+        std::uint64_t updates{0};
+        SeqlockBuffer buffer;
+    };
+
+    std::size_t m_payloadCapacity;
+    std::vector<std::unique_ptr<Slot>> m_slots;
+    std::unordered_map<std::uint32_t, Slot *> m_index;
+};
+
+} // namespace trdp::communication
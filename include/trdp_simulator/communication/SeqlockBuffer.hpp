@@ -0,0 +1,42 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <span>
+
+namespace trdp::communication {
+
+/// Readers retry instead of blocking the writer; callers serialise writers themselves.
+class SeqlockBuffer {
+public:
+    explicit SeqlockBuffer(std::size_t size);
+
+    SeqlockBuffer(const SeqlockBuffer &) = delete;
+    SeqlockBuffer &operator=(const SeqlockBuffer &) = delete;
+
+    [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+
+    /// Overwrites @p bytes at @p offset; throws std::out_of_range when the range exceeds the buffer.
+    void write(std::size_t offset, std::span<const std::uint8_t> bytes);
+    /// Writes @p parts back to back from @p offset as a single update, so readers see all of them or none.
+    void write(std::size_t offset, std::initializer_list<std::span<const std::uint8_t>> parts);
+
+    /// @p out must hold size() bytes; returns the (even) sequence number of the snapshot.
+    std::uint64_t read(std::span<std::uint8_t> out) const;
+
+    /// Sequence number of the last completed write.
+    [[nodiscard]] std::uint64_t version() const noexcept { return m_sequence.load(std::memory_order_acquire) & ~1ull; }
+
+private:
+    void copyIn(std::size_t offset, std::span<const std::uint8_t> bytes) noexcept;
+
+    std::size_t m_size;
+    std::size_t m_wordCount;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> m_words;
+    std::atomic<std::uint64_t> m_sequence{0};
+};
+
+} // namespace trdp::communication
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+
+namespace trdp::communication {
+
+/// SplitMix64 finaliser; spreads a (seed, comId) pair into the seed of a per-comId generator.
+[[nodiscard]] constexpr std::uint64_t splitMix64(std::uint64_t value) noexcept {
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+} // namespace trdp::communication
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "trdp_simulator/communication/Types.hpp"
+
+namespace trdp::communication {
+
+/// Send hooks run before the stack sees a telegram, receive hooks on the dispatching thread; must not throw.
+class TelegramObserver {
+public:
+    virtual ~TelegramObserver() = default;
+
+    virtual void onProcessDataSent(const ProcessDataMessage &message) { (void)message; }
+    virtual void onMessageDataSent(const MessageDataMessage &message) { (void)message; }
+    virtual void onProcessDataReceived(const ProcessDataMessage &message) { (void)message; }
+    virtual void onMessageDataReceived(const MessageDataMessage &message) { (void)message; }
+};
+
+} // namespace trdp::communication
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace trdp::communication {
+
+/// Items due in the same tick fire in scheduling order. Not thread-safe.
+template <typename T>
+class TimingWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    TimingWheel(std::chrono::nanoseconds tick, std::size_t slots, Clock::time_point origin = Clock::now())
+        : m_tick(std::max<std::int64_t>(1, tick.count())), m_slots(std::bit_ceil(std::max<std::size_t>(slots, 2))),
+          m_mask(m_slots.size() - 1), m_origin(origin) {}
+
+    /// Holds @p value until @p due; a deadline in the past fires on the next advance(). Items never fire early.
+    void schedule(Clock::time_point due, T value) {
+        const auto tick = std::max(tickOf(due + std::chrono::nanoseconds{m_tick - 1}), m_current);
+        m_slots[static_cast<std::size_t>(tick) & m_mask].push_back(Entry{tick, std::move(value)});
+        ++m_size;
+    }
+
+    /// @p fire may schedule new items; returns the number of items fired.
+    template <typename Fire>
+    std::size_t advance(Clock::time_point now, Fire &&fire) {
+        const auto target = tickOf(now);
+        if (target < m_current || m_size == 0) {
+            m_current = std::max(m_current, target + 1);
+            return 0;
+        }
+        // One revolution visits every slot, so a longer gap needs no further passes; items from several rounds
+        // may then be collected out of order and are sorted by tick before firing.
+        const auto revolution = static_cast<std::int64_t>(m_slots.size());
+        const bool wrapped = target - m_current >= revolution;
+        const auto last = wrapped ? m_current + revolution - 1 : target;
+        for (auto tick = m_current; tick <= last; ++tick) {
+            auto &slot = m_slots[static_cast<std::size_t>(tick) & m_mask];
+            std::size_t kept = 0;
+            for (std::size_t i = 0; i < slot.size(); ++i) {
+                if (slot[i].tick <= target) {
+                    m_firing.push_back(std::move(slot[i]));
+                } else if (kept++ != i) {
+                    slot[kept - 1] = std::move(slot[i]);
+                }
+            }
+            slot.erase(slot.begin() + static_cast<std::ptrdiff_t>(kept), slot.end());
+        }
+        if (wrapped) {
+            std::stable_sort(m_firing.begin(), m_firing.end(),
+                             [](const Entry &lhs, const Entry &rhs) { return lhs.tick < rhs.tick; });
+        }
+        // Advance first so items scheduled from fire() land in a future tick.
+        m_current = target + 1;
+        m_size -= m_firing.size();
+        const auto fired = m_firing.size();
+        for (auto &entry : m_firing) {
+            fire(std::move(entry.value));
+        }
+        m_firing.clear();
+        return fired;
+    }
+
+    /// Fires every held item regardless of its deadline, in tick order; the wheel's time does not move.
+    template <typename Fire>
+    std::size_t drain(Fire &&fire) {
+        for (auto &slot : m_slots) {
+            std::move(slot.begin(), slot.end(), std::back_inserter(m_firing));
+            slot.clear();
+        }
+        std::stable_sort(m_firing.begin(), m_firing.end(),
+                         [](const Entry &lhs, const Entry &rhs) { return lhs.tick < rhs.tick; });
+        m_size = 0;
+        const auto fired = m_firing.size();
+        for (auto &entry : m_firing) {
+            fire(std::move(entry.value));
+        }
+        m_firing.clear();
+        return fired;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] std::chrono::nanoseconds tick() const noexcept { return std::chrono::nanoseconds{m_tick}; }
+
+private:
+    struct Entry {
+        std::int64_t tick;
+        T value;
+    };
+
+    [[nodiscard]] std::int64_t tickOf(Clock::time_point time) const noexcept {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(time - m_origin).count();
+        return elapsed <= 0 ? 0 : elapsed / m_tick;
+    }
+
+    std::int64_t m_tick;
+    std::vector<std::vector<Entry>> m_slots;
+    std::size_t m_mask;
+    Clock::time_point m_origin;
+    std::int64_t m_current{0};
+    std::size_t m_size{0};
+    std::vector<Entry> m_firing;
+};
+
+} // namespace trdp::communication
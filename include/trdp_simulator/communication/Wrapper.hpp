@@ -2,6 +2,7 @@
 
 #include "trdp_simulator/communication/Diagnostics.hpp"
 #include "trdp_simulator/communication/StackAdapter.hpp"
+#include "trdp_simulator/communication/TelegramObserver.hpp"
 #include "trdp_simulator/communication/Types.hpp"
 
 #include <functional>
@@ -12,6 +13,9 @@
 
 namespace trdp::communication {
 
+/// Adapter a Wrapper uses when none is given: every telegram sent is delivered straight back to its handlers.
+[[nodiscard]] std::shared_ptr<StackAdapter> makeLoopbackStackAdapter();
+
 class Wrapper {
 public:
     using ProcessDataCallback = std::function<void(const ProcessDataMessage &)>;
@@ -25,11 +29,17 @@ public:
     void registerProcessDataHandler(ProcessDataCallback callback);
     void registerMessageDataHandler(MessageDataCallback callback);
 
+    void addObserver(TelegramObserver &observer);
+    void removeObserver(TelegramObserver &observer);
+
     void publishProcessData(const ProcessDataMessage &message);
     MessageDataAck sendMessageData(const MessageDataMessage &message);
 
     void poll();
 
+    /// Enables (default) or disables per-telegram telemetry; session events and errors are always recorded.
+    void setTelegramTracing(bool enabled) noexcept;
+
     [[nodiscard]] bool isOpen() const noexcept;
     [[nodiscard]] const std::vector<std::string> &telemetry() const noexcept;
     [[nodiscard]] const std::vector<DiagnosticEvent> &diagnostics() const noexcept;
@@ -43,10 +53,12 @@ private:
     std::string m_endpoint;
     std::shared_ptr<StackAdapter> m_adapter;
     bool m_open{false};
+    bool m_traceTelegrams{true};
     std::vector<std::string> m_telemetry;
     std::vector<DiagnosticEvent> m_diagnostics;
     ProcessDataCallback m_processDataCallback;
     MessageDataCallback m_messageDataCallback;
+    std::vector<TelegramObserver *> m_observers;
 };
 
 } // namespace trdp::communication
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "trdp_simulator/device/DeviceConfig.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace trdp::device {
+
+/// Wire size in bytes of a TRDP basic type (1 BOOL8 .. 16 TIMEDATE64); zero for anything else.
+[[nodiscard]] std::size_t basicTypeSize(std::uint32_t type) noexcept;
+/// True for the two's-complement types CHAR8 and INT8 .. INT64.
+[[nodiscard]] bool isSignedType(std::uint32_t type) noexcept;
+/// True for REAL32 and REAL64.
+[[nodiscard]] bool isRealType(std::uint32_t type) noexcept;
+
+/// Position of one flattened data set element within the marshalled payload.
+struct FieldLayout {
+    /// Element name; elements of nested data sets are prefixed with the outer name ("outer.inner").
+    std::string name;
+    std::uint32_t type{0};
+    std::size_t offset{0};
+    /// Size of a single value; arrays occupy @c count consecutive values.
+    std::size_t size{0};
+    std::size_t count{1};
+};
+
+/// Offsets follow the marshalled wire format: packed in declaration order, nested sets inlined, big-endian.
+class DatasetLayout {
+public:
+    /// Compiles data set @p datasetId of @p config; throws std::runtime_error for unknown or variable-size types.
+    [[nodiscard]] static DatasetLayout compile(const DeviceConfig &config, std::uint32_t datasetId);
+
+    [[nodiscard]] std::uint32_t id() const noexcept { return m_id; }
+    [[nodiscard]] const std::string &name() const noexcept { return m_name; }
+    [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+    [[nodiscard]] const std::vector<FieldLayout> &fields() const noexcept { return m_fields; }
+    /// Field called @p name, or nullptr.
+    [[nodiscard]] const FieldLayout *find(std::string_view name) const;
+
+private:
+    void append(const DeviceConfig &config, const DatasetConfig &dataset, const std::string &prefix,
+                std::vector<std::uint32_t> &path);
+
+    std::uint32_t m_id{0};
+    std::string m_name;
+    std::size_t m_size{0};
+    std::vector<FieldLayout> m_fields;
+    std::unordered_map<std::string, std::size_t> m_index;
+};
+
+} // namespace trdp::device
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace trdp::device {
+
+struct TelegramConfig {
+    std::string name;
+    std::uint32_t comId{0};
+    std::uint32_t datasetId{0};
+    /// The telegram lists at least one <source>, i.e. the device receives it.
+    bool subscribed{false};
+    /// The telegram lists at least one <destination>, i.e. the device sends it.
+    bool published{false};
+};
+
+/// Element of a <data-set>; @c type is a TRDP basic type (1..16) or the id of a nested data set.
+struct DatasetElement {
+    std::string name;
+    std::uint32_t type{0};
+    /// Number of consecutive values; zero declares a variable-length array.
+    std::uint32_t arraySize{1};
+};
+
+struct DatasetConfig {
+    std::string name;
+    std::uint32_t id{0};
+    std::vector<DatasetElement> elements;
+};
+
+struct DeviceConfig {
+    std::string hostName;
+    std::vector<TelegramConfig> telegrams;
+    std::vector<DatasetConfig> datasets;
+
+    /// ComIds the device receives, in declaration order.
+    [[nodiscard]] std::vector<std::uint32_t> subscriptions() const;
+    /// Telegrams the device sends, in declaration order.
+    [[nodiscard]] std::vector<TelegramConfig> publications() const;
+    /// Data set declared with @p id, or nullptr.
+    [[nodiscard]] const DatasetConfig *dataset(std::uint32_t id) const noexcept;
+};
+
+/// Reads the telegram and data set declarations of a device XML; throws std::runtime_error when it cannot be parsed.
+[[nodiscard]] DeviceConfig loadDeviceConfig(const std::filesystem::path &xmlPath);
+
+} // namespace trdp::device
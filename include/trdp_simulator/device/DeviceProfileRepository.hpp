@@ -1,10 +1,20 @@
 #pragma once
 
+#include "trdp_simulator/simulation/BulkImport.hpp"
+
+#include <cstddef>
 #include <filesystem>
+#include <mutex>
+#include <span>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
+namespace trdp::simulation {
+class BlobStore;
+}
+
 namespace trdp::device {
 
 struct DeviceProfileRecord {
@@ -19,9 +29,16 @@ class XmlValidator;
 
 class DeviceProfileRepository {
 public:
+    /// The manifest under @p root is read on the first call that needs it, not here.
     DeviceProfileRepository(std::filesystem::path root, XmlValidator &validator);
 
+    /// Profiles registered from now on are stored in @p blobs, shared with identical files; nullptr copies them.
+    void attachBlobStore(simulation::BlobStore *blobs) noexcept { m_blobs = blobs; }
+
     [[nodiscard]] std::string registerProfile(const std::filesystem::path &xmlPath);
+    /// Ids are handed out in file order. Not safe to call concurrently with anything else on the repository.
+    [[nodiscard]] std::vector<simulation::ImportOutcome>
+    registerProfiles(std::span<const std::filesystem::path> xmlPaths, std::size_t threads = 0);
     [[nodiscard]] bool exists(const std::string &id) const;
     [[nodiscard]] DeviceProfileRecord get(const std::string &id) const;
     [[nodiscard]] std::vector<DeviceProfileRecord> list() const;
@@ -32,13 +49,22 @@ private:
     std::filesystem::path m_root;
     std::filesystem::path m_manifestPath;
     XmlValidator &m_validator;
+    simulation::BlobStore *m_blobs{nullptr};
 
+    mutable std::once_flag m_loaded;
+    mutable std::string m_manifestText;
+    /// Latest manifest line per profile id, pointing into m_manifestText; decoded on lookup.
+    mutable std::unordered_map<std::string_view, std::string_view> m_manifestLines;
+    /// Profiles registered or changed since the manifest was read; their ids are no longer in m_manifestLines.
     std::unordered_map<std::string, DeviceProfileRecord> m_records;
 
-    void loadManifest();
+    void ensureLoaded() const;
+    void loadManifest() const;
     void persistManifest() const;
+    [[nodiscard]] std::string allocateId(const std::filesystem::path &xmlPath) const;
     static std::string sanitiseId(std::string candidate);
-    static std::string computeChecksum(const std::filesystem::path &path);
+    /// FNV-1a checksum that versions before XXH64 recorded; only compared against such records.
+    static std::string legacyChecksum(const std::filesystem::path &path);
     static std::string isoTimestamp();
 };
 
@@ -1,7 +1,12 @@
 #pragma once
 
 #include <filesystem>
+#include <mutex>
 #include <string>
+#include <vector>
+
+struct _xmlSchema;
+struct _xmlSchemaValidCtxt;
 
 namespace trdp::device {
 
@@ -10,16 +15,29 @@ struct XmlValidationResult {
     std::string message;
 };
 
+/// Compiles the schema on the first validate(), which may be called from several threads at once.
 class XmlValidator {
 public:
     explicit XmlValidator(std::filesystem::path schemaPath);
+    ~XmlValidator();
+
+    XmlValidator(const XmlValidator &) = delete;
+    XmlValidator &operator=(const XmlValidator &) = delete;
 
     [[nodiscard]] const std::filesystem::path &schemaPath() const noexcept;
     [[nodiscard]] XmlValidationResult validate(const std::filesystem::path &xmlPath) const;
 
 private:
+    [[nodiscard]] _xmlSchema *compiledSchema() const;
+    [[nodiscard]] _xmlSchemaValidCtxt *acquireContext(_xmlSchema *schema) const;
+    void releaseContext(_xmlSchemaValidCtxt *context) const noexcept;
+
     std::filesystem::path m_schemaPath;
+    mutable std::once_flag m_compileOnce;
+    mutable _xmlSchema *m_schema{nullptr};
+    mutable std::mutex m_poolMutex;
+    /// Validation contexts no call is using; each is only ever used by one call at a time.
+    mutable std::vector<_xmlSchemaValidCtxt *> m_idleContexts;
 };
 
 } // namespace trdp::device
-
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace trdp::simulation {
+
+/// Owners hold blobs by hard link, so a blob's link count is its reference count.
+class BlobStore {
+public:
+    struct Collection {
+        std::size_t blobs{0};
+        std::uintmax_t bytes{0};
+    };
+
+    explicit BlobStore(std::filesystem::path root);
+
+    /// Stores the contents of @p source and links @p destination to them; returns their checksum.
+    std::string storeFile(const std::filesystem::path &source, const std::filesystem::path &destination);
+    /// Stores @p contents and links @p destination to them; returns their checksum.
+    std::string storeContents(std::string_view contents, const std::filesystem::path &destination);
+
+    [[nodiscard]] std::filesystem::path pathFor(std::string_view checksum) const;
+    /// Links to the blob with @p checksum besides the store's own; 0 for an unknown blob.
+    [[nodiscard]] std::size_t references(std::string_view checksum) const;
+
+    /// Removes every blob without references, and staging files an interrupted store left behind.
+    Collection collect();
+
+    [[nodiscard]] const std::filesystem::path &root() const noexcept { return m_root; }
+
+private:
+    [[nodiscard]] std::filesystem::path stagingPath() const;
+    /// Links the staged copy into place as blob @p checksum, or checks that the existing blob holds the same bytes.
+    void commit(const std::filesystem::path &staged, const std::string &checksum);
+    /// Links @p destination to blob @p checksum; the staged copy restores a blob collected meanwhile.
+    void link(const std::string &checksum, const std::filesystem::path &staged,
+              const std::filesystem::path &destination);
+    [[nodiscard]] bool tryLink(const std::string &checksum, const std::filesystem::path &destination) const;
+
+    std::filesystem::path m_root;
+};
+
+} // namespace trdp::simulation
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace trdp::simulation {
+
+/// What became of one file of a bulk import: the id it was stored under, or why it was not.
+struct ImportOutcome {
+    std::filesystem::path source;
+    std::string id;
+    std::string error;
+
+    [[nodiscard]] bool ok() const noexcept { return error.empty(); }
+};
+
+/// Sorted by path, so a batch imports in the same order on every run.
+[[nodiscard]] std::vector<std::filesystem::path> importFiles(const std::filesystem::path &directory,
+                                                             std::initializer_list<std::string_view> extensions);
+
+/// Unique across threads and across processes importing into the same directory.
+[[nodiscard]] std::filesystem::path importStagingPath(const std::filesystem::path &directory, std::string_view suffix);
+
+/// Rethrows the first exception a task throws once all threads have finished.
+void parallelFor(std::size_t count, std::size_t threads, const std::function<void(std::size_t)> &task);
+
+} // namespace trdp::simulation
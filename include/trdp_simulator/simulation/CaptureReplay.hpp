@@ -0,0 +1,38 @@
+#pragma once
+
+#include "trdp_simulator/communication/LatencyHistogram.hpp"
+#include "trdp_simulator/simulation/RunCapture.hpp"
+#include "trdp_simulator/simulation/TimelineScheduler.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+
+namespace trdp::simulation {
+
+/// How closely a replay reproduced the send times of the recorded run.
+struct ReplayTiming {
+    std::string source;
+    std::uint64_t telegrams{0};
+    /// Time between the first and the last send, as recorded and as replayed.
+    std::chrono::nanoseconds recordedSpan{0};
+    std::chrono::nanoseconds replayedSpan{0};
+    /// How late each send was against its deadline.
+    communication::LatencyHistogram lateness;
+    /// Absolute difference between each replayed inter-send gap and the recorded one.
+    communication::LatencyHistogram gapError;
+};
+
+/// Receives every sent telegram of a capture when its deadline is due.
+using CaptureEmitter = std::function<void(const CaptureRecord &)>;
+
+/// @p capture, @p emit and @p timing are referenced and must outlive the task.
+[[nodiscard]] TimelineTask playCapture(TimelineScheduler &scheduler, const CaptureReader &capture,
+                                       TimelineScheduler::Clock::time_point start, const CaptureEmitter &emit,
+                                       ReplayTiming &timing);
+
+void writeReplayTiming(const std::filesystem::path &path, const ReplayTiming &timing);
+
+} // namespace trdp::simulation
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "trdp_simulator/simulation/MappedFile.hpp"
+#include "trdp_simulator/simulation/Scenario.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+namespace trdp::simulation {
+
+inline constexpr char kCompiledScenarioExtension[] = ".tsc";
+
+/// Written under a temporary name and renamed, so readers never see a partial file.
+void writeCompiledScenario(const std::filesystem::path &path, const Scenario &scenario, std::string_view checksum);
+
+/// Opening checks the header and section bounds only; toScenario() throws for records outside their table.
+class CompiledScenario {
+public:
+    explicit CompiledScenario(const std::filesystem::path &path);
+
+    /// Checksum of the YAML the file was compiled from.
+    [[nodiscard]] std::string_view checksum() const noexcept;
+    [[nodiscard]] std::size_t eventCount() const noexcept;
+    /// Interned string @p index; index 0 is the empty string.
+    [[nodiscard]] std::string_view string(std::uint32_t index) const;
+    [[nodiscard]] std::span<const std::uint8_t> arena() const noexcept;
+
+    /// Builds the Scenario; strings and payloads are copied out of the mapping, nothing is parsed.
+    [[nodiscard]] Scenario toScenario() const;
+
+private:
+    MappedFile m_file;
+};
+
+} // namespace trdp::simulation
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "trdp_simulator/communication/LatencyHistogram.hpp"
+#include "trdp_simulator/simulation/Scenario.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace trdp::simulation {
+
+class DeviceStateStore;
+
+struct ConsistMember {
+    std::string endpoint;
+    /// Shared read-only, so members playing the same stored scenario hold one copy.
+    std::shared_ptr<const Scenario> scenario;
+    std::vector<std::uint32_t> subscriptions;
+    /// Required when the scenario writes or publishes device state.
+    std::shared_ptr<DeviceStateStore> state;
+};
+
+/// Consist file entry referencing a stored scenario; the endpoint defaults to the scenario id.
+struct ConsistMemberRef {
+    std::string scenarioId;
+    std::string endpoint;
+};
+
+struct ConsistDefinition {
+    std::string id;
+    std::size_t shards{0};
+    std::vector<ConsistMemberRef> members;
+};
+
+/// Throws ScenarioValidationError on malformed input.
+[[nodiscard]] ConsistDefinition loadConsistDefinition(const std::filesystem::path &path);
+
+struct ConsistOptions {
+    /// Worker threads; zero selects one per hardware thread. Never more than the number of members.
+    std::size_t shards{0};
+    bool pinThreads{true};
+    std::size_t inboxCapacity{4096};
+    /// Upper bound on how long a shard sleeps between inbox polls while no timeline is due.
+    std::chrono::microseconds pollInterval{100};
+};
+
+struct ShardReport {
+    std::size_t index{0};
+    /// CPU the shard last ran on, or -1 when unknown.
+    int cpu{-1};
+    std::size_t members{0};
+    std::uint64_t sent{0};
+    std::uint64_t received{0};
+    std::chrono::nanoseconds wallTime{0};
+    std::chrono::nanoseconds cpuTime{0};
+    communication::LatencyHistogram latency;
+    std::vector<std::string> failures;
+
+    /// Thread CPU time over wall time for the shard's run.
+    [[nodiscard]] double utilisation() const noexcept;
+};
+
+/// Failures of one member, such as an MD send nobody answered; they stop that member only.
+struct MemberReport {
+    std::string endpoint;
+    std::vector<std::string> failures;
+};
+
+struct ConsistReport {
+    std::vector<ShardReport> shards;
+    /// One entry per member, in the order they were added.
+    std::vector<MemberReport> members;
+    communication::LatencyHistogram latency;
+    std::uint64_t dropped{0};
+
+    [[nodiscard]] bool success() const noexcept;
+};
+
+/// Triggers, expectations and run artefacts remain SimulationEngine features and are not evaluated here.
+class ConsistRunner {
+public:
+    explicit ConsistRunner(ConsistOptions options = {});
+
+    void addMember(ConsistMember member);
+    [[nodiscard]] std::size_t members() const noexcept { return m_members.size(); }
+
+    [[nodiscard]] ConsistReport run();
+
+private:
+    ConsistOptions m_options;
+    std::vector<ConsistMember> m_members;
+};
+
+} // namespace trdp::simulation
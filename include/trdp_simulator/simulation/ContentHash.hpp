@@ -0,0 +1,43 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace trdp::simulation {
+
+/// Streaming XXH64. Not collision resistant.
+class Xxh64 {
+public:
+    explicit Xxh64(std::uint64_t seed = 0) noexcept;
+
+    void update(std::span<const std::byte> data) noexcept;
+    void update(std::string_view data) noexcept { update(std::as_bytes(std::span{data.data(), data.size()})); }
+    [[nodiscard]] std::uint64_t digest() const noexcept;
+
+    [[nodiscard]] static std::uint64_t hash(std::string_view data, std::uint64_t seed = 0) noexcept;
+
+private:
+    std::array<std::uint64_t, 4> m_lanes{};
+    std::array<std::byte, 32> m_pending{};
+    std::size_t m_pendingSize{0};
+    std::uint64_t m_totalSize{0};
+    std::uint64_t m_seed{0};
+};
+
+/// Prefix of checksums produced by fileChecksum(); checksums recorded by earlier versions have none.
+inline constexpr std::string_view kChecksumPrefix = "xxh64:";
+
+/// Checksum of @p contents: kChecksumPrefix followed by the 16 hex digits of its XXH64.
+[[nodiscard]] std::string contentChecksum(std::string_view contents);
+/// contentChecksum() of the contents of @p path. Throws std::runtime_error.
+[[nodiscard]] std::string fileChecksum(const std::filesystem::path &path);
+
+/// An existing @p to is unlinked rather than overwritten, so hard links to it keep their contents.
+[[nodiscard]] std::string copyFileWithChecksum(const std::filesystem::path &from, const std::filesystem::path &to);
+
+} // namespace trdp::simulation
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "trdp_simulator/communication/SeqlockBuffer.hpp"
+#include "trdp_simulator/device/DatasetLayout.hpp"
+#include "trdp_simulator/simulation/Scenario.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace trdp::simulation {
+
+/// Publishers snapshot without waiting for writers; writers are serialised among themselves.
+class DeviceStateStore {
+public:
+    /// Resolved location of a (possibly indexed) field.
+    struct FieldRef {
+        std::size_t slot{0};
+        std::size_t offset{0};
+        std::size_t size{0};
+        std::uint32_t type{0};
+    };
+
+    /// Big-endian wire encoding of a single field value.
+    struct EncodedValue {
+        std::array<std::uint8_t, 8> bytes{};
+        std::size_t size{0};
+    };
+
+    explicit DeviceStateStore(const device::DeviceConfig &config);
+
+    [[nodiscard]] bool contains(std::uint32_t datasetId) const noexcept;
+    /// Throws std::out_of_range for undeclared data sets.
+    [[nodiscard]] const device::DatasetLayout &layout(std::uint32_t datasetId) const;
+
+    /// Array elements are addressed as `name[index]`. Throws std::out_of_range for unknown names.
+    [[nodiscard]] FieldRef resolve(std::uint32_t datasetId, std::string_view field) const;
+
+    /// Throws std::invalid_argument when @p value is not a valid value of the field's type.
+    [[nodiscard]] static EncodedValue encode(const FieldRef &field, std::string_view value);
+
+    void write(const FieldRef &field, const EncodedValue &value);
+    /// resolve() + encode() + write() in one call.
+    void set(std::uint32_t datasetId, std::string_view field, std::string_view value);
+
+    /// Copies a consistent snapshot of data set @p datasetId into @p out, resizing it to the data set size.
+    std::uint64_t snapshot(std::uint32_t datasetId, std::vector<std::uint8_t> &out) const;
+
+private:
+    struct Slot {
+        device::DatasetLayout layout;
+        communication::SeqlockBuffer buffer;
+    };
+
+    [[nodiscard]] const Slot &slot(std::uint32_t datasetId) const;
+
+    std::vector<std::unique_ptr<Slot>> m_slots;
+    std::unordered_map<std::uint32_t, std::size_t> m_index;
+    std::mutex m_writeMutex;
+};
+
+/// True when an event or trigger action writes or publishes device state, or a predicate names a data set field.
+[[nodiscard]] bool usesDeviceState(const Scenario &scenario) noexcept;
+
+} // namespace trdp::simulation
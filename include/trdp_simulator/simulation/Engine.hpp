@@ -1,33 +1,59 @@
 #pragma once
 
 #include "trdp_simulator/communication/Wrapper.hpp"
+#include "trdp_simulator/simulation/CaptureReplay.hpp"
 #include "trdp_simulator/simulation/Scenario.hpp"
 
 #include <cstdint>
 #include <filesystem>
+#include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace trdp::simulation {
 
+class BlobStore;
+class DeviceStateStore;
 class ScenarioRepository;
 
+/// Throws std::logic_error for state events without @p state, std::runtime_error for undelivered MD.
+void sendScenarioEvent(communication::Wrapper &wrapper, const ScenarioEvent &event,
+                       const std::vector<std::uint8_t> &payload, DeviceStateStore *state = nullptr);
+
 class SimulationEngine {
 public:
     explicit SimulationEngine(communication::Wrapper &wrapper, std::filesystem::path artefactRoot = {},
                               ScenarioRepository *repository = nullptr);
 
     void loadScenario(Scenario scenario);
+    /// Runs @p scenario without copying it, e.g. one shared from the ScenarioRepository cache.
+    void loadScenario(std::shared_ptr<const Scenario> scenario);
+    /// Device state used by `set` events and `source: state` publishers; required when the scenario uses them.
+    void attachDeviceState(DeviceStateStore *state) noexcept;
+    /// Run directories link their `scenario.yaml` to a blob in @p blobs instead of holding a copy each.
+    void attachBlobStore(BlobStore *blobs) noexcept;
+    /// The next run() sends the capture's telegrams instead of the scenario's events and triggers.
+    void replayCapture(const std::filesystem::path &capture);
     void run();
 
     [[nodiscard]] const Scenario &scenario() const noexcept;
+    /// Per-expectation outcome of the most recent run; empty when the scenario declares no expectations.
+    [[nodiscard]] const std::vector<ExpectationResult> &expectationResults() const noexcept;
+    /// Timing fidelity of the most recent capture replay; empty after a normal run.
+    [[nodiscard]] const std::optional<ReplayTiming> &replayTiming() const noexcept;
 
 private:
     communication::Wrapper &m_wrapper;
     std::filesystem::path m_artefactRoot;
     ScenarioRepository *m_repository{nullptr};
-    Scenario m_scenario;
+    DeviceStateStore *m_deviceState{nullptr};
+    BlobStore *m_blobs{nullptr};
+    std::shared_ptr<const Scenario> m_scenario{std::make_shared<const Scenario>()};
     bool m_loaded{false};
+    std::vector<ExpectationResult> m_expectationResults;
+    std::optional<CaptureReader> m_replay;
+    std::optional<ReplayTiming> m_replayTiming;
 };
 
 } // namespace trdp::simulation
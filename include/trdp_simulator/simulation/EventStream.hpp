@@ -0,0 +1,42 @@
+#pragma once
+
+#include "trdp_simulator/simulation/Scenario.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace trdp::simulation {
+
+/// @c payload is only valid until the next EventStream::next().
+struct EventEmission {
+    const ScenarioEvent *event{nullptr};
+    std::uint32_t iteration{0};
+    std::chrono::microseconds gap{0};
+    const std::vector<std::uint8_t> *payload{nullptr};
+};
+
+/// Counter payloads are rewritten in one working buffer, so memory does not grow with iterations.
+class EventStream {
+public:
+    explicit EventStream(const std::vector<ScenarioEvent> &events);
+
+    [[nodiscard]] bool next(EventEmission &emission);
+
+private:
+    const std::vector<ScenarioEvent> &m_events;
+    std::size_t m_index{0};
+    std::uint32_t m_iteration{0};
+    std::vector<std::uint8_t> m_payload;
+};
+
+/// Gap preceding iteration @p iteration of @p event (the event delay for the first iteration).
+[[nodiscard]] std::chrono::microseconds generatorGap(const ScenarioEvent &event, std::uint32_t iteration);
+
+void applyCounter(const PayloadCounter &counter, std::uint32_t iteration, std::vector<std::uint8_t> &payload);
+
+/// Total number of emissions a scenario expands to.
+[[nodiscard]] std::uint64_t emissionCount(const std::vector<ScenarioEvent> &events);
+
+} // namespace trdp::simulation
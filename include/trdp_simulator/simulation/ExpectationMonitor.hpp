@@ -0,0 +1,50 @@
+#pragma once
+
+#include "trdp_simulator/communication/TelegramObserver.hpp"
+#include "trdp_simulator/simulation/PayloadMatcher.hpp"
+#include "trdp_simulator/simulation/Scenario.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace trdp::simulation {
+
+/// References the expectations it was built from, which must outlive it.
+class ExpectationMonitor final : public communication::TelegramObserver {
+public:
+    /// @p deviceState resolves named payload fields and is not referenced afterwards.
+    explicit ExpectationMonitor(const std::vector<ScenarioExpectation> &expectations,
+                                const DeviceStateStore *deviceState = nullptr);
+
+    void start(std::chrono::steady_clock::time_point runStart);
+
+    void onProcessDataReceived(const communication::ProcessDataMessage &message) override;
+    void onMessageDataReceived(const communication::MessageDataMessage &message) override;
+
+    void observe(ScenarioEvent::Type type, std::uint32_t comId, std::span<const std::uint8_t> payload,
+                 std::chrono::steady_clock::time_point receivedAt);
+
+    [[nodiscard]] std::vector<ExpectationResult> results() const;
+
+private:
+    struct State {
+        const ScenarioExpectation *expectation{nullptr};
+        PayloadMatcher matcher;
+        std::uint64_t received{0};
+        std::uint64_t receivedInWindow{0};
+        std::uint64_t mismatches{0};
+        std::uint64_t cycleViolations{0};
+        std::chrono::microseconds maxCycleDeviation{0};
+        std::chrono::steady_clock::time_point lastArrival{};
+        bool seen{false};
+    };
+
+    std::vector<State> m_states;
+    std::unordered_map<std::uint32_t, std::vector<std::size_t>> m_byComId;
+    std::chrono::steady_clock::time_point m_runStart{};
+};
+
+} // namespace trdp::simulation
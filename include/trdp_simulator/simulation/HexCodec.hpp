@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace trdp::simulation::hex {
+
+/// Implementations of the codec; the widest one the CPU supports is picked once, at first use.
+enum class Kernel { Scalar, Sse2, Avx2 };
+
+[[nodiscard]] Kernel activeKernel() noexcept;
+/// Whether this CPU can run @p kernel; passing an unsupported kernel to decode or encode is undefined.
+[[nodiscard]] bool kernelSupported(Kernel kernel) noexcept;
+[[nodiscard]] const char *kernelName(Kernel kernel) noexcept;
+
+/// Returns the digits decoded: all (rounded down to even), or the index of the first invalid one.
+[[nodiscard]] std::size_t decode(std::string_view digits, std::uint8_t *out,
+                                 Kernel kernel = activeKernel()) noexcept;
+
+/// Writes the lower-case hex digits of @p bytes, two per byte, to @p out.
+void encode(std::span<const std::uint8_t> bytes, char *out, Kernel kernel = activeKernel()) noexcept;
+
+/// Lower-case hex digits of @p bytes, without a prefix.
+[[nodiscard]] std::string encode(std::span<const std::uint8_t> bytes);
+
+} // namespace trdp::simulation::hex
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "trdp_simulator/communication/LatencyHistogram.hpp"
+#include "trdp_simulator/communication/TelegramObserver.hpp"
+#include "trdp_simulator/communication/Wrapper.hpp"
+#include "trdp_simulator/device/DeviceConfig.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace trdp::simulation {
+
+struct LoadTarget {
+    std::uint32_t comId{0};
+    std::uint32_t datasetId{0};
+    std::size_t payloadSize{0};
+};
+
+/// Bytes at the start of every load payload: the step index and the send time, used to match receptions.
+inline constexpr std::size_t kLoadHeaderSize = 12;
+
+/// Throws std::runtime_error when the profile declares no telegrams.
+[[nodiscard]] std::vector<LoadTarget> loadTargets(const device::DeviceConfig &config);
+
+struct LoadOptions {
+    std::vector<LoadTarget> targets;
+    /// Offered telegrams per second over all targets; the ramp multiplies the rate by @c rampFactor per step.
+    double startRate{1000.0};
+    double maxRate{256000.0};
+    double rampFactor{2.0};
+    std::chrono::milliseconds stepDuration{500};
+    /// Time after a step for telegrams still in flight to arrive before they count as lost.
+    std::chrono::milliseconds drainTime{50};
+    /// Fraction of telegrams sent as MD instead of PD.
+    double mdShare{0.0};
+    /// A step is sustainable while it receives at least this fraction of the offered rate...
+    double minEfficiency{0.95};
+    /// ...loses at most this fraction of the telegrams it sent...
+    double maxLoss{0.001};
+    /// ...and its p99 latency stays within this factor of the first step's.
+    double maxLatencyGrowth{10.0};
+    /// Bisection steps between the last sustainable and the first unsustainable rate.
+    std::size_t refineSteps{3};
+};
+
+struct LoadStep {
+    double offeredRate{0.0};
+    double sendRate{0.0};
+    double receiveRate{0.0};
+    std::uint64_t sent{0};
+    std::uint64_t received{0};
+    /// MD requests the stack did not acknowledge as delivered.
+    std::uint64_t mdFailures{0};
+    communication::LatencyHistogram latency;
+    bool sustainable{false};
+
+    [[nodiscard]] double loss() const noexcept;
+};
+
+struct LoadReport {
+    std::string startedAt;
+    std::string completedAt;
+    std::vector<LoadTarget> targets;
+    /// Steps in the order they ran: the geometric ramp first, then the bisection towards the knee.
+    std::vector<LoadStep> steps;
+    /// Index of the sustainable step with the highest offered rate; empty when even the first step failed.
+    std::optional<std::size_t> knee;
+
+    /// Receive rate at the knee, or zero.
+    [[nodiscard]] double maxSustainableRate() const noexcept;
+};
+
+/// After the first unsustainable step the ramp bisects towards the highest sustainable rate.
+class LoadGenerator final : public communication::TelegramObserver {
+public:
+    /// Throws std::invalid_argument for empty targets or inconsistent rates.
+    LoadGenerator(communication::Wrapper &wrapper, LoadOptions options);
+
+    [[nodiscard]] LoadReport run();
+
+    void onProcessDataReceived(const communication::ProcessDataMessage &message) override;
+    void onMessageDataReceived(const communication::MessageDataMessage &message) override;
+
+private:
+    [[nodiscard]] LoadStep runStep(double rate);
+    void receive(const std::vector<std::uint8_t> &payload);
+    void judge(LoadStep &step);
+
+    communication::Wrapper &m_wrapper;
+    LoadOptions m_options;
+    std::chrono::steady_clock::time_point m_epoch;
+    std::uint32_t m_stepIndex{0};
+    LoadStep *m_current{nullptr};
+    std::optional<std::chrono::nanoseconds> m_baselineP99;
+};
+
+/// Writes @p report as YAML into a new `load-<profile>-<timestamp>` directory below @p runsRoot; returns the file.
+std::filesystem::path writeLoadReport(const std::filesystem::path &runsRoot, const std::string &profileId,
+                                      const LoadReport &report);
+
+} // namespace trdp::simulation
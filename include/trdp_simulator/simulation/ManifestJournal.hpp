@@ -0,0 +1,72 @@
+#pragma once
+
+#include "trdp_simulator/simulation/MappedFile.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace trdp::simulation {
+
+/// A later line for a key replaces an earlier one; a journal line cut short by a crash is dropped.
+class ManifestJournal {
+public:
+    struct Options {
+        /// fsync appended entries, and the snapshot and its directory on compaction, before returning.
+        bool sync{true};
+        std::size_t compactAfter{1024};
+    };
+
+    using LineVisitor = std::function<void(std::string_view)>;
+
+    /// @p header is the comment line written at the top of every snapshot, without the leading '#'.
+    ManifestJournal(std::filesystem::path snapshotPath, std::string header, Options options);
+    ManifestJournal(std::filesystem::path snapshotPath, std::string header)
+        : ManifestJournal(std::move(snapshotPath), std::move(header), Options{}) {}
+    ~ManifestJournal();
+
+    ManifestJournal(const ManifestJournal &) = delete;
+    ManifestJournal &operator=(const ManifestJournal &) = delete;
+
+    /// Visited lines point into mappings the journal keeps for its lifetime.
+    void replay(const LineVisitor &visitor);
+
+    void append(const std::string &entry);
+    /// Group commit: all of @p entries in one write and at most one fsync.
+    void append(std::span<const std::string> entries);
+
+    [[nodiscard]] bool compactionDue(std::size_t liveRecords) const noexcept;
+    /// Atomically replaces the snapshot with @p entries, then empties the journal.
+    void compact(std::span<const std::string> entries);
+
+    /// Returns the number of fields in @p line; only the first fields.size() are stored.
+    [[nodiscard]] static std::size_t splitFields(std::string_view line, std::span<std::string_view> fields) noexcept;
+
+    /// Entries in the journal: those replayed plus those appended since.
+    [[nodiscard]] std::size_t journalEntries() const noexcept { return m_journalEntries; }
+    [[nodiscard]] const Options &options() const noexcept { return m_options; }
+    [[nodiscard]] const std::filesystem::path &snapshotPath() const noexcept { return m_snapshotPath; }
+    [[nodiscard]] const std::filesystem::path &journalPath() const noexcept { return m_journalPath; }
+
+private:
+    void dropTornTail();
+    void truncateJournal(std::size_t complete, std::size_t size);
+    void openJournal();
+    void closeJournal() noexcept;
+    void writeJournal(std::string_view data);
+
+    std::filesystem::path m_snapshotPath;
+    std::filesystem::path m_journalPath;
+    std::string m_header;
+    Options m_options;
+    int m_journalFd{-1};
+    std::vector<MappedFile> m_mappings;
+    std::size_t m_journalEntries{0};
+    bool m_tailChecked{false};
+};
+
+} // namespace trdp::simulation
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace trdp::simulation {
+
+/// Reads the file into memory where mmap is unavailable. Throws std::runtime_error.
+class MappedFile {
+public:
+    explicit MappedFile(const std::filesystem::path &path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    [[nodiscard]] std::span<const std::byte> bytes() const noexcept { return {m_data, m_size}; }
+    [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+    [[nodiscard]] std::string_view text() const noexcept { return {reinterpret_cast<const char *>(m_data), m_size}; }
+
+private:
+    void release() noexcept;
+
+    const std::byte *m_data{nullptr};
+    std::size_t m_size{0};
+    bool m_mapped{false};
+    std::vector<std::byte> m_fallback;
+};
+
+} // namespace trdp::simulation
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "trdp_simulator/simulation/Scenario.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace trdp::simulation {
+
+class DeviceStateStore;
+
+class PayloadMatcher {
+public:
+    PayloadMatcher() = default;
+    /// Named fields are resolved through @p state, which is only read here and may be null otherwise.
+    explicit PayloadMatcher(const PayloadPredicate &predicate, const DeviceStateStore *state = nullptr);
+
+    [[nodiscard]] bool matches(std::span<const std::uint8_t> payload) const noexcept;
+    [[nodiscard]] bool empty() const noexcept { return !m_hasMasked && !m_hasField; }
+
+private:
+    bool m_hasMasked{false};
+    std::size_t m_maskOffset{0};
+    std::vector<std::uint8_t> m_mask;
+    std::vector<std::uint8_t> m_expected;
+
+    enum class FieldKind { Unsigned, Signed, Real };
+
+    bool m_hasField{false};
+    FieldKind m_fieldKind{FieldKind::Unsigned};
+    FieldMatch m_field{};
+};
+
+/// Reads an unsigned big-endian integer of @p width bytes starting at @p offset.
+[[nodiscard]] std::uint64_t readBigEndian(std::span<const std::uint8_t> payload, std::size_t offset,
+                                          std::uint8_t width) noexcept;
+
+} // namespace trdp::simulation
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "trdp_simulator/communication/TelegramObserver.hpp"
+#include "trdp_simulator/simulation/MappedFile.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace trdp::simulation {
+
+inline constexpr char kCaptureFileName[] = "capture.trc";
+
+enum class CaptureDirection : std::uint8_t { Sent = 0, Received = 1 };
+enum class CaptureType : std::uint8_t { ProcessData = 0, MessageData = 1 };
+
+/// One captured telegram; the payload points into the reader's mapping and lives as long as the reader.
+struct CaptureRecord {
+    std::int64_t timestampNs{0};
+    CaptureDirection direction{CaptureDirection::Sent};
+    CaptureType type{CaptureType::ProcessData};
+    std::uint32_t comId{0};
+    std::uint32_t datasetId{0};
+    std::span<const std::uint8_t> payload;
+};
+
+/// Writes a capture file block by block; records are buffered until a block fills up or flush() is called.
+class CaptureWriter {
+public:
+    static constexpr std::uint32_t kBlockRecords = 4096;
+    /// A block is also cut once its payload blob reaches this size.
+    static constexpr std::size_t kBlockBlobLimit = 1U << 20U;
+
+    /// Creates (or truncates) @p path; throws std::runtime_error when it cannot be opened.
+    explicit CaptureWriter(const std::filesystem::path &path);
+    ~CaptureWriter();
+
+    CaptureWriter(const CaptureWriter &) = delete;
+    CaptureWriter &operator=(const CaptureWriter &) = delete;
+
+    void append(std::int64_t timestampNs, CaptureDirection direction, CaptureType type, std::uint32_t comId,
+                std::uint32_t datasetId, std::span<const std::uint8_t> payload);
+    void flush();
+    void close();
+
+    [[nodiscard]] std::uint64_t recordCount() const noexcept { return m_written + m_timestamps.size(); }
+
+private:
+    std::ofstream m_stream;
+    std::uint64_t m_written{0};
+    std::vector<std::int64_t> m_timestamps;
+    std::vector<std::uint64_t> m_offsets;
+    std::vector<std::uint32_t> m_comIds;
+    std::vector<std::uint32_t> m_datasetIds;
+    std::vector<std::uint32_t> m_sizes;
+    std::vector<std::uint8_t> m_directions;
+    std::vector<std::uint8_t> m_types;
+    std::vector<std::uint8_t> m_blob;
+};
+
+/// Records selected by a scan: an optional comId and an inclusive timestamp range.
+struct CaptureQuery {
+    std::optional<std::uint32_t> comId;
+    std::int64_t fromNs{std::numeric_limits<std::int64_t>::min()};
+    std::int64_t toNs{std::numeric_limits<std::int64_t>::max()};
+};
+
+/// Sparse index entry for one block.
+struct CaptureBlock {
+    std::size_t offset{0};
+    std::uint32_t records{0};
+    std::int64_t minTimestampNs{0};
+    std::int64_t maxTimestampNs{0};
+    std::uint64_t blobBytes{0};
+    std::vector<std::uint32_t> comIds;
+};
+
+/// A block cut short by a crash ends the capture. Throws std::runtime_error for files that are not captures.
+class CaptureReader {
+public:
+    using Visitor = std::function<void(const CaptureRecord &)>;
+
+    /// Pull-style iteration over all records in file order, for consumers that interleave several captures.
+    class Cursor {
+    public:
+        /// Fills @p record with the next record; false once the capture is exhausted.
+        bool next(CaptureRecord &record);
+
+    private:
+        friend class CaptureReader;
+        explicit Cursor(const CaptureReader &reader) : m_reader(&reader) {}
+
+        const CaptureReader *m_reader;
+        std::size_t m_block{0};
+        std::uint32_t m_index{0};
+    };
+
+    explicit CaptureReader(const std::filesystem::path &path);
+
+    [[nodiscard]] const std::filesystem::path &path() const noexcept { return m_path; }
+    [[nodiscard]] const std::vector<CaptureBlock> &blocks() const noexcept { return m_blocks; }
+    [[nodiscard]] std::uint64_t recordCount() const noexcept { return m_records; }
+    /// Indexes of the blocks a scan for @p query reads.
+    [[nodiscard]] std::vector<std::size_t> candidateBlocks(const CaptureQuery &query) const;
+
+    /// Visits the matching records in file order.
+    void scan(const CaptureQuery &query, const Visitor &visitor) const;
+    [[nodiscard]] std::vector<CaptureRecord> select(const CaptureQuery &query) const;
+    [[nodiscard]] Cursor cursor() const { return Cursor{*this}; }
+    /// Earliest timestamp in the capture; zero when it is empty.
+    [[nodiscard]] std::int64_t firstTimestampNs() const noexcept;
+
+private:
+    [[nodiscard]] CaptureRecord recordAt(const CaptureBlock &block, std::size_t index) const noexcept;
+
+    std::filesystem::path m_path;
+    MappedFile m_file;
+    std::vector<CaptureBlock> m_blocks;
+    std::uint64_t m_records{0};
+};
+
+/// Appends every telegram the observed Wrapper sends or receives to a CaptureWriter, stamped with system time.
+class TelegramCapture final : public communication::TelegramObserver {
+public:
+    explicit TelegramCapture(CaptureWriter &writer) : m_writer(writer) {}
+
+    void onProcessDataSent(const communication::ProcessDataMessage &message) override;
+    void onMessageDataSent(const communication::MessageDataMessage &message) override;
+    void onProcessDataReceived(const communication::ProcessDataMessage &message) override;
+    void onMessageDataReceived(const communication::MessageDataMessage &message) override;
+
+private:
+    CaptureWriter &m_writer;
+};
+
+} // namespace trdp::simulation
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "trdp_simulator/communication/LatencyHistogram.hpp"
+#include "trdp_simulator/simulation/RunCapture.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace trdp::simulation {
+
+struct RunDiffOptions {
+    /// A telegram still unmatched this far (in run time) behind the other run counts as added or missing.
+    std::chrono::nanoseconds matchWindow{std::chrono::milliseconds{50}};
+    /// Individual differences kept for the report; the counters always cover all of them.
+    std::size_t maxSamples{20};
+};
+
+enum class DiffKind { Changed, Missing, Added };
+
+/// One telegram that differs: missing from the second run, added by it, or changed in data set or payload.
+struct DiffSample {
+    DiffKind kind{DiffKind::Changed};
+    CaptureDirection direction{CaptureDirection::Sent};
+    std::uint32_t comId{0};
+    /// Position among the telegrams of this comId and direction in the run that holds it (the first run if both).
+    std::uint64_t sequence{0};
+    /// Time since the start of that run.
+    std::chrono::nanoseconds offset{0};
+    std::size_t bytesDiffering{0};
+};
+
+/// Comparison of the telegrams of one comId in one direction.
+struct TelegramDiff {
+    std::uint32_t comId{0};
+    CaptureDirection direction{CaptureDirection::Sent};
+    std::uint64_t matched{0};
+    std::uint64_t changed{0};
+    std::uint64_t missing{0};
+    std::uint64_t added{0};
+    std::uint64_t bytesDiffering{0};
+    /// Absolute difference of the matched pairs' offsets from the start of their runs.
+    communication::LatencyHistogram timingDelta;
+    /// Sum of the signed differences (second run minus first); divided by @c matched it gives the mean shift.
+    std::int64_t timingShiftNs{0};
+};
+
+struct RunDiffReport {
+    std::uint64_t recordsA{0};
+    std::uint64_t recordsB{0};
+    /// Sorted by comId, then direction.
+    std::vector<TelegramDiff> telegrams;
+    /// The first RunDiffOptions::maxSamples differences in the order they were found.
+    std::vector<DiffSample> samples;
+
+    /// True when no telegram was added, missing or changed; timing differences do not count.
+    [[nodiscard]] bool equivalent() const noexcept;
+};
+
+/// Pairs telegrams per comId and direction in order; memory is bounded by RunDiffOptions::matchWindow.
+[[nodiscard]] RunDiffReport diffCaptures(const CaptureReader &a, const CaptureReader &b,
+                                         const RunDiffOptions &options = {});
+
+/// Number of positions at which @p a and @p b differ, counting any length difference as differing bytes.
+[[nodiscard]] std::size_t countDifferingBytes(std::span<const std::uint8_t> a,
+                                              std::span<const std::uint8_t> b) noexcept;
+
+} // namespace trdp::simulation
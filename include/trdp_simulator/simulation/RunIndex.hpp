@@ -0,0 +1,125 @@
+#pragma once
+
+#include "trdp_simulator/simulation/Scenario.hpp"
+
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace trdp::simulation {
+
+struct RunRecord {
+    std::string id;
+    std::string scenarioId;
+    std::filesystem::path artefactPath;
+    std::string startedAt;
+    std::string completedAt;
+    bool success{false};
+    std::string detail;
+    std::vector<ExpectationResult> expectations;
+};
+
+enum class RunOrder { OldestFirst, NewestFirst };
+
+/// Time bounds are inclusive; @c startedUntil also matches timestamps it is a prefix of.
+struct RunQuery {
+    std::optional<std::string> scenarioId{};
+    std::optional<bool> success{};
+    std::optional<std::string> startedFrom{};
+    std::optional<std::string> startedUntil{};
+    RunOrder order{RunOrder::NewestFirst};
+    std::optional<std::string> after{};
+    std::size_t offset{0};
+    /// Maximum number of runs returned; 0 returns every match.
+    std::size_t limit{0};
+};
+
+struct RunPage {
+    std::vector<RunRecord> runs;
+    /// Set when more runs match; pass it as RunQuery::after to fetch the next page.
+    std::optional<std::string> nextCursor;
+};
+
+/// Keeps manifest lines and decodes a RunRecord only when a query returns it.
+class RunIndex {
+public:
+    /// Manifest entry for @p record; '|' and line breaks in free text are replaced.
+    [[nodiscard]] static std::string encode(const RunRecord &record);
+    /// Decodes a manifest entry; std::nullopt for lines that are not run entries.
+    [[nodiscard]] static std::optional<RunRecord> decode(std::string_view line);
+
+    /// Indexes manifest entry @p line, replacing any run with the same id; other lines are ignored.
+    void upsert(std::string line);
+    void upsert(const RunRecord &record) { upsert(encode(record)); }
+    /// Like upsert(std::string), but only views @p line, which must outlive the index (a ManifestJournal mapping).
+    void upsertView(std::string_view line);
+    void clear();
+
+    [[nodiscard]] bool contains(std::string_view id) const { return m_runs.contains(id); }
+    [[nodiscard]] std::optional<RunRecord> find(std::string_view id) const;
+    [[nodiscard]] std::size_t size() const noexcept { return m_runs.size(); }
+
+    /// Throws std::invalid_argument for a malformed RunQuery::after cursor.
+    [[nodiscard]] RunPage query(const RunQuery &query) const;
+    /// Visits the manifest entry of every run, oldest first.
+    void forEachEntry(const std::function<void(std::string_view)> &visitor) const;
+
+private:
+    struct Entry {
+        std::string_view line;
+        std::string_view id;
+        std::string_view scenarioId;
+        std::string_view startedAt;
+        bool success{false};
+    };
+
+    /// Position in start order; runs starting at the same time are ordered by id.
+    struct Position {
+        std::string_view startedAt;
+        std::string_view id;
+    };
+
+    /// Everything up to and including timestamps with this prefix.
+    struct Until {
+        std::string_view prefix;
+    };
+
+    struct ByStart {
+        using is_transparent = void;
+        bool operator()(const Entry *lhs, const Entry *rhs) const noexcept;
+        bool operator()(const Entry *lhs, const Position &rhs) const noexcept;
+        bool operator()(const Position &lhs, const Entry *rhs) const noexcept;
+        bool operator()(const Entry *lhs, const Until &rhs) const noexcept;
+        bool operator()(const Until &lhs, const Entry *rhs) const noexcept;
+    };
+
+    using Ordered = std::set<const Entry *, ByStart>;
+
+    /// Every run of one scope, plus the failed ([0]) and successful ([1]) ones.
+    struct Indexes {
+        Ordered all;
+        std::array<Ordered, 2> byOutcome;
+    };
+
+    /// Indexes @p line, which must stay alive until clear(); false if it is not a run entry.
+    bool index(std::string_view line);
+    void link(const Entry &entry);
+    void unlink(const Entry &entry);
+
+    /// Keyed by Entry::id, which views the entry's own line.
+    std::unordered_map<std::string_view, Entry> m_runs;
+    /// Lines passed to upsert(std::string); replaced ones stay, since map keys may still view them.
+    std::deque<std::string> m_ownedLines;
+    Indexes m_all;
+    std::unordered_map<std::string_view, Indexes> m_byScenario;
+};
+
+} // namespace trdp::simulation
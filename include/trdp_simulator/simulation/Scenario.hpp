@@ -1,16 +1,43 @@
 #pragma once
 
+#include "trdp_simulator/communication/FaultProfiles.hpp"
+
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <optional>
 #include <string>
 #include <vector>
 
 namespace trdp::simulation {
 
+/// Stored big-endian at @c offset; with @c end set the value wraps back to @c start.
+struct PayloadCounter {
+    std::size_t offset{0};
+    std::uint8_t width{1};
+    std::uint64_t start{0};
+    std::uint64_t step{1};
+    std::optional<std::uint64_t> end;
+};
+
+/// A ramp (both rates non-zero) takes precedence over a fixed period.
+struct EventGenerator {
+    std::uint32_t repeat{1};
+    std::chrono::milliseconds period{0};
+    std::uint32_t rampStartHz{0};
+    std::uint32_t rampEndHz{0};
+    std::optional<PayloadCounter> counter;
+
+    [[nodiscard]] bool active() const noexcept { return repeat > 1 || counter.has_value(); }
+    [[nodiscard]] bool ramped() const noexcept { return rampStartHz > 0 && rampEndHz > 0; }
+};
+
 struct ScenarioEvent {
     enum class Type {
         ProcessData,
         MessageData,
+        /// Writes @c value to @c field of data set @c datasetId in the device state; nothing is sent.
+        StateUpdate,
     };
 
     Type type{Type::ProcessData};
@@ -19,13 +46,96 @@ struct ScenarioEvent {
     std::uint32_t datasetId{0};
     std::vector<std::uint8_t> payload;
     std::chrono::milliseconds delay{0};
+    EventGenerator generator{};
+    /// Timeline the event belongs to; empty selects the scenario's default timeline.
+    std::string timeline{};
+    /// PD only: publish the current device state of @c datasetId instead of @c payload.
+    bool fromState{false};
+    std::string field{};
+    std::string value{};
+};
+
+/// Delays are relative to the previous event of the same timeline; every timeline drives the scenario device.
+struct ScenarioTimeline {
+    std::string name;
+};
+
+/// Masked byte compare: (payload[offset + i] & mask[i]) == (value[i] & mask[i]) for every i.
+struct MaskedMatch {
+    std::size_t offset{0};
+    std::vector<std::uint8_t> mask;
+    std::vector<std::uint8_t> value;
+};
+
+/// Big-endian field compare against a constant; a named field replaces @c offset and @c width.
+struct FieldMatch {
+    enum class Op {
+        Equal,
+        NotEqual,
+        Less,
+        LessEqual,
+        Greater,
+        GreaterEqual,
+    };
+
+    std::size_t offset{0};
+    std::uint8_t width{1};
+    Op op{Op::Equal};
+    std::uint64_t value{0};
+    /// Element of data set @c datasetId, resolved to offset, size and type when the matcher is built.
+    std::uint32_t datasetId{0};
+    std::string name{};
+
+    [[nodiscard]] bool named() const noexcept { return !name.empty(); }
+};
+
+/// Predicate over a received payload; every configured compare must hold.
+struct PayloadPredicate {
+    std::optional<MaskedMatch> masked;
+    std::optional<FieldMatch> field;
+};
+
+/// A zero deadline disables the deadline check; latency is still recorded.
+struct ScenarioTrigger {
+    std::string label;
+    ScenarioEvent::Type on{ScenarioEvent::Type::ProcessData};
+    std::uint32_t comId{0};
+    PayloadPredicate predicate;
+    ScenarioEvent action;
+    std::chrono::milliseconds deadline{0};
+};
+
+/// Count bounds apply within @c window of the run start, or the whole run when zero.
+struct ScenarioExpectation {
+    std::string label;
+    ScenarioEvent::Type type{ScenarioEvent::Type::ProcessData};
+    std::uint32_t comId{0};
+    std::uint32_t minCount{1};
+    std::optional<std::uint32_t> maxCount;
+    std::chrono::milliseconds window{0};
+    PayloadPredicate predicate;
+    std::chrono::milliseconds cycle{0};
+    std::chrono::milliseconds cycleTolerance{0};
+};
+
+struct ExpectationResult {
+    std::string label;
+    bool passed{false};
+    std::string detail;
 };
 
 struct Scenario {
     std::string id;
     std::string deviceProfileId;
     std::vector<ScenarioEvent> events;
+    std::vector<ScenarioTimeline> timelines;
+    std::vector<ScenarioTrigger> triggers;
+    std::vector<ScenarioExpectation> expectations;
+    /// Per-comId faults injected into outgoing telegrams, reproducible from @c seed.
+    std::vector<communication::FaultProfile> faults;
+    /// Emulated egress links (latency, jitter, bandwidth, queueing) for outgoing PD.
+    std::vector<communication::LinkProfile> network;
+    std::uint64_t seed{0};
 };
 
 } // namespace trdp::simulation
-
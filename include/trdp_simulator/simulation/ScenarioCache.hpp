@@ -0,0 +1,60 @@
+#pragma once
+
+#include "trdp_simulator/simulation/Scenario.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace trdp::simulation {
+
+struct ScenarioCacheStats {
+    std::uint64_t hits{0};
+    std::uint64_t misses{0};
+    std::uint64_t evictions{0};
+    std::size_t entries{0};
+    std::size_t bytes{0};
+    std::size_t budgetBytes{0};
+};
+
+/// Approximate heap and inline bytes held by @p scenario; the unit of the cache budget.
+[[nodiscard]] std::size_t scenarioFootprint(const Scenario &scenario) noexcept;
+
+/// LRU cache keyed by YAML checksum; a scenario larger than the budget is not cached. Thread safe.
+class ScenarioCache {
+public:
+    static constexpr std::size_t kDefaultBudgetBytes = std::size_t{64} << 20U;
+
+    explicit ScenarioCache(std::size_t budgetBytes = kDefaultBudgetBytes);
+
+    /// Cached scenario for @p checksum, or null; counts a hit or a miss.
+    [[nodiscard]] std::shared_ptr<const Scenario> find(const std::string &checksum);
+    /// Returns the copy another thread cached first, if any.
+    std::shared_ptr<const Scenario> insert(const std::string &checksum, Scenario scenario);
+
+    /// Changes the budget, evicting at once when the cache is over it; zero disables caching.
+    void setBudget(std::size_t budgetBytes);
+    void clear();
+    [[nodiscard]] ScenarioCacheStats stats() const;
+
+private:
+    struct Entry {
+        std::string checksum;
+        std::shared_ptr<const Scenario> scenario;
+        std::size_t bytes{0};
+    };
+
+    void evictLocked();
+
+    mutable std::mutex m_mutex;
+    /// Most recently used first.
+    std::list<Entry> m_entries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> m_index;
+    ScenarioCacheStats m_stats;
+};
+
+} // namespace trdp::simulation
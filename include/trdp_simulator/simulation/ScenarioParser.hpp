@@ -2,6 +2,7 @@
 
 #include "trdp_simulator/simulation/Scenario.hpp"
 
+#include <cstddef>
 #include <filesystem>
 #include <stdexcept>
 #include <string>
@@ -12,13 +13,28 @@ class DeviceProfileRepository;
 
 namespace trdp::simulation {
 
-struct ScenarioValidationError : public std::runtime_error {
+class ScenarioSchemaValidator;
+
+class ScenarioValidationError : public std::runtime_error {
+public:
     using std::runtime_error::runtime_error;
+    ScenarioValidationError(const std::string &message, std::size_t line)
+        : std::runtime_error(message), m_line(line) {}
+
+    /// 1-based line of the scenario file the error refers to, or 0 when it concerns the file as a whole.
+    [[nodiscard]] std::size_t line() const noexcept { return m_line; }
+
+private:
+    std::size_t m_line{0};
 };
 
+/// Errors carry the line number; an item's own checks report the line of its leading `-`.
 class ScenarioParser {
 public:
     static Scenario parse(const std::filesystem::path &path, device::DeviceProfileRepository &repository);
+    /// Also validates against @p schema in the same pass over the file. Of several errors, the first in the file wins.
+    static Scenario parse(const std::filesystem::path &path, device::DeviceProfileRepository &repository,
+                          const ScenarioSchemaValidator &schema);
 };
 
 } // namespace trdp::simulation
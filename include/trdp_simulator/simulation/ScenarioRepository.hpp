@@ -1,9 +1,19 @@
 #pragma once
 
+#include "trdp_simulator/simulation/BulkImport.hpp"
+#include "trdp_simulator/simulation/ManifestJournal.hpp"
+#include "trdp_simulator/simulation/RunIndex.hpp"
 #include "trdp_simulator/simulation/Scenario.hpp"
+#include "trdp_simulator/simulation/ScenarioCache.hpp"
 
+#include <cstddef>
 #include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -12,6 +22,7 @@ class DeviceProfileRepository;
 }
 
 namespace trdp::simulation {
+class BlobStore;
 class ScenarioSchemaValidator;
 }
 
@@ -26,49 +37,80 @@ struct ScenarioRecord {
     std::string updatedAt;
 };
 
-struct RunRecord {
-    std::string id;
-    std::string scenarioId;
-    std::filesystem::path artefactPath;
-    std::string startedAt;
-    std::string completedAt;
-    bool success{false};
-    std::string detail;
-};
-
 class ScenarioRepository {
 public:
+    /// Manifests are replayed on first use, so opening the repository reads nothing.
     ScenarioRepository(std::filesystem::path root, device::DeviceProfileRepository &deviceRepository,
-                       ScenarioSchemaValidator &schemaValidator);
+                       ScenarioSchemaValidator &schemaValidator,
+                       std::size_t cacheBudgetBytes = ScenarioCache::kDefaultBudgetBytes,
+                       ManifestJournal::Options journalOptions = {});
+
+    /// Scenarios imported from now on are stored in @p blobs, shared with identical files; nullptr copies them.
+    void attachBlobStore(BlobStore *blobs) noexcept { m_blobs = blobs; }
 
     [[nodiscard]] std::string importScenario(const std::filesystem::path &path);
+    /// A later file with the same scenario id replaces an earlier one, as it would one import at a time.
+    [[nodiscard]] std::vector<ImportOutcome> importScenarios(std::span<const std::filesystem::path> paths,
+                                                             std::size_t threads = 0);
     [[nodiscard]] bool exists(const std::string &id) const;
     [[nodiscard]] ScenarioRecord get(const std::string &id) const;
     [[nodiscard]] std::vector<ScenarioRecord> list() const;
     [[nodiscard]] Scenario load(const std::string &id) const;
+    /// Like load(), but shares the cached scenario instead of copying it.
+    [[nodiscard]] std::shared_ptr<const Scenario> loadShared(const std::string &id) const;
     [[nodiscard]] Scenario loadRunScenario(const std::string &runId) const;
+    [[nodiscard]] std::shared_ptr<const Scenario> loadRunScenarioShared(const std::string &runId) const;
+
+    void setCacheBudget(std::size_t budgetBytes) { m_cache.setBudget(budgetBytes); }
+    [[nodiscard]] ScenarioCacheStats cacheStats() const { return m_cache.stats(); }
 
     void exportScenario(const std::string &id, const std::filesystem::path &destination) const;
     void recordRun(RunRecord record);
+    /// Records several finished runs with a single journal write and fsync.
+    void recordRuns(std::vector<RunRecord> records);
+    /// Folds both journals into fresh snapshots now instead of waiting for them to grow.
+    void compactManifests();
+    /// Every recorded run, oldest first.
     [[nodiscard]] std::vector<RunRecord> listRuns() const;
     [[nodiscard]] std::vector<RunRecord> listRunsForScenario(const std::string &scenarioId) const;
+    /// One page of the runs matching @p query; only the returned runs are copied.
+    [[nodiscard]] RunPage queryRuns(const RunQuery &query) const;
     [[nodiscard]] RunRecord getRun(const std::string &id) const;
 
 private:
     std::filesystem::path m_root;
-    std::filesystem::path m_manifestPath;
-    std::filesystem::path m_runManifestPath;
+    // The manifests and what they replay into are filled in on first use, from const members too.
+    mutable ManifestJournal m_manifest;
+    mutable ManifestJournal m_runManifest;
+    mutable std::once_flag m_manifestLoaded;
+    mutable std::once_flag m_runManifestLoaded;
+    mutable bool m_runManifestReplayed{false};
     device::DeviceProfileRepository &m_deviceRepository;
     ScenarioSchemaValidator &m_schemaValidator;
+    BlobStore *m_blobs{nullptr};
+    /// Latest manifest line per scenario id, pointing into the manifest's mappings; decoded on lookup.
+    mutable std::unordered_map<std::string_view, std::string_view> m_manifestLines;
+    /// Records imported since the manifest was replayed; their ids are no longer in m_manifestLines.
     std::unordered_map<std::string, ScenarioRecord> m_records;
-    std::unordered_map<std::string, RunRecord> m_runs;
+    mutable RunIndex m_runs;
+    mutable ScenarioCache m_cache;
 
-    void loadManifest();
-    void persistManifest() const;
-    void loadRunManifest();
-    void persistRunManifest() const;
+    void ensureManifest() const;
+    void ensureRunManifest() const;
+    void loadManifest() const;
+    void loadRunManifest() const;
+    void compactManifest();
+    [[nodiscard]] std::optional<ScenarioRecord> findRecord(const std::string &id) const;
+    void compactRunManifest();
+    [[nodiscard]] std::shared_ptr<const Scenario> loadCached(const std::filesystem::path &path,
+                                                             const std::string &checksum) const;
+    [[nodiscard]] std::optional<Scenario> loadCompiled(const ScenarioRecord &record,
+                                                       const std::string &checksum) const;
+    void compile(const std::filesystem::path &storedPath, const Scenario &scenario,
+                 const std::string &checksum) const;
+    /// Id a scenario is stored under: its own id, reduced to characters safe in a file name.
+    static std::string storageId(const Scenario &scenario);
     static std::string sanitiseId(std::string candidate);
-    static std::string computeChecksum(const std::filesystem::path &path);
     static std::string isoTimestamp();
 };
 
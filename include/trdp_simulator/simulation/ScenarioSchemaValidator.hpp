@@ -1,33 +1,85 @@
 #pragma once
 
 #include "trdp_simulator/simulation/ScenarioParser.hpp"
+#include "trdp_simulator/simulation/ScenarioVisitor.hpp"
 
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <map>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace trdp::simulation {
 
 class ScenarioSchemaValidator {
+private:
+    struct ItemSchema;
+
 public:
+    /// Schema field names as bits; positions follow alphabetical order, so the lowest bit is the first name.
+    using FieldSet = std::bitset<128>;
+
+    /// With @p parseValues off, payload, type and field_op values are left to the next visitor.
+    class Checker final : public ScenarioVisitor {
+    public:
+        Checker(const ScenarioSchemaValidator &schema, bool parseValues);
+
+        void headerField(std::string_view key, std::string_view value) override;
+        void section(std::string_view name) override;
+        void item(std::size_t line) override;
+        void itemField(std::string_view key, std::string_view value) override;
+        void end() override;
+
+    private:
+        void finaliseItem();
+
+        const ScenarioSchemaValidator &m_schema;
+        bool m_parseValues;
+        const ItemSchema *m_section{nullptr};
+        bool m_sawEvents{false};
+        bool m_itemActive{false};
+        std::size_t m_itemLine{0};
+        std::size_t m_eventCount{0};
+        FieldSet m_scenarioFields;
+        FieldSet m_itemFields;
+    };
+
     explicit ScenarioSchemaValidator(std::filesystem::path schemaPath);
 
     void validate(const std::filesystem::path &scenarioPath) const;
 
+    [[nodiscard]] Checker checker(bool parseValues = true) const { return Checker{*this, parseValues}; }
+
     [[nodiscard]] const std::filesystem::path &schemaPath() const noexcept { return m_schemaPath; }
 
 private:
-    std::filesystem::path m_schemaPath;
-    std::set<std::string> m_requiredScenarioFields;
-    std::set<std::string> m_allowedScenarioFields;
-    std::set<std::string> m_requiredEventFields;
-    std::set<std::string> m_allowedEventFields;
-    std::set<std::string> m_eventTypeValues;
-    std::set<std::string> m_numericEventFields;
+    /// Field rules for one list section (events, triggers, ...).
+    struct ItemSchema {
+        std::string context;
+        FieldSet required;
+        FieldSet allowed;
+        FieldSet numeric;
+    };
 
+    /// Bit of @p field, or -1 when the schema never names it. One probe of a collision-free hash table.
+    [[nodiscard]] int fieldBit(std::string_view field) const noexcept;
+    [[nodiscard]] FieldSet compile(const std::set<std::string> &fields) const;
+    void ensureRequired(const FieldSet &required, const FieldSet &present, const std::string &context) const;
     void loadSchema();
+
+    std::filesystem::path m_schemaPath;
+    FieldSet m_requiredScenarioFields;
+    FieldSet m_allowedScenarioFields;
+    std::vector<std::string> m_eventTypeValues;
+    std::map<std::string, ItemSchema, std::less<>> m_sections;
+    std::vector<std::string> m_fieldNames;
+    std::vector<std::int16_t> m_fieldSlots;
+    std::uint64_t m_fieldSeed{0};
 };
 
 } // namespace trdp::simulation
-
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "trdp_simulator/simulation/MappedFile.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <initializer_list>
+#include <string_view>
+
+namespace trdp::simulation {
+
+/// Keys and values view the file's text and are only valid during the call.
+class ScenarioVisitor {
+public:
+    virtual ~ScenarioVisitor() = default;
+
+    /// A `key: value` line before the first section.
+    virtual void headerField(std::string_view key, std::string_view value) = 0;
+    /// A section line such as `events:`; @p name excludes the colon.
+    virtual void section(std::string_view name) = 0;
+    /// The `-` opening a list item, on @p line. A field on the same line follows as itemField.
+    virtual void item(std::size_t line) = 0;
+    virtual void itemField(std::string_view key, std::string_view value) = 0;
+    virtual void end() = 0;
+};
+
+/// Maps a scenario file, raising ScenarioValidationError when it is missing or unreadable.
+[[nodiscard]] MappedFile mapScenarioFile(const std::filesystem::path &path);
+
+/// Errors raised without a line number while handling a line get that line's number.
+void visitScenario(std::string_view text, std::initializer_list<ScenarioVisitor *> visitors);
+
+} // namespace trdp::simulation
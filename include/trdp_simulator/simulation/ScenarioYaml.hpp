@@ -3,8 +3,10 @@
 #include "trdp_simulator/simulation/Scenario.hpp"
 #include "trdp_simulator/simulation/ScenarioParser.hpp"
 
+#include <charconv>
 #include <chrono>
 #include <cstdint>
+#include <limits>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -13,11 +15,35 @@
 namespace trdp::simulation::scenario_yaml {
 
 [[nodiscard]] std::string trim(std::string value);
+/// Allocation-free trim; the result views @p value.
+[[nodiscard]] std::string_view trimView(std::string_view value) noexcept;
 [[nodiscard]] std::pair<std::string, std::string> parseKeyValue(const std::string &line);
-[[nodiscard]] ScenarioEvent::Type parseType(const std::string &token);
-[[nodiscard]] std::vector<std::uint8_t> parsePayload(const std::string &value);
-[[nodiscard]] std::chrono::milliseconds parseDelay(const std::string &value);
+/// Splits `key: value` into trimmed views of @p line, dropping quotes around the value.
+[[nodiscard]] std::pair<std::string_view, std::string_view> splitKeyValue(std::string_view line);
+[[nodiscard]] ScenarioEvent::Type parseType(std::string_view token);
+[[nodiscard]] const char *typeName(ScenarioEvent::Type type) noexcept;
+[[nodiscard]] std::vector<std::uint8_t> parsePayload(std::string_view value);
+[[nodiscard]] std::chrono::milliseconds parseDelay(std::string_view value);
+[[nodiscard]] FieldMatch::Op parseFieldOp(std::string_view token);
+[[nodiscard]] const char *fieldOpName(FieldMatch::Op op) noexcept;
 [[nodiscard]] std::string describeEvent(const ScenarioEvent &event);
 
+/// Parses the decimal value of field @p key, which must consist of digits only and fit @p T.
+template <typename T>
+[[nodiscard]] T parseUnsigned(std::string_view key, std::string_view value) {
+    std::uint64_t number = 0;
+    const auto *end = value.data() + value.size();
+    const auto [parsed, ec] = std::from_chars(value.data(), end, number);
+    if (value.empty() || ec == std::errc::invalid_argument || parsed != end) {
+        throw ScenarioValidationError{"Numeric field '" + std::string{key} +
+                                      "' must be a non-negative integer: " + std::string{value}};
+    }
+    if (ec == std::errc::result_out_of_range || number > std::numeric_limits<T>::max()) {
+        throw ScenarioValidationError{"Numeric field '" + std::string{key} + "' is out of range: " +
+                                      std::string{value}};
+    }
+    return static_cast<T>(number);
+}
+
 } // namespace trdp::simulation::scenario_yaml
 
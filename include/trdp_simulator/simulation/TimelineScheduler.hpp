@@ -0,0 +1,110 @@
+#pragma once
+
+#include "trdp_simulator/simulation/EventStream.hpp"
+
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace trdp::simulation {
+
+/// Events of one timeline, in scenario order.
+struct TimelinePlan {
+    std::string name;
+    std::vector<ScenarioEvent> events;
+};
+
+/// The default timeline comes first, then declared timelines, then undeclared names by first use.
+[[nodiscard]] std::vector<TimelinePlan> planTimelines(const Scenario &scenario);
+
+/// Starts suspended; the only suspension point is TimelineScheduler::sleepUntil().
+class TimelineTask {
+public:
+    struct promise_type {
+        std::exception_ptr exception;
+
+        TimelineTask get_return_object() noexcept {
+            return TimelineTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        std::suspend_always final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() noexcept { exception = std::current_exception(); }
+    };
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    TimelineTask(TimelineTask &&other) noexcept;
+    TimelineTask &operator=(TimelineTask &&other) noexcept;
+    TimelineTask(const TimelineTask &) = delete;
+    TimelineTask &operator=(const TimelineTask &) = delete;
+    ~TimelineTask();
+
+    [[nodiscard]] Handle release() noexcept;
+
+private:
+    explicit TimelineTask(Handle handle) noexcept : m_handle(handle) {}
+
+    Handle m_handle;
+};
+
+/// Deadlines are absolute; timelines due at the same instant resume in scheduling order.
+class TimelineScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+    /// Called with the next deadline while no timeline is due; must return no later than that deadline.
+    using IdleHook = std::function<void(Clock::time_point)>;
+
+    struct SleepAwaiter {
+        TimelineScheduler &scheduler;
+        Clock::time_point deadline;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(TimelineTask::Handle handle) { scheduler.schedule(handle, deadline); }
+        void await_resume() const noexcept {}
+    };
+
+    TimelineScheduler() = default;
+    TimelineScheduler(const TimelineScheduler &) = delete;
+    TimelineScheduler &operator=(const TimelineScheduler &) = delete;
+    ~TimelineScheduler();
+
+    /// Takes ownership of @p task and makes it runnable immediately.
+    void spawn(TimelineTask task);
+
+    /// Suspends the calling timeline until @p deadline; a deadline in the past still yields to other due timelines.
+    [[nodiscard]] SleepAwaiter sleepUntil(Clock::time_point deadline) noexcept { return SleepAwaiter{*this, deadline}; }
+
+    /// An exception escaping a timeline stops the run and is rethrown.
+    void run(const IdleHook &idle = {});
+
+    /// Number of coroutine resumptions performed so far.
+    [[nodiscard]] std::uint64_t switches() const noexcept { return m_switches; }
+
+private:
+    struct Entry {
+        Clock::time_point deadline;
+        std::uint64_t sequence;
+        TimelineTask::Handle handle;
+    };
+
+    void schedule(TimelineTask::Handle handle, Clock::time_point deadline);
+    void destroyPending() noexcept;
+
+    std::vector<Entry> m_ready;
+    std::uint64_t m_sequence{0};
+    std::uint64_t m_switches{0};
+};
+
+/// Receives every emission of a timeline started with playTimeline().
+using TimelineEmitter = std::function<void(const TimelinePlan &, const EventEmission &)>;
+
+/// @p plan and @p emit are referenced and must outlive the task.
+[[nodiscard]] TimelineTask playTimeline(TimelineScheduler &scheduler, const TimelinePlan &plan,
+                                        TimelineScheduler::Clock::time_point start, const TimelineEmitter &emit);
+
+} // namespace trdp::simulation
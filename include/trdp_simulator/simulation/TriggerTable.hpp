@@ -0,0 +1,40 @@
+#pragma once
+
+#include "trdp_simulator/simulation/PayloadMatcher.hpp"
+#include "trdp_simulator/simulation/Scenario.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace trdp::simulation {
+
+/// A trigger whose predicate matched a received telegram and whose action is waiting to be sent.
+struct TriggerReaction {
+    const ScenarioTrigger *trigger{nullptr};
+    std::chrono::steady_clock::time_point receivedAt;
+};
+
+/// References the triggers it was built from, which must outlive it.
+class TriggerTable {
+public:
+    /// @p state resolves named payload fields and is not referenced afterwards.
+    explicit TriggerTable(const std::vector<ScenarioTrigger> &triggers, const DeviceStateStore *state = nullptr);
+
+    [[nodiscard]] bool empty() const noexcept { return m_rules.empty(); }
+
+    void evaluate(ScenarioEvent::Type type, std::uint32_t comId, std::span<const std::uint8_t> payload,
+                  std::chrono::steady_clock::time_point receivedAt, std::vector<TriggerReaction> &fired) const;
+
+private:
+    struct Rule {
+        const ScenarioTrigger *trigger{nullptr};
+        PayloadMatcher matcher;
+    };
+
+    std::unordered_map<std::uint32_t, std::vector<Rule>> m_rules;
+};
+
+} // namespace trdp::simulation
@@ -0,0 +1,63 @@
+#include "trdp_simulator/communication/Fabric.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace trdp::communication {
+
+Fabric::Fabric(std::size_t inboxCapacity) : m_inboxCapacity(inboxCapacity) {
+    if (m_inboxCapacity == 0) {
+        throw std::invalid_argument("Fabric inbox capacity must be positive");
+    }
+}
+
+std::size_t Fabric::attach(std::string endpoint, const std::vector<std::uint32_t> &subscriptions) {
+    if (m_sealed) {
+        throw std::logic_error("Cannot attach endpoint '" + endpoint + "' to a sealed fabric");
+    }
+    const std::size_t port = m_ports.size();
+    m_ports.push_back(std::make_unique<Port>(std::move(endpoint), m_inboxCapacity));
+    for (const auto comId : subscriptions) {
+        auto &route = m_routes[comId];
+        if (route.empty() || route.back() != port) {
+            route.push_back(port);
+        }
+    }
+    return port;
+}
+
+void Fabric::seal() {
+    m_sealed = true;
+}
+
+std::size_t Fabric::send(FabricFrame frame) {
+    if (!m_sealed) {
+        throw std::logic_error("Fabric must be sealed before telegrams are sent");
+    }
+    const auto it = m_routes.find(frame.comId);
+    if (it == m_routes.end()) {
+        return 0;
+    }
+    std::size_t delivered = 0;
+    for (const auto port : it->second) {
+        if (port == frame.source) {
+            continue;
+        }
+        if (m_ports[port]->inbox.tryPush(frame)) {
+            ++delivered;
+        } else {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    return delivered;
+}
+
+bool Fabric::receive(std::size_t port, FabricFrame &frame) {
+    return m_ports.at(port)->inbox.tryPop(frame);
+}
+
+const std::string &Fabric::endpoint(std::size_t port) const {
+    return m_ports.at(port)->endpoint;
+}
+
+} // namespace trdp::communication
@@ -0,0 +1,82 @@
+#include "trdp_simulator/communication/FabricStackAdapter.hpp"
+
+#include "trdp_simulator/communication/TrdpError.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace trdp::communication {
+
+FabricStackAdapter::FabricStackAdapter(Fabric &fabric, std::size_t port) : m_fabric(fabric), m_port(port) {
+    if (m_port >= m_fabric.ports()) {
+        throw std::out_of_range("Fabric port out of range");
+    }
+}
+
+void FabricStackAdapter::openSession(const std::string &endpoint) {
+    if (m_open) {
+        throw TrdpError("Session already open", 1001, endpoint);
+    }
+    m_open = true;
+}
+
+void FabricStackAdapter::closeSession() {
+    if (!m_open) {
+        throw TrdpError("Session already closed", 1002, m_fabric.endpoint(m_port));
+    }
+    m_open = false;
+}
+
+void FabricStackAdapter::registerProcessDataHandler(ProcessDataHandler handler) {
+    m_pdHandler = std::move(handler);
+}
+
+void FabricStackAdapter::registerMessageDataHandler(MessageDataHandler handler) {
+    m_mdHandler = std::move(handler);
+}
+
+void FabricStackAdapter::publishProcessData(const ProcessDataMessage &message) {
+    ensureOpen("publishProcessData");
+    m_fabric.send(FabricFrame{FabricFrame::Kind::ProcessData, m_port, message.label, message.comId, message.datasetId,
+                              message.payload, std::chrono::steady_clock::now()});
+    ++m_sent;
+}
+
+MessageDataAck FabricStackAdapter::sendMessageData(const MessageDataMessage &message) {
+    ensureOpen("sendMessageData");
+    const auto delivered =
+        m_fabric.send(FabricFrame{FabricFrame::Kind::MessageData, m_port, message.label, message.comId,
+                                  message.datasetId, message.payload, std::chrono::steady_clock::now()});
+    ++m_sent;
+    if (delivered == 0) {
+        return MessageDataAck{MessageDataStatus::Timeout, "no listener for comId " + std::to_string(message.comId)};
+    }
+    return MessageDataAck{MessageDataStatus::Delivered, "fabric"};
+}
+
+void FabricStackAdapter::poll() {
+    if (!m_open) {
+        return;
+    }
+    while (m_fabric.receive(m_port, m_frame)) {
+        m_latency.record(std::chrono::steady_clock::now() - m_frame.sentAt);
+        ++m_received;
+        if (m_frame.kind == FabricFrame::Kind::ProcessData) {
+            if (m_pdHandler) {
+                m_pdHandler(ProcessDataMessage{std::move(m_frame.label), m_frame.comId, m_frame.datasetId,
+                                               std::move(m_frame.payload)});
+            }
+        } else if (m_mdHandler) {
+            m_mdHandler(MessageDataMessage{std::move(m_frame.label), m_frame.comId, m_frame.datasetId,
+                                           std::move(m_frame.payload)});
+        }
+    }
+}
+
+void FabricStackAdapter::ensureOpen(const char *operation) const {
+    if (!m_open) {
+        throw TrdpError(std::string(operation) + " called without open session", 1003, operation);
+    }
+}
+
+} // namespace trdp::communication
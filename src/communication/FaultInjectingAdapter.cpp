@@ -0,0 +1,217 @@
+#include "trdp_simulator/communication/FaultInjectingAdapter.hpp"
+
+#include "trdp_simulator/communication/SplitMix64.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace trdp::communication {
+namespace {
+
+using Clock = TimingWheel<ProcessDataMessage>::Clock;
+
+constexpr std::chrono::microseconds kWheelTick{100};
+constexpr std::size_t kWheelSlots = 1024;
+
+[[nodiscard]] std::mt19937_64 generatorFor(std::uint64_t seed, std::uint32_t comId) {
+    return std::mt19937_64{splitMix64(seed ^ splitMix64(comId))};
+}
+
+/// Uniform double in [0, 1) from the top 53 bits; unlike std::uniform_real_distribution identical everywhere.
+[[nodiscard]] double unitInterval(std::uint64_t value) noexcept {
+    return static_cast<double>(value >> 11) * 0x1.0p-53;
+}
+
+void checkProbability(double value, const char *name, std::uint32_t comId) {
+    if (!(value >= 0.0 && value <= 1.0)) {
+        throw std::invalid_argument(std::string{"Fault "} + name + " for comId " + std::to_string(comId) +
+                                    " must be between 0 and 1");
+    }
+}
+
+void flipBit(std::vector<std::uint8_t> &payload, double position) {
+    const auto bit = static_cast<std::size_t>(position * static_cast<double>(payload.size() * 8));
+    payload[bit / 8] ^= static_cast<std::uint8_t>(1u << (bit % 8));
+}
+
+} // namespace
+
+FaultInjectingAdapter::FaultInjectingAdapter(std::shared_ptr<StackAdapter> inner, std::vector<FaultProfile> profiles,
+                                             std::uint64_t seed)
+    : m_inner(std::move(inner)), m_seed(seed), m_delayed(kWheelTick, kWheelSlots) {
+    if (!m_inner) {
+        throw std::invalid_argument("Fault injection requires a stack adapter to wrap");
+    }
+    for (auto &profile : profiles) {
+        checkProbability(profile.loss, "loss", profile.comId);
+        checkProbability(profile.duplicate, "duplicate", profile.comId);
+        checkProbability(profile.reorder, "reorder", profile.comId);
+        checkProbability(profile.corrupt, "corrupt", profile.comId);
+        if (profile.delay.count() < 0 || profile.jitter.count() < 0) {
+            throw std::invalid_argument("Fault delay for comId " + std::to_string(profile.comId) +
+                                        " cannot be negative");
+        }
+        const auto comId = profile.comId;
+        const auto [it, inserted] =
+            m_profiles.try_emplace(comId, ProfileState{profile, generatorFor(seed, comId), std::nullopt});
+        if (!inserted) {
+            throw std::invalid_argument("Duplicate fault profile for comId " + std::to_string(comId));
+        }
+        if (comId == 0) {
+            m_wildcard = profile;
+        }
+    }
+}
+
+void FaultInjectingAdapter::openSession(const std::string &endpoint) {
+    m_inner->openSession(endpoint);
+}
+
+void FaultInjectingAdapter::closeSession() {
+    flush();
+    m_inner->closeSession();
+}
+
+void FaultInjectingAdapter::registerProcessDataHandler(ProcessDataHandler handler) {
+    m_inner->registerProcessDataHandler(std::move(handler));
+}
+
+void FaultInjectingAdapter::registerMessageDataHandler(MessageDataHandler handler) {
+    m_inner->registerMessageDataHandler(std::move(handler));
+}
+
+void FaultInjectingAdapter::publishProcessData(const ProcessDataMessage &message) {
+    releaseDue(Clock::now());
+    auto *state = profileFor(message.comId);
+    if (state == nullptr) {
+        m_inner->publishProcessData(message);
+        return;
+    }
+    const auto faults = draw(*state);
+    if (faults.lose) {
+        ++m_stats.dropped;
+        return;
+    }
+    ProcessDataMessage corrupted;
+    const ProcessDataMessage *outgoing = &message;
+    if (faults.corrupt && !message.payload.empty()) {
+        corrupted = message;
+        flipBit(corrupted.payload, faults.bit);
+        ++m_stats.corrupted;
+        outgoing = &corrupted;
+    }
+    if (faults.reorder && !state->held) {
+        state->held = outgoing == &corrupted ? std::move(corrupted) : message;
+        ++m_stats.reordered;
+        return;
+    }
+    if (faults.duplicate) {
+        ++m_stats.duplicated;
+        emit(*state, *outgoing, faults.jitter);
+    }
+    emit(*state, *outgoing, faults.jitter);
+    if (state->held) {
+        const auto held = std::move(*state->held);
+        state->held.reset();
+        emit(*state, held, faults.jitter);
+    }
+}
+
+MessageDataAck FaultInjectingAdapter::sendMessageData(const MessageDataMessage &message) {
+    auto *state = profileFor(message.comId);
+    if (state == nullptr) {
+        return m_inner->sendMessageData(message);
+    }
+    const auto faults = draw(*state);
+    if (faults.lose) {
+        ++m_stats.dropped;
+        return MessageDataAck{MessageDataStatus::Timeout, "dropped by fault injection"};
+    }
+    MessageDataMessage corrupted;
+    const MessageDataMessage *outgoing = &message;
+    if (faults.corrupt && !message.payload.empty()) {
+        corrupted = message;
+        flipBit(corrupted.payload, faults.bit);
+        ++m_stats.corrupted;
+        outgoing = &corrupted;
+    }
+    auto ack = m_inner->sendMessageData(*outgoing);
+    if (faults.duplicate) {
+        ++m_stats.duplicated;
+        (void)m_inner->sendMessageData(*outgoing);
+    }
+    return ack;
+}
+
+void FaultInjectingAdapter::poll() {
+    releaseDue(Clock::now());
+    m_inner->poll();
+}
+
+std::size_t FaultInjectingAdapter::pending() const noexcept {
+    std::size_t held = 0;
+    for (const auto &[_, state] : m_profiles) {
+        held += state.held ? 1 : 0;
+    }
+    return m_delayed.size() + held;
+}
+
+FaultInjectingAdapter::ProfileState *FaultInjectingAdapter::profileFor(std::uint32_t comId) {
+    if (m_profiles.empty()) {
+        return nullptr;
+    }
+    if (const auto it = m_profiles.find(comId); it != m_profiles.end()) {
+        return &it->second;
+    }
+    if (!m_wildcard) {
+        return nullptr;
+    }
+    // The first telegram of an unprofiled comId gives it its own generator, so it never shares a draw stream.
+    auto profile = *m_wildcard;
+    profile.comId = comId;
+    return &m_profiles.try_emplace(comId, ProfileState{profile, generatorFor(m_seed, comId), std::nullopt})
+                .first->second;
+}
+
+FaultInjectingAdapter::Draw FaultInjectingAdapter::draw(ProfileState &state) {
+    // Every telegram consumes the same number of draws so the stream stays aligned whatever faults fire.
+    const auto &profile = state.profile;
+    Draw result{};
+    result.lose = unitInterval(state.random()) < profile.loss;
+    result.duplicate = unitInterval(state.random()) < profile.duplicate;
+    result.reorder = unitInterval(state.random()) < profile.reorder;
+    result.corrupt = unitInterval(state.random()) < profile.corrupt;
+    result.jitter = unitInterval(state.random());
+    result.bit = unitInterval(state.random());
+    return result;
+}
+
+void FaultInjectingAdapter::emit(ProfileState &state, const ProcessDataMessage &message, double jitter) {
+    const auto &profile = state.profile;
+    if (profile.delay.count() == 0 && profile.jitter.count() == 0) {
+        m_inner->publishProcessData(message);
+        return;
+    }
+    const auto extra = std::chrono::duration_cast<Clock::duration>(profile.jitter * jitter);
+    m_delayed.schedule(Clock::now() + profile.delay + extra, message);
+    ++m_stats.delayed;
+}
+
+void FaultInjectingAdapter::releaseDue(Clock::time_point now) {
+    if (m_delayed.empty()) {
+        return;
+    }
+    m_delayed.advance(now, [this](ProcessDataMessage &&message) { m_inner->publishProcessData(message); });
+}
+
+void FaultInjectingAdapter::flush() {
+    m_delayed.drain([this](ProcessDataMessage &&message) { m_inner->publishProcessData(message); });
+    for (auto &[_, state] : m_profiles) {
+        if (state.held) {
+            m_inner->publishProcessData(*state.held);
+            state.held.reset();
+        }
+    }
+}
+
+} // namespace trdp::communication
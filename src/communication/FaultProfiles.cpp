@@ -0,0 +1,33 @@
+#include "trdp_simulator/communication/FaultProfiles.hpp"
+
+#include <stdexcept>
+#include <string>
+
+namespace trdp::communication {
+
+LatencyDistribution parseLatencyDistribution(std::string_view name) {
+    if (name == "constant") {
+        return LatencyDistribution::Constant;
+    }
+    if (name == "normal") {
+        return LatencyDistribution::Normal;
+    }
+    if (name == "pareto") {
+        return LatencyDistribution::Pareto;
+    }
+    throw std::invalid_argument("Unknown latency distribution: " + std::string{name});
+}
+
+std::string_view latencyDistributionName(LatencyDistribution distribution) noexcept {
+    switch (distribution) {
+    case LatencyDistribution::Normal:
+        return "normal";
+    case LatencyDistribution::Pareto:
+        return "pareto";
+    case LatencyDistribution::Constant:
+        break;
+    }
+    return "constant";
+}
+
+} // namespace trdp::communication
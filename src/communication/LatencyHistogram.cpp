@@ -0,0 +1,68 @@
+#include "trdp_simulator/communication/LatencyHistogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace trdp::communication {
+
+unsigned LatencyHistogram::indexOf(std::uint64_t value) noexcept {
+    if (value < kSubBuckets) {
+        return static_cast<unsigned>(value);
+    }
+    const unsigned shift = static_cast<unsigned>(std::bit_width(value)) - 1 - kSubBucketBits;
+    const auto sub = static_cast<unsigned>((value >> shift) - kSubBuckets);
+    return kSubBuckets + shift * kSubBuckets + sub;
+}
+
+std::uint64_t LatencyHistogram::upperBound(unsigned index) noexcept {
+    if (index < kSubBuckets) {
+        return index;
+    }
+    const unsigned shift = (index - kSubBuckets) / kSubBuckets;
+    const unsigned sub = (index - kSubBuckets) % kSubBuckets;
+    const std::uint64_t lower = static_cast<std::uint64_t>(kSubBuckets + sub) << shift;
+    return lower + ((std::uint64_t{1} << shift) - 1);
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds latency) noexcept {
+    const auto value = static_cast<std::uint64_t>(std::max<std::int64_t>(latency.count(), 0));
+    ++m_buckets[indexOf(value)];
+    ++m_count;
+    m_total += value;
+    m_max = std::max(m_max, value);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other) noexcept {
+    for (unsigned i = 0; i < kBuckets; ++i) {
+        m_buckets[i] += other.m_buckets[i];
+    }
+    m_count += other.m_count;
+    m_total += other.m_total;
+    m_max = std::max(m_max, other.m_max);
+}
+
+std::chrono::nanoseconds LatencyHistogram::mean() const noexcept {
+    if (m_count == 0) {
+        return std::chrono::nanoseconds{0};
+    }
+    return std::chrono::nanoseconds{static_cast<std::int64_t>(m_total / m_count)};
+}
+
+std::chrono::nanoseconds LatencyHistogram::percentile(double quantile) const noexcept {
+    if (m_count == 0) {
+        return std::chrono::nanoseconds{0};
+    }
+    const double clamped = std::clamp(quantile, 0.0, 1.0);
+    const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(clamped * m_count)));
+    std::uint64_t seen = 0;
+    for (unsigned i = 0; i < kBuckets; ++i) {
+        seen += m_buckets[i];
+        if (seen >= rank) {
+            return std::chrono::nanoseconds{static_cast<std::int64_t>(std::min(upperBound(i), m_max))};
+        }
+    }
+    return std::chrono::nanoseconds{static_cast<std::int64_t>(m_max)};
+}
+
+} // namespace trdp::communication
@@ -0,0 +1,162 @@
+#include "trdp_simulator/communication/NetworkEmulationAdapter.hpp"
+
+#include "trdp_simulator/communication/SplitMix64.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+#include <utility>
+
+namespace trdp::communication {
+namespace {
+
+constexpr std::chrono::microseconds kWheelTick{20};
+constexpr std::size_t kWheelSlots = 4096;
+/// Shape of the Pareto tail; finite variance, yet far heavier than a normal distribution.
+constexpr double kParetoShape = 3.0;
+
+/// Uniform double in (0, 1], safe to take the logarithm or a negative power of.
+[[nodiscard]] double openUnitInterval(std::uint64_t value) noexcept {
+    return static_cast<double>((value >> 11) + 1) * 0x1.0p-53;
+}
+
+} // namespace
+
+NetworkEmulationAdapter::NetworkEmulationAdapter(std::shared_ptr<StackAdapter> inner, std::vector<LinkProfile> links,
+                                                 std::uint64_t seed)
+    : m_inner(std::move(inner)), m_inFlight(kWheelTick, kWheelSlots) {
+    if (!m_inner) {
+        throw std::invalid_argument("Network emulation requires a stack adapter to wrap");
+    }
+    for (auto &profile : links) {
+        if (profile.latency.count() < 0 || profile.jitter.count() < 0) {
+            throw std::invalid_argument("Link latency for comId " + std::to_string(profile.comId) +
+                                        " cannot be negative");
+        }
+        const auto comId = profile.comId;
+        // Distinct stream from the fault injector's for the same seed and comId.
+        std::mt19937_64 random{splitMix64(~seed ^ splitMix64(comId))};
+        const auto [it, inserted] = m_links.try_emplace(comId, Link{profile, random, {}, {}});
+        if (!inserted) {
+            throw std::invalid_argument("Duplicate link profile for comId " + std::to_string(comId));
+        }
+    }
+    if (const auto it = m_links.find(0); it != m_links.end()) {
+        m_default = &it->second;
+    }
+}
+
+void NetworkEmulationAdapter::openSession(const std::string &endpoint) {
+    m_inner->openSession(endpoint);
+}
+
+void NetworkEmulationAdapter::closeSession() {
+    const auto now = Clock::now();
+    m_inFlight.drain([&](InFlight &&telegram) { deliver(std::move(telegram), now); });
+    for (auto &[_, link] : m_links) {
+        link.queue.clear();
+    }
+    m_inner->closeSession();
+}
+
+void NetworkEmulationAdapter::registerProcessDataHandler(ProcessDataHandler handler) {
+    m_inner->registerProcessDataHandler(std::move(handler));
+}
+
+void NetworkEmulationAdapter::registerMessageDataHandler(MessageDataHandler handler) {
+    m_inner->registerMessageDataHandler(std::move(handler));
+}
+
+void NetworkEmulationAdapter::publishProcessData(const ProcessDataMessage &message) {
+    const auto now = Clock::now();
+    release(now);
+    transmit(message, now);
+}
+
+MessageDataAck NetworkEmulationAdapter::sendMessageData(const MessageDataMessage &message) {
+    return m_inner->sendMessageData(message);
+}
+
+void NetworkEmulationAdapter::poll() {
+    release(Clock::now());
+    m_inner->poll();
+}
+
+void NetworkEmulationAdapter::transmit(const ProcessDataMessage &message, Clock::time_point now) {
+    auto *link = linkFor(message.comId);
+    if (link == nullptr) {
+        m_inner->publishProcessData(message);
+        ++m_stats.delivered;
+        return;
+    }
+
+    auto departure = now;
+    const auto &profile = link->profile;
+    if (profile.bandwidth != 0) {
+        auto &queue = link->queue;
+        while (!queue.empty() && queue.front() <= now) {
+            queue.pop_front();
+        }
+        if (profile.queueLimit != 0 && queue.size() >= profile.queueLimit) {
+            ++m_stats.queueDrops;
+            return;
+        }
+        const auto bits = static_cast<std::uint64_t>(message.payload.size() + kWireOverhead) * 8;
+        const std::chrono::nanoseconds serialisation{bits * 1'000'000'000ull / profile.bandwidth};
+        departure = std::max(now, link->busyUntil) + serialisation;
+        link->busyUntil = departure;
+        queue.push_back(departure);
+        m_stats.peakQueueDepth = std::max(m_stats.peakQueueDepth, queue.size());
+    }
+
+    const auto arrival = departure + propagation(*link);
+    m_inFlight.schedule(arrival, InFlight{message, now});
+}
+
+std::size_t NetworkEmulationAdapter::release(Clock::time_point now) {
+    if (m_inFlight.empty()) {
+        return 0;
+    }
+    return m_inFlight.advance(now, [&](InFlight &&telegram) { deliver(std::move(telegram), now); });
+}
+
+NetworkEmulationAdapter::Link *NetworkEmulationAdapter::linkFor(std::uint32_t comId) noexcept {
+    if (m_links.empty()) {
+        return nullptr;
+    }
+    const auto it = m_links.find(comId);
+    return it != m_links.end() ? &it->second : m_default;
+}
+
+std::chrono::nanoseconds NetworkEmulationAdapter::propagation(Link &link) {
+    const auto &profile = link.profile;
+    const auto latency = std::chrono::duration<double, std::nano>(profile.latency).count();
+    const auto jitter = std::chrono::duration<double, std::nano>(profile.jitter).count();
+    double delay = latency;
+    switch (profile.distribution) {
+    case LatencyDistribution::Constant:
+        break;
+    case LatencyDistribution::Normal: {
+        // Box-Muller on the raw generator output; std::normal_distribution differs between standard libraries.
+        const auto radius = std::sqrt(-2.0 * std::log(openUnitInterval(link.random())));
+        const auto angle = 2.0 * std::numbers::pi * openUnitInterval(link.random());
+        delay += jitter * radius * std::cos(angle);
+        break;
+    }
+    case LatencyDistribution::Pareto:
+        // Inverse transform of a Pareto tail scaled so that its mean equals the jitter.
+        delay += jitter * (kParetoShape - 1.0) *
+                 (std::pow(openUnitInterval(link.random()), -1.0 / kParetoShape) - 1.0);
+        break;
+    }
+    return std::chrono::nanoseconds{static_cast<std::int64_t>(std::max(0.0, delay))};
+}
+
+void NetworkEmulationAdapter::deliver(InFlight &&telegram, Clock::time_point now) {
+    m_inner->publishProcessData(telegram.message);
+    ++m_stats.delivered;
+    m_stats.totalDelay += std::chrono::duration_cast<std::chrono::nanoseconds>(now - telegram.sentAt);
+}
+
+} // namespace trdp::communication
@@ -0,0 +1,92 @@
+#include "trdp_simulator/communication/PdMailbox.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace trdp::communication {
+namespace {
+
+// Slot header: sequence (8 bytes), receive time in steady-clock nanoseconds (8), received payload size (4).
+constexpr std::size_t kSequenceOffset = 0;
+constexpr std::size_t kTimestampOffset = 8;
+constexpr std::size_t kSizeOffset = 16;
+constexpr std::size_t kHeaderSize = 20;
+
+template <typename T>
+[[nodiscard]] std::span<const std::uint8_t> bytesOf(const T &value) noexcept {
+    return {reinterpret_cast<const std::uint8_t *>(&value), sizeof(value)};
+}
+
+template <typename T>
+[[nodiscard]] T load(const std::vector<std::uint8_t> &raw, std::size_t offset) noexcept {
+    T value{};
+    std::memcpy(&value, raw.data() + offset, sizeof(value));
+    return value;
+}
+
+} // namespace
+
+PdMailbox::PdMailbox(const std::vector<std::uint32_t> &comIds, std::size_t payloadCapacity)
+    : m_payloadCapacity(payloadCapacity) {
+    m_slots.reserve(comIds.size());
+    for (const auto comId : comIds) {
+        if (m_index.contains(comId)) {
+            continue;
+        }
+        m_slots.push_back(std::unique_ptr<Slot>(new Slot{comId, 0, SeqlockBuffer{kHeaderSize + payloadCapacity}}));
+        m_index.emplace(comId, m_slots.back().get());
+    }
+}
+
+void PdMailbox::onProcessDataReceived(const ProcessDataMessage &message) {
+    update(message.comId, message.payload, std::chrono::steady_clock::now());
+}
+
+void PdMailbox::update(std::uint32_t comId, std::span<const std::uint8_t> payload,
+                       std::chrono::steady_clock::time_point receivedAt) noexcept {
+    const auto it = m_index.find(comId);
+    if (it == m_index.end()) {
+        return;
+    }
+    auto &slot = *it->second;
+    const std::uint64_t sequence = ++slot.updates;
+    const std::int64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                       receivedAt.time_since_epoch()).count();
+    const auto size = static_cast<std::uint32_t>(payload.size());
+    // The header and payload are one seqlock update; sizes are bounded by construction so this cannot throw.
+    slot.buffer.write(kSequenceOffset, {bytesOf(sequence), bytesOf(timestamp), bytesOf(size),
+                                        payload.first(std::min(payload.size(), m_payloadCapacity))});
+}
+
+bool PdMailbox::snapshot(std::uint32_t comId, PdSample &out) const {
+    const auto it = m_index.find(comId);
+    if (it == m_index.end()) {
+        return false;
+    }
+    auto &raw = out.payload;
+    raw.resize(it->second->buffer.size());
+    it->second->buffer.read(raw);
+
+    out.comId = comId;
+    out.sequence = load<std::uint64_t>(raw, kSequenceOffset);
+    out.receivedAt = std::chrono::steady_clock::time_point{
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::nanoseconds{load<std::int64_t>(raw, kTimestampOffset)})};
+    const auto size = load<std::uint32_t>(raw, kSizeOffset);
+    out.truncated = size > m_payloadCapacity;
+    const auto kept = std::min<std::size_t>(size, m_payloadCapacity);
+    raw.erase(raw.begin(), raw.begin() + kHeaderSize);
+    raw.resize(kept);
+    return true;
+}
+
+std::vector<std::uint32_t> PdMailbox::comIds() const {
+    std::vector<std::uint32_t> result;
+    result.reserve(m_slots.size());
+    for (const auto &slot : m_slots) {
+        result.push_back(slot->comId);
+    }
+    return result;
+}
+
+} // namespace trdp::communication
@@ -0,0 +1,79 @@
+#include "trdp_simulator/communication/SeqlockBuffer.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+namespace trdp::communication {
+
+SeqlockBuffer::SeqlockBuffer(std::size_t size)
+    : m_size(size), m_wordCount((size + 7) / 8), m_words(std::make_unique<std::atomic<std::uint64_t>[]>(m_wordCount)) {
+    for (std::size_t i = 0; i < m_wordCount; ++i) {
+        m_words[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void SeqlockBuffer::write(std::size_t offset, std::span<const std::uint8_t> bytes) {
+    write(offset, {bytes});
+}
+
+void SeqlockBuffer::write(std::size_t offset, std::initializer_list<std::span<const std::uint8_t>> parts) {
+    std::size_t total = 0;
+    for (const auto &part : parts) {
+        total += part.size();
+    }
+    if (offset > m_size || total > m_size - offset) {
+        throw std::out_of_range("Seqlock write exceeds buffer size");
+    }
+    if (total == 0) {
+        return;
+    }
+    const auto sequence = m_sequence.load(std::memory_order_relaxed);
+    m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (const auto &part : parts) {
+        copyIn(offset, part);
+        offset += part.size();
+    }
+    m_sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void SeqlockBuffer::copyIn(std::size_t offset, std::span<const std::uint8_t> bytes) noexcept {
+    // Merge the new bytes into the covered words; bytes outside [offset, offset + size) keep their value.
+    std::size_t position = offset;
+    const std::size_t end = offset + bytes.size();
+    while (position < end) {
+        const std::size_t word = position / 8;
+        const std::size_t first = position % 8;
+        const std::size_t count = std::min<std::size_t>(8 - first, end - position);
+        std::uint64_t value = m_words[word].load(std::memory_order_relaxed);
+        std::memcpy(reinterpret_cast<std::uint8_t *>(&value) + first, bytes.data() + (position - offset), count);
+        m_words[word].store(value, std::memory_order_relaxed);
+        position += count;
+    }
+}
+
+std::uint64_t SeqlockBuffer::read(std::span<std::uint8_t> out) const {
+    if (out.size() < m_size) {
+        throw std::out_of_range("Seqlock snapshot target is smaller than the buffer");
+    }
+    while (true) {
+        const auto before = m_sequence.load(std::memory_order_acquire);
+        if ((before & 1u) != 0) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (std::size_t word = 0; word < m_wordCount; ++word) {
+            const std::uint64_t value = m_words[word].load(std::memory_order_relaxed);
+            const std::size_t count = std::min<std::size_t>(8, m_size - word * 8);
+            std::memcpy(out.data() + word * 8, &value, count);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_sequence.load(std::memory_order_relaxed) == before) {
+            return before;
+        }
+    }
+}
+
+} // namespace trdp::communication
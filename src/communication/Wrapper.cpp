@@ -2,6 +2,7 @@
 
 #include "trdp_simulator/communication/TrdpError.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <iomanip>
 #include <memory>
@@ -107,10 +108,6 @@ private:
     MessageDataHandler m_mdHandler;
 };
 
-[[nodiscard]] std::shared_ptr<StackAdapter> makeDefaultAdapter() {
-    return std::make_shared<DummyStackAdapter>();
-}
-
 void appendTelemetry(std::vector<std::string> &buffer, const std::string &timestamp, const std::string &message, bool error) {
     if (error) {
         buffer.emplace_back(timestamp + " | error -> " + message);
@@ -121,8 +118,12 @@ void appendTelemetry(std::vector<std::string> &buffer, const std::string &timest
 
 } // namespace
 
+std::shared_ptr<StackAdapter> makeLoopbackStackAdapter() {
+    return std::make_shared<DummyStackAdapter>();
+}
+
 Wrapper::Wrapper(std::string endpoint, std::shared_ptr<StackAdapter> adapter)
-    : m_endpoint(std::move(endpoint)), m_adapter(adapter ? std::move(adapter) : makeDefaultAdapter()) {
+    : m_endpoint(std::move(endpoint)), m_adapter(adapter ? std::move(adapter) : makeLoopbackStackAdapter()) {
     if (!m_adapter) {
         throw std::invalid_argument("Stack adapter cannot be null");
     }
@@ -175,10 +176,23 @@ void Wrapper::registerProcessDataHandler(ProcessDataCallback callback) { m_proce
 
 void Wrapper::registerMessageDataHandler(MessageDataCallback callback) { m_messageDataCallback = std::move(callback); }
 
+void Wrapper::addObserver(TelegramObserver &observer) {
+    if (std::find(m_observers.begin(), m_observers.end(), &observer) == m_observers.end()) {
+        m_observers.push_back(&observer);
+    }
+}
+
+void Wrapper::removeObserver(TelegramObserver &observer) {
+    m_observers.erase(std::remove(m_observers.begin(), m_observers.end(), &observer), m_observers.end());
+}
+
 void Wrapper::publishProcessData(const ProcessDataMessage &message) {
     if (!m_open) {
         throw std::runtime_error("Cannot publish PD telegram: connection closed");
     }
+    for (auto *observer : m_observers) {
+        observer->onProcessDataSent(message);
+    }
     try {
         m_adapter->publishProcessData(message);
     } catch (const TrdpError &error) {
@@ -191,13 +205,18 @@ void Wrapper::publishProcessData(const ProcessDataMessage &message) {
         recordError(oss.str());
         throw;
     }
-    recordInfo("pd -> " + formatPdMessage(message));
+    if (m_traceTelegrams) {
+        recordInfo("pd -> " + formatPdMessage(message));
+    }
 }
 
 MessageDataAck Wrapper::sendMessageData(const MessageDataMessage &message) {
     if (!m_open) {
         throw std::runtime_error("Cannot send MD telegram: connection closed");
     }
+    for (auto *observer : m_observers) {
+        observer->onMessageDataSent(message);
+    }
     MessageDataAck ack;
     try {
         ack = m_adapter->sendMessageData(message);
@@ -211,9 +230,11 @@ MessageDataAck Wrapper::sendMessageData(const MessageDataMessage &message) {
         recordError(oss.str());
         throw;
     }
-    std::ostringstream oss;
-    oss << "md -> " << formatMdMessage(message) << " | " << formatAck(ack);
-    recordInfo(oss.str());
+    if (m_traceTelegrams) {
+        std::ostringstream oss;
+        oss << "md -> " << formatMdMessage(message) << " | " << formatAck(ack);
+        recordInfo(oss.str());
+    }
     return ack;
 }
 
@@ -232,6 +253,8 @@ void Wrapper::poll() {
     }
 }
 
+void Wrapper::setTelegramTracing(bool enabled) noexcept { m_traceTelegrams = enabled; }
+
 bool Wrapper::isOpen() const noexcept { return m_open; }
 
 const std::vector<std::string> &Wrapper::telemetry() const noexcept { return m_telemetry; }
@@ -251,14 +274,24 @@ void Wrapper::recordError(std::string message) {
 }
 
 void Wrapper::handleProcessData(const ProcessDataMessage &message) {
-    recordInfo("pd <- " + formatPdMessage(message));
+    if (m_traceTelegrams) {
+        recordInfo("pd <- " + formatPdMessage(message));
+    }
+    for (auto *observer : m_observers) {
+        observer->onProcessDataReceived(message);
+    }
     if (m_processDataCallback) {
         m_processDataCallback(message);
     }
 }
 
 void Wrapper::handleMessageData(const MessageDataMessage &message) {
-    recordInfo("md <- " + formatMdMessage(message));
+    if (m_traceTelegrams) {
+        recordInfo("md <- " + formatMdMessage(message));
+    }
+    for (auto *observer : m_observers) {
+        observer->onMessageDataReceived(message);
+    }
     if (m_messageDataCallback) {
         m_messageDataCallback(message);
     }
@@ -0,0 +1,95 @@
+#include "trdp_simulator/device/DatasetLayout.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace trdp::device {
+
+std::size_t basicTypeSize(std::uint32_t type) noexcept {
+    switch (type) {
+    case 1:  // BOOL8
+    case 2:  // CHAR8
+    case 4:  // INT8
+    case 8:  // UINT8
+        return 1;
+    case 3:  // UTF16
+    case 5:  // INT16
+    case 9:  // UINT16
+        return 2;
+    case 6:  // INT32
+    case 10: // UINT32
+    case 12: // REAL32
+    case 14: // TIMEDATE32
+        return 4;
+    case 15: // TIMEDATE48
+        return 6;
+    case 7:  // INT64
+    case 11: // UINT64
+    case 13: // REAL64
+    case 16: // TIMEDATE64
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+bool isSignedType(std::uint32_t type) noexcept {
+    return type == 2 || (type >= 4 && type <= 7);
+}
+
+bool isRealType(std::uint32_t type) noexcept {
+    return type == 12 || type == 13;
+}
+
+DatasetLayout DatasetLayout::compile(const DeviceConfig &config, std::uint32_t datasetId) {
+    const auto *dataset = config.dataset(datasetId);
+    if (dataset == nullptr) {
+        throw std::runtime_error("Unknown data set: " + std::to_string(datasetId));
+    }
+    DatasetLayout layout{};
+    layout.m_id = dataset->id;
+    layout.m_name = dataset->name;
+    std::vector<std::uint32_t> path;
+    layout.append(config, *dataset, {}, path);
+    layout.m_index.reserve(layout.m_fields.size());
+    for (std::size_t i = 0; i < layout.m_fields.size(); ++i) {
+        layout.m_index.emplace(layout.m_fields[i].name, i);
+    }
+    return layout;
+}
+
+const FieldLayout *DatasetLayout::find(std::string_view name) const {
+    const auto it = m_index.find(std::string{name});
+    return it == m_index.end() ? nullptr : &m_fields[it->second];
+}
+
+void DatasetLayout::append(const DeviceConfig &config, const DatasetConfig &dataset, const std::string &prefix,
+                           std::vector<std::uint32_t> &path) {
+    if (std::find(path.begin(), path.end(), dataset.id) != path.end()) {
+        throw std::runtime_error("Data set " + std::to_string(dataset.id) + " contains itself");
+    }
+    path.push_back(dataset.id);
+    for (const auto &element : dataset.elements) {
+        const auto name = prefix + element.name;
+        if (element.arraySize == 0) {
+            throw std::runtime_error("Data set element '" + name + "' has a variable size");
+        }
+        if (const auto size = basicTypeSize(element.type); size != 0) {
+            m_fields.push_back(FieldLayout{name, element.type, m_size, size, element.arraySize});
+            m_size += size * element.arraySize;
+            continue;
+        }
+        const auto *nested = config.dataset(element.type);
+        if (nested == nullptr) {
+            throw std::runtime_error("Data set element '" + name + "' has unknown type " +
+                                     std::to_string(element.type));
+        }
+        for (std::uint32_t i = 0; i < element.arraySize; ++i) {
+            const auto nestedPrefix = element.arraySize == 1 ? name + '.' : name + '[' + std::to_string(i) + "].";
+            append(config, *nested, nestedPrefix, path);
+        }
+    }
+    path.pop_back();
+}
+
+} // namespace trdp::device
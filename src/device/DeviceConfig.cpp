@@ -0,0 +1,144 @@
+#include "trdp_simulator/device/DeviceConfig.hpp"
+
+#include <libxml/parser.h>
+#include <libxml/tree.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+
+namespace trdp::device {
+
+namespace {
+
+struct DocDeleter {
+    void operator()(xmlDoc *doc) const noexcept { xmlFreeDoc(doc); }
+};
+
+[[nodiscard]] bool hasName(const xmlNode *node, std::string_view name) {
+    return node->type == XML_ELEMENT_NODE && name == reinterpret_cast<const char *>(node->name);
+}
+
+[[nodiscard]] std::string attribute(const xmlNode *node, const char *name) {
+    xmlChar *value = xmlGetProp(node, reinterpret_cast<const xmlChar *>(name));
+    if (value == nullptr) {
+        return {};
+    }
+    std::string result{reinterpret_cast<const char *>(value)};
+    xmlFree(value);
+    return result;
+}
+
+[[nodiscard]] std::uint32_t numericAttribute(const xmlNode *node, const char *name) {
+    const auto value = attribute(node, name);
+    if (value.empty()) {
+        return 0;
+    }
+    try {
+        return static_cast<std::uint32_t>(std::stoul(value));
+    } catch (const std::exception &) {
+        throw std::runtime_error(std::string{"Invalid numeric attribute '"} + name + "': " + value);
+    }
+}
+
+TelegramConfig parseTelegram(const xmlNode *node) {
+    TelegramConfig telegram{};
+    telegram.name = attribute(node, "name");
+    telegram.comId = numericAttribute(node, "com-id");
+    telegram.datasetId = numericAttribute(node, "data-set-id");
+    for (const xmlNode *child = node->children; child != nullptr; child = child->next) {
+        telegram.subscribed = telegram.subscribed || hasName(child, "source");
+        telegram.published = telegram.published || hasName(child, "destination");
+    }
+    return telegram;
+}
+
+DatasetConfig parseDataset(const xmlNode *node) {
+    DatasetConfig dataset{};
+    dataset.name = attribute(node, "name");
+    dataset.id = numericAttribute(node, "id");
+    for (const xmlNode *child = node->children; child != nullptr; child = child->next) {
+        if (!hasName(child, "element")) {
+            continue;
+        }
+        DatasetElement element{};
+        element.name = attribute(child, "name");
+        element.type = numericAttribute(child, "type");
+        if (!attribute(child, "array-size").empty()) {
+            element.arraySize = numericAttribute(child, "array-size");
+        }
+        dataset.elements.push_back(std::move(element));
+    }
+    return dataset;
+}
+
+} // namespace
+
+std::vector<std::uint32_t> DeviceConfig::subscriptions() const {
+    std::vector<std::uint32_t> comIds;
+    for (const auto &telegram : telegrams) {
+        if (telegram.subscribed) {
+            comIds.push_back(telegram.comId);
+        }
+    }
+    return comIds;
+}
+
+std::vector<TelegramConfig> DeviceConfig::publications() const {
+    std::vector<TelegramConfig> published;
+    for (const auto &telegram : telegrams) {
+        if (telegram.published) {
+            published.push_back(telegram);
+        }
+    }
+    return published;
+}
+
+const DatasetConfig *DeviceConfig::dataset(std::uint32_t id) const noexcept {
+    for (const auto &candidate : datasets) {
+        if (candidate.id == id) {
+            return &candidate;
+        }
+    }
+    return nullptr;
+}
+
+DeviceConfig loadDeviceConfig(const std::filesystem::path &xmlPath) {
+    std::unique_ptr<xmlDoc, DocDeleter> doc{xmlReadFile(xmlPath.c_str(), nullptr, XML_PARSE_NONET)};
+    if (!doc) {
+        throw std::runtime_error("Unable to parse device XML: " + xmlPath.string());
+    }
+    const xmlNode *root = xmlDocGetRootElement(doc.get());
+    if (root == nullptr || !hasName(root, "device")) {
+        throw std::runtime_error("Device XML has no <device> root: " + xmlPath.string());
+    }
+
+    DeviceConfig config{};
+    config.hostName = attribute(root, "host-name");
+    for (const xmlNode *section = root->children; section != nullptr; section = section->next) {
+        if (hasName(section, "data-set-list")) {
+            for (const xmlNode *node = section->children; node != nullptr; node = node->next) {
+                if (hasName(node, "data-set")) {
+                    config.datasets.push_back(parseDataset(node));
+                }
+            }
+            continue;
+        }
+        if (!hasName(section, "bus-interface-list")) {
+            continue;
+        }
+        for (const xmlNode *bus = section->children; bus != nullptr; bus = bus->next) {
+            if (!hasName(bus, "bus-interface")) {
+                continue;
+            }
+            for (const xmlNode *node = bus->children; node != nullptr; node = node->next) {
+                if (hasName(node, "telegram")) {
+                    config.telegrams.push_back(parseTelegram(node));
+                }
+            }
+        }
+    }
+    return config;
+}
+
+} // namespace trdp::device
@@ -1,36 +1,62 @@
 #include "trdp_simulator/device/DeviceProfileRepository.hpp"
 
 #include "trdp_simulator/device/XmlValidator.hpp"
+#include "trdp_simulator/simulation/BlobStore.hpp"
+#include "trdp_simulator/simulation/ContentHash.hpp"
 
+#include <array>
 #include <chrono>
 #include <cctype>
 #include <fstream>
 #include <iomanip>
+#include <optional>
+#include <span>
 #include <sstream>
 #include <stdexcept>
-#include <unordered_set>
+#include <string_view>
+#include <system_error>
 
 namespace trdp::device {
 
 namespace {
 
-[[nodiscard]] std::string trim(std::string value) {
+[[nodiscard]] std::string_view trim(std::string_view value) noexcept {
     const auto first = value.find_first_not_of(" \t\r\n");
-    if (first == std::string::npos) {
+    if (first == std::string_view::npos) {
         return {};
     }
-    const auto last = value.find_last_not_of(" \t\r\n");
-    return value.substr(first, last - first + 1);
+    return value.substr(first, value.find_last_not_of(" \t\r\n") - first + 1);
 }
 
-[[nodiscard]] std::vector<std::string> split(const std::string &line, char delim) {
-    std::vector<std::string> tokens;
-    std::stringstream ss{line};
-    std::string token;
-    while (std::getline(ss, token, delim)) {
-        tokens.emplace_back(std::move(token));
+/// Splits @p line at '|' into @p fields; returns the number of fields, of which at most fields.size() are stored.
+std::size_t splitFields(std::string_view line, std::span<std::string_view> fields) noexcept {
+    std::size_t count = 0;
+    for (;;) {
+        const auto end = line.find('|');
+        if (count < fields.size()) {
+            fields[count] = line.substr(0, end);
+        }
+        ++count;
+        if (end == std::string_view::npos) {
+            return count;
+        }
+        line.remove_prefix(end + 1);
     }
-    return tokens;
+}
+
+constexpr std::size_t kManifestFields = 5;
+constexpr std::size_t kChecksumField = 3;
+
+[[nodiscard]] DeviceProfileRecord decodeRecord(std::string_view line) {
+    std::array<std::string_view, kManifestFields> fields;
+    (void)splitFields(line, fields);
+    DeviceProfileRecord record{};
+    record.id = fields[0];
+    record.storedPath = fields[1];
+    record.sourcePath = fields[2];
+    record.checksum = fields[3];
+    record.validatedAt = fields[4];
+    return record;
 }
 
 } // namespace
@@ -38,40 +64,45 @@ namespace {
 DeviceProfileRepository::DeviceProfileRepository(std::filesystem::path root, XmlValidator &validator)
     : m_root(std::move(root)), m_manifestPath(m_root / "manifest.db"), m_validator(validator) {
     std::filesystem::create_directories(m_root);
-    loadManifest();
 }
 
 std::string DeviceProfileRepository::registerProfile(const std::filesystem::path &xmlPath) {
+    ensureLoaded();
     if (!std::filesystem::exists(xmlPath)) {
         throw std::invalid_argument("XML file does not exist: " + xmlPath.string());
     }
 
-    const auto checksum = computeChecksum(xmlPath);
+    const auto uniqueId = allocateId(xmlPath);
+
+    // Hashing while copying reads the source once; a profile that turns out to be registered already is removed.
+    const auto storedPath = m_root / (uniqueId + ".xml");
+    const auto checksum = m_blobs != nullptr ? m_blobs->storeFile(xmlPath, storedPath)
+                                             : simulation::copyFileWithChecksum(xmlPath, storedPath);
+    std::optional<std::string> legacy;
+    const auto registered = [&](std::string_view recorded) {
+        if (recorded.starts_with(simulation::kChecksumPrefix)) {
+            return recorded == checksum;
+        }
+        if (!legacy) {
+            legacy = legacyChecksum(storedPath);
+        }
+        return recorded == *legacy;
+    };
     for (const auto &[id, record] : m_records) {
-        if (record.checksum == checksum) {
+        if (registered(record.checksum)) {
+            std::filesystem::remove(storedPath);
             return id;
         }
     }
-
-    auto candidateId = sanitiseId(xmlPath.stem().string());
-    if (candidateId.empty()) {
-        candidateId = "device";
-    }
-
-    std::unordered_set<std::string> ids;
-    for (const auto &[id, _] : m_records) {
-        ids.insert(id);
-    }
-
-    std::string uniqueId = candidateId;
-    int suffix = 1;
-    while (ids.contains(uniqueId)) {
-        uniqueId = candidateId + "-" + std::to_string(++suffix);
+    for (const auto &[id, line] : m_manifestLines) {
+        std::array<std::string_view, kChecksumField + 1> fields;
+        (void)splitFields(line, fields);
+        if (registered(fields[kChecksumField])) {
+            std::filesystem::remove(storedPath);
+            return std::string{id};
+        }
     }
 
-    const auto storedPath = m_root / (uniqueId + ".xml");
-    std::filesystem::copy_file(xmlPath, storedPath, std::filesystem::copy_options::overwrite_existing);
-
     const auto result = m_validator.validate(storedPath);
     if (!result.success) {
         std::filesystem::remove(storedPath);
@@ -85,66 +116,172 @@ std::string DeviceProfileRepository::registerProfile(const std::filesystem::path
     record.checksum = checksum;
     record.validatedAt = isoTimestamp();
 
-    m_records.insert_or_assign(uniqueId, record);
+    m_records.insert_or_assign(uniqueId, std::move(record));
     persistManifest();
     return uniqueId;
 }
 
+std::vector<simulation::ImportOutcome>
+DeviceProfileRepository::registerProfiles(std::span<const std::filesystem::path> xmlPaths, std::size_t threads) {
+    ensureLoaded();
+    // Profile id per checksum, so each file finds an identical registered profile with one lookup.
+    std::unordered_map<std::string, std::string> registered;
+    bool legacyRecords = false;
+    const auto remember = [&](std::string_view id, std::string_view checksum) {
+        legacyRecords = legacyRecords || !checksum.starts_with(simulation::kChecksumPrefix);
+        registered.try_emplace(std::string{checksum}, id);
+    };
+    for (const auto &[id, record] : m_records) {
+        remember(id, record.checksum);
+    }
+    for (const auto &[id, line] : m_manifestLines) {
+        std::array<std::string_view, kChecksumField + 1> fields;
+        (void)splitFields(line, fields);
+        remember(id, fields[kChecksumField]);
+    }
+    const auto find = [&registered](const std::string &checksum) {
+        return checksum.empty() ? registered.end() : registered.find(checksum);
+    };
+
+    struct Staged {
+        std::filesystem::path path;
+        std::string checksum;
+        std::string legacy;
+    };
+    std::vector<simulation::ImportOutcome> outcomes(xmlPaths.size());
+    std::vector<Staged> staged(xmlPaths.size());
+    // Files are copied under a staging name first: ids depend on the files before them and are handed out below.
+    simulation::parallelFor(xmlPaths.size(), threads, [&](std::size_t i) {
+        auto &outcome = outcomes[i];
+        auto &file = staged[i];
+        outcome.source = xmlPaths[i];
+        file.path = simulation::importStagingPath(m_root, ".staging");
+        try {
+            if (!std::filesystem::exists(outcome.source)) {
+                throw std::invalid_argument("XML file does not exist: " + outcome.source.string());
+            }
+            file.checksum = m_blobs != nullptr ? m_blobs->storeFile(outcome.source, file.path)
+                                               : simulation::copyFileWithChecksum(outcome.source, file.path);
+            if (legacyRecords) {
+                file.legacy = legacyChecksum(file.path);
+            }
+            if (find(file.checksum) != registered.end() || find(file.legacy) != registered.end()) {
+                return;
+            }
+            const auto result = m_validator.validate(file.path);
+            if (!result.success) {
+                throw std::runtime_error("XML validation failed: " + result.message);
+            }
+        } catch (const std::exception &ex) {
+            outcome.error = ex.what();
+        }
+    });
+
+    for (std::size_t i = 0; i < outcomes.size(); ++i) {
+        auto &outcome = outcomes[i];
+        const auto &file = staged[i];
+        std::error_code error;
+        if (!outcome.ok()) {
+            std::filesystem::remove(file.path, error);
+            continue;
+        }
+        auto existing = find(file.checksum);
+        if (existing == registered.end()) {
+            existing = find(file.legacy);
+        }
+        if (existing != registered.end()) {
+            outcome.id = existing->second;
+            std::filesystem::remove(file.path, error);
+            continue;
+        }
+
+        const auto uniqueId = allocateId(outcome.source);
+        const auto storedPath = m_root / (uniqueId + ".xml");
+        std::filesystem::rename(file.path, storedPath, error);
+        if (error) {
+            outcome.error = "Failed to store " + storedPath.string() + ": " + error.message();
+            std::filesystem::remove(file.path, error);
+            continue;
+        }
+        outcome.id = uniqueId;
+        remember(uniqueId, file.checksum);
+
+        DeviceProfileRecord record{};
+        record.id = uniqueId;
+        record.storedPath = storedPath;
+        record.sourcePath = std::filesystem::absolute(outcome.source);
+        record.checksum = file.checksum;
+        record.validatedAt = isoTimestamp();
+        m_records.insert_or_assign(uniqueId, std::move(record));
+    }
+    persistManifest();
+    return outcomes;
+}
+
 bool DeviceProfileRepository::exists(const std::string &id) const {
-    return m_records.find(id) != m_records.end();
+    ensureLoaded();
+    return m_records.contains(id) || m_manifestLines.contains(id);
 }
 
 DeviceProfileRecord DeviceProfileRepository::get(const std::string &id) const {
-    const auto it = m_records.find(id);
-    if (it == m_records.end()) {
+    ensureLoaded();
+    if (const auto it = m_records.find(id); it != m_records.end()) {
+        return it->second;
+    }
+    const auto line = m_manifestLines.find(id);
+    if (line == m_manifestLines.end()) {
         throw std::out_of_range("Unknown device profile: " + id);
     }
-    return it->second;
+    return decodeRecord(line->second);
 }
 
 std::vector<DeviceProfileRecord> DeviceProfileRepository::list() const {
+    ensureLoaded();
     std::vector<DeviceProfileRecord> records;
-    records.reserve(m_records.size());
+    records.reserve(m_records.size() + m_manifestLines.size());
     for (const auto &[_, record] : m_records) {
         records.push_back(record);
     }
+    for (const auto &[_, line] : m_manifestLines) {
+        records.push_back(decodeRecord(line));
+    }
     return records;
 }
 
 void DeviceProfileRepository::markValidated(const std::string &id, std::string timestamp) {
-    auto it = m_records.find(id);
-    if (it == m_records.end()) {
-        throw std::out_of_range("Unknown device profile: " + id);
-    }
-    it->second.validatedAt = std::move(timestamp);
+    auto record = get(id);
+    record.validatedAt = std::move(timestamp);
+    m_manifestLines.erase(id);
+    m_records.insert_or_assign(id, std::move(record));
     persistManifest();
 }
 
-void DeviceProfileRepository::loadManifest() {
-    m_records.clear();
+void DeviceProfileRepository::ensureLoaded() const {
+    std::call_once(m_loaded, [this] { loadManifest(); });
+}
+
+void DeviceProfileRepository::loadManifest() const {
+    m_manifestLines.clear();
     if (!std::filesystem::exists(m_manifestPath)) {
         return;
     }
 
-    std::ifstream stream{m_manifestPath};
-    std::string line;
-    while (std::getline(stream, line)) {
-        line = trim(line);
-        if (line.empty() || line.starts_with('#')) {
+    // Records are decoded from their line on lookup; loading only finds the latest line of every id.
+    std::ifstream stream{m_manifestPath, std::ios::binary | std::ios::ate};
+    m_manifestText.resize(static_cast<std::size_t>(stream.tellg()));
+    stream.seekg(0);
+    stream.read(m_manifestText.data(), static_cast<std::streamsize>(m_manifestText.size()));
+    std::string_view remaining{m_manifestText};
+    while (!remaining.empty()) {
+        const auto end = remaining.find('\n');
+        const auto line = trim(remaining.substr(0, end));
+        remaining.remove_prefix(end == std::string_view::npos ? remaining.size() : end + 1);
+        if (line.empty() || line.front() == '#') {
             continue;
         }
-        const auto tokens = split(line, '|');
-        if (tokens.size() < 5) {
-            continue;
-        }
-        DeviceProfileRecord record{};
-        record.id = tokens[0];
-        record.storedPath = tokens[1];
-        record.sourcePath = tokens[2];
-        record.checksum = tokens[3];
-        record.validatedAt = tokens[4];
-        if (!record.id.empty()) {
-            m_records.insert_or_assign(record.id, std::move(record));
+        std::array<std::string_view, 1> id;
+        if (splitFields(line, id) >= kManifestFields && !id[0].empty()) {
+            m_manifestLines.insert_or_assign(id[0], line);
         }
     }
 }
@@ -156,6 +293,23 @@ void DeviceProfileRepository::persistManifest() const {
         stream << record.id << '|' << record.storedPath.string() << '|' << record.sourcePath.string()
                << '|' << record.checksum << '|' << record.validatedAt << '\n';
     }
+    for (const auto &[_, line] : m_manifestLines) {
+        stream << line << '\n';
+    }
+}
+
+std::string DeviceProfileRepository::allocateId(const std::filesystem::path &xmlPath) const {
+    auto candidateId = sanitiseId(xmlPath.stem().string());
+    if (candidateId.empty()) {
+        candidateId = "device";
+    }
+
+    std::string uniqueId = candidateId;
+    int suffix = 1;
+    while (m_records.contains(uniqueId) || m_manifestLines.contains(uniqueId)) {
+        uniqueId = candidateId + "-" + std::to_string(++suffix);
+    }
+    return uniqueId;
 }
 
 std::string DeviceProfileRepository::sanitiseId(std::string candidate) {
@@ -171,7 +325,7 @@ std::string DeviceProfileRepository::sanitiseId(std::string candidate) {
     return result;
 }
 
-std::string DeviceProfileRepository::computeChecksum(const std::filesystem::path &path) {
+std::string DeviceProfileRepository::legacyChecksum(const std::filesystem::path &path) {
     std::ifstream stream{path, std::ios::binary};
     if (!stream) {
         throw std::runtime_error("Failed to open XML file for checksum: " + path.string());
@@ -1,5 +1,6 @@
 #include "trdp_simulator/device/XmlValidator.hpp"
 
+#include <libxml/parser.h>
 #include <libxml/xmlschemas.h>
 #include <libxml/xmlstring.h>
 
@@ -26,6 +27,15 @@ XmlValidator::XmlValidator(std::filesystem::path schemaPath) : m_schemaPath(std:
     if (!std::filesystem::exists(m_schemaPath)) {
         throw std::invalid_argument("Schema file not found: " + m_schemaPath.string());
     }
+    // libxml2 sets up its global state here, before any thread can validate concurrently.
+    xmlInitParser();
+}
+
+XmlValidator::~XmlValidator() {
+    for (auto *context : m_idleContexts) {
+        xmlSchemaFreeValidCtxt(context);
+    }
+    xmlSchemaFree(m_schema);
 }
 
 const std::filesystem::path &XmlValidator::schemaPath() const noexcept {
@@ -36,29 +46,19 @@ XmlValidationResult XmlValidator::validate(const std::filesystem::path &xmlPath)
     if (!std::filesystem::exists(xmlPath)) {
         return {false, "XML file not found: " + xmlPath.string()};
     }
-
-    xmlSchemaParserCtxtPtr parser = xmlSchemaNewParserCtxt(m_schemaPath.c_str());
-    if (parser == nullptr) {
-        throw std::runtime_error("Failed to create XML schema parser context");
-    }
-
-    xmlSchemaPtr schema = xmlSchemaParse(parser);
-    xmlSchemaFreeParserCtxt(parser);
-    if (schema == nullptr) {
-        throw std::runtime_error("Failed to parse XML schema");
-    }
+    auto *schema = compiledSchema();
 
     xmlDocPtr doc = xmlReadFile(xmlPath.c_str(), nullptr, 0);
     if (doc == nullptr) {
-        xmlSchemaFree(schema);
         return {false, "Unable to parse XML file"};
     }
 
-    xmlSchemaValidCtxtPtr validCtxt = xmlSchemaNewValidCtxt(schema);
-    if (validCtxt == nullptr) {
+    xmlSchemaValidCtxtPtr validCtxt = nullptr;
+    try {
+        validCtxt = acquireContext(schema);
+    } catch (...) {
         xmlFreeDoc(doc);
-        xmlSchemaFree(schema);
-        throw std::runtime_error("Failed to create XML validation context");
+        throw;
     }
 
     std::ostringstream errors;
@@ -66,9 +66,10 @@ XmlValidationResult XmlValidator::validate(const std::filesystem::path &xmlPath)
 
     const int result = xmlSchemaValidateDoc(validCtxt, doc);
 
-    xmlSchemaFreeValidCtxt(validCtxt);
+    // The context outlives this call's error stream.
+    xmlSchemaSetValidErrors(validCtxt, nullptr, nullptr, nullptr);
+    releaseContext(validCtxt);
     xmlFreeDoc(doc);
-    xmlSchemaFree(schema);
 
     if (result == 0) {
         return {true, {}};
@@ -81,5 +82,47 @@ XmlValidationResult XmlValidator::validate(const std::filesystem::path &xmlPath)
     return {false, message};
 }
 
-} // namespace trdp::device
+_xmlSchema *XmlValidator::compiledSchema() const {
+    // A failed compile leaves the flag unset, so the next call tries again and reports the same error.
+    std::call_once(m_compileOnce, [this] {
+        xmlSchemaParserCtxtPtr parser = xmlSchemaNewParserCtxt(m_schemaPath.c_str());
+        if (parser == nullptr) {
+            throw std::runtime_error("Failed to create XML schema parser context");
+        }
+        m_schema = xmlSchemaParse(parser);
+        xmlSchemaFreeParserCtxt(parser);
+        if (m_schema == nullptr) {
+            throw std::runtime_error("Failed to parse XML schema");
+        }
+    });
+    return m_schema;
+}
 
+_xmlSchemaValidCtxt *XmlValidator::acquireContext(_xmlSchema *schema) const {
+    {
+        const std::lock_guard lock{m_poolMutex};
+        if (!m_idleContexts.empty()) {
+            auto *context = m_idleContexts.back();
+            m_idleContexts.pop_back();
+            return context;
+        }
+    }
+    // A compiled schema is only read while validating, so any number of contexts can share it.
+    xmlSchemaValidCtxtPtr context = xmlSchemaNewValidCtxt(schema);
+    if (context == nullptr) {
+        throw std::runtime_error("Failed to create XML validation context");
+    }
+    return context;
+}
+
+void XmlValidator::releaseContext(_xmlSchemaValidCtxt *context) const noexcept {
+    try {
+        const std::lock_guard lock{m_poolMutex};
+        m_idleContexts.push_back(context);
+    } catch (...) {
+        // No room to keep it for later.
+        xmlSchemaFreeValidCtxt(context);
+    }
+}
+
+} // namespace trdp::device
@@ -1,34 +1,69 @@
+#include "trdp_simulator/communication/FaultInjectingAdapter.hpp"
+#include "trdp_simulator/communication/NetworkEmulationAdapter.hpp"
+#include "trdp_simulator/communication/PdMailbox.hpp"
 #include "trdp_simulator/communication/TrdpError.hpp"
 #include "trdp_simulator/communication/Wrapper.hpp"
+#include "trdp_simulator/device/DeviceConfig.hpp"
 #include "trdp_simulator/device/DeviceProfileRepository.hpp"
 #include "trdp_simulator/device/XmlValidator.hpp"
+#include "trdp_simulator/simulation/BlobStore.hpp"
+#include "trdp_simulator/simulation/BulkImport.hpp"
+#include "trdp_simulator/simulation/ConsistRunner.hpp"
+#include "trdp_simulator/simulation/DeviceStateStore.hpp"
 #include "trdp_simulator/simulation/Engine.hpp"
+#include "trdp_simulator/simulation/HexCodec.hpp"
+#include "trdp_simulator/simulation/LoadGenerator.hpp"
+#include "trdp_simulator/simulation/RunDiff.hpp"
 #include "trdp_simulator/simulation/ScenarioRepository.hpp"
 #include "trdp_simulator/simulation/ScenarioSchemaValidator.hpp"
 
 #include <chrono>
+#include <condition_variable>
 #include <cstdlib>
 #include <exception>
 #include <filesystem>
+#include <iomanip>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <system_error>
+#include <thread>
 #include <vector>
 
 using trdp::communication::DiagnosticEvent;
+using trdp::communication::FaultInjectingAdapter;
+using trdp::communication::NetworkEmulationAdapter;
 using trdp::communication::MessageDataMessage;
+using trdp::communication::PdMailbox;
+using trdp::communication::PdSample;
 using trdp::communication::ProcessDataMessage;
 using trdp::communication::TrdpError;
 using trdp::communication::Wrapper;
 using trdp::device::DeviceProfileRepository;
 using trdp::device::XmlValidator;
+using trdp::simulation::BlobStore;
+using trdp::simulation::ConsistMember;
+using trdp::simulation::ConsistOptions;
+using trdp::simulation::ConsistReport;
+using trdp::simulation::ConsistRunner;
+using trdp::simulation::DeviceStateStore;
+using trdp::simulation::ImportOutcome;
+using trdp::simulation::LoadGenerator;
+using trdp::simulation::LoadOptions;
+using trdp::simulation::LoadReport;
 using trdp::simulation::Scenario;
 using trdp::simulation::ScenarioEvent;
 using trdp::simulation::ScenarioRepository;
 using trdp::simulation::ScenarioSchemaValidator;
+using trdp::simulation::ScenarioValidationError;
+using trdp::simulation::RunDiffReport;
+using trdp::simulation::RunOrder;
+using trdp::simulation::RunPage;
 using trdp::simulation::RunRecord;
 using trdp::simulation::SimulationEngine;
 
@@ -42,13 +77,23 @@ struct CliOptions {
     std::vector<std::pair<std::string, std::filesystem::path>> exportScenarioRequests;
     std::vector<std::filesystem::path> validateScenarioPaths;
     bool listScenarios{false};
+    bool collectBlobs{false};
     bool listRuns{false};
     std::vector<std::string> listRunsFor;
+    trdp::simulation::RunQuery runQuery{.limit = 50};
     bool noRun{false};
     std::string deviceProfileId;
     std::string endpoint{"127.0.0.1"};
     std::vector<ScenarioEvent> events;
     std::optional<std::string> replayRunId;
+    bool replayTiming{false};
+    std::optional<std::filesystem::path> replayCapture;
+    std::optional<std::filesystem::path> consistFile;
+    std::optional<std::filesystem::path> mailboxFile;
+    std::optional<std::string> loadProfileId;
+    LoadOptions load;
+    std::optional<std::pair<std::string, std::string>> diffRuns;
+    trdp::simulation::RunDiffOptions diff;
 };
 
 [[nodiscard]] std::filesystem::path defaultConfigRoot() {
@@ -76,6 +121,22 @@ struct CliOptions {
     return relative;
 }
 
+[[nodiscard]] double parseRate(const std::string &flag, const std::string &value) {
+    std::size_t consumed = 0;
+    const double rate = std::stod(value, &consumed);
+    if (consumed != value.size() || !(rate > 0.0)) {
+        throw std::invalid_argument(flag + " expects positive numbers: " + value);
+    }
+    return rate;
+}
+
+[[nodiscard]] std::size_t parseCount(const std::string &flag, const std::string &value) {
+    if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos) {
+        throw std::invalid_argument(flag + " expects a non-negative integer: " + value);
+    }
+    return static_cast<std::size_t>(std::stoull(value));
+}
+
 [[nodiscard]] ScenarioEvent::Type parseEventType(std::string_view token) {
     if (token == "pd") {
         return ScenarioEvent::Type::ProcessData;
@@ -114,13 +175,11 @@ struct CliOptions {
         if ((token.size() - 2) % 2 != 0) {
             throw std::invalid_argument("Hex payload must contain an even number of characters");
         }
-        for (std::size_t i = 2; i < token.size(); i += 2) {
-            const auto byteStr = token.substr(i, 2);
-            const unsigned value = std::stoul(std::string{byteStr}, nullptr, 16);
-            if (value > 0xFF) {
-                throw std::invalid_argument("Hex payload byte out of range: " + std::string{byteStr});
-            }
-            payload.push_back(static_cast<std::uint8_t>(value));
+        const auto digits = token.substr(2);
+        payload.resize(digits.size() / 2);
+        if (const auto decoded = trdp::simulation::hex::decode(digits, payload.data()); decoded != digits.size()) {
+            const auto bad = digits.substr(decoded & ~std::size_t{1}, 2);
+            throw std::invalid_argument("Invalid hex payload byte: " + std::string{bad});
         }
         return payload;
     }
@@ -131,9 +190,16 @@ struct CliOptions {
 CliOptions parseArgs(int argc, char **argv) {
     if (argc < 2) {
         throw std::invalid_argument(
-            "Usage: trdp-sim [scenario-id] [--scenario-file <path>] [--device-xml <path>]... [--device <profile-id>] "
-            "[--endpoint <ip>] [--event <pd|md>:label[:comId][:dataset][:payload]]... "
-            "[--import-scenario <path>] [--export-scenario <id> <path>] [--list-scenarios] [--no-run]");
+            "Usage: trdp-sim [scenario-id] [--scenario-file <path>] [--device-xml <path|dir>]... "
+            "[--device <profile-id>] [--endpoint <ip>] [--event <pd|md>:label[:comId][:dataset][:payload]]... "
+            "[--import-scenario <path|dir>] [--export-scenario <id> <path>] [--list-scenarios] [--consist <path>] "
+            "[--collect-blobs] [--mailbox-file <path>] [--load <profile-id>] [--load-rate <start>[:<max>]] "
+            "[--load-step-ms <ms>] "
+            "[--load-md-share <fraction>] [--diff-runs <run-a> <run-b>] [--diff-window-ms <ms>] "
+            "[--list-runs] [--list-runs-for <id>] [--runs-since <time>] [--runs-until <time>] "
+            "[--runs-status <pass|fail>] [--runs-order <newest|oldest>] [--runs-limit <n>] [--runs-offset <n>] "
+            "[--runs-after <cursor>] "
+            "[--replay-run <run-id> [--replay-timing]] [--replay-capture <path>] [--no-run]");
     }
 
     CliOptions options;
@@ -201,6 +267,8 @@ CliOptions parseArgs(int argc, char **argv) {
             options.validateScenarioPaths.emplace_back(argv[++i]);
         } else if (arg == "--list-scenarios") {
             options.listScenarios = true;
+        } else if (arg == "--collect-blobs") {
+            options.collectBlobs = true;
         } else if (arg == "--list-runs") {
             options.listRuns = true;
         } else if (arg == "--list-runs-for") {
@@ -208,6 +276,42 @@ CliOptions parseArgs(int argc, char **argv) {
                 throw std::invalid_argument("--list-runs-for requires an id");
             }
             options.listRunsFor.emplace_back(argv[++i]);
+        } else if (arg == "--runs-since" || arg == "--runs-until" || arg == "--runs-after") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument(arg + " requires a value");
+            }
+            auto &bound = arg == "--runs-since"   ? options.runQuery.startedFrom
+                          : arg == "--runs-until" ? options.runQuery.startedUntil
+                                                  : options.runQuery.after;
+            bound = argv[++i];
+        } else if (arg == "--runs-status") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--runs-status requires pass or fail");
+            }
+            const std::string status{argv[++i]};
+            if (status != "pass" && status != "fail") {
+                throw std::invalid_argument("--runs-status expects pass or fail: " + status);
+            }
+            options.runQuery.success = status == "pass";
+        } else if (arg == "--runs-order") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--runs-order requires newest or oldest");
+            }
+            const std::string order{argv[++i]};
+            if (order != "newest" && order != "oldest") {
+                throw std::invalid_argument("--runs-order expects newest or oldest: " + order);
+            }
+            options.runQuery.order = order == "newest" ? RunOrder::NewestFirst : RunOrder::OldestFirst;
+        } else if (arg == "--runs-limit") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--runs-limit requires a value");
+            }
+            options.runQuery.limit = parseCount(arg, argv[++i]);
+        } else if (arg == "--runs-offset") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--runs-offset requires a value");
+            }
+            options.runQuery.offset = parseCount(arg, argv[++i]);
         } else if (arg == "--no-run") {
             options.noRun = true;
         } else if (arg == "--replay-run") {
@@ -218,6 +322,56 @@ CliOptions parseArgs(int argc, char **argv) {
                 throw std::invalid_argument("--replay-run specified multiple times");
             }
             options.replayRunId = argv[++i];
+        } else if (arg == "--replay-timing") {
+            options.replayTiming = true;
+        } else if (arg == "--replay-capture") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--replay-capture requires a path");
+            }
+            options.replayCapture = std::filesystem::path{argv[++i]};
+        } else if (arg == "--consist") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--consist requires a path");
+            }
+            options.consistFile = std::filesystem::path{argv[++i]};
+        } else if (arg == "--mailbox-file") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--mailbox-file requires a path");
+            }
+            options.mailboxFile = std::filesystem::path{argv[++i]};
+        } else if (arg == "--load") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--load requires a device profile id");
+            }
+            options.loadProfileId = argv[++i];
+        } else if (arg == "--load-rate") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--load-rate requires <start>[:<max>]");
+            }
+            const auto tokens = splitTokens(argv[++i]);
+            options.load.startRate = parseRate(arg, tokens[0]);
+            options.load.maxRate = tokens.size() > 1 ? parseRate(arg, tokens[1]) : options.load.startRate;
+        } else if (arg == "--load-step-ms") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--load-step-ms requires a value");
+            }
+            options.load.stepDuration = std::chrono::milliseconds{std::stoll(argv[++i])};
+        } else if (arg == "--load-md-share") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--load-md-share requires a value");
+            }
+            options.load.mdShare = std::stod(argv[++i]);
+        } else if (arg == "--diff-runs") {
+            if (i + 2 >= argc) {
+                throw std::invalid_argument("--diff-runs requires two run ids");
+            }
+            const std::string first{argv[++i]};
+            options.diffRuns.emplace(first, argv[++i]);
+        } else if (arg == "--diff-window-ms") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("--diff-window-ms requires a value");
+            }
+            options.diff.matchWindow = std::chrono::milliseconds{std::stoll(argv[++i])};
         } else if (arg.rfind("--", 0) == 0) {
             throw std::invalid_argument("Unknown argument: " + arg);
         } else {
@@ -228,11 +382,15 @@ CliOptions parseArgs(int argc, char **argv) {
         }
     }
 
+    if (options.replayTiming && !options.replayRunId.has_value()) {
+        throw std::invalid_argument("--replay-timing requires --replay-run");
+    }
     if (options.scenarioId.empty() && !options.noRun && !options.scenarioFile.has_value() && options.events.empty() &&
-        !options.replayRunId.has_value()) {
+        !options.replayRunId.has_value() && !options.consistFile.has_value() && !options.loadProfileId.has_value()) {
         const bool managementOnly = options.listScenarios || !options.importScenarioPaths.empty() ||
                                     !options.exportScenarioRequests.empty() || options.listRuns ||
-                                    !options.listRunsFor.empty() || !options.validateScenarioPaths.empty();
+                                    !options.listRunsFor.empty() || !options.validateScenarioPaths.empty() ||
+                                    options.diffRuns.has_value() || options.collectBlobs;
         if (!managementOnly) {
             throw std::invalid_argument("Scenario identifier is required unless --no-run is specified");
         }
@@ -258,6 +416,80 @@ void registerLoopbackLogging(Wrapper &wrapper) {
     });
 }
 
+/// Writes the latest received value of every mailbox comId; the file is replaced atomically.
+void writeMailboxFile(const std::filesystem::path &path, const PdMailbox &mailbox) {
+    const auto now = std::chrono::steady_clock::now();
+    auto staging = path;
+    staging += ".tmp";
+    {
+        std::ofstream stream{staging, std::ios::trunc};
+        PdSample sample;
+        for (const auto comId : mailbox.comIds()) {
+            (void)mailbox.snapshot(comId, sample);
+            stream << "- com_id: " << comId << '\n';
+            stream << "  sequence: " << sample.sequence << '\n';
+            if (sample.sequence == 0) {
+                continue;
+            }
+            const auto age = std::chrono::duration_cast<std::chrono::microseconds>(now - sample.receivedAt);
+            stream << "  age_us: " << age.count() << '\n';
+            stream << "  payload: 0x" << trdp::simulation::hex::encode(sample.payload) << '\n';
+            if (sample.truncated) {
+                stream << "  truncated: true\n";
+            }
+        }
+    }
+    // Best effort: a failed refresh is retried on the next interval.
+    std::error_code error;
+    std::filesystem::rename(staging, path, error);
+}
+
+/// Refreshes the mailbox file from a background thread while a run is in progress.
+class MailboxFileWriter {
+public:
+    MailboxFileWriter(std::filesystem::path path, const PdMailbox &mailbox)
+        : m_path(std::move(path)), m_mailbox(mailbox), m_thread([this](std::stop_token stop) {
+              std::mutex mutex;
+              std::unique_lock lock{mutex};
+              while (!stop.stop_requested()) {
+                  writeMailboxFile(m_path, m_mailbox);
+                  m_wake.wait_for(lock, stop, std::chrono::milliseconds{100}, [] { return false; });
+              }
+          }) {}
+
+    ~MailboxFileWriter() {
+        m_thread.request_stop();
+        m_thread.join();
+        writeMailboxFile(m_path, m_mailbox);
+    }
+
+    MailboxFileWriter(const MailboxFileWriter &) = delete;
+    MailboxFileWriter &operator=(const MailboxFileWriter &) = delete;
+
+private:
+    std::filesystem::path m_path;
+    const PdMailbox &m_mailbox;
+    std::condition_variable_any m_wake;
+    std::jthread m_thread;
+};
+
+/// Prints what became of every file of a directory import; returns how many files failed.
+std::size_t printImportOutcomes(const std::vector<ImportOutcome> &outcomes, const std::filesystem::path &directory,
+                                std::string_view done, std::string_view kind) {
+    std::size_t failed = 0;
+    for (const auto &outcome : outcomes) {
+        if (outcome.ok()) {
+            std::cout << done << " '" << outcome.id << "' from " << outcome.source << std::endl;
+        } else {
+            ++failed;
+            std::cerr << "Failed to import " << outcome.source << ": " << outcome.error << std::endl;
+        }
+    }
+    std::cout << "Imported " << outcomes.size() - failed << " of " << outcomes.size() << ' ' << kind << " from "
+              << directory << std::endl;
+    return failed;
+}
+
 void printScenarioRecords(const ScenarioRepository &repository) {
     const auto records = repository.list();
     if (records.empty()) {
@@ -271,13 +503,13 @@ void printScenarioRecords(const ScenarioRepository &repository) {
     }
 }
 
-void printRunRecords(const std::vector<RunRecord> &records, std::string_view heading = "Recorded runs") {
-    if (records.empty()) {
+void printRunRecords(const RunPage &page, std::string_view heading = "Recorded runs") {
+    if (page.runs.empty()) {
         std::cout << "No runs recorded." << std::endl;
         return;
     }
     std::cout << heading << ':' << std::endl;
-    for (const auto &record : records) {
+    for (const auto &record : page.runs) {
         std::cout << "  - " << record.id << " (scenario=" << record.scenarioId << ", started=" << record.startedAt
                   << ", success=" << (record.success ? "yes" : "no") << ")" << std::endl;
         std::cout << "      artefacts: " << record.artefactPath << std::endl;
@@ -285,6 +517,165 @@ void printRunRecords(const std::vector<RunRecord> &records, std::string_view hea
             std::cout << "      detail: " << record.detail << std::endl;
         }
     }
+    if (page.nextCursor) {
+        std::cout << "More runs match; continue with --runs-after '" << *page.nextCursor << "'" << std::endl;
+    }
+}
+
+void printConsistReport(const ConsistReport &report) {
+    const auto micros = [](std::chrono::nanoseconds value) {
+        return std::chrono::duration<double, std::micro>(value).count();
+    };
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Consist shards:" << std::endl;
+    for (const auto &shard : report.shards) {
+        std::cout << "  - shard " << shard.index << " (cpu=" << shard.cpu << ", members=" << shard.members
+                  << ", sent=" << shard.sent << ", received=" << shard.received
+                  << ", cpu_ms=" << std::chrono::duration<double, std::milli>(shard.cpuTime).count()
+                  << ", utilisation=" << shard.utilisation() * 100.0
+                  << "%, p99_us=" << micros(shard.latency.percentile(0.99)) << ")" << std::endl;
+        for (const auto &failure : shard.failures) {
+            std::cout << "      failure: " << failure << std::endl;
+        }
+    }
+    for (const auto &member : report.members) {
+        for (const auto &failure : member.failures) {
+            std::cout << "  member " << member.endpoint << " failure: " << failure << std::endl;
+        }
+    }
+    const auto &latency = report.latency;
+    std::cout << "Delivery latency (us): count=" << latency.count() << " p50=" << micros(latency.percentile(0.5))
+              << " p90=" << micros(latency.percentile(0.9)) << " p99=" << micros(latency.percentile(0.99))
+              << " max=" << micros(latency.max()) << std::endl;
+    std::cout << "Dropped telegrams: " << report.dropped << std::endl;
+}
+
+int runConsist(const std::filesystem::path &path, ScenarioRepository &scenarioRepository,
+               DeviceProfileRepository &deviceRepository) {
+    const auto definition = trdp::simulation::loadConsistDefinition(path);
+    ConsistOptions consistOptions{};
+    consistOptions.shards = definition.shards;
+    ConsistRunner runner{consistOptions};
+    for (const auto &ref : definition.members) {
+        ConsistMember member{};
+        member.endpoint = ref.endpoint;
+        member.scenario = scenarioRepository.loadShared(ref.scenarioId);
+        const auto profile = deviceRepository.get(member.scenario->deviceProfileId);
+        const auto device = trdp::device::loadDeviceConfig(profile.storedPath);
+        member.subscriptions = device.subscriptions();
+        if (trdp::simulation::usesDeviceState(*member.scenario)) {
+            member.state = std::make_shared<DeviceStateStore>(device);
+        }
+        runner.addMember(std::move(member));
+    }
+    std::cout << "Running consist '" << definition.id << "' with " << runner.members() << " members" << std::endl;
+    const auto report = runner.run();
+    printConsistReport(report);
+    return report.success() ? 0 : 1;
+}
+
+void printLoadReport(const LoadReport &report) {
+    const auto micros = [](std::chrono::nanoseconds value) {
+        return std::chrono::duration<double, std::micro>(value).count();
+    };
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Load steps:" << std::endl;
+    for (const auto &step : report.steps) {
+        std::cout << "  - offered=" << step.offeredRate << "/s sent=" << step.sendRate
+                  << "/s received=" << step.receiveRate << "/s loss=" << step.loss() * 100.0
+                  << "% p50_us=" << micros(step.latency.percentile(0.5))
+                  << " p99_us=" << micros(step.latency.percentile(0.99))
+                  << (step.sustainable ? "" : " (unsustainable)") << std::endl;
+    }
+    if (report.knee) {
+        std::cout << "Maximum sustainable rate: " << report.maxSustainableRate() << " telegrams/s (offered "
+                  << report.steps[*report.knee].offeredRate << "/s)" << std::endl;
+    } else {
+        std::cout << "No sustainable rate found; lower --load-rate" << std::endl;
+    }
+}
+
+int runLoad(const std::string &profileId, LoadOptions load, DeviceProfileRepository &deviceRepository,
+            const std::filesystem::path &runsRoot, const std::string &endpoint) {
+    const auto profile = deviceRepository.get(profileId);
+    load.targets = trdp::simulation::loadTargets(trdp::device::loadDeviceConfig(profile.storedPath));
+    Wrapper wrapper{endpoint};
+    // Per-telegram telemetry would dominate the measurement and grow without bound.
+    wrapper.setTelegramTracing(false);
+    LoadGenerator generator{wrapper, std::move(load)};
+    std::cout << "Load run for device profile '" << profileId << "'" << std::endl;
+    const auto report = generator.run();
+    printLoadReport(report);
+    const auto path = trdp::simulation::writeLoadReport(runsRoot, profileId, report);
+    std::cout << "Load report: " << path << std::endl;
+    return report.knee ? 0 : 1;
+}
+
+void printReplayTiming(const trdp::simulation::ReplayTiming &timing) {
+    const auto micros = [](std::chrono::nanoseconds value) {
+        return std::chrono::duration<double, std::micro>(value).count();
+    };
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Replayed " << timing.telegrams << " telegrams from " << timing.source << " over "
+              << micros(timing.replayedSpan) << "us (recorded " << micros(timing.recordedSpan) << "us)" << std::endl;
+    std::cout << "Gap error (us): p50=" << micros(timing.gapError.percentile(0.5))
+              << " p99=" << micros(timing.gapError.percentile(0.99)) << " max=" << micros(timing.gapError.max())
+              << "; lateness (us): p50=" << micros(timing.lateness.percentile(0.5))
+              << " p99=" << micros(timing.lateness.percentile(0.99)) << " max=" << micros(timing.lateness.max())
+              << std::endl;
+}
+
+/// Capture of a recorded run; a capture file or run directory may be given instead of a run id.
+[[nodiscard]] std::filesystem::path resolveCapturePath(const std::string &run, const ScenarioRepository &repository) {
+    const std::filesystem::path candidate{run};
+    if (std::filesystem::is_regular_file(candidate)) {
+        return candidate;
+    }
+    if (std::filesystem::is_directory(candidate)) {
+        return candidate / trdp::simulation::kCaptureFileName;
+    }
+    return repository.getRun(run).artefactPath / trdp::simulation::kCaptureFileName;
+}
+
+void printRunDiff(const RunDiffReport &report) {
+    const auto micros = [](std::chrono::nanoseconds value) {
+        return std::chrono::duration<double, std::micro>(value).count();
+    };
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Telegrams: " << report.recordsA << " vs " << report.recordsB << std::endl;
+    for (const auto &diff : report.telegrams) {
+        const bool sent = diff.direction == trdp::simulation::CaptureDirection::Sent;
+        const auto shift = diff.matched == 0 ? 0 : diff.timingShiftNs / static_cast<std::int64_t>(diff.matched);
+        std::cout << "  - comId " << diff.comId << (sent ? " sent" : " received") << ": matched=" << diff.matched
+                  << " changed=" << diff.changed << " missing=" << diff.missing << " added=" << diff.added
+                  << " bytes_differing=" << diff.bytesDiffering
+                  << " timing_delta_us p50=" << micros(diff.timingDelta.percentile(0.5))
+                  << " p99=" << micros(diff.timingDelta.percentile(0.99)) << " max=" << micros(diff.timingDelta.max())
+                  << " mean_shift=" << micros(std::chrono::nanoseconds{shift}) << std::endl;
+    }
+    if (!report.samples.empty()) {
+        std::cout << "Differences:" << std::endl;
+    }
+    for (const auto &sample : report.samples) {
+        const char *kind = sample.kind == trdp::simulation::DiffKind::Changed   ? "changed"
+                           : sample.kind == trdp::simulation::DiffKind::Missing ? "missing"
+                                                                                 : "added";
+        const bool sent = sample.direction == trdp::simulation::CaptureDirection::Sent;
+        std::cout << "  - " << kind << " comId " << sample.comId << (sent ? " sent" : " received") << " #"
+                  << sample.sequence << " at +" << micros(sample.offset) << "us (" << sample.bytesDiffering
+                  << " bytes)" << std::endl;
+    }
+    std::cout << (report.equivalent() ? "Runs are equivalent" : "Runs differ") << std::endl;
+}
+
+int runDiff(const std::string &first, const std::string &second, const trdp::simulation::RunDiffOptions &options,
+            const ScenarioRepository &repository) {
+    const trdp::simulation::CaptureReader a{resolveCapturePath(first, repository)};
+    const trdp::simulation::CaptureReader b{resolveCapturePath(second, repository)};
+    std::cout << "Comparing run '" << first << "' with '" << second << "'" << std::endl;
+    const auto report = trdp::simulation::diffCaptures(a, b, options);
+    printRunDiff(report);
+    return report.equivalent() ? 0 : 1;
 }
 
 Scenario buildInlineScenario(const CliOptions &options) {
@@ -324,19 +715,39 @@ int main(int argc, char **argv) {
 
     try {
         XmlValidator validator{schemaPath};
+        BlobStore blobs{configRoot / "blobs"};
         DeviceProfileRepository deviceRepository{deviceRoot, validator};
+        deviceRepository.attachBlobStore(&blobs);
         ScenarioSchemaValidator scenarioValidator{scenarioSchemaPath};
         ScenarioRepository scenarioRepository{scenarioRoot, deviceRepository, scenarioValidator};
+        scenarioRepository.attachBlobStore(&blobs);
 
+        // A directory is imported as one batch that reports failed files and carries on with the rest.
+        std::size_t importFailures = 0;
         for (const auto &xml : options.deviceXmls) {
+            if (std::filesystem::is_directory(xml)) {
+                const auto files = trdp::simulation::importFiles(xml, {".xml"});
+                importFailures += printImportOutcomes(deviceRepository.registerProfiles(files), xml,
+                                                      "Registered device profile", "device profiles");
+                continue;
+            }
             const auto id = deviceRepository.registerProfile(xml);
             std::cout << "Registered device profile '" << id << "' from " << xml << std::endl;
         }
 
         for (const auto &path : options.importScenarioPaths) {
+            if (std::filesystem::is_directory(path)) {
+                const auto files = trdp::simulation::importFiles(path, {".yaml", ".yml"});
+                importFailures += printImportOutcomes(scenarioRepository.importScenarios(files), path,
+                                                      "Imported scenario", "scenarios");
+                continue;
+            }
             const auto id = scenarioRepository.importScenario(path);
             std::cout << "Imported scenario '" << id << "' from " << path << std::endl;
         }
+        if (importFailures > 0) {
+            return 1;
+        }
 
         for (const auto &path : options.validateScenarioPaths) {
             scenarioValidator.validate(path);
@@ -348,12 +759,13 @@ int main(int argc, char **argv) {
         }
 
         if (options.listRuns) {
-            printRunRecords(scenarioRepository.listRuns());
+            printRunRecords(scenarioRepository.queryRuns(options.runQuery));
         }
         for (const auto &scenarioId : options.listRunsFor) {
-            const auto records = scenarioRepository.listRunsForScenario(scenarioId);
+            auto query = options.runQuery;
+            query.scenarioId = scenarioId;
             const std::string heading = "Runs for scenario '" + scenarioId + "'";
-            printRunRecords(records, heading);
+            printRunRecords(scenarioRepository.queryRuns(query), heading);
         }
 
         for (const auto &[id, destination] : options.exportScenarioRequests) {
@@ -361,6 +773,25 @@ int main(int argc, char **argv) {
             std::cout << "Exported scenario '" << id << "' to " << destination << std::endl;
         }
 
+        if (options.collectBlobs) {
+            const auto collected = blobs.collect();
+            std::cout << "Removed " << collected.blobs << " unreferenced blobs (" << collected.bytes << " bytes)"
+                      << std::endl;
+        }
+
+        if (options.diffRuns.has_value()) {
+            return runDiff(options.diffRuns->first, options.diffRuns->second, options.diff, scenarioRepository);
+        }
+
+        if (options.consistFile.has_value() && !options.noRun) {
+            return runConsist(*options.consistFile, scenarioRepository, deviceRepository);
+        }
+
+        if (options.loadProfileId.has_value() && !options.noRun) {
+            return runLoad(*options.loadProfileId, options.load, deviceRepository, configRoot / "runs",
+                           options.endpoint);
+        }
+
         if (options.noRun && !options.scenarioFile.has_value() && options.events.empty() && options.scenarioId.empty() &&
             !options.replayRunId.has_value()) {
             return 0;
@@ -373,26 +804,65 @@ int main(int argc, char **argv) {
             return 0;
         }
 
-        Scenario scenario;
+        std::shared_ptr<const Scenario> scenario;
         if (options.replayRunId.has_value()) {
-            scenario = scenarioRepository.loadRunScenario(*options.replayRunId);
+            scenario = scenarioRepository.loadRunScenarioShared(*options.replayRunId);
             std::cout << "Loaded scenario from run '" << *options.replayRunId << "'" << std::endl;
         } else if (options.scenarioFile.has_value()) {
             const auto id = scenarioRepository.importScenario(*options.scenarioFile);
             std::cout << "Imported scenario '" << id << "' from " << *options.scenarioFile << std::endl;
-            scenario = scenarioRepository.load(id);
+            scenario = scenarioRepository.loadShared(id);
         } else if (!options.events.empty() || !options.deviceProfileId.empty()) {
-            scenario = buildInlineScenario(options);
+            scenario = std::make_shared<const Scenario>(buildInlineScenario(options));
         } else {
-            scenario = scenarioRepository.load(options.scenarioId);
+            scenario = scenarioRepository.loadShared(options.scenarioId);
+        }
+
+        std::optional<DeviceStateStore> deviceState;
+        std::optional<PdMailbox> mailbox;
+        if (trdp::simulation::usesDeviceState(*scenario) || options.mailboxFile.has_value()) {
+            const auto profile = deviceRepository.get(scenario->deviceProfileId);
+            const auto device = trdp::device::loadDeviceConfig(profile.storedPath);
+            if (trdp::simulation::usesDeviceState(*scenario)) {
+                deviceState.emplace(device);
+            }
+            if (options.mailboxFile.has_value()) {
+                mailbox.emplace(device.subscriptions());
+            }
         }
 
-        Wrapper wrapper{options.endpoint};
+        // Faults are decided first; surviving telegrams then cross the emulated network.
+        std::shared_ptr<trdp::communication::StackAdapter> stack = trdp::communication::makeLoopbackStackAdapter();
+        std::shared_ptr<NetworkEmulationAdapter> network;
+        if (!scenario->network.empty()) {
+            network = std::make_shared<NetworkEmulationAdapter>(stack, scenario->network, scenario->seed);
+            stack = network;
+        }
+        std::shared_ptr<FaultInjectingAdapter> faults;
+        if (!scenario->faults.empty()) {
+            faults = std::make_shared<FaultInjectingAdapter>(stack, scenario->faults, scenario->seed);
+            stack = faults;
+        }
+
+        Wrapper wrapper{options.endpoint, stack};
         registerLoopbackLogging(wrapper);
         SimulationEngine engine{wrapper, configRoot / "runs", &scenarioRepository};
+        engine.attachDeviceState(deviceState ? &*deviceState : nullptr);
+        engine.attachBlobStore(&blobs);
+        std::optional<MailboxFileWriter> mailboxWriter;
+        if (mailbox) {
+            wrapper.addObserver(*mailbox);
+            mailboxWriter.emplace(*options.mailboxFile, *mailbox);
+        }
 
         try {
             engine.loadScenario(std::move(scenario));
+            if (options.replayCapture.has_value()) {
+                engine.replayCapture(*options.replayCapture);
+            } else if (options.replayTiming) {
+                engine.replayCapture(scenarioRepository.getRun(*options.replayRunId).artefactPath /
+                                     trdp::simulation::kCaptureFileName);
+            }
             engine.run();
         } catch (const TrdpError &trdp) {
             std::cerr << "TRDP failure (code " << trdp.errorCode() << ")";
@@ -409,6 +879,38 @@ int main(int argc, char **argv) {
         }
 
         printDiagnostics(wrapper.diagnostics());
+        if (faults) {
+            const auto &stats = faults->stats();
+            std::cout << "Injected faults: dropped=" << stats.dropped << " duplicated=" << stats.duplicated
+                      << " reordered=" << stats.reordered << " corrupted=" << stats.corrupted
+                      << " delayed=" << stats.delayed << std::endl;
+        }
+        if (network) {
+            const auto &stats = network->stats();
+            const auto totalUs = std::chrono::duration<double, std::micro>(stats.totalDelay).count();
+            const auto meanDelay = stats.delivered == 0 ? 0.0 : totalUs / static_cast<double>(stats.delivered);
+            std::cout << "Network emulation: delivered=" << stats.delivered << " queue_drops=" << stats.queueDrops
+                      << " peak_queue=" << stats.peakQueueDepth << " mean_delay_us=" << meanDelay << std::endl;
+        }
+        if (const auto &timing = engine.replayTiming()) {
+            printReplayTiming(*timing);
+        }
+        bool expectationsPassed = true;
+        for (const auto &result : engine.expectationResults()) {
+            std::cout << "Expectation " << result.label << ": " << (result.passed ? "PASS" : "FAIL") << " ("
+                      << result.detail << ")" << std::endl;
+            expectationsPassed = expectationsPassed && result.passed;
+        }
+        if (!expectationsPassed) {
+            return 3;
+        }
+    } catch (const ScenarioValidationError &ex) {
+        std::cerr << ex.what();
+        if (ex.line() != 0) {
+            std::cerr << " (line " << ex.line() << ")";
+        }
+        std::cerr << std::endl;
+        return 1;
     } catch (const std::exception &ex) {
         std::cerr << ex.what() << std::endl;
         return 1;
@@ -0,0 +1,184 @@
+#include "trdp_simulator/simulation/BlobStore.hpp"
+
+#include "trdp_simulator/simulation/ContentHash.hpp"
+#include "trdp_simulator/simulation/MappedFile.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+namespace trdp::simulation {
+namespace {
+
+constexpr std::string_view kStagingPrefix = "staging-";
+/// Staging files this old belong to a store that will not finish.
+constexpr std::chrono::hours kAbandonedAfter{1};
+
+[[nodiscard]] bool isHex(std::string_view text) noexcept {
+    return text.find_first_not_of("0123456789abcdef") == std::string_view::npos;
+}
+
+/// False as well when @p blob cannot be read, e.g. because collect() just removed it.
+[[nodiscard]] bool holds(const std::filesystem::path &blob, std::string_view contents) {
+    try {
+        return MappedFile{blob}.text() == contents;
+    } catch (const std::runtime_error &) {
+        return false;
+    }
+}
+
+void writeStaged(const std::filesystem::path &staged, std::string_view contents) {
+    std::ofstream stream{staged, std::ios::binary | std::ios::trunc};
+    if (!stream.write(contents.data(), static_cast<std::streamsize>(contents.size())).flush()) {
+        throw std::runtime_error("Failed to write " + staged.string());
+    }
+}
+
+} // namespace
+
+BlobStore::BlobStore(std::filesystem::path root) : m_root(std::move(root)) {
+    std::filesystem::create_directories(m_root);
+}
+
+std::string BlobStore::storeFile(const std::filesystem::path &source, const std::filesystem::path &destination) {
+    // The staged copy is kept until the destination is linked, so collect() cannot take the blob from under it.
+    const auto staged = stagingPath();
+    std::string checksum;
+    try {
+        checksum = copyFileWithChecksum(source, staged);
+        commit(staged, checksum);
+        link(checksum, staged, destination);
+    } catch (...) {
+        std::error_code ignored;
+        std::filesystem::remove(staged, ignored);
+        throw;
+    }
+    std::filesystem::remove(staged);
+    return checksum;
+}
+
+std::string BlobStore::storeContents(std::string_view contents, const std::filesystem::path &destination) {
+    auto checksum = contentChecksum(contents);
+    if (holds(pathFor(checksum), contents) && tryLink(checksum, destination)) {
+        return checksum;
+    }
+    const auto staged = stagingPath();
+    try {
+        writeStaged(staged, contents);
+        commit(staged, checksum);
+        link(checksum, staged, destination);
+    } catch (...) {
+        std::error_code ignored;
+        std::filesystem::remove(staged, ignored);
+        throw;
+    }
+    std::filesystem::remove(staged);
+    return checksum;
+}
+
+std::filesystem::path BlobStore::pathFor(std::string_view checksum) const {
+    if (checksum.starts_with(kChecksumPrefix)) {
+        checksum.remove_prefix(kChecksumPrefix.size());
+    }
+    if (checksum.size() < 3 || !isHex(checksum)) {
+        throw std::invalid_argument("Not a blob checksum: " + std::string{checksum});
+    }
+    return m_root / checksum.substr(0, 2) / checksum;
+}
+
+std::size_t BlobStore::references(std::string_view checksum) const {
+    std::error_code error;
+    const auto links = std::filesystem::hard_link_count(pathFor(checksum), error);
+    return error || links == 0 ? 0 : static_cast<std::size_t>(links - 1);
+}
+
+BlobStore::Collection BlobStore::collect() {
+    Collection collection;
+    const auto abandoned = std::filesystem::file_time_type::clock::now() - kAbandonedAfter;
+    for (const auto &entry : std::filesystem::directory_iterator{m_root}) {
+        const auto name = entry.path().filename().string();
+        if (entry.is_regular_file() && name.starts_with(kStagingPrefix) && entry.last_write_time() < abandoned) {
+            std::error_code ignored;
+            std::filesystem::remove(entry.path(), ignored);
+            continue;
+        }
+        if (!entry.is_directory() || name.size() != 2 || !isHex(name)) {
+            continue;
+        }
+        for (const auto &blob : std::filesystem::directory_iterator{entry.path()}) {
+            // One link left means only the store holds the blob.
+            if (!blob.is_regular_file() || blob.hard_link_count() != 1) {
+                continue;
+            }
+            const auto bytes = blob.file_size();
+            std::error_code error;
+            if (std::filesystem::remove(blob.path(), error)) {
+                ++collection.blobs;
+                collection.bytes += bytes;
+            }
+        }
+    }
+    return collection;
+}
+
+std::filesystem::path BlobStore::stagingPath() const {
+    static std::atomic<std::uint64_t> counter{0};
+    const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+    return m_root / (std::string{kStagingPrefix} + std::to_string(now) + '-' + std::to_string(counter++));
+}
+
+void BlobStore::commit(const std::filesystem::path &staged, const std::string &checksum) {
+    const auto blob = pathFor(checksum);
+    std::filesystem::create_directories(blob.parent_path());
+    std::error_code error;
+    std::filesystem::create_hard_link(staged, blob, error);
+    if (!error) {
+        return;
+    }
+    if (!std::filesystem::exists(blob)) {
+        throw std::filesystem::filesystem_error("Failed to store blob", staged, blob, error);
+    }
+    // XXH64 is not collision resistant, so a matching checksum alone does not make the contents equal.
+    const MappedFile existing{blob};
+    const MappedFile incoming{staged};
+    if (!std::ranges::equal(existing.bytes(), incoming.bytes())) {
+        throw std::runtime_error("Blob " + checksum + " already holds different contents");
+    }
+}
+
+void BlobStore::link(const std::string &checksum, const std::filesystem::path &staged,
+                     const std::filesystem::path &destination) {
+    if (tryLink(checksum, destination)) {
+        return;
+    }
+    if (!std::filesystem::exists(pathFor(checksum))) {
+        commit(staged, checksum);
+        if (tryLink(checksum, destination)) {
+            return;
+        }
+    }
+    // No hard link across file systems: the owner gets a copy of its own.
+    auto linked = destination;
+    linked += ".link";
+    std::filesystem::copy_file(staged, linked, std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::rename(linked, destination);
+}
+
+bool BlobStore::tryLink(const std::string &checksum, const std::filesystem::path &destination) const {
+    auto linked = destination;
+    linked += ".link";
+    std::error_code error;
+    std::filesystem::remove(linked, error);
+    std::filesystem::create_hard_link(pathFor(checksum), linked, error);
+    if (error) {
+        return false;
+    }
+    std::filesystem::rename(linked, destination);
+    return true;
+}
+
+} // namespace trdp::simulation
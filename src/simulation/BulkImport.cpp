@@ -0,0 +1,86 @@
+#include "trdp_simulator/simulation/BulkImport.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace trdp::simulation {
+
+std::vector<std::filesystem::path> importFiles(const std::filesystem::path &directory,
+                                               std::initializer_list<std::string_view> extensions) {
+    std::vector<std::filesystem::path> files;
+    for (const auto &entry : std::filesystem::recursive_directory_iterator{directory}) {
+        if (!entry.is_regular_file()) {
+            continue;
+        }
+        const auto extension = entry.path().extension().string();
+        if (std::find(extensions.begin(), extensions.end(), extension) != extensions.end()) {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+std::filesystem::path importStagingPath(const std::filesystem::path &directory, std::string_view suffix) {
+    static std::atomic<std::uint64_t> counter{0};
+#if defined(__unix__) || defined(__APPLE__)
+    const auto process = static_cast<std::uint64_t>(::getpid());
+#else
+    static const auto process = static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    return directory / ("import-" + std::to_string(process) + '-' + std::to_string(counter++) + std::string{suffix});
+}
+
+void parallelFor(std::size_t count, std::size_t threads, const std::function<void(std::size_t)> &task) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, count);
+    if (threads <= 1) {
+        for (std::size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    std::exception_ptr failure;
+    std::mutex failureMutex;
+    const auto work = [&] {
+        for (auto i = next.fetch_add(1, std::memory_order_relaxed); i < count;
+             i = next.fetch_add(1, std::memory_order_relaxed)) {
+            try {
+                task(i);
+            } catch (...) {
+                const std::lock_guard lock{failureMutex};
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (std::size_t i = 1; i < threads; ++i) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+} // namespace trdp::simulation
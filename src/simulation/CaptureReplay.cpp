@@ -0,0 +1,72 @@
+#include "trdp_simulator/simulation/CaptureReplay.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+namespace trdp::simulation {
+
+TimelineTask playCapture(TimelineScheduler &scheduler, const CaptureReader &capture,
+                         TimelineScheduler::Clock::time_point start, const CaptureEmitter &emit,
+                         ReplayTiming &timing) {
+    using Clock = TimelineScheduler::Clock;
+    auto cursor = capture.cursor();
+    CaptureRecord record;
+    std::int64_t firstRecorded = 0;
+    std::int64_t previousRecorded = 0;
+    Clock::time_point firstSent;
+    Clock::time_point previousSent;
+    while (cursor.next(record)) {
+        if (record.direction != CaptureDirection::Sent) {
+            continue;
+        }
+        if (timing.telegrams == 0) {
+            firstRecorded = record.timestampNs;
+            previousRecorded = record.timestampNs;
+        }
+        const auto deadline = start + std::chrono::nanoseconds{record.timestampNs - firstRecorded};
+        co_await scheduler.sleepUntil(deadline);
+
+        const auto sentAt = Clock::now();
+        timing.lateness.record(sentAt > deadline ? sentAt - deadline : Clock::duration::zero());
+        if (timing.telegrams == 0) {
+            firstSent = sentAt;
+        } else {
+            const auto recordedGap = std::chrono::nanoseconds{record.timestampNs - previousRecorded};
+            const auto replayedGap = sentAt - previousSent;
+            timing.gapError.record(replayedGap > recordedGap ? replayedGap - recordedGap : recordedGap - replayedGap);
+        }
+        ++timing.telegrams;
+        previousRecorded = record.timestampNs;
+        previousSent = sentAt;
+        timing.recordedSpan = std::chrono::nanoseconds{record.timestampNs - firstRecorded};
+        timing.replayedSpan = sentAt - firstSent;
+        emit(record);
+    }
+}
+
+void writeReplayTiming(const std::filesystem::path &path, const ReplayTiming &timing) {
+    std::ofstream stream{path, std::ios::trunc};
+    if (!stream) {
+        throw std::runtime_error("Failed to write replay timing: " + path.string());
+    }
+    const auto micros = [](std::chrono::nanoseconds value) {
+        return std::chrono::duration<double, std::micro>(value).count();
+    };
+    stream << std::fixed << std::setprecision(1);
+    stream << "source: " << timing.source << '\n';
+    stream << "telegrams: " << timing.telegrams << '\n';
+    stream << "recorded_span_us: " << micros(timing.recordedSpan) << '\n';
+    stream << "replayed_span_us: " << micros(timing.replayedSpan) << '\n';
+    stream << "gap_error_us:\n";
+    stream << "  p50: " << micros(timing.gapError.percentile(0.5)) << '\n';
+    stream << "  p99: " << micros(timing.gapError.percentile(0.99)) << '\n';
+    stream << "  max: " << micros(timing.gapError.max()) << '\n';
+    stream << "  mean: " << micros(timing.gapError.mean()) << '\n';
+    stream << "lateness_us:\n";
+    stream << "  p50: " << micros(timing.lateness.percentile(0.5)) << '\n';
+    stream << "  p99: " << micros(timing.lateness.percentile(0.99)) << '\n';
+    stream << "  max: " << micros(timing.lateness.max()) << '\n';
+}
+
+} // namespace trdp::simulation
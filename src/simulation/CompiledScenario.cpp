@@ -0,0 +1,590 @@
+#include "trdp_simulator/simulation/CompiledScenario.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+namespace trdp::simulation {
+
+namespace {
+
+constexpr std::array<char, 8> kFileMagic{'T', 'R', 'D', 'P', 'S', 'C', 'N', '1'};
+constexpr std::uint32_t kFileVersion = 3;
+constexpr std::size_t kChecksumCapacity = 32;
+
+struct FileHeader {
+    std::array<char, 8> magic{};
+    std::uint32_t version{kFileVersion};
+    std::uint32_t reserved{0};
+    std::array<char, kChecksumCapacity> checksum{};
+    std::uint64_t seed{0};
+    std::uint32_t id{0};
+    std::uint32_t deviceProfileId{0};
+    std::uint32_t strings{0};
+    std::uint32_t events{0};
+    std::uint32_t timelines{0};
+    std::uint32_t triggers{0};
+    std::uint32_t expectations{0};
+    std::uint32_t faults{0};
+    std::uint32_t links{0};
+    std::uint32_t reserved2{0};
+    std::uint64_t stringBytes{0};
+    std::uint64_t arenaBytes{0};
+};
+static_assert(sizeof(FileHeader) == 112);
+
+/// Bytes in the payload arena.
+struct BlobRef {
+    std::uint64_t offset{0};
+    std::uint64_t size{0};
+};
+
+struct EventRecord {
+    std::uint8_t type{0};
+    std::uint8_t fromState{0};
+    std::uint8_t hasCounter{0};
+    std::uint8_t hasCounterEnd{0};
+    std::uint8_t counterWidth{0};
+    std::array<std::uint8_t, 3> reserved{};
+    std::uint32_t label{0};
+    std::uint32_t comId{0};
+    std::uint32_t datasetId{0};
+    std::uint32_t timeline{0};
+    std::uint32_t field{0};
+    std::uint32_t value{0};
+    std::uint32_t repeat{1};
+    std::uint32_t rampStartHz{0};
+    std::uint32_t rampEndHz{0};
+    std::uint32_t reserved2{0};
+    std::int64_t delayMs{0};
+    std::int64_t periodMs{0};
+    BlobRef payload;
+    std::uint64_t counterOffset{0};
+    std::uint64_t counterStart{0};
+    std::uint64_t counterStep{1};
+    std::uint64_t counterEnd{0};
+};
+static_assert(sizeof(EventRecord) == 112);
+
+struct PredicateRecord {
+    std::uint8_t hasMasked{0};
+    std::uint8_t hasField{0};
+    std::uint8_t fieldWidth{1};
+    std::uint8_t fieldOp{0};
+    std::uint32_t fieldDatasetId{0};
+    std::uint64_t maskedOffset{0};
+    BlobRef mask;
+    BlobRef value;
+    std::uint64_t fieldOffset{0};
+    std::uint64_t fieldValue{0};
+    std::uint32_t fieldName{0};
+    std::uint32_t reserved{0};
+};
+static_assert(sizeof(PredicateRecord) == 72);
+
+struct TimelineRecord {
+    std::uint32_t name{0};
+    std::uint32_t reserved{0};
+};
+
+struct TriggerRecord {
+    std::uint32_t label{0};
+    std::uint8_t on{0};
+    std::array<std::uint8_t, 3> reserved{};
+    std::uint32_t comId{0};
+    std::uint32_t reserved2{0};
+    std::int64_t deadlineMs{0};
+    PredicateRecord predicate;
+    EventRecord action;
+};
+static_assert(sizeof(TriggerRecord) == 208);
+
+struct ExpectationRecord {
+    std::uint32_t label{0};
+    std::uint8_t type{0};
+    std::uint8_t hasMaxCount{0};
+    std::array<std::uint8_t, 2> reserved{};
+    std::uint32_t comId{0};
+    std::uint32_t minCount{0};
+    std::uint32_t maxCount{0};
+    std::uint32_t reserved2{0};
+    std::int64_t windowMs{0};
+    std::int64_t cycleMs{0};
+    std::int64_t cycleToleranceMs{0};
+    PredicateRecord predicate;
+};
+static_assert(sizeof(ExpectationRecord) == 120);
+
+struct FaultRecord {
+    std::uint32_t comId{0};
+    std::uint32_t reserved{0};
+    double loss{0.0};
+    double duplicate{0.0};
+    double reorder{0.0};
+    double corrupt{0.0};
+    std::int64_t delayUs{0};
+    std::int64_t jitterUs{0};
+};
+static_assert(sizeof(FaultRecord) == 56);
+
+struct LinkRecord {
+    std::uint32_t comId{0};
+    std::uint32_t distribution{0};
+    std::int64_t latencyUs{0};
+    std::int64_t jitterUs{0};
+    std::uint64_t bandwidth{0};
+    std::uint64_t queueLimit{0};
+};
+static_assert(sizeof(LinkRecord) == 40);
+
+[[nodiscard]] constexpr std::size_t padded(std::size_t bytes) noexcept { return (bytes + 7U) & ~std::size_t{7U}; }
+
+/// Byte offsets of the sections, relative to the start of the file.
+struct Layout {
+    std::size_t stringOffsets{0};
+    std::size_t stringChars{0};
+    std::size_t arena{0};
+    std::size_t events{0};
+    std::size_t timelines{0};
+    std::size_t triggers{0};
+    std::size_t expectations{0};
+    std::size_t faults{0};
+    std::size_t links{0};
+    std::size_t end{0};
+};
+
+[[nodiscard]] Layout layoutFor(const FileHeader &header) noexcept {
+    Layout layout;
+    layout.stringOffsets = sizeof(FileHeader);
+    layout.stringChars = layout.stringOffsets + padded((std::size_t{header.strings} + 1) * sizeof(std::uint32_t));
+    layout.arena = layout.stringChars + padded(header.stringBytes);
+    layout.events = layout.arena + padded(header.arenaBytes);
+    layout.timelines = layout.events + header.events * sizeof(EventRecord);
+    layout.triggers = layout.timelines + header.timelines * sizeof(TimelineRecord);
+    layout.expectations = layout.triggers + header.triggers * sizeof(TriggerRecord);
+    layout.faults = layout.expectations + header.expectations * sizeof(ExpectationRecord);
+    layout.links = layout.faults + header.faults * sizeof(FaultRecord);
+    layout.end = layout.links + header.links * sizeof(LinkRecord);
+    return layout;
+}
+
+template <typename T>
+[[nodiscard]] T load(const std::byte *data) noexcept {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+[[nodiscard]] FileHeader readHeader(std::span<const std::byte> bytes) noexcept {
+    return load<FileHeader>(bytes.data());
+}
+
+/// Interns strings and collects payload bytes while records are built.
+class ImageBuilder {
+public:
+    ImageBuilder() { (void)intern({}); }
+
+    std::uint32_t intern(std::string_view value) {
+        const auto [it, inserted] = m_index.try_emplace(value, static_cast<std::uint32_t>(m_strings.size()));
+        if (inserted) {
+            m_strings.push_back(value);
+        }
+        return it->second;
+    }
+
+    BlobRef blob(std::span<const std::uint8_t> bytes) {
+        BlobRef ref{m_arena.size(), bytes.size()};
+        m_arena.insert(m_arena.end(), bytes.begin(), bytes.end());
+        return ref;
+    }
+
+    EventRecord event(const ScenarioEvent &event) {
+        EventRecord record{};
+        record.type = static_cast<std::uint8_t>(event.type);
+        record.fromState = event.fromState ? 1 : 0;
+        record.label = intern(event.label);
+        record.comId = event.comId;
+        record.datasetId = event.datasetId;
+        record.timeline = intern(event.timeline);
+        record.field = intern(event.field);
+        record.value = intern(event.value);
+        record.repeat = event.generator.repeat;
+        record.rampStartHz = event.generator.rampStartHz;
+        record.rampEndHz = event.generator.rampEndHz;
+        record.delayMs = event.delay.count();
+        record.periodMs = event.generator.period.count();
+        record.payload = blob(event.payload);
+        if (const auto &counter = event.generator.counter) {
+            record.hasCounter = 1;
+            record.counterWidth = counter->width;
+            record.counterOffset = counter->offset;
+            record.counterStart = counter->start;
+            record.counterStep = counter->step;
+            record.hasCounterEnd = counter->end ? 1 : 0;
+            record.counterEnd = counter->end.value_or(0);
+        }
+        return record;
+    }
+
+    PredicateRecord predicate(const PayloadPredicate &predicate) {
+        PredicateRecord record{};
+        if (const auto &masked = predicate.masked) {
+            record.hasMasked = 1;
+            record.maskedOffset = masked->offset;
+            record.mask = blob(masked->mask);
+            record.value = blob(masked->value);
+        }
+        if (const auto &field = predicate.field) {
+            record.hasField = 1;
+            record.fieldWidth = field->width;
+            record.fieldOp = static_cast<std::uint8_t>(field->op);
+            record.fieldOffset = field->offset;
+            record.fieldValue = field->value;
+            record.fieldDatasetId = field->datasetId;
+            record.fieldName = intern(field->name);
+        }
+        return record;
+    }
+
+    [[nodiscard]] const std::vector<std::string_view> &strings() const noexcept { return m_strings; }
+    [[nodiscard]] const std::vector<std::uint8_t> &arena() const noexcept { return m_arena; }
+
+private:
+    std::vector<std::string_view> m_strings;
+    std::unordered_map<std::string_view, std::uint32_t> m_index;
+    std::vector<std::uint8_t> m_arena;
+};
+
+template <typename T>
+void writeTable(std::ofstream &stream, const std::vector<T> &records) {
+    stream.write(reinterpret_cast<const char *>(records.data()),
+                 static_cast<std::streamsize>(records.size() * sizeof(T)));
+}
+
+void writePadding(std::ofstream &stream, std::size_t bytes) {
+    static constexpr std::array<char, 8> kZeros{};
+    stream.write(kZeros.data(), static_cast<std::streamsize>(padded(bytes) - bytes));
+}
+
+/// Bounds-checked access to the string table and arena of a mapped file.
+class ImageReader {
+public:
+    explicit ImageReader(std::span<const std::byte> bytes)
+        : m_bytes(bytes), m_header(readHeader(bytes)), m_layout(layoutFor(m_header)) {}
+
+    [[nodiscard]] const FileHeader &header() const noexcept { return m_header; }
+    [[nodiscard]] const Layout &layout() const noexcept { return m_layout; }
+
+    template <typename T>
+    [[nodiscard]] T record(std::size_t section, std::size_t index) const noexcept {
+        return load<T>(m_bytes.data() + section + index * sizeof(T));
+    }
+
+    [[nodiscard]] std::string_view string(std::uint32_t index) const {
+        if (index >= m_header.strings) {
+            throw std::runtime_error("Compiled scenario string index out of range");
+        }
+        const auto *offsets = m_bytes.data() + m_layout.stringOffsets;
+        const auto begin = load<std::uint32_t>(offsets + index * sizeof(std::uint32_t));
+        const auto end = load<std::uint32_t>(offsets + (index + 1) * sizeof(std::uint32_t));
+        if (begin > end || end > m_header.stringBytes) {
+            throw std::runtime_error("Compiled scenario string table is corrupt");
+        }
+        return {reinterpret_cast<const char *>(m_bytes.data() + m_layout.stringChars + begin), end - begin};
+    }
+
+    [[nodiscard]] std::vector<std::uint8_t> blob(const BlobRef &ref) const {
+        if (ref.offset > m_header.arenaBytes || ref.size > m_header.arenaBytes - ref.offset) {
+            throw std::runtime_error("Compiled scenario payload out of range");
+        }
+        const auto *begin = reinterpret_cast<const std::uint8_t *>(m_bytes.data() + m_layout.arena + ref.offset);
+        return {begin, begin + ref.size};
+    }
+
+    [[nodiscard]] ScenarioEvent event(const EventRecord &record) const {
+        ScenarioEvent event{};
+        event.type = static_cast<ScenarioEvent::Type>(record.type);
+        event.label = string(record.label);
+        event.comId = record.comId;
+        event.datasetId = record.datasetId;
+        event.payload = blob(record.payload);
+        event.delay = std::chrono::milliseconds{record.delayMs};
+        event.generator.repeat = record.repeat;
+        event.generator.period = std::chrono::milliseconds{record.periodMs};
+        event.generator.rampStartHz = record.rampStartHz;
+        event.generator.rampEndHz = record.rampEndHz;
+        if (record.hasCounter != 0) {
+            PayloadCounter counter{};
+            counter.offset = record.counterOffset;
+            counter.width = record.counterWidth;
+            counter.start = record.counterStart;
+            counter.step = record.counterStep;
+            if (record.hasCounterEnd != 0) {
+                counter.end = record.counterEnd;
+            }
+            event.generator.counter = counter;
+        }
+        event.timeline = string(record.timeline);
+        event.fromState = record.fromState != 0;
+        event.field = string(record.field);
+        event.value = string(record.value);
+        return event;
+    }
+
+    [[nodiscard]] PayloadPredicate predicate(const PredicateRecord &record) const {
+        PayloadPredicate predicate;
+        if (record.hasMasked != 0) {
+            predicate.masked = MaskedMatch{record.maskedOffset, blob(record.mask), blob(record.value)};
+        }
+        if (record.hasField != 0) {
+            predicate.field = FieldMatch{record.fieldOffset, record.fieldWidth,
+                                         static_cast<FieldMatch::Op>(record.fieldOp), record.fieldValue,
+                                         record.fieldDatasetId, std::string{string(record.fieldName)}};
+        }
+        return predicate;
+    }
+
+private:
+    std::span<const std::byte> m_bytes;
+    FileHeader m_header;
+    Layout m_layout;
+};
+
+} // namespace
+
+void writeCompiledScenario(const std::filesystem::path &path, const Scenario &scenario, std::string_view checksum) {
+    if (checksum.size() > kChecksumCapacity) {
+        throw std::invalid_argument("Scenario checksum too long for a compiled scenario");
+    }
+    ImageBuilder builder;
+    FileHeader header{};
+    header.magic = kFileMagic;
+    std::memcpy(header.checksum.data(), checksum.data(), checksum.size());
+    header.seed = scenario.seed;
+    header.id = builder.intern(scenario.id);
+    header.deviceProfileId = builder.intern(scenario.deviceProfileId);
+
+    std::vector<EventRecord> events;
+    events.reserve(scenario.events.size());
+    for (const auto &event : scenario.events) {
+        events.push_back(builder.event(event));
+    }
+    std::vector<TimelineRecord> timelines;
+    for (const auto &timeline : scenario.timelines) {
+        timelines.push_back(TimelineRecord{builder.intern(timeline.name)});
+    }
+    std::vector<TriggerRecord> triggers;
+    for (const auto &trigger : scenario.triggers) {
+        TriggerRecord record{};
+        record.label = builder.intern(trigger.label);
+        record.on = static_cast<std::uint8_t>(trigger.on);
+        record.comId = trigger.comId;
+        record.deadlineMs = trigger.deadline.count();
+        record.predicate = builder.predicate(trigger.predicate);
+        record.action = builder.event(trigger.action);
+        triggers.push_back(record);
+    }
+    std::vector<ExpectationRecord> expectations;
+    for (const auto &expectation : scenario.expectations) {
+        ExpectationRecord record{};
+        record.label = builder.intern(expectation.label);
+        record.type = static_cast<std::uint8_t>(expectation.type);
+        record.comId = expectation.comId;
+        record.minCount = expectation.minCount;
+        record.hasMaxCount = expectation.maxCount ? 1 : 0;
+        record.maxCount = expectation.maxCount.value_or(0);
+        record.windowMs = expectation.window.count();
+        record.cycleMs = expectation.cycle.count();
+        record.cycleToleranceMs = expectation.cycleTolerance.count();
+        record.predicate = builder.predicate(expectation.predicate);
+        expectations.push_back(record);
+    }
+    std::vector<FaultRecord> faults;
+    for (const auto &fault : scenario.faults) {
+        faults.push_back(FaultRecord{fault.comId, 0, fault.loss, fault.duplicate, fault.reorder, fault.corrupt,
+                                     fault.delay.count(), fault.jitter.count()});
+    }
+    std::vector<LinkRecord> links;
+    for (const auto &link : scenario.network) {
+        links.push_back(LinkRecord{link.comId, static_cast<std::uint32_t>(link.distribution), link.latency.count(),
+                                   link.jitter.count(), link.bandwidth, link.queueLimit});
+    }
+
+    std::vector<std::uint32_t> stringOffsets;
+    stringOffsets.reserve(builder.strings().size() + 1);
+    std::uint64_t stringBytes = 0;
+    for (const auto &value : builder.strings()) {
+        stringOffsets.push_back(static_cast<std::uint32_t>(stringBytes));
+        stringBytes += value.size();
+    }
+    stringOffsets.push_back(static_cast<std::uint32_t>(stringBytes));
+    if (stringBytes > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::runtime_error("Scenario strings too large to compile: " + scenario.id);
+    }
+
+    header.strings = static_cast<std::uint32_t>(builder.strings().size());
+    header.events = static_cast<std::uint32_t>(events.size());
+    header.timelines = static_cast<std::uint32_t>(timelines.size());
+    header.triggers = static_cast<std::uint32_t>(triggers.size());
+    header.expectations = static_cast<std::uint32_t>(expectations.size());
+    header.faults = static_cast<std::uint32_t>(faults.size());
+    header.links = static_cast<std::uint32_t>(links.size());
+    header.stringBytes = stringBytes;
+    header.arenaBytes = builder.arena().size();
+
+    auto temporary = path;
+    temporary += ".tmp";
+    {
+        std::ofstream stream{temporary, std::ios::binary | std::ios::out | std::ios::trunc};
+        if (!stream) {
+            throw std::runtime_error("Failed to open compiled scenario file: " + temporary.string());
+        }
+        stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        writeTable(stream, stringOffsets);
+        writePadding(stream, stringOffsets.size() * sizeof(std::uint32_t));
+        for (const auto &value : builder.strings()) {
+            stream.write(value.data(), static_cast<std::streamsize>(value.size()));
+        }
+        writePadding(stream, stringBytes);
+        writeTable(stream, builder.arena());
+        writePadding(stream, builder.arena().size());
+        writeTable(stream, events);
+        writeTable(stream, timelines);
+        writeTable(stream, triggers);
+        writeTable(stream, expectations);
+        writeTable(stream, faults);
+        writeTable(stream, links);
+        if (!stream.flush()) {
+            throw std::runtime_error("Failed to write compiled scenario file: " + temporary.string());
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::filesystem::remove(temporary, error);
+        throw std::runtime_error("Failed to replace compiled scenario file: " + path.string());
+    }
+}
+
+CompiledScenario::CompiledScenario(const std::filesystem::path &path) : m_file(path) {
+    const auto bytes = m_file.bytes();
+    if (bytes.size() < sizeof(FileHeader) ||
+        std::memcmp(bytes.data(), kFileMagic.data(), kFileMagic.size()) != 0) {
+        throw std::runtime_error("Not a compiled scenario file: " + path.string());
+    }
+    const auto header = readHeader(bytes);
+    if (header.version != kFileVersion) {
+        throw std::runtime_error("Unsupported compiled scenario version: " + path.string());
+    }
+    if (header.strings == 0 || header.stringBytes > bytes.size() || header.arenaBytes > bytes.size() ||
+        layoutFor(header).end > bytes.size()) {
+        throw std::runtime_error("Truncated compiled scenario file: " + path.string());
+    }
+}
+
+std::string_view CompiledScenario::checksum() const noexcept {
+    const auto *data = reinterpret_cast<const char *>(m_file.bytes().data() + offsetof(FileHeader, checksum));
+    std::size_t size = 0;
+    while (size < kChecksumCapacity && data[size] != '\0') {
+        ++size;
+    }
+    return {data, size};
+}
+
+std::size_t CompiledScenario::eventCount() const noexcept {
+    return readHeader(m_file.bytes()).events;
+}
+
+std::string_view CompiledScenario::string(std::uint32_t index) const {
+    return ImageReader{m_file.bytes()}.string(index);
+}
+
+std::span<const std::uint8_t> CompiledScenario::arena() const noexcept {
+    const ImageReader reader{m_file.bytes()};
+    return {reinterpret_cast<const std::uint8_t *>(m_file.bytes().data() + reader.layout().arena),
+            static_cast<std::size_t>(reader.header().arenaBytes)};
+}
+
+Scenario CompiledScenario::toScenario() const {
+    const ImageReader reader{m_file.bytes()};
+    const auto &header = reader.header();
+    const auto &layout = reader.layout();
+
+    Scenario scenario{};
+    scenario.id = reader.string(header.id);
+    scenario.deviceProfileId = reader.string(header.deviceProfileId);
+    scenario.seed = header.seed;
+    scenario.events.reserve(header.events);
+    for (std::size_t i = 0; i < header.events; ++i) {
+        scenario.events.push_back(reader.event(reader.record<EventRecord>(layout.events, i)));
+    }
+    scenario.timelines.reserve(header.timelines);
+    for (std::size_t i = 0; i < header.timelines; ++i) {
+        const auto record = reader.record<TimelineRecord>(layout.timelines, i);
+        scenario.timelines.push_back(ScenarioTimeline{std::string{reader.string(record.name)}});
+    }
+    scenario.triggers.reserve(header.triggers);
+    for (std::size_t i = 0; i < header.triggers; ++i) {
+        const auto record = reader.record<TriggerRecord>(layout.triggers, i);
+        ScenarioTrigger trigger{};
+        trigger.label = reader.string(record.label);
+        trigger.on = static_cast<ScenarioEvent::Type>(record.on);
+        trigger.comId = record.comId;
+        trigger.predicate = reader.predicate(record.predicate);
+        trigger.action = reader.event(record.action);
+        trigger.deadline = std::chrono::milliseconds{record.deadlineMs};
+        scenario.triggers.push_back(std::move(trigger));
+    }
+    scenario.expectations.reserve(header.expectations);
+    for (std::size_t i = 0; i < header.expectations; ++i) {
+        const auto record = reader.record<ExpectationRecord>(layout.expectations, i);
+        ScenarioExpectation expectation{};
+        expectation.label = reader.string(record.label);
+        expectation.type = static_cast<ScenarioEvent::Type>(record.type);
+        expectation.comId = record.comId;
+        expectation.minCount = record.minCount;
+        if (record.hasMaxCount != 0) {
+            expectation.maxCount = record.maxCount;
+        }
+        expectation.window = std::chrono::milliseconds{record.windowMs};
+        expectation.predicate = reader.predicate(record.predicate);
+        expectation.cycle = std::chrono::milliseconds{record.cycleMs};
+        expectation.cycleTolerance = std::chrono::milliseconds{record.cycleToleranceMs};
+        scenario.expectations.push_back(std::move(expectation));
+    }
+    scenario.faults.reserve(header.faults);
+    for (std::size_t i = 0; i < header.faults; ++i) {
+        const auto record = reader.record<FaultRecord>(layout.faults, i);
+        communication::FaultProfile fault{};
+        fault.comId = record.comId;
+        fault.loss = record.loss;
+        fault.duplicate = record.duplicate;
+        fault.reorder = record.reorder;
+        fault.corrupt = record.corrupt;
+        fault.delay = std::chrono::microseconds{record.delayUs};
+        fault.jitter = std::chrono::microseconds{record.jitterUs};
+        scenario.faults.push_back(fault);
+    }
+    scenario.network.reserve(header.links);
+    for (std::size_t i = 0; i < header.links; ++i) {
+        const auto record = reader.record<LinkRecord>(layout.links, i);
+        communication::LinkProfile link{};
+        link.comId = record.comId;
+        link.distribution = static_cast<communication::LatencyDistribution>(record.distribution);
+        link.latency = std::chrono::microseconds{record.latencyUs};
+        link.jitter = std::chrono::microseconds{record.jitterUs};
+        link.bandwidth = record.bandwidth;
+        link.queueLimit = static_cast<std::size_t>(record.queueLimit);
+        scenario.network.push_back(link);
+    }
+    return scenario;
+}
+
+} // namespace trdp::simulation
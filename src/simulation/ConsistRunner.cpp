@@ -0,0 +1,348 @@
+#include "trdp_simulator/simulation/ConsistRunner.hpp"
+
+#include "trdp_simulator/communication/Fabric.hpp"
+#include "trdp_simulator/communication/FaultInjectingAdapter.hpp"
+#include "trdp_simulator/communication/FabricStackAdapter.hpp"
+#include "trdp_simulator/communication/NetworkEmulationAdapter.hpp"
+#include "trdp_simulator/communication/Wrapper.hpp"
+#include "trdp_simulator/simulation/DeviceStateStore.hpp"
+#include "trdp_simulator/simulation/Engine.hpp"
+#include "trdp_simulator/simulation/EventStream.hpp"
+#include "trdp_simulator/simulation/ScenarioYaml.hpp"
+#include "trdp_simulator/simulation/TimelineScheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <latch>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#endif
+
+namespace trdp::simulation {
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+[[nodiscard]] std::chrono::nanoseconds threadCpuTime() {
+#if defined(__linux__)
+    timespec ts{};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+        return std::chrono::seconds{ts.tv_sec} + std::chrono::nanoseconds{ts.tv_nsec};
+    }
+#endif
+    return std::chrono::nanoseconds{0};
+}
+
+void pinToCore(std::size_t shard) {
+#if defined(__linux__)
+    const auto cores = std::max(1u, std::thread::hardware_concurrency());
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<int>(shard % cores), &set);
+    // Pinning is best effort: containers may restrict the allowed CPU set.
+    (void)pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)shard;
+#endif
+}
+
+[[nodiscard]] int currentCpu() {
+#if defined(__linux__)
+    return sched_getcpu();
+#else
+    return -1;
+#endif
+}
+
+/// Message of the exception being handled; call only from a catch block.
+[[nodiscard]] std::string currentFailure() {
+    try {
+        throw;
+    } catch (const std::exception &ex) {
+        return ex.what();
+    } catch (...) {
+        return "unknown failure";
+    }
+}
+
+/// Endpoint state owned by one shard thread.
+struct Endpoint {
+    const ConsistMember *member{nullptr};
+    MemberReport *report{nullptr};
+    std::vector<TimelinePlan> plans;
+    std::shared_ptr<communication::FabricStackAdapter> adapter;
+    std::unique_ptr<communication::Wrapper> wrapper;
+    TimelineEmitter emit;
+};
+
+} // namespace
+
+double ShardReport::utilisation() const noexcept {
+    if (wallTime.count() <= 0) {
+        return 0.0;
+    }
+    return static_cast<double>(cpuTime.count()) / static_cast<double>(wallTime.count());
+}
+
+bool ConsistReport::success() const noexcept {
+    const auto clean = [](const auto &report) { return report.failures.empty(); };
+    return std::all_of(shards.begin(), shards.end(), clean) && std::all_of(members.begin(), members.end(), clean);
+}
+
+ConsistDefinition loadConsistDefinition(const std::filesystem::path &path) {
+    std::ifstream stream{path};
+    if (!stream) {
+        throw ScenarioValidationError{"Failed to open consist file: " + path.string()};
+    }
+
+    ConsistDefinition definition{};
+    definition.id = path.stem().string();
+    bool inMembers = false;
+    bool itemActive = false;
+    ConsistMemberRef current{};
+
+    const auto finaliseMember = [&]() {
+        if (!itemActive) {
+            return;
+        }
+        if (current.scenarioId.empty()) {
+            throw ScenarioValidationError{"Consist member is missing a scenario"};
+        }
+        if (current.endpoint.empty()) {
+            current.endpoint = current.scenarioId;
+        }
+        definition.members.push_back(current);
+        current = ConsistMemberRef{};
+        itemActive = false;
+    };
+
+    std::string rawLine;
+    while (std::getline(stream, rawLine)) {
+        auto trimmed = scenario_yaml::trim(rawLine);
+        if (trimmed.empty() || trimmed.starts_with('#')) {
+            continue;
+        }
+        if (trimmed == "members:") {
+            inMembers = true;
+            continue;
+        }
+        if (!inMembers) {
+            const auto [key, value] = scenario_yaml::parseKeyValue(trimmed);
+            if (key == "consist") {
+                definition.id = value;
+            } else if (key == "shards") {
+                definition.shards = static_cast<std::size_t>(std::stoul(value));
+            } else {
+                throw ScenarioValidationError{"Unknown consist field: " + key};
+            }
+            continue;
+        }
+        if (trimmed.starts_with('-')) {
+            finaliseMember();
+            itemActive = true;
+            trimmed = scenario_yaml::trim(trimmed.substr(1));
+            if (trimmed.empty()) {
+                continue;
+            }
+        } else if (!itemActive) {
+            throw ScenarioValidationError{"Consist member field defined outside of list: " + trimmed};
+        }
+        const auto [key, value] = scenario_yaml::parseKeyValue(trimmed);
+        if (key == "scenario") {
+            current.scenarioId = value;
+        } else if (key == "endpoint") {
+            current.endpoint = value;
+        } else {
+            throw ScenarioValidationError{"Unknown consist member field: " + key};
+        }
+    }
+    finaliseMember();
+
+    if (definition.members.empty()) {
+        throw ScenarioValidationError{"Consist does not contain any members"};
+    }
+    return definition;
+}
+
+ConsistRunner::ConsistRunner(ConsistOptions options) : m_options(options) {}
+
+void ConsistRunner::addMember(ConsistMember member) {
+    if (!member.scenario) {
+        throw std::invalid_argument("Consist member '" + member.endpoint + "' has no scenario");
+    }
+    if (member.endpoint.empty()) {
+        member.endpoint = member.scenario->id;
+    }
+    if (member.scenario->events.empty()) {
+        throw std::invalid_argument("Consist member '" + member.endpoint + "' has no events");
+    }
+    if (!member.state && usesDeviceState(*member.scenario)) {
+        throw std::invalid_argument("Consist member '" + member.endpoint + "' requires device state");
+    }
+    m_members.push_back(std::move(member));
+}
+
+ConsistReport ConsistRunner::run() {
+    if (m_members.empty()) {
+        throw std::logic_error("Consist has no members");
+    }
+    std::size_t shardCount = m_options.shards != 0 ? m_options.shards : std::thread::hardware_concurrency();
+    shardCount = std::clamp<std::size_t>(shardCount, 1, m_members.size());
+
+    communication::Fabric fabric{m_options.inboxCapacity};
+    std::vector<std::size_t> ports;
+    ports.reserve(m_members.size());
+    for (const auto &member : m_members) {
+        ports.push_back(fabric.attach(member.endpoint, member.subscriptions));
+    }
+    fabric.seal();
+
+    ConsistReport report{};
+    report.shards.resize(shardCount);
+    report.members.resize(m_members.size());
+    for (std::size_t i = 0; i < m_members.size(); ++i) {
+        report.members[i].endpoint = m_members[i].endpoint;
+    }
+    std::latch ready{static_cast<std::ptrdiff_t>(shardCount)};
+    std::atomic<std::size_t> finished{0};
+
+    const auto runShard = [&](std::size_t shardIndex) {
+        auto &shard = report.shards[shardIndex];
+        shard.index = shardIndex;
+        if (m_options.pinThreads) {
+            pinToCore(shardIndex);
+        }
+
+        // Endpoints are built on the shard thread so their state is only ever touched by that thread.
+        std::vector<Endpoint> endpoints;
+        const auto pollAll = [&]() {
+            for (auto &endpoint : endpoints) {
+                endpoint.wrapper->poll();
+            }
+        };
+
+        try {
+            for (std::size_t i = shardIndex; i < m_members.size(); i += shardCount) {
+                auto &endpoint = endpoints.emplace_back();
+                endpoint.member = &m_members[i];
+                endpoint.report = &report.members[i];
+                endpoint.plans = planTimelines(*m_members[i].scenario);
+                endpoint.adapter = std::make_shared<communication::FabricStackAdapter>(fabric, ports[i]);
+                std::shared_ptr<communication::StackAdapter> stack = endpoint.adapter;
+                const auto &scenario = *m_members[i].scenario;
+                if (!scenario.network.empty()) {
+                    stack = std::make_shared<communication::NetworkEmulationAdapter>(stack, scenario.network,
+                                                                                      scenario.seed);
+                }
+                if (!scenario.faults.empty()) {
+                    stack = std::make_shared<communication::FaultInjectingAdapter>(stack, scenario.faults,
+                                                                                    scenario.seed);
+                }
+                endpoint.wrapper = std::make_unique<communication::Wrapper>(m_members[i].endpoint, stack);
+            }
+            shard.members = endpoints.size();
+            for (auto &endpoint : endpoints) {
+                endpoint.wrapper->open();
+                auto &wrapper = *endpoint.wrapper;
+                auto *state = endpoint.member->state.get();
+                auto &failures = endpoint.report->failures;
+                // A failed send stops only this member; the other members of the shard keep running.
+                endpoint.emit = [&wrapper, state, &failures](const TimelinePlan &, const EventEmission &emission) {
+                    if (!failures.empty()) {
+                        return;
+                    }
+                    try {
+                        sendScenarioEvent(wrapper, *emission.event, *emission.payload, state);
+                        wrapper.poll();
+                    } catch (...) {
+                        failures.push_back(currentFailure());
+                    }
+                };
+            }
+        } catch (...) {
+            shard.failures.push_back(currentFailure());
+            endpoints.clear();
+        }
+
+        ready.arrive_and_wait();
+        const auto wallStart = Clock::now();
+        const auto cpuStart = threadCpuTime();
+
+        if (shard.failures.empty()) {
+            try {
+                TimelineScheduler scheduler;
+                for (const auto &endpoint : endpoints) {
+                    for (const auto &plan : endpoint.plans) {
+                        scheduler.spawn(playTimeline(scheduler, plan, wallStart, endpoint.emit));
+                    }
+                }
+                scheduler.run([&](Clock::time_point deadline) {
+                    while (true) {
+                        pollAll();
+                        const auto now = Clock::now();
+                        if (now >= deadline) {
+                            break;
+                        }
+                        const Clock::duration remaining = deadline - now;
+                        std::this_thread::sleep_for(std::min<Clock::duration>(remaining, m_options.pollInterval));
+                    }
+                });
+            } catch (...) {
+                shard.failures.push_back(currentFailure());
+            }
+        }
+
+        // Keep receiving until every shard has stopped sending, then drain once more.
+        finished.fetch_add(1, std::memory_order_acq_rel);
+        try {
+            while (finished.load(std::memory_order_acquire) < shardCount) {
+                pollAll();
+                std::this_thread::sleep_for(m_options.pollInterval);
+            }
+            pollAll();
+        } catch (...) {
+            shard.failures.push_back(currentFailure());
+        }
+
+        shard.cpuTime = threadCpuTime() - cpuStart;
+        shard.wallTime = Clock::now() - wallStart;
+        shard.cpu = currentCpu();
+        for (auto &endpoint : endpoints) {
+            shard.sent += endpoint.adapter->sent();
+            shard.received += endpoint.adapter->received();
+            shard.latency.merge(endpoint.adapter->latency());
+            if (endpoint.wrapper->isOpen()) {
+                try {
+                    endpoint.wrapper->close();
+                } catch (...) {
+                    shard.failures.push_back(currentFailure());
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(shardCount);
+    for (std::size_t i = 0; i < shardCount; ++i) {
+        threads.emplace_back(runShard, i);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (const auto &shard : report.shards) {
+        report.latency.merge(shard.latency);
+    }
+    report.dropped = fabric.dropped();
+    return report;
+}
+
+} // namespace trdp::simulation
@@ -0,0 +1,259 @@
+#include "trdp_simulator/simulation/ContentHash.hpp"
+
+#include "trdp_simulator/simulation/MappedFile.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TRDP_SIM_HAVE_POSIX_IO 1
+#endif
+
+namespace trdp::simulation {
+namespace {
+
+constexpr std::uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+constexpr std::uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+constexpr std::uint64_t kPrime3 = 0x165667B19E3779F9ull;
+constexpr std::uint64_t kPrime4 = 0x85EBCA77C2B2AE63ull;
+constexpr std::uint64_t kPrime5 = 0x27D4EB2F165667C5ull;
+
+/// Files below this size are copied through a buffer rather than mapped.
+constexpr std::size_t kMapThreshold = 256 * 1024;
+constexpr std::size_t kCopyBufferSize = 64 * 1024;
+
+/// Little-endian load; compilers turn the loop into one load on little-endian targets.
+template <typename T>
+[[nodiscard]] T load(const std::byte *data) noexcept {
+    T value = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        value |= static_cast<T>(std::to_integer<std::uint8_t>(data[i])) << (8 * i);
+    }
+    return value;
+}
+
+[[nodiscard]] std::uint64_t roundLane(std::uint64_t lane, std::uint64_t input) noexcept {
+    lane += input * kPrime2;
+    return std::rotl(lane, 31) * kPrime1;
+}
+
+[[nodiscard]] std::uint64_t mergeRound(std::uint64_t hash, std::uint64_t lane) noexcept {
+    hash ^= roundLane(0, lane);
+    return hash * kPrime1 + kPrime4;
+}
+
+/// Consumes every whole 32-byte stripe of @p data; returns the number of bytes consumed.
+std::size_t consumeStripes(std::array<std::uint64_t, 4> &lanes, const std::byte *data, std::size_t size) noexcept {
+    const std::byte *const begin = data;
+    for (; size >= 32; data += 32, size -= 32) {
+        lanes[0] = roundLane(lanes[0], load<std::uint64_t>(data));
+        lanes[1] = roundLane(lanes[1], load<std::uint64_t>(data + 8));
+        lanes[2] = roundLane(lanes[2], load<std::uint64_t>(data + 16));
+        lanes[3] = roundLane(lanes[3], load<std::uint64_t>(data + 24));
+    }
+    return static_cast<std::size_t>(data - begin);
+}
+
+[[nodiscard]] std::string formatChecksum(std::uint64_t digest) {
+    constexpr char kDigits[] = "0123456789abcdef";
+    std::string checksum{kChecksumPrefix};
+    for (int shift = 60; shift >= 0; shift -= 4) {
+        checksum.push_back(kDigits[(digest >> shift) & 0xF]);
+    }
+    return checksum;
+}
+
+#ifdef TRDP_SIM_HAVE_POSIX_IO
+
+void writeAll(int fd, std::span<const std::byte> data, const std::filesystem::path &path) {
+    while (!data.empty()) {
+        const auto written = ::write(fd, data.data(), data.size());
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Failed to write " + path.string());
+        }
+        data = data.subspan(static_cast<std::size_t>(written));
+    }
+}
+
+/// Copies the file open as @p in, whose contents @p data maps, into @p out; writes from @p data whatever the kernel
+/// cannot copy.
+void copyContents(int in, std::span<const std::byte> data, int out, const std::filesystem::path &to) {
+    std::size_t copied = 0;
+#ifdef __linux__
+    while (copied < data.size()) {
+        const auto result = ::copy_file_range(in, nullptr, out, nullptr, data.size() - copied, 0);
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result <= 0) {
+            // Unsupported here (another file system, an old kernel); the rest comes from the mapping.
+            break;
+        }
+        copied += static_cast<std::size_t>(result);
+    }
+#else
+    (void)in;
+#endif
+    writeAll(out, data.subspan(copied), to);
+}
+
+#endif
+
+} // namespace
+
+Xxh64::Xxh64(std::uint64_t seed) noexcept
+    : m_lanes{seed + kPrime1 + kPrime2, seed + kPrime2, seed, seed - kPrime1}, m_seed(seed) {}
+
+void Xxh64::update(std::span<const std::byte> data) noexcept {
+    if (data.empty()) {
+        return;
+    }
+    m_totalSize += data.size();
+    if (m_pendingSize > 0) {
+        const auto take = std::min(data.size(), m_pending.size() - m_pendingSize);
+        std::memcpy(m_pending.data() + m_pendingSize, data.data(), take);
+        m_pendingSize += take;
+        data = data.subspan(take);
+        if (m_pendingSize < m_pending.size()) {
+            return;
+        }
+        (void)consumeStripes(m_lanes, m_pending.data(), m_pending.size());
+        m_pendingSize = 0;
+    }
+    data = data.subspan(consumeStripes(m_lanes, data.data(), data.size()));
+    std::memcpy(m_pending.data(), data.data(), data.size());
+    m_pendingSize = data.size();
+}
+
+std::uint64_t Xxh64::digest() const noexcept {
+    std::uint64_t hash = 0;
+    if (m_totalSize >= 32) {
+        hash = std::rotl(m_lanes[0], 1) + std::rotl(m_lanes[1], 7) + std::rotl(m_lanes[2], 12) +
+               std::rotl(m_lanes[3], 18);
+        for (const auto lane : m_lanes) {
+            hash = mergeRound(hash, lane);
+        }
+    } else {
+        hash = m_seed + kPrime5;
+    }
+    hash += m_totalSize;
+
+    const std::byte *data = m_pending.data();
+    std::size_t size = m_pendingSize;
+    for (; size >= 8; data += 8, size -= 8) {
+        hash ^= roundLane(0, load<std::uint64_t>(data));
+        hash = std::rotl(hash, 27) * kPrime1 + kPrime4;
+    }
+    if (size >= 4) {
+        hash ^= load<std::uint32_t>(data) * kPrime1;
+        hash = std::rotl(hash, 23) * kPrime2 + kPrime3;
+        data += 4;
+        size -= 4;
+    }
+    for (; size > 0; ++data, --size) {
+        hash ^= std::to_integer<std::uint8_t>(*data) * kPrime5;
+        hash = std::rotl(hash, 11) * kPrime1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= kPrime2;
+    hash ^= hash >> 29;
+    hash *= kPrime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+std::uint64_t Xxh64::hash(std::string_view data, std::uint64_t seed) noexcept {
+    Xxh64 hasher{seed};
+    hasher.update(data);
+    return hasher.digest();
+}
+
+std::string contentChecksum(std::string_view contents) {
+    return formatChecksum(Xxh64::hash(contents));
+}
+
+std::string fileChecksum(const std::filesystem::path &path) {
+    const MappedFile file{path};
+    Xxh64 hasher;
+    hasher.update(file.bytes());
+    return formatChecksum(hasher.digest());
+}
+
+std::string copyFileWithChecksum(const std::filesystem::path &from, const std::filesystem::path &to) {
+    std::error_code ignored;
+    if (std::filesystem::equivalent(from, to, ignored)) {
+        // Truncating the destination would truncate the source.
+        throw std::runtime_error("Cannot copy " + from.string() + " onto itself");
+    }
+    std::filesystem::remove(to, ignored);
+    Xxh64 hasher;
+#ifdef TRDP_SIM_HAVE_POSIX_IO
+    const int in = ::open(from.c_str(), O_RDONLY | O_CLOEXEC);
+    if (in < 0) {
+        throw std::runtime_error("Failed to open " + from.string());
+    }
+    const int out = ::open(to.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (out < 0) {
+        ::close(in);
+        throw std::runtime_error("Failed to open " + to.string());
+    }
+    try {
+        struct stat info {};
+        if (::fstat(in, &info) != 0) {
+            throw std::runtime_error("Failed to stat " + from.string());
+        }
+        if (static_cast<std::size_t>(info.st_size) < kMapThreshold) {
+            // Setting up and tearing down a mapping costs more than one buffered pass over a small file.
+            std::array<std::byte, kCopyBufferSize> buffer;
+            for (;;) {
+                const auto count = ::read(in, buffer.data(), buffer.size());
+                if (count < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (count < 0) {
+                    throw std::runtime_error("Failed to read " + from.string());
+                }
+                if (count == 0) {
+                    break;
+                }
+                const std::span<const std::byte> chunk{buffer.data(), static_cast<std::size_t>(count)};
+                hasher.update(chunk);
+                writeAll(out, chunk, to);
+            }
+        } else {
+            const MappedFile source{from};
+            hasher.update(source.bytes());
+            copyContents(in, source.bytes(), out, to);
+        }
+    } catch (...) {
+        ::close(in);
+        ::close(out);
+        throw;
+    }
+    ::close(in);
+    ::close(out);
+#else
+    const MappedFile source{from};
+    hasher.update(source.bytes());
+    std::ofstream stream{to, std::ios::binary | std::ios::trunc};
+    const auto text = source.text();
+    if (!stream.write(text.data(), static_cast<std::streamsize>(text.size())).flush()) {
+        throw std::runtime_error("Failed to write " + to.string());
+    }
+#endif
+    return formatChecksum(hasher.digest());
+}
+
+} // namespace trdp::simulation
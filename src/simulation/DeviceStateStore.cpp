@@ -0,0 +1,184 @@
+#include "trdp_simulator/simulation/DeviceStateStore.hpp"
+
+#include <bit>
+#include <charconv>
+#include <stdexcept>
+#include <string>
+
+namespace trdp::simulation {
+namespace {
+
+constexpr std::uint32_t kBool8 = 1;
+constexpr std::uint32_t kReal32 = 12;
+constexpr std::uint32_t kReal64 = 13;
+
+[[nodiscard]] std::invalid_argument invalidValue(std::string_view value) {
+    return std::invalid_argument("Invalid state value: " + std::string{value});
+}
+
+template <typename T>
+[[nodiscard]] T parseNumber(std::string_view value, int base = 10) {
+    T result{};
+    const auto *end = value.data() + value.size();
+    const auto [ptr, ec] = std::from_chars(value.data(), end, result, base);
+    if (ec != std::errc{} || ptr != end) {
+        throw invalidValue(value);
+    }
+    return result;
+}
+
+[[nodiscard]] double parseReal(std::string_view value) {
+    double result{};
+    const auto *end = value.data() + value.size();
+    const auto [ptr, ec] = std::from_chars(value.data(), end, result);
+    if (ec != std::errc{} || ptr != end) {
+        throw invalidValue(value);
+    }
+    return result;
+}
+
+void storeBigEndian(DeviceStateStore::EncodedValue &encoded, std::uint64_t raw, std::size_t size) {
+    encoded.size = size;
+    for (std::size_t i = 0; i < size; ++i) {
+        encoded.bytes[size - 1 - i] = static_cast<std::uint8_t>(raw >> (8 * i));
+    }
+}
+
+} // namespace
+
+DeviceStateStore::DeviceStateStore(const device::DeviceConfig &config) {
+    m_slots.reserve(config.datasets.size());
+    for (const auto &dataset : config.datasets) {
+        auto layout = device::DatasetLayout::compile(config, dataset.id);
+        const auto size = layout.size();
+        m_index.emplace(dataset.id, m_slots.size());
+        m_slots.push_back(std::unique_ptr<Slot>(new Slot{std::move(layout), communication::SeqlockBuffer{size}}));
+    }
+}
+
+bool DeviceStateStore::contains(std::uint32_t datasetId) const noexcept {
+    return m_index.contains(datasetId);
+}
+
+const DeviceStateStore::Slot &DeviceStateStore::slot(std::uint32_t datasetId) const {
+    const auto it = m_index.find(datasetId);
+    if (it == m_index.end()) {
+        throw std::out_of_range("Device state has no data set " + std::to_string(datasetId));
+    }
+    return *m_slots[it->second];
+}
+
+const device::DatasetLayout &DeviceStateStore::layout(std::uint32_t datasetId) const {
+    return slot(datasetId).layout;
+}
+
+DeviceStateStore::FieldRef DeviceStateStore::resolve(std::uint32_t datasetId, std::string_view field) const {
+    const auto &target = slot(datasetId);
+    const auto &layout = target.layout;
+    std::size_t index = 0;
+    const auto *element = layout.find(field);
+    if (element == nullptr && field.ends_with(']')) {
+        const auto open = field.rfind('[');
+        if (open != std::string_view::npos) {
+            element = layout.find(field.substr(0, open));
+            const auto digits = field.substr(open + 1, field.size() - open - 2);
+            const auto [ptr, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), index);
+            if (ec != std::errc{} || ptr != digits.data() + digits.size()) {
+                element = nullptr;
+            }
+        }
+    }
+    if (element == nullptr) {
+        throw std::out_of_range("Data set " + std::to_string(datasetId) + " has no field '" + std::string{field} +
+                                "'");
+    }
+    if (index >= element->count) {
+        throw std::out_of_range("Field '" + std::string{field} + "' index out of range");
+    }
+    return FieldRef{m_index.at(datasetId), element->offset + index * element->size, element->size, element->type};
+}
+
+DeviceStateStore::EncodedValue DeviceStateStore::encode(const FieldRef &field, std::string_view value) {
+    EncodedValue encoded{};
+    if (field.type == kBool8) {
+        if (value == "true" || value == "1") {
+            storeBigEndian(encoded, 1, field.size);
+        } else if (value == "false" || value == "0") {
+            storeBigEndian(encoded, 0, field.size);
+        } else {
+            throw invalidValue(value);
+        }
+        return encoded;
+    }
+    if (field.type == kReal32) {
+        storeBigEndian(encoded, std::bit_cast<std::uint32_t>(static_cast<float>(parseReal(value))),
+                       field.size);
+        return encoded;
+    }
+    if (field.type == kReal64) {
+        storeBigEndian(encoded, std::bit_cast<std::uint64_t>(parseReal(value)), field.size);
+        return encoded;
+    }
+    const auto bits = 8 * field.size;
+    if (device::isSignedType(field.type) && !value.starts_with("0x")) {
+        const auto number = parseNumber<std::int64_t>(value);
+        if (bits < 64) {
+            const auto limit = std::int64_t{1} << (bits - 1);
+            if (number < -limit || number >= limit) {
+                throw std::invalid_argument("State value out of range: " + std::string{value});
+            }
+        }
+        storeBigEndian(encoded, static_cast<std::uint64_t>(number), field.size);
+        return encoded;
+    }
+    const auto number = value.starts_with("0x") ? parseNumber<std::uint64_t>(value.substr(2), 16)
+                                                : parseNumber<std::uint64_t>(value);
+    if (bits < 64 && number >= (std::uint64_t{1} << bits)) {
+        throw std::invalid_argument("State value out of range: " + std::string{value});
+    }
+    storeBigEndian(encoded, number, field.size);
+    return encoded;
+}
+
+void DeviceStateStore::write(const FieldRef &field, const EncodedValue &value) {
+    std::lock_guard lock{m_writeMutex};
+    m_slots.at(field.slot)->buffer.write(field.offset, std::span{value.bytes.data(), value.size});
+}
+
+void DeviceStateStore::set(std::uint32_t datasetId, std::string_view field, std::string_view value) {
+    const auto ref = resolve(datasetId, field);
+    write(ref, encode(ref, value));
+}
+
+std::uint64_t DeviceStateStore::snapshot(std::uint32_t datasetId, std::vector<std::uint8_t> &out) const {
+    const auto &target = slot(datasetId);
+    out.resize(target.buffer.size());
+    return target.buffer.read(out);
+}
+
+bool usesDeviceState(const Scenario &scenario) noexcept {
+    const auto usesState = [](const ScenarioEvent &event) {
+        return event.type == ScenarioEvent::Type::StateUpdate || event.fromState;
+    };
+    for (const auto &event : scenario.events) {
+        if (usesState(event)) {
+            return true;
+        }
+    }
+    const auto namesField = [](const PayloadPredicate &predicate) {
+        return predicate.field && predicate.field->named();
+    };
+    for (const auto &trigger : scenario.triggers) {
+        if (usesState(trigger.action) || namesField(trigger.predicate)) {
+            return true;
+        }
+    }
+    for (const auto &expectation : scenario.expectations) {
+        if (namesField(expectation.predicate)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace trdp::simulation
@@ -1,19 +1,32 @@
 #include "trdp_simulator/simulation/Engine.hpp"
 
 #include "trdp_simulator/communication/Types.hpp"
+#include "trdp_simulator/simulation/BlobStore.hpp"
+#include "trdp_simulator/simulation/DeviceStateStore.hpp"
+#include "trdp_simulator/simulation/EventStream.hpp"
+#include "trdp_simulator/simulation/ExpectationMonitor.hpp"
+#include "trdp_simulator/simulation/HexCodec.hpp"
+#include "trdp_simulator/simulation/RunCapture.hpp"
 #include "trdp_simulator/simulation/ScenarioRepository.hpp"
 #include "trdp_simulator/simulation/ScenarioYaml.hpp"
+#include "trdp_simulator/simulation/TimelineScheduler.hpp"
+#include "trdp_simulator/simulation/TriggerTable.hpp"
 
+#include <algorithm>
+#include <charconv>
 #include <chrono>
 #include <cctype>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iomanip>
+#include <memory>
 #include <sstream>
 #include <optional>
 #include <stdexcept>
 #include <string_view>
 #include <thread>
+#include <vector>
 
 namespace trdp::simulation {
 
@@ -69,29 +82,135 @@ namespace {
     if (payload.empty()) {
         return "";
     }
-    std::ostringstream oss;
-    oss << "0x";
-    oss << std::hex << std::setfill('0');
-    for (std::uint8_t byte : payload) {
-        oss << std::setw(2) << static_cast<int>(byte);
+    return "0x" + hex::encode(payload);
+}
+
+void writePredicate(std::ostream &stream, const PayloadPredicate &predicate) {
+    if (predicate.masked) {
+        const auto &masked = *predicate.masked;
+        stream << "    match_offset: " << masked.offset << '\n';
+        if (!masked.mask.empty()) {
+            stream << "    match_mask: " << payloadToString(masked.mask) << '\n';
+        }
+        stream << "    match_value: " << payloadToString(masked.value) << '\n';
+    }
+    if (predicate.field) {
+        const auto &field = *predicate.field;
+        if (field.named()) {
+            stream << "    field_dataset_id: " << field.datasetId << '\n';
+            stream << "    field_name: " << field.name << '\n';
+        } else {
+            stream << "    field_offset: " << field.offset << '\n';
+            stream << "    field_width: " << static_cast<unsigned>(field.width) << '\n';
+        }
+        stream << "    field_op: " << scenario_yaml::fieldOpName(field.op) << '\n';
+        stream << "    field_value: " << field.value << '\n';
     }
-    return oss.str();
 }
 
-void writeScenarioFile(const std::filesystem::path &path, const Scenario &scenario) {
-    std::ofstream stream{path, std::ios::trunc};
+void writeStateFields(std::ostream &stream, const ScenarioEvent &event) {
+    if (event.fromState) {
+        stream << "    source: state\n";
+    }
+    if (event.type == ScenarioEvent::Type::StateUpdate) {
+        stream << "    field: " << event.field << '\n';
+        stream << "    value: " << event.value << '\n';
+    }
+}
+
+void writeExpectations(std::ostream &stream, const std::vector<ScenarioExpectation> &expectations) {
+    if (expectations.empty()) {
+        return;
+    }
+    stream << "expect:\n";
+    for (const auto &expectation : expectations) {
+        stream << "  - label: " << expectation.label << '\n';
+        stream << "    type: " << scenario_yaml::typeName(expectation.type) << '\n';
+        stream << "    com_id: " << expectation.comId << '\n';
+        stream << "    min_count: " << expectation.minCount << '\n';
+        if (expectation.maxCount) {
+            stream << "    max_count: " << *expectation.maxCount << '\n';
+        }
+        if (expectation.window.count() > 0) {
+            stream << "    within_ms: " << expectation.window.count() << '\n';
+        }
+        writePredicate(stream, expectation.predicate);
+        if (expectation.cycle.count() > 0) {
+            stream << "    cycle_ms: " << expectation.cycle.count() << '\n';
+            stream << "    cycle_tolerance_ms: " << expectation.cycleTolerance.count() << '\n';
+        }
+    }
+}
+
+void writeFaults(std::ostream &stream, const std::vector<communication::FaultProfile> &faults) {
+    if (faults.empty()) {
+        return;
+    }
+    stream << "faults:\n";
+    for (const auto &fault : faults) {
+        stream << "  - com_id: " << fault.comId << '\n';
+        const auto writeProbability = [&](const char *key, double value) {
+            if (value > 0.0) {
+                // Shortest round-trip form, so a replayed run draws exactly the same faults.
+                char buffer[32];
+                const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+                stream << "    " << key << ": " << std::string_view(buffer, result.ptr - buffer) << '\n';
+            }
+        };
+        writeProbability("loss", fault.loss);
+        writeProbability("duplicate", fault.duplicate);
+        writeProbability("reorder", fault.reorder);
+        writeProbability("corrupt", fault.corrupt);
+        if (fault.delay.count() > 0) {
+            stream << "    delay_us: " << fault.delay.count() << '\n';
+        }
+        if (fault.jitter.count() > 0) {
+            stream << "    jitter_us: " << fault.jitter.count() << '\n';
+        }
+    }
+}
+
+void writeNetwork(std::ostream &stream, const std::vector<communication::LinkProfile> &links) {
+    if (links.empty()) {
+        return;
+    }
+    stream << "network:\n";
+    for (const auto &link : links) {
+        stream << "  - com_id: " << link.comId << '\n';
+        stream << "    distribution: " << communication::latencyDistributionName(link.distribution) << '\n';
+        stream << "    latency_us: " << link.latency.count() << '\n';
+        if (link.jitter.count() > 0) {
+            stream << "    jitter_us: " << link.jitter.count() << '\n';
+        }
+        if (link.bandwidth > 0) {
+            stream << "    bandwidth_kbps: " << link.bandwidth / 1000 << '\n';
+        }
+        if (link.queueLimit > 0) {
+            stream << "    queue_limit: " << link.queueLimit << '\n';
+        }
+    }
+}
+
+void writeScenario(std::ostream &stream, const Scenario &scenario) {
     stream << "scenario: " << scenario.id << '\n';
     stream << "device: " << scenario.deviceProfileId << '\n';
+    if (scenario.seed != 0) {
+        stream << "seed: " << scenario.seed << '\n';
+    }
     stream << "events:\n";
     for (const auto &event : scenario.events) {
-        stream << "  - type: " << (event.type == ScenarioEvent::Type::ProcessData ? "pd" : "md") << '\n';
+        stream << "  - type: " << scenario_yaml::typeName(event.type) << '\n';
         stream << "    label: " << event.label << '\n';
+        if (!event.timeline.empty()) {
+            stream << "    timeline: " << event.timeline << '\n';
+        }
         if (event.comId != 0) {
             stream << "    com_id: " << event.comId << '\n';
         }
         if (event.datasetId != 0) {
             stream << "    dataset_id: " << event.datasetId << '\n';
         }
+        writeStateFields(stream, event);
         const auto payloadStr = payloadToString(event.payload);
         if (!payloadStr.empty()) {
             stream << "    payload: " << payloadStr << '\n';
@@ -99,7 +218,75 @@ void writeScenarioFile(const std::filesystem::path &path, const Scenario &scenar
         if (event.delay.count() > 0) {
             stream << "    delay_ms: " << event.delay.count() << '\n';
         }
+        const auto &generator = event.generator;
+        if (generator.repeat > 1) {
+            stream << "    repeat: " << generator.repeat << '\n';
+        }
+        if (generator.period.count() > 0) {
+            stream << "    period_ms: " << generator.period.count() << '\n';
+        }
+        if (generator.ramped()) {
+            stream << "    ramp_start_hz: " << generator.rampStartHz << '\n';
+            stream << "    ramp_end_hz: " << generator.rampEndHz << '\n';
+        }
+        if (generator.counter) {
+            const auto &counter = *generator.counter;
+            stream << "    counter_offset: " << counter.offset << '\n';
+            stream << "    counter_width: " << static_cast<unsigned>(counter.width) << '\n';
+            stream << "    counter_start: " << counter.start << '\n';
+            stream << "    counter_step: " << counter.step << '\n';
+            if (counter.end) {
+                stream << "    counter_end: " << *counter.end << '\n';
+            }
+        }
+    }
+    if (!scenario.timelines.empty()) {
+        stream << "timelines:\n";
+        for (const auto &timeline : scenario.timelines) {
+            stream << "  - name: " << timeline.name << '\n';
+        }
+    }
+    writeExpectations(stream, scenario.expectations);
+    writeFaults(stream, scenario.faults);
+    writeNetwork(stream, scenario.network);
+    if (scenario.triggers.empty()) {
+        return;
+    }
+    stream << "triggers:\n";
+    for (const auto &trigger : scenario.triggers) {
+        stream << "  - label: " << trigger.label << '\n';
+        stream << "    on_type: " << scenario_yaml::typeName(trigger.on) << '\n';
+        stream << "    on_com_id: " << trigger.comId << '\n';
+        writePredicate(stream, trigger.predicate);
+        const auto &action = trigger.action;
+        stream << "    type: " << scenario_yaml::typeName(action.type) << '\n';
+        if (action.comId != 0) {
+            stream << "    com_id: " << action.comId << '\n';
+        }
+        if (action.datasetId != 0) {
+            stream << "    dataset_id: " << action.datasetId << '\n';
+        }
+        writeStateFields(stream, action);
+        const auto payloadStr = payloadToString(action.payload);
+        if (!payloadStr.empty()) {
+            stream << "    payload: " << payloadStr << '\n';
+        }
+        if (trigger.deadline.count() > 0) {
+            stream << "    deadline_ms: " << trigger.deadline.count() << '\n';
+        }
+    }
+}
+
+/// Runs of one scenario write identical files, which @p blobs stores once.
+void writeScenarioFile(const std::filesystem::path &path, const Scenario &scenario, BlobStore *blobs) {
+    if (blobs == nullptr) {
+        std::ofstream stream{path, std::ios::trunc};
+        writeScenario(stream, scenario);
+        return;
     }
+    std::ostringstream stream;
+    writeScenario(stream, scenario);
+    (void)blobs->storeContents(stream.view(), path);
 }
 
 void writeTelemetryFile(const std::filesystem::path &path, const std::vector<std::string> &entries) {
@@ -126,9 +313,17 @@ void writeDiagnosticsFile(const std::filesystem::path &path, const std::vector<c
     return detail;
 }
 
+struct TriggerStats {
+    std::uint64_t reactions{0};
+    std::uint64_t deadlineMisses{0};
+    std::chrono::microseconds maxLatency{0};
+    std::chrono::microseconds totalLatency{0};
+};
+
 void writeMetadataFile(const std::filesystem::path &path, const std::string &runId, const Scenario &scenario,
                        const std::string &startedAt, const std::string &completedAt, bool success,
-                       std::string_view detail) {
+                       std::string_view detail, const TriggerStats *triggerStats,
+                       const std::vector<ExpectationResult> &expectations) {
     std::ofstream stream{path, std::ios::trunc};
     stream << "run_id: " << runId << '\n';
     stream << "scenario_id: " << scenario.id << '\n';
@@ -139,16 +334,110 @@ void writeMetadataFile(const std::filesystem::path &path, const std::string &run
     if (!detail.empty()) {
         stream << "detail: " << sanitiseDetail(std::string{detail}) << '\n';
     }
+    if (triggerStats != nullptr) {
+        const auto mean = triggerStats->reactions == 0
+                              ? 0
+                              : triggerStats->totalLatency.count() /
+                                    static_cast<std::int64_t>(triggerStats->reactions);
+        stream << "triggers:\n";
+        stream << "  reactions: " << triggerStats->reactions << '\n';
+        stream << "  deadline_misses: " << triggerStats->deadlineMisses << '\n';
+        stream << "  max_latency_us: " << triggerStats->maxLatency.count() << '\n';
+        stream << "  mean_latency_us: " << mean << '\n';
+    }
+    if (!expectations.empty()) {
+        stream << "expectations:\n";
+        for (const auto &expectation : expectations) {
+            stream << "  - label: " << expectation.label << '\n';
+            stream << "    passed: " << (expectation.passed ? "true" : "false") << '\n';
+            stream << "    detail: " << sanitiseDetail(expectation.detail) << '\n';
+        }
+    }
 }
 
+/// Queues trigger reactions on the receive path and sends them from the engine loop, so the stack is never re-entered.
+class TriggerDispatcher final : public communication::TelegramObserver {
+public:
+    TriggerDispatcher(const std::vector<ScenarioTrigger> &triggers, const DeviceStateStore *state)
+        : m_table(triggers, state) {
+        m_pending.reserve(16);
+        m_draining.reserve(16);
+    }
+
+    void onProcessDataReceived(const ProcessDataMessage &message) override {
+        m_table.evaluate(ScenarioEvent::Type::ProcessData, message.comId, message.payload,
+                         std::chrono::steady_clock::now(), m_pending);
+    }
+
+    void onMessageDataReceived(const MessageDataMessage &message) override {
+        m_table.evaluate(ScenarioEvent::Type::MessageData, message.comId, message.payload,
+                         std::chrono::steady_clock::now(), m_pending);
+    }
+
+    void service(communication::Wrapper &wrapper, DeviceStateStore *state, std::ostream *log) {
+        if (m_pending.empty()) {
+            return;
+        }
+        m_draining.swap(m_pending);
+        for (const auto &reaction : m_draining) {
+            const auto &trigger = *reaction.trigger;
+            sendScenarioEvent(wrapper, trigger.action, trigger.action.payload, state);
+            const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - reaction.receivedAt);
+            const bool missed = trigger.deadline.count() > 0 && latency > trigger.deadline;
+            ++m_stats.reactions;
+            m_stats.totalLatency += latency;
+            m_stats.maxLatency = std::max(m_stats.maxLatency, latency);
+            if (missed) {
+                ++m_stats.deadlineMisses;
+            }
+            if (log != nullptr) {
+                *log << isoTimestamp() << " | " << trigger.label << " | on=" << trigger.comId << " -> "
+                     << scenario_yaml::typeName(trigger.action.type) << ':'
+                     << trigger.action.comId << " | latency_us=" << latency.count() << " | deadline="
+                     << (trigger.deadline.count() == 0 ? "none" : (missed ? "missed" : "met")) << '\n';
+            }
+        }
+        m_draining.clear();
+    }
+
+    [[nodiscard]] const TriggerStats &stats() const noexcept { return m_stats; }
+
+private:
+    TriggerTable m_table;
+    std::vector<TriggerReaction> m_pending;
+    std::vector<TriggerReaction> m_draining;
+    TriggerStats m_stats;
+};
+
+class ObserverRegistration {
+public:
+    ObserverRegistration(communication::Wrapper &wrapper, communication::TelegramObserver &observer)
+        : m_wrapper(wrapper), m_observer(observer) {
+        m_wrapper.addObserver(m_observer);
+    }
+    ~ObserverRegistration() { m_wrapper.removeObserver(m_observer); }
+
+    ObserverRegistration(const ObserverRegistration &) = delete;
+    ObserverRegistration &operator=(const ObserverRegistration &) = delete;
+
+private:
+    communication::Wrapper &m_wrapper;
+    communication::TelegramObserver &m_observer;
+};
+
+constexpr std::chrono::milliseconds kIdlePollInterval{1};
+
 struct RunContext {
     std::string id;
     std::string startedAt;
     std::filesystem::path directory;
     std::ofstream eventLog;
+    std::ofstream triggerLog;
+    std::unique_ptr<CaptureWriter> capture;
 };
 
-RunContext prepareRunContext(const Scenario &scenario, const std::filesystem::path &root) {
+RunContext prepareRunContext(const Scenario &scenario, const std::filesystem::path &root, BlobStore *blobs) {
     RunContext context;
     context.startedAt = isoTimestamp();
     auto baseId = sanitiseId(scenario.id.empty() ? "scenario" : scenario.id);
@@ -162,12 +451,47 @@ RunContext prepareRunContext(const Scenario &scenario, const std::filesystem::pa
     if (!context.eventLog) {
         throw std::runtime_error("Failed to open run event log: " + (context.directory / "events.log").string());
     }
-    writeScenarioFile(context.directory / "scenario.yaml", scenario);
+    if (!scenario.triggers.empty()) {
+        context.triggerLog.open(context.directory / "triggers.log", std::ios::out | std::ios::trunc);
+    }
+    context.capture = std::make_unique<CaptureWriter>(context.directory / kCaptureFileName);
+    writeScenarioFile(context.directory / "scenario.yaml", scenario, blobs);
     return context;
 }
 
 } // namespace
 
+void sendScenarioEvent(communication::Wrapper &wrapper, const ScenarioEvent &event,
+                       const std::vector<std::uint8_t> &payload, DeviceStateStore *state) {
+    if ((event.type == ScenarioEvent::Type::StateUpdate || event.fromState) && state == nullptr) {
+        throw std::logic_error("Event '" + event.label + "' requires device state");
+    }
+    switch (event.type) {
+    case ScenarioEvent::Type::ProcessData: {
+        if (event.fromState) {
+            ProcessDataMessage message{event.label, event.comId, event.datasetId, {}};
+            state->snapshot(event.datasetId, message.payload);
+            wrapper.publishProcessData(message);
+        } else {
+            ProcessDataMessage message{event.label, event.comId, event.datasetId, payload};
+            wrapper.publishProcessData(message);
+        }
+        break;
+    }
+    case ScenarioEvent::Type::StateUpdate:
+        state->set(event.datasetId, event.field, event.value);
+        break;
+    case ScenarioEvent::Type::MessageData: {
+        MessageDataMessage message{event.label, event.comId, event.datasetId, payload};
+        const MessageDataAck ack = wrapper.sendMessageData(message);
+        if (ack.status != MessageDataStatus::Delivered) {
+            throw std::runtime_error("Message data send failed: " + ack.detail);
+        }
+        break;
+    }
+    }
+}
+
 SimulationEngine::SimulationEngine(communication::Wrapper &wrapper, std::filesystem::path artefactRoot,
                                    ScenarioRepository *repository)
     : m_wrapper(wrapper), m_artefactRoot(std::move(artefactRoot)), m_repository(repository) {
@@ -177,30 +501,124 @@ SimulationEngine::SimulationEngine(communication::Wrapper &wrapper, std::filesys
 }
 
 void SimulationEngine::loadScenario(Scenario scenario) {
-    if (scenario.events.empty()) {
+    loadScenario(std::make_shared<const Scenario>(std::move(scenario)));
+}
+
+void SimulationEngine::loadScenario(std::shared_ptr<const Scenario> scenario) {
+    if (!scenario) {
+        throw std::invalid_argument("Scenario must not be null");
+    }
+    if (scenario->events.empty()) {
         throw std::invalid_argument("Scenario must contain at least one event");
     }
-    if (scenario.deviceProfileId.empty()) {
+    if (scenario->deviceProfileId.empty()) {
         throw std::invalid_argument("Scenario requires a device profile");
     }
     m_scenario = std::move(scenario);
     m_loaded = true;
 }
 
+void SimulationEngine::attachDeviceState(DeviceStateStore *state) noexcept {
+    m_deviceState = state;
+}
+
+void SimulationEngine::attachBlobStore(BlobStore *blobs) noexcept {
+    m_blobs = blobs;
+}
+
+void SimulationEngine::replayCapture(const std::filesystem::path &capture) {
+    m_replay.emplace(capture);
+}
+
 void SimulationEngine::run() {
     if (!m_loaded) {
         throw std::logic_error("No scenario loaded");
     }
+    // A replay sends the captured bytes, so only named expectation fields still need the state store.
+    const auto namesField = [](const ScenarioExpectation &expectation) {
+        return expectation.predicate.field && expectation.predicate.field->named();
+    };
+    const bool needsState =
+        m_replay ? std::ranges::any_of(m_scenario->expectations, namesField) : usesDeviceState(*m_scenario);
+    if (m_deviceState == nullptr && needsState) {
+        throw std::logic_error("Scenario '" + m_scenario->id + "' requires device state");
+    }
     if (!m_wrapper.isOpen()) {
         m_wrapper.open();
     }
 
     std::optional<RunContext> runContext;
     if (!m_artefactRoot.empty()) {
-        runContext = prepareRunContext(m_scenario, m_artefactRoot);
+        runContext = prepareRunContext(*m_scenario, m_artefactRoot, m_blobs);
     }
 
+    std::optional<TelegramCapture> capture;
+    std::optional<ObserverRegistration> captureRegistration;
+    if (runContext) {
+        capture.emplace(*runContext->capture);
+        captureRegistration.emplace(m_wrapper, *capture);
+    }
+    std::optional<TriggerDispatcher> triggers;
+    std::optional<ObserverRegistration> triggerRegistration;
+    if (!m_scenario->triggers.empty() && !m_replay) {
+        triggers.emplace(m_scenario->triggers, m_deviceState);
+        triggerRegistration.emplace(m_wrapper, *triggers);
+    }
+    std::optional<ExpectationMonitor> expectations;
+    std::optional<ObserverRegistration> expectationRegistration;
+    if (!m_scenario->expectations.empty()) {
+        expectations.emplace(m_scenario->expectations, m_deviceState);
+        expectations->start(std::chrono::steady_clock::now());
+        expectationRegistration.emplace(m_wrapper, *expectations);
+    }
+    m_expectationResults.clear();
+    m_replayTiming.reset();
+    if (m_replay) {
+        m_replayTiming.emplace();
+        m_replayTiming->source = m_replay->path().string();
+    }
+    std::ostream *triggerLog =
+        runContext && runContext->triggerLog.is_open() ? static_cast<std::ostream *>(&runContext->triggerLog) : nullptr;
+
+    const auto serviceReactions = [&]() {
+        if (triggers) {
+            triggers->service(m_wrapper, m_deviceState, triggerLog);
+        }
+    };
+
+    // Idle time between emissions keeps polling the stack so received telegrams (and the reactions they trigger)
+    // are handled within roughly one poll interval instead of after the next scheduled event.
+    const TimelineScheduler::IdleHook idleUntil = [&](TimelineScheduler::Clock::time_point deadline) {
+        while (true) {
+            serviceReactions();
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= deadline) {
+                break;
+            }
+            const std::chrono::steady_clock::duration remaining = deadline - now;
+            std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(remaining, kIdlePollInterval));
+            m_wrapper.poll();
+        }
+    };
+
     const auto finaliseRun = [&](bool success, std::string_view detail) {
+        captureRegistration.reset();
+        triggerRegistration.reset();
+        expectationRegistration.reset();
+        std::string failures;
+        if (expectations) {
+            m_expectationResults = expectations->results();
+            for (const auto &result : m_expectationResults) {
+                if (!result.passed) {
+                    failures += failures.empty() ? "expectations failed: " : ", ";
+                    failures += result.label;
+                }
+            }
+        }
+        if (!failures.empty() && success) {
+            success = false;
+            detail = failures;
+        }
         if (!runContext) {
             return;
         }
@@ -208,49 +626,84 @@ void SimulationEngine::run() {
             runContext->eventLog.flush();
             runContext->eventLog.close();
         }
+        if (runContext->triggerLog.is_open()) {
+            runContext->triggerLog.close();
+        }
+        runContext->capture->close();
         const auto completedAt = isoTimestamp();
         writeTelemetryFile(runContext->directory / "telemetry.log", m_wrapper.telemetry());
         writeDiagnosticsFile(runContext->directory / "diagnostics.log", m_wrapper.diagnostics());
-        writeMetadataFile(runContext->directory / "metadata.yaml", runContext->id, m_scenario, runContext->startedAt,
-                          completedAt, success, detail);
+        if (m_replayTiming) {
+            writeReplayTiming(runContext->directory / "replay.yaml", *m_replayTiming);
+        }
+        writeMetadataFile(runContext->directory / "metadata.yaml", runContext->id, *m_scenario, runContext->startedAt,
+                          completedAt, success, detail, triggers ? &triggers->stats() : nullptr,
+                          m_expectationResults);
         if (m_repository != nullptr) {
             RunRecord record{};
             record.id = runContext->id;
-            record.scenarioId = m_scenario.id;
+            record.scenarioId = m_scenario->id;
             record.artefactPath = runContext->directory;
             record.startedAt = runContext->startedAt;
             record.completedAt = completedAt;
             record.success = success;
             record.detail = std::string(detail);
+            record.expectations = m_expectationResults;
             m_repository->recordRun(std::move(record));
         }
     };
 
     try {
-        for (const auto &event : m_scenario.events) {
-            if (event.delay.count() > 0) {
-                std::this_thread::sleep_for(event.delay);
-            }
+        const TimelineEmitter emit = [&](const TimelinePlan &plan, const EventEmission &emission) {
+            const auto &event = *emission.event;
             if (runContext && runContext->eventLog.is_open()) {
-                runContext->eventLog << isoTimestamp() << " | " << scenario_yaml::describeEvent(event) << '\n';
+                runContext->eventLog << isoTimestamp() << " | " << scenario_yaml::describeEvent(event);
+                if (!plan.name.empty()) {
+                    runContext->eventLog << "::timeline=" << plan.name;
+                }
+                if (event.generator.active()) {
+                    runContext->eventLog << "::iteration=" << emission.iteration;
+                }
+                runContext->eventLog << '\n';
             }
-            switch (event.type) {
-            case ScenarioEvent::Type::ProcessData: {
-                ProcessDataMessage message{event.label, event.comId, event.datasetId, event.payload};
-                m_wrapper.publishProcessData(message);
-                break;
+            sendScenarioEvent(m_wrapper, event, *emission.payload, m_deviceState);
+            m_wrapper.poll();
+            serviceReactions();
+        };
+
+        const CaptureEmitter emitCaptured = [&](const CaptureRecord &record) {
+            const bool pd = record.type == CaptureType::ProcessData;
+            if (runContext && runContext->eventLog.is_open()) {
+                runContext->eventLog << isoTimestamp() << " | " << (pd ? "pd" : "md") << "::replay::comId="
+                                     << record.comId << "::dataset=" << record.datasetId
+                                     << "::bytes=" << record.payload.size() << '\n';
             }
-            case ScenarioEvent::Type::MessageData: {
-                MessageDataMessage message{event.label, event.comId, event.datasetId, event.payload};
-                const MessageDataAck ack = m_wrapper.sendMessageData(message);
+            const std::vector<std::uint8_t> payload(record.payload.begin(), record.payload.end());
+            if (pd) {
+                m_wrapper.publishProcessData(ProcessDataMessage{"replay", record.comId, record.datasetId, payload});
+            } else {
+                const auto ack =
+                    m_wrapper.sendMessageData(MessageDataMessage{"replay", record.comId, record.datasetId, payload});
                 if (ack.status != MessageDataStatus::Delivered) {
                     throw std::runtime_error("Message data send failed: " + ack.detail);
                 }
-                break;
-            }
             }
             m_wrapper.poll();
+            serviceReactions();
+        };
+
+        // Every timeline is a coroutine on one scheduler thread, so thousands of timelines interleave without a
+        // thread each and the Wrapper is never entered concurrently.
+        const auto plans = m_replay ? std::vector<TimelinePlan>{} : planTimelines(*m_scenario);
+        TimelineScheduler scheduler;
+        const auto start = TimelineScheduler::Clock::now();
+        for (const auto &plan : plans) {
+            scheduler.spawn(playTimeline(scheduler, plan, start, emit));
+        }
+        if (m_replay) {
+            scheduler.spawn(playCapture(scheduler, *m_replay, start, emitCaptured, *m_replayTiming));
         }
+        scheduler.run(idleUntil);
         m_wrapper.close();
         finaliseRun(true, {});
     } catch (...) {
@@ -265,18 +718,29 @@ void SimulationEngine::run() {
         } catch (const std::exception &ex) {
             finaliseRun(false, ex.what());
             m_loaded = false;
+            m_replay.reset();
             throw;
         } catch (...) {
             finaliseRun(false, "unknown failure");
             m_loaded = false;
+            m_replay.reset();
             throw;
         }
     }
     m_loaded = false;
+    m_replay.reset();
 }
 
 const Scenario &SimulationEngine::scenario() const noexcept {
-    return m_scenario;
+    return *m_scenario;
+}
+
+const std::vector<ExpectationResult> &SimulationEngine::expectationResults() const noexcept {
+    return m_expectationResults;
+}
+
+const std::optional<ReplayTiming> &SimulationEngine::replayTiming() const noexcept {
+    return m_replayTiming;
 }
 
 } // namespace trdp::simulation
@@ -0,0 +1,78 @@
+#include "trdp_simulator/simulation/EventStream.hpp"
+
+namespace trdp::simulation {
+
+EventStream::EventStream(const std::vector<ScenarioEvent> &events) : m_events(events) {}
+
+bool EventStream::next(EventEmission &emission) {
+    while (m_index < m_events.size()) {
+        const auto &event = m_events[m_index];
+        const std::uint32_t repeat = event.generator.repeat == 0 ? 1 : event.generator.repeat;
+        if (m_iteration >= repeat) {
+            ++m_index;
+            m_iteration = 0;
+            continue;
+        }
+
+        emission.event = &event;
+        emission.iteration = m_iteration;
+        emission.gap = generatorGap(event, m_iteration);
+        if (event.generator.counter) {
+            if (m_iteration == 0) {
+                m_payload.assign(event.payload.begin(), event.payload.end());
+            }
+            applyCounter(*event.generator.counter, m_iteration, m_payload);
+            emission.payload = &m_payload;
+        } else {
+            emission.payload = &event.payload;
+        }
+        ++m_iteration;
+        return true;
+    }
+    return false;
+}
+
+std::chrono::microseconds generatorGap(const ScenarioEvent &event, std::uint32_t iteration) {
+    if (iteration == 0) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(event.delay);
+    }
+    const auto &generator = event.generator;
+    if (generator.ramped()) {
+        // The rate climbs linearly over the repeat - 1 gaps: the gap before emission 1 runs at the start rate, the
+        // gap before the last emission at the end rate. A single gap stays at the start rate.
+        const double fraction = generator.repeat > 2 ? static_cast<double>(iteration - 1) /
+                                                           static_cast<double>(generator.repeat - 2)
+                                                     : 0.0;
+        const double start = generator.rampStartHz;
+        const double end = generator.rampEndHz;
+        const double rate = start + (end - start) * fraction;
+        return std::chrono::microseconds{static_cast<std::int64_t>(1'000'000.0 / rate)};
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(generator.period);
+}
+
+void applyCounter(const PayloadCounter &counter, std::uint32_t iteration, std::vector<std::uint8_t> &payload) {
+    const std::uint64_t offset = static_cast<std::uint64_t>(iteration) * counter.step;
+    std::uint64_t value = counter.start + offset;
+    if (counter.end && *counter.end >= counter.start) {
+        // A zero range means the sweep covers the whole 64-bit domain and plain wrap-around applies.
+        const std::uint64_t range = *counter.end - counter.start + 1;
+        if (range != 0) {
+            value = counter.start + offset % range;
+        }
+    }
+    for (std::size_t i = 0; i < counter.width; ++i) {
+        const std::size_t shift = 8 * (counter.width - 1 - i);
+        payload[counter.offset + i] = static_cast<std::uint8_t>((value >> shift) & 0xFFu);
+    }
+}
+
+std::uint64_t emissionCount(const std::vector<ScenarioEvent> &events) {
+    std::uint64_t count = 0;
+    for (const auto &event : events) {
+        count += event.generator.repeat == 0 ? 1 : event.generator.repeat;
+    }
+    return count;
+}
+
+} // namespace trdp::simulation
@@ -0,0 +1,92 @@
+#include "trdp_simulator/simulation/ExpectationMonitor.hpp"
+
+#include <cstdlib>
+#include <sstream>
+
+namespace trdp::simulation {
+
+ExpectationMonitor::ExpectationMonitor(const std::vector<ScenarioExpectation> &expectations,
+                                       const DeviceStateStore *deviceState) {
+    m_states.reserve(expectations.size());
+    for (const auto &expectation : expectations) {
+        m_byComId[expectation.comId].push_back(m_states.size());
+        State state{};
+        state.expectation = &expectation;
+        state.matcher = PayloadMatcher{expectation.predicate, deviceState};
+        m_states.push_back(std::move(state));
+    }
+    m_runStart = std::chrono::steady_clock::now();
+}
+
+void ExpectationMonitor::start(std::chrono::steady_clock::time_point runStart) {
+    m_runStart = runStart;
+}
+
+void ExpectationMonitor::onProcessDataReceived(const communication::ProcessDataMessage &message) {
+    observe(ScenarioEvent::Type::ProcessData, message.comId, message.payload, std::chrono::steady_clock::now());
+}
+
+void ExpectationMonitor::onMessageDataReceived(const communication::MessageDataMessage &message) {
+    observe(ScenarioEvent::Type::MessageData, message.comId, message.payload, std::chrono::steady_clock::now());
+}
+
+void ExpectationMonitor::observe(ScenarioEvent::Type type, std::uint32_t comId, std::span<const std::uint8_t> payload,
+                                 std::chrono::steady_clock::time_point receivedAt) {
+    const auto it = m_byComId.find(comId);
+    if (it == m_byComId.end()) {
+        return;
+    }
+    for (const auto index : it->second) {
+        auto &state = m_states[index];
+        const auto &expectation = *state.expectation;
+        if (expectation.type != type) {
+            continue;
+        }
+        ++state.received;
+        if (expectation.window.count() == 0 || receivedAt - m_runStart <= expectation.window) {
+            ++state.receivedInWindow;
+        }
+        if (!state.matcher.empty() && !state.matcher.matches(payload)) {
+            ++state.mismatches;
+        }
+        if (expectation.cycle.count() > 0 && state.seen) {
+            const auto interval = std::chrono::duration_cast<std::chrono::microseconds>(receivedAt - state.lastArrival);
+            const auto expected = std::chrono::duration_cast<std::chrono::microseconds>(expectation.cycle);
+            const auto deviation = std::chrono::microseconds{std::abs((interval - expected).count())};
+            if (deviation > state.maxCycleDeviation) {
+                state.maxCycleDeviation = deviation;
+            }
+            if (deviation > expectation.cycleTolerance) {
+                ++state.cycleViolations;
+            }
+        }
+        state.lastArrival = receivedAt;
+        state.seen = true;
+    }
+}
+
+std::vector<ExpectationResult> ExpectationMonitor::results() const {
+    std::vector<ExpectationResult> results;
+    results.reserve(m_states.size());
+    for (const auto &state : m_states) {
+        const auto &expectation = *state.expectation;
+        bool passed = state.receivedInWindow >= expectation.minCount;
+        if (expectation.maxCount && state.receivedInWindow > *expectation.maxCount) {
+            passed = false;
+        }
+        if (state.mismatches > 0 || state.cycleViolations > 0) {
+            passed = false;
+        }
+        std::ostringstream detail;
+        detail << "received=" << state.received << " in_window=" << state.receivedInWindow
+               << " mismatches=" << state.mismatches;
+        if (expectation.cycle.count() > 0) {
+            detail << " cycle_violations=" << state.cycleViolations
+                   << " max_cycle_deviation_us=" << state.maxCycleDeviation.count();
+        }
+        results.push_back(ExpectationResult{expectation.label, passed, detail.str()});
+    }
+    return results;
+}
+
+} // namespace trdp::simulation
@@ -0,0 +1,233 @@
+#include "trdp_simulator/simulation/HexCodec.hpp"
+
+#include <array>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define TRDP_SIM_HAVE_X86_SIMD 1
+#endif
+
+namespace trdp::simulation::hex {
+namespace {
+
+/// Nibble value of every character, 0xFF for anything that is not a hex digit.
+constexpr auto kNibbles = [] {
+    std::array<std::uint8_t, 256> table{};
+    table.fill(0xFF);
+    for (int c = 0; c < 10; ++c) {
+        table['0' + c] = static_cast<std::uint8_t>(c);
+    }
+    for (int c = 0; c < 6; ++c) {
+        table['a' + c] = static_cast<std::uint8_t>(10 + c);
+        table['A' + c] = static_cast<std::uint8_t>(10 + c);
+    }
+    return table;
+}();
+
+constexpr char kDigits[] = "0123456789abcdef";
+
+/// Decodes the pairs from @p pair onwards; also pinpoints the invalid digit in a block a vector kernel rejected.
+std::size_t decodeScalar(std::string_view digits, std::uint8_t *out, std::size_t pair) noexcept {
+    const auto pairs = digits.size() / 2;
+    for (; pair < pairs; ++pair) {
+        const auto high = kNibbles[static_cast<unsigned char>(digits[2 * pair])];
+        const auto low = kNibbles[static_cast<unsigned char>(digits[2 * pair + 1])];
+        if ((high | low) > 0x0F) {
+            return 2 * pair + (high > 0x0F ? 0 : 1);
+        }
+        out[pair] = static_cast<std::uint8_t>(high << 4U | low);
+    }
+    return 2 * pairs;
+}
+
+void encodeScalar(std::span<const std::uint8_t> bytes, char *out, std::size_t from) noexcept {
+    for (std::size_t i = from; i < bytes.size(); ++i) {
+        out[2 * i] = kDigits[bytes[i] >> 4U];
+        out[2 * i + 1] = kDigits[bytes[i] & 0x0FU];
+    }
+}
+
+#ifdef TRDP_SIM_HAVE_X86_SIMD
+
+// Characters map to nibbles branch-free: c - '0' is a digit when it lands in [0, 9] and (c | 0x20) - 'a' a letter
+// when it lands in [0, 5]; signed byte compares suffice because every other byte wraps outside those ranges. Each
+// 16-bit lane then holds a digit pair with the high nibble in its low byte, so (lane << 4 & 0xFF) | (lane >> 8) is
+// the decoded byte, and a saturating pack squeezes the lanes back to bytes.
+
+__attribute__((target("sse2"))) __m128i nibblesSse2(__m128i chars, int &valid) noexcept {
+    const __m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    const __m128i letter = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i isDigit =
+        _mm_andnot_si128(_mm_cmplt_epi8(digit, _mm_setzero_si128()), _mm_cmplt_epi8(digit, _mm_set1_epi8(10)));
+    const __m128i isLetter =
+        _mm_andnot_si128(_mm_cmplt_epi8(letter, _mm_setzero_si128()), _mm_cmplt_epi8(letter, _mm_set1_epi8(6)));
+    valid = _mm_movemask_epi8(_mm_or_si128(isDigit, isLetter));
+    return _mm_or_si128(_mm_and_si128(isDigit, digit),
+                        _mm_and_si128(isLetter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+}
+
+__attribute__((target("sse2"))) std::size_t decodeSse2(std::string_view digits, std::uint8_t *out) noexcept {
+    const auto pairs = digits.size() / 2;
+    std::size_t pair = 0;
+    for (; pair + 8 <= pairs; pair += 8) {
+        int valid = 0;
+        const __m128i nibbles =
+            nibblesSse2(_mm_loadu_si128(reinterpret_cast<const __m128i *>(digits.data() + 2 * pair)), valid);
+        if (valid != 0xFFFF) {
+            return decodeScalar(digits, out, pair);
+        }
+        const __m128i bytes = _mm_or_si128(_mm_and_si128(_mm_slli_epi16(nibbles, 4), _mm_set1_epi16(0x00FF)),
+                                           _mm_srli_epi16(nibbles, 8));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(out + pair), _mm_packus_epi16(bytes, bytes));
+    }
+    return decodeScalar(digits, out, pair);
+}
+
+__attribute__((target("sse2"))) __m128i digitsSse2(__m128i nibbles) noexcept {
+    const __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9)), _mm_set1_epi8('a' - '0' - 10));
+    return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), letters);
+}
+
+__attribute__((target("sse2"))) void encodeSse2(std::span<const std::uint8_t> bytes, char *out) noexcept {
+    std::size_t i = 0;
+    for (; i + 16 <= bytes.size(); i += 16) {
+        const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes.data() + i));
+        const __m128i high = _mm_and_si128(_mm_srli_epi16(input, 4), _mm_set1_epi8(0x0F));
+        const __m128i low = _mm_and_si128(input, _mm_set1_epi8(0x0F));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 2 * i), digitsSse2(_mm_unpacklo_epi8(high, low)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 2 * i + 16), digitsSse2(_mm_unpackhi_epi8(high, low)));
+    }
+    encodeScalar(bytes, out, i);
+}
+
+__attribute__((target("avx2"))) __m256i nibblesAvx2(__m256i chars, int &valid) noexcept {
+    const __m256i digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+    const __m256i letter = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    const __m256i isDigit = _mm256_andnot_si256(_mm256_cmpgt_epi8(_mm256_setzero_si256(), digit),
+                                                _mm256_cmpgt_epi8(_mm256_set1_epi8(10), digit));
+    const __m256i isLetter = _mm256_andnot_si256(_mm256_cmpgt_epi8(_mm256_setzero_si256(), letter),
+                                                 _mm256_cmpgt_epi8(_mm256_set1_epi8(6), letter));
+    valid = _mm256_movemask_epi8(_mm256_or_si256(isDigit, isLetter));
+    return _mm256_or_si256(_mm256_and_si256(isDigit, digit),
+                           _mm256_and_si256(isLetter, _mm256_add_epi8(letter, _mm256_set1_epi8(10))));
+}
+
+__attribute__((target("avx2"))) std::size_t decodeAvx2(std::string_view digits, std::uint8_t *out) noexcept {
+    const auto pairs = digits.size() / 2;
+    std::size_t pair = 0;
+    for (; pair + 16 <= pairs; pair += 16) {
+        int valid = 0;
+        const __m256i nibbles =
+            nibblesAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(digits.data() + 2 * pair)), valid);
+        if (valid != -1) {
+            return decodeScalar(digits, out, pair);
+        }
+        const __m256i bytes = _mm256_or_si256(
+            _mm256_and_si256(_mm256_slli_epi16(nibbles, 4), _mm256_set1_epi16(0x00FF)), _mm256_srli_epi16(nibbles, 8));
+        // The pack works per 128-bit lane; gather the low quadword of each lane into the lower half.
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(bytes, bytes), 0xD8);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + pair), _mm256_castsi256_si128(packed));
+    }
+    return decodeScalar(digits, out, pair);
+}
+
+__attribute__((target("avx2"))) __m256i digitsAvx2(__m256i nibbles) noexcept {
+    const __m256i letters =
+        _mm256_and_si256(_mm256_cmpgt_epi8(nibbles, _mm256_set1_epi8(9)), _mm256_set1_epi8('a' - '0' - 10));
+    return _mm256_add_epi8(_mm256_add_epi8(nibbles, _mm256_set1_epi8('0')), letters);
+}
+
+__attribute__((target("avx2"))) void encodeAvx2(std::span<const std::uint8_t> bytes, char *out) noexcept {
+    std::size_t i = 0;
+    for (; i + 32 <= bytes.size(); i += 32) {
+        const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bytes.data() + i));
+        const __m256i high = _mm256_and_si256(_mm256_srli_epi16(input, 4), _mm256_set1_epi8(0x0F));
+        const __m256i low = _mm256_and_si256(input, _mm256_set1_epi8(0x0F));
+        // Unpacking interleaves within each 128-bit lane, so the halves are swapped back into byte order.
+        const __m256i first = digitsAvx2(_mm256_unpacklo_epi8(high, low));
+        const __m256i second = digitsAvx2(_mm256_unpackhi_epi8(high, low));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 2 * i), _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 2 * i + 32),
+                            _mm256_permute2x128_si256(first, second, 0x31));
+    }
+    encodeSse2(bytes.subspan(i), out + 2 * i);
+}
+
+#endif
+
+} // namespace
+
+bool kernelSupported(Kernel kernel) noexcept {
+    switch (kernel) {
+    case Kernel::Scalar:
+        return true;
+#ifdef TRDP_SIM_HAVE_X86_SIMD
+    case Kernel::Sse2:
+        return __builtin_cpu_supports("sse2") != 0;
+    case Kernel::Avx2:
+        return __builtin_cpu_supports("avx2") != 0;
+#else
+    case Kernel::Sse2:
+    case Kernel::Avx2:
+        return false;
+#endif
+    }
+    return false;
+}
+
+Kernel activeKernel() noexcept {
+    static const Kernel kernel = kernelSupported(Kernel::Avx2)   ? Kernel::Avx2
+                                 : kernelSupported(Kernel::Sse2) ? Kernel::Sse2
+                                                                 : Kernel::Scalar;
+    return kernel;
+}
+
+const char *kernelName(Kernel kernel) noexcept {
+    switch (kernel) {
+    case Kernel::Scalar:
+        return "scalar";
+    case Kernel::Sse2:
+        return "sse2";
+    case Kernel::Avx2:
+        return "avx2";
+    }
+    return "scalar";
+}
+
+std::size_t decode(std::string_view digits, std::uint8_t *out, Kernel kernel) noexcept {
+#ifdef TRDP_SIM_HAVE_X86_SIMD
+    if (kernel == Kernel::Avx2) {
+        return decodeAvx2(digits, out);
+    }
+    if (kernel == Kernel::Sse2) {
+        return decodeSse2(digits, out);
+    }
+#else
+    (void)kernel;
+#endif
+    return decodeScalar(digits, out, 0);
+}
+
+void encode(std::span<const std::uint8_t> bytes, char *out, Kernel kernel) noexcept {
+#ifdef TRDP_SIM_HAVE_X86_SIMD
+    if (kernel == Kernel::Avx2) {
+        encodeAvx2(bytes, out);
+        return;
+    }
+    if (kernel == Kernel::Sse2) {
+        encodeSse2(bytes, out);
+        return;
+    }
+#else
+    (void)kernel;
+#endif
+    encodeScalar(bytes, out, 0);
+}
+
+std::string encode(std::span<const std::uint8_t> bytes) {
+    std::string digits(2 * bytes.size(), '\0');
+    encode(bytes, digits.data());
+    return digits;
+}
+
+} // namespace trdp::simulation::hex
@@ -0,0 +1,319 @@
+#include "trdp_simulator/simulation/LoadGenerator.hpp"
+
+#include "trdp_simulator/device/DatasetLayout.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace trdp::simulation {
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t kDefaultPayloadSize = 64;
+constexpr std::chrono::nanoseconds kLatencyFloor{std::chrono::microseconds{50}};
+constexpr std::chrono::microseconds kSleepThreshold{200};
+constexpr std::chrono::milliseconds kMaxSleep{1};
+
+[[nodiscard]] std::string formatTime(const char *format) {
+    const auto time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::tm tm{};
+#ifdef _WIN32
+    gmtime_s(&tm, &time);
+#else
+    gmtime_r(&time, &tm);
+#endif
+    std::ostringstream oss;
+    oss << std::put_time(&tm, format);
+    return oss.str();
+}
+
+[[nodiscard]] std::string sanitiseId(const std::string &candidate) {
+    std::string result;
+    for (char ch : candidate) {
+        if (std::isalnum(static_cast<unsigned char>(ch)) || ch == '-' || ch == '_') {
+            result.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(ch))));
+        }
+    }
+    return result.empty() ? "device" : result;
+}
+
+void writeHeader(std::vector<std::uint8_t> &payload, std::uint32_t step, std::int64_t sentAt) noexcept {
+    std::memcpy(payload.data(), &step, sizeof(step));
+    std::memcpy(payload.data() + sizeof(step), &sentAt, sizeof(sentAt));
+}
+
+[[nodiscard]] double micros(std::chrono::nanoseconds value) {
+    return std::chrono::duration<double, std::micro>(value).count();
+}
+
+void writeStep(std::ostream &stream, const LoadStep &step) {
+    const auto &latency = step.latency;
+    stream << "  - offered_rate: " << step.offeredRate << '\n';
+    stream << "    send_rate: " << step.sendRate << '\n';
+    stream << "    receive_rate: " << step.receiveRate << '\n';
+    stream << "    sent: " << step.sent << '\n';
+    stream << "    received: " << step.received << '\n';
+    stream << "    md_failures: " << step.mdFailures << '\n';
+    stream << "    loss: " << std::defaultfloat << step.loss() << std::fixed << '\n';
+    stream << "    p50_us: " << micros(latency.percentile(0.5)) << '\n';
+    stream << "    p90_us: " << micros(latency.percentile(0.9)) << '\n';
+    stream << "    p99_us: " << micros(latency.percentile(0.99)) << '\n';
+    stream << "    max_us: " << micros(latency.max()) << '\n';
+    stream << "    sustainable: " << (step.sustainable ? "true" : "false") << '\n';
+}
+
+} // namespace
+
+std::vector<LoadTarget> loadTargets(const device::DeviceConfig &config) {
+    auto telegrams = config.publications();
+    if (telegrams.empty()) {
+        telegrams = config.telegrams;
+    }
+    if (telegrams.empty()) {
+        throw std::runtime_error("Device profile declares no telegrams to load");
+    }
+    std::vector<LoadTarget> targets;
+    targets.reserve(telegrams.size());
+    for (const auto &telegram : telegrams) {
+        std::size_t size = kDefaultPayloadSize;
+        if (config.dataset(telegram.datasetId) != nullptr) {
+            try {
+                size = device::DatasetLayout::compile(config, telegram.datasetId).size();
+            } catch (const std::runtime_error &) {
+                // Variable-size data sets keep the default size.
+            }
+        }
+        targets.push_back(LoadTarget{telegram.comId, telegram.datasetId, std::max(size, kLoadHeaderSize)});
+    }
+    return targets;
+}
+
+double LoadStep::loss() const noexcept {
+    if (sent == 0) {
+        return 0.0;
+    }
+    return 1.0 - static_cast<double>(std::min(received, sent)) / static_cast<double>(sent);
+}
+
+double LoadReport::maxSustainableRate() const noexcept {
+    return knee ? steps[*knee].receiveRate : 0.0;
+}
+
+LoadGenerator::LoadGenerator(communication::Wrapper &wrapper, LoadOptions options)
+    : m_wrapper(wrapper), m_options(std::move(options)) {
+    if (m_options.targets.empty()) {
+        throw std::invalid_argument("Load run requires at least one target telegram");
+    }
+    for (auto &target : m_options.targets) {
+        target.payloadSize = std::max(target.payloadSize, kLoadHeaderSize);
+    }
+    if (!(m_options.startRate > 0.0) || m_options.maxRate < m_options.startRate || !(m_options.rampFactor > 1.0)) {
+        throw std::invalid_argument("Load rates must satisfy 0 < start <= max and a ramp factor above 1");
+    }
+    if (!(m_options.mdShare >= 0.0 && m_options.mdShare <= 1.0)) {
+        throw std::invalid_argument("Load MD share must be between 0 and 1");
+    }
+    if (m_options.stepDuration.count() <= 0) {
+        throw std::invalid_argument("Load step duration must be positive");
+    }
+}
+
+LoadReport LoadGenerator::run() {
+    struct Registration {
+        communication::Wrapper &wrapper;
+        LoadGenerator &observer;
+        ~Registration() { wrapper.removeObserver(observer); }
+    };
+
+    if (!m_wrapper.isOpen()) {
+        m_wrapper.open();
+    }
+    m_wrapper.addObserver(*this);
+    const Registration registration{m_wrapper, *this};
+
+    LoadReport report;
+    report.startedAt = formatTime("%Y-%m-%dT%H:%M:%SZ");
+    report.targets = m_options.targets;
+    m_epoch = Clock::now();
+    m_baselineP99.reset();
+
+    const auto record = [&](LoadStep step) {
+        report.steps.push_back(std::move(step));
+        const auto &added = report.steps.back();
+        if (added.sustainable &&
+            (!report.knee || added.offeredRate > report.steps[*report.knee].offeredRate)) {
+            report.knee = report.steps.size() - 1;
+        }
+        return added.sustainable;
+    };
+
+    std::optional<double> failedRate;
+    for (double rate = m_options.startRate; rate <= m_options.maxRate * (1.0 + 1e-9); rate *= m_options.rampFactor) {
+        if (!record(runStep(rate))) {
+            failedRate = rate;
+            break;
+        }
+    }
+    if (failedRate && report.knee) {
+        double low = report.steps[*report.knee].offeredRate;
+        double high = *failedRate;
+        for (std::size_t i = 0; i < m_options.refineSteps; ++i) {
+            const auto rate = (low + high) / 2.0;
+            if (record(runStep(rate))) {
+                low = rate;
+            } else {
+                high = rate;
+            }
+        }
+    }
+
+    m_wrapper.close();
+    report.completedAt = formatTime("%Y-%m-%dT%H:%M:%SZ");
+    return report;
+}
+
+void LoadGenerator::onProcessDataReceived(const communication::ProcessDataMessage &message) {
+    receive(message.payload);
+}
+
+void LoadGenerator::onMessageDataReceived(const communication::MessageDataMessage &message) {
+    receive(message.payload);
+}
+
+LoadStep LoadGenerator::runStep(double rate) {
+    LoadStep step;
+    step.offeredRate = rate;
+    ++m_stepIndex;
+    m_current = &step;
+
+    std::vector<communication::ProcessDataMessage> pd;
+    std::vector<communication::MessageDataMessage> md;
+    for (const auto &target : m_options.targets) {
+        std::vector<std::uint8_t> payload(target.payloadSize, 0);
+        pd.push_back({"load", target.comId, target.datasetId, payload});
+        md.push_back({"load", target.comId, target.datasetId, std::move(payload)});
+    }
+
+    const auto interval = std::chrono::duration<double>(1.0 / rate);
+    const auto start = Clock::now();
+    const auto end = start + m_options.stepDuration;
+    double mdCredit = 0.0;
+    auto now = start;
+    while (now < end) {
+        const auto nextDue = start + std::chrono::duration_cast<Clock::duration>(interval * step.sent);
+        if (now < nextDue) {
+            m_wrapper.poll();
+            if (nextDue - now > kSleepThreshold) {
+                std::this_thread::sleep_for(std::min<Clock::duration>(nextDue - now, kMaxSleep));
+            }
+            now = Clock::now();
+            continue;
+        }
+        const auto index = static_cast<std::size_t>(step.sent % m_options.targets.size());
+        const auto sentAt = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_epoch).count();
+        ++step.sent;
+        mdCredit += m_options.mdShare;
+        if (mdCredit >= 1.0) {
+            mdCredit -= 1.0;
+            writeHeader(md[index].payload, m_stepIndex, sentAt);
+            if (m_wrapper.sendMessageData(md[index]).status != communication::MessageDataStatus::Delivered) {
+                ++step.mdFailures;
+            }
+        } else {
+            writeHeader(pd[index].payload, m_stepIndex, sentAt);
+            m_wrapper.publishProcessData(pd[index]);
+        }
+        now = Clock::now();
+    }
+    const auto elapsed = std::chrono::duration<double>(now - start).count();
+
+    const auto drainEnd = Clock::now() + m_options.drainTime;
+    while (step.received < step.sent && Clock::now() < drainEnd) {
+        m_wrapper.poll();
+        std::this_thread::sleep_for(std::chrono::microseconds{100});
+    }
+    m_current = nullptr;
+
+    step.sendRate = static_cast<double>(step.sent) / elapsed;
+    // Telegrams still arriving during the drain were sent within the step, so they count towards its rate.
+    step.receiveRate = static_cast<double>(std::min(step.received, step.sent)) / elapsed;
+    judge(step);
+    return step;
+}
+
+void LoadGenerator::receive(const std::vector<std::uint8_t> &payload) {
+    if (m_current == nullptr || payload.size() < kLoadHeaderSize) {
+        return;
+    }
+    std::uint32_t stepIndex = 0;
+    std::int64_t sentAt = 0;
+    std::memcpy(&stepIndex, payload.data(), sizeof(stepIndex));
+    std::memcpy(&sentAt, payload.data() + sizeof(stepIndex), sizeof(sentAt));
+    if (stepIndex != m_stepIndex) {
+        return;
+    }
+    const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_epoch);
+    ++m_current->received;
+    m_current->latency.record(now - std::chrono::nanoseconds{sentAt});
+}
+
+void LoadGenerator::judge(LoadStep &step) {
+    const auto p99 = step.latency.percentile(0.99);
+    bool sustainable = step.receiveRate >= m_options.minEfficiency * step.offeredRate &&
+                       step.loss() <= m_options.maxLoss && step.received > 0;
+    if (sustainable && m_baselineP99) {
+        const auto limit = std::max(*m_baselineP99, kLatencyFloor);
+        const auto allowed = m_options.maxLatencyGrowth * static_cast<double>(limit.count());
+        sustainable = static_cast<double>(p99.count()) <= allowed;
+    }
+    step.sustainable = sustainable;
+    if (sustainable && !m_baselineP99) {
+        m_baselineP99 = p99;
+    }
+}
+
+std::filesystem::path writeLoadReport(const std::filesystem::path &runsRoot, const std::string &profileId,
+                                      const LoadReport &report) {
+    const auto directory = runsRoot / ("load-" + sanitiseId(profileId) + '-' + formatTime("%Y%m%dT%H%M%SZ"));
+    std::filesystem::create_directories(directory);
+    const auto path = directory / "load-report.yaml";
+    std::ofstream stream{path, std::ios::trunc};
+    if (!stream) {
+        throw std::runtime_error("Failed to write load report: " + path.string());
+    }
+    stream << std::fixed << std::setprecision(1);
+    stream << "mode: load\n";
+    stream << "device_profile: " << profileId << '\n';
+    stream << "started_at: " << report.startedAt << '\n';
+    stream << "completed_at: " << report.completedAt << '\n';
+    stream << "targets:\n";
+    for (const auto &target : report.targets) {
+        stream << "  - com_id: " << target.comId << '\n';
+        stream << "    dataset_id: " << target.datasetId << '\n';
+        stream << "    payload_bytes: " << target.payloadSize << '\n';
+    }
+    stream << "steps:\n";
+    for (const auto &step : report.steps) {
+        writeStep(stream, step);
+    }
+    if (report.knee) {
+        const auto &knee = report.steps[*report.knee];
+        stream << "knee:\n";
+        stream << "  offered_rate: " << knee.offeredRate << '\n';
+        stream << "  receive_rate: " << knee.receiveRate << '\n';
+        stream << "  p99_us: " << micros(knee.latency.percentile(0.99)) << '\n';
+    }
+    stream << "max_sustainable_rate: " << report.maxSustainableRate() << '\n';
+    return path;
+}
+
+} // namespace trdp::simulation
@@ -0,0 +1,263 @@
+#include "trdp_simulator/simulation/ManifestJournal.hpp"
+
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#define TRDP_SIM_HAVE_FSYNC 1
+#endif
+
+namespace trdp::simulation {
+namespace {
+
+/// Length of @p text up to and including its last newline.
+[[nodiscard]] std::size_t completeLength(std::string_view text) noexcept {
+    const auto last = text.rfind('\n');
+    return last == std::string_view::npos ? 0 : last + 1;
+}
+
+[[nodiscard]] bool isEntry(std::string_view line) noexcept {
+    const auto first = line.find_first_not_of(" \t\r");
+    return first != std::string_view::npos && line[first] != '#';
+}
+
+/// Calls @p visitor for every entry line of @p text; returns the number of entries.
+std::size_t visitLines(std::string_view text, const ManifestJournal::LineVisitor &visitor) {
+    std::size_t entries = 0;
+    while (!text.empty()) {
+        const auto end = text.find('\n');
+        auto line = text.substr(0, end);
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        if (isEntry(line)) {
+            visitor(line);
+            ++entries;
+        }
+        if (end == std::string_view::npos) {
+            break;
+        }
+        text.remove_prefix(end + 1);
+    }
+    return entries;
+}
+
+#ifdef TRDP_SIM_HAVE_FSYNC
+
+void writeAll(int fd, std::string_view data, const std::filesystem::path &path) {
+    while (!data.empty()) {
+        const auto written = ::write(fd, data.data(), data.size());
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Failed to write " + path.string());
+        }
+        data.remove_prefix(static_cast<std::size_t>(written));
+    }
+}
+
+void syncFile(int fd, const std::filesystem::path &path) {
+    if (::fsync(fd) != 0) {
+        throw std::runtime_error("Failed to sync " + path.string());
+    }
+}
+
+/// Makes a rename or file creation inside @p directory durable.
+void syncDirectory(const std::filesystem::path &directory) {
+    const int fd = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+}
+
+#endif
+
+} // namespace
+
+ManifestJournal::ManifestJournal(std::filesystem::path snapshotPath, std::string header, Options options)
+    : m_snapshotPath(std::move(snapshotPath)), m_header(std::move(header)), m_options(options) {
+    m_journalPath = m_snapshotPath;
+    m_journalPath += ".journal";
+}
+
+ManifestJournal::~ManifestJournal() {
+    closeJournal();
+}
+
+void ManifestJournal::replay(const LineVisitor &visitor) {
+    if (std::filesystem::exists(m_snapshotPath)) {
+        visitLines(m_mappings.emplace_back(m_snapshotPath).text(), visitor);
+    }
+    m_journalEntries = 0;
+    if (!std::filesystem::exists(m_journalPath)) {
+        m_tailChecked = true;
+        return;
+    }
+    const auto journal = m_mappings.emplace_back(m_journalPath).text();
+    const auto complete = completeLength(journal);
+    m_journalEntries = visitLines(journal.substr(0, complete), visitor);
+    // Shrinking a mapped file is fine: no visited line reaches past the cut.
+    truncateJournal(complete, journal.size());
+}
+
+void ManifestJournal::append(const std::string &entry) {
+    append(std::span<const std::string>{&entry, 1});
+}
+
+void ManifestJournal::append(std::span<const std::string> entries) {
+    if (entries.empty()) {
+        return;
+    }
+    std::string data;
+    for (const auto &entry : entries) {
+        if (entry.find('\n') != std::string::npos) {
+            throw std::invalid_argument("Manifest entries must be single lines");
+        }
+        data += entry;
+        data.push_back('\n');
+    }
+    writeJournal(data);
+    m_journalEntries += entries.size();
+}
+
+std::size_t ManifestJournal::splitFields(std::string_view line, std::span<std::string_view> fields) noexcept {
+    const auto first = line.find_first_not_of(" \t\r\n");
+    if (first == std::string_view::npos) {
+        return 0;
+    }
+    line = line.substr(first, line.find_last_not_of(" \t\r\n") - first + 1);
+    std::size_t count = 0;
+    for (;;) {
+        const auto end = line.find('|');
+        if (count < fields.size()) {
+            fields[count] = line.substr(0, end);
+        }
+        ++count;
+        if (end == std::string_view::npos) {
+            return count;
+        }
+        line.remove_prefix(end + 1);
+    }
+}
+
+bool ManifestJournal::compactionDue(std::size_t liveRecords) const noexcept {
+    return m_journalEntries >= m_options.compactAfter && m_journalEntries >= liveRecords;
+}
+
+void ManifestJournal::compact(std::span<const std::string> entries) {
+    std::string data = "# " + m_header + '\n';
+    for (const auto &entry : entries) {
+        data += entry;
+        data.push_back('\n');
+    }
+    auto temporary = m_snapshotPath;
+    temporary += ".tmp";
+#ifdef TRDP_SIM_HAVE_FSYNC
+    const int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open " + temporary.string());
+    }
+    try {
+        writeAll(fd, data, temporary);
+        if (m_options.sync) {
+            syncFile(fd, temporary);
+        }
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
+#else
+    {
+        std::ofstream stream{temporary, std::ios::binary | std::ios::trunc};
+        if (!stream.write(data.data(), static_cast<std::streamsize>(data.size())).flush()) {
+            throw std::runtime_error("Failed to write " + temporary.string());
+        }
+    }
+#endif
+    std::filesystem::rename(temporary, m_snapshotPath);
+#ifdef TRDP_SIM_HAVE_FSYNC
+    if (m_options.sync) {
+        syncDirectory(m_snapshotPath.parent_path());
+    }
+#endif
+
+    // The snapshot already holds every journal entry; a crash before this point only replays them twice.
+    closeJournal();
+    std::error_code ignored;
+    std::filesystem::remove(m_journalPath, ignored);
+    m_journalEntries = 0;
+}
+
+void ManifestJournal::dropTornTail() {
+    if (!std::filesystem::exists(m_journalPath)) {
+        m_tailChecked = true;
+        return;
+    }
+    const auto [complete, size] = [&] {
+        const MappedFile journal{m_journalPath};
+        return std::pair{completeLength(journal.text()), journal.size()};
+    }();
+    truncateJournal(complete, size);
+}
+
+void ManifestJournal::truncateJournal(std::size_t complete, std::size_t size) {
+    // Anything after the last newline is an append that did not complete; drop it so the next one starts clean.
+    if (complete < size) {
+        closeJournal();
+        std::filesystem::resize_file(m_journalPath, complete);
+    }
+    m_tailChecked = true;
+}
+
+void ManifestJournal::openJournal() {
+#ifdef TRDP_SIM_HAVE_FSYNC
+    const bool created = !std::filesystem::exists(m_journalPath);
+    m_journalFd = ::open(m_journalPath.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+    if (m_journalFd < 0) {
+        throw std::runtime_error("Failed to open " + m_journalPath.string());
+    }
+    if (created && m_options.sync) {
+        syncDirectory(m_journalPath.parent_path());
+    }
+#endif
+}
+
+void ManifestJournal::closeJournal() noexcept {
+#ifdef TRDP_SIM_HAVE_FSYNC
+    if (m_journalFd >= 0) {
+        ::close(m_journalFd);
+        m_journalFd = -1;
+    }
+#endif
+}
+
+void ManifestJournal::writeJournal(std::string_view data) {
+    if (!m_tailChecked) {
+        // Appending before any replay must not glue the entry onto a line a crash cut short.
+        dropTornTail();
+    }
+#ifdef TRDP_SIM_HAVE_FSYNC
+    if (m_journalFd < 0) {
+        openJournal();
+    }
+    writeAll(m_journalFd, data, m_journalPath);
+    if (m_options.sync) {
+        syncFile(m_journalFd, m_journalPath);
+    }
+#else
+    std::ofstream stream{m_journalPath, std::ios::binary | std::ios::app};
+    if (!stream.write(data.data(), static_cast<std::streamsize>(data.size())).flush()) {
+        throw std::runtime_error("Failed to write " + m_journalPath.string());
+    }
+#endif
+}
+
+} // namespace trdp::simulation
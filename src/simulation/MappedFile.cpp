@@ -0,0 +1,90 @@
+#include "trdp_simulator/simulation/MappedFile.hpp"
+
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TRDP_SIM_HAVE_MMAP 1
+#endif
+
+namespace trdp::simulation {
+
+MappedFile::MappedFile(const std::filesystem::path &path) {
+#ifdef TRDP_SIM_HAVE_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open " + path.string());
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Failed to stat " + path.string());
+    }
+    m_size = static_cast<std::size_t>(info.st_size);
+    if (m_size > 0) {
+        void *data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Failed to map " + path.string());
+        }
+        m_data = static_cast<const std::byte *>(data);
+        m_mapped = true;
+    }
+    ::close(fd);
+#else
+    std::ifstream stream{path, std::ios::binary | std::ios::ate};
+    if (!stream) {
+        throw std::runtime_error("Failed to open " + path.string());
+    }
+    m_fallback.resize(static_cast<std::size_t>(stream.tellg()));
+    stream.seekg(0);
+    stream.read(reinterpret_cast<char *>(m_fallback.data()), static_cast<std::streamsize>(m_fallback.size()));
+    m_data = m_fallback.data();
+    m_size = m_fallback.size();
+#endif
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)),
+      m_mapped(std::exchange(other.m_mapped, false)), m_fallback(std::move(other.m_fallback)) {
+    if (!m_mapped && m_size > 0) {
+        m_data = m_fallback.data();
+    }
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+        release();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_mapped = std::exchange(other.m_mapped, false);
+        m_fallback = std::move(other.m_fallback);
+        if (!m_mapped && m_size > 0) {
+            m_data = m_fallback.data();
+        }
+    }
+    return *this;
+}
+
+void MappedFile::release() noexcept {
+#ifdef TRDP_SIM_HAVE_MMAP
+    if (m_mapped) {
+        ::munmap(const_cast<std::byte *>(m_data), m_size);
+    }
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_mapped = false;
+    m_fallback.clear();
+}
+
+} // namespace trdp::simulation
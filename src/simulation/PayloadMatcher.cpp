@@ -0,0 +1,118 @@
+#include "trdp_simulator/simulation/PayloadMatcher.hpp"
+
+#include "trdp_simulator/device/DatasetLayout.hpp"
+#include "trdp_simulator/simulation/DeviceStateStore.hpp"
+#include "trdp_simulator/simulation/ScenarioParser.hpp"
+
+#include <bit>
+
+namespace trdp::simulation {
+namespace {
+
+template <typename T>
+[[nodiscard]] bool compare(FieldMatch::Op op, T actual, T expected) noexcept {
+    switch (op) {
+    case FieldMatch::Op::Equal:
+        return actual == expected;
+    case FieldMatch::Op::NotEqual:
+        return actual != expected;
+    case FieldMatch::Op::Less:
+        return actual < expected;
+    case FieldMatch::Op::LessEqual:
+        return actual <= expected;
+    case FieldMatch::Op::Greater:
+        return actual > expected;
+    case FieldMatch::Op::GreaterEqual:
+        return actual >= expected;
+    }
+    return false;
+}
+
+} // namespace
+
+PayloadMatcher::PayloadMatcher(const PayloadPredicate &predicate, const DeviceStateStore *state) {
+    if (predicate.masked) {
+        const auto &masked = *predicate.masked;
+        if (masked.value.empty()) {
+            throw ScenarioValidationError{"Masked payload match requires a value"};
+        }
+        m_mask = masked.mask.empty() ? std::vector<std::uint8_t>(masked.value.size(), 0xFF) : masked.mask;
+        if (m_mask.size() != masked.value.size()) {
+            throw ScenarioValidationError{"Payload match mask and value must have the same length"};
+        }
+        m_expected.resize(m_mask.size());
+        for (std::size_t i = 0; i < m_mask.size(); ++i) {
+            m_expected[i] = static_cast<std::uint8_t>(masked.value[i] & m_mask[i]);
+        }
+        m_maskOffset = masked.offset;
+        m_hasMasked = true;
+    }
+    if (predicate.field) {
+        m_field = *predicate.field;
+        if (m_field.named()) {
+            if (state == nullptr) {
+                throw ScenarioValidationError{"Payload field '" + m_field.name + "' requires device state"};
+            }
+            const auto ref = state->resolve(m_field.datasetId, m_field.name);
+            if (ref.size > 8) {
+                throw ScenarioValidationError{"Payload field '" + m_field.name + "' is wider than 8 bytes"};
+            }
+            m_field.offset = ref.offset;
+            m_field.width = static_cast<std::uint8_t>(ref.size);
+            if (device::isRealType(ref.type)) {
+                m_fieldKind = FieldKind::Real;
+            } else if (device::isSignedType(ref.type)) {
+                m_fieldKind = FieldKind::Signed;
+            }
+        }
+        if (m_field.width == 0 || m_field.width > 8) {
+            throw ScenarioValidationError{"Payload field width must be between 1 and 8"};
+        }
+        m_hasField = true;
+    }
+}
+
+bool PayloadMatcher::matches(std::span<const std::uint8_t> payload) const noexcept {
+    if (m_hasMasked) {
+        if (m_mask.size() > payload.size() || m_maskOffset > payload.size() - m_mask.size()) {
+            return false;
+        }
+        const auto *bytes = payload.data() + m_maskOffset;
+        for (std::size_t i = 0; i < m_mask.size(); ++i) {
+            if ((bytes[i] & m_mask[i]) != m_expected[i]) {
+                return false;
+            }
+        }
+    }
+    if (m_hasField) {
+        if (m_field.width > payload.size() || m_field.offset > payload.size() - m_field.width) {
+            return false;
+        }
+        const auto actual = readBigEndian(payload, m_field.offset, m_field.width);
+        switch (m_fieldKind) {
+        case FieldKind::Unsigned:
+            return compare(m_field.op, actual, m_field.value);
+        case FieldKind::Signed: {
+            const auto unused = 64 - 8 * m_field.width;
+            const auto extended = static_cast<std::int64_t>(actual << unused) >> unused;
+            return compare(m_field.op, extended, static_cast<std::int64_t>(m_field.value));
+        }
+        case FieldKind::Real: {
+            const double real = m_field.width == 4 ? std::bit_cast<float>(static_cast<std::uint32_t>(actual))
+                                                   : std::bit_cast<double>(actual);
+            return compare(m_field.op, real, static_cast<double>(m_field.value));
+        }
+        }
+    }
+    return true;
+}
+
+std::uint64_t readBigEndian(std::span<const std::uint8_t> payload, std::size_t offset, std::uint8_t width) noexcept {
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < width; ++i) {
+        value = (value << 8) | payload[offset + i];
+    }
+    return value;
+}
+
+} // namespace trdp::simulation
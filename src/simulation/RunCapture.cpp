@@ -0,0 +1,314 @@
+#include "trdp_simulator/simulation/RunCapture.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace trdp::simulation {
+
+namespace {
+
+constexpr std::array<char, 8> kFileMagic{'T', 'R', 'D', 'P', 'C', 'A', 'P', '1'};
+constexpr std::uint32_t kFileVersion = 1;
+constexpr std::size_t kFileHeaderSize = 16;
+constexpr std::uint32_t kBlockMagic = 0x4B424354; // "TCBK"
+
+/// On-disk block header; followed by the comIds, the columns and the blob, each padded to 8 bytes.
+struct BlockHeader {
+    std::uint32_t magic{kBlockMagic};
+    std::uint32_t records{0};
+    std::int64_t minTimestampNs{0};
+    std::int64_t maxTimestampNs{0};
+    std::uint32_t comIdCount{0};
+    std::uint32_t reserved{0};
+    std::uint64_t blobBytes{0};
+    std::uint64_t blockBytes{0};
+};
+static_assert(sizeof(BlockHeader) == 48);
+
+[[nodiscard]] constexpr std::size_t padded(std::size_t bytes) noexcept { return (bytes + 7U) & ~std::size_t{7U}; }
+
+/// Byte offsets of the columns inside a block, relative to its start.
+struct BlockLayout {
+    std::size_t comIds{0};
+    std::size_t timestamps{0};
+    std::size_t offsets{0};
+    std::size_t comIdColumn{0};
+    std::size_t datasetIds{0};
+    std::size_t sizes{0};
+    std::size_t directions{0};
+    std::size_t types{0};
+    std::size_t blob{0};
+    std::size_t end{0};
+};
+
+[[nodiscard]] BlockLayout layoutFor(std::size_t records, std::size_t comIdCount, std::size_t blobBytes) noexcept {
+    BlockLayout layout;
+    layout.comIds = sizeof(BlockHeader);
+    layout.timestamps = layout.comIds + padded(comIdCount * sizeof(std::uint32_t));
+    layout.offsets = layout.timestamps + records * sizeof(std::int64_t);
+    layout.comIdColumn = layout.offsets + records * sizeof(std::uint64_t);
+    layout.datasetIds = layout.comIdColumn + records * sizeof(std::uint32_t);
+    layout.sizes = layout.datasetIds + records * sizeof(std::uint32_t);
+    layout.directions = layout.sizes + records * sizeof(std::uint32_t);
+    layout.types = layout.directions + records;
+    layout.blob = padded(layout.types + records);
+    layout.end = layout.blob + padded(blobBytes);
+    return layout;
+}
+
+template <typename T>
+[[nodiscard]] T load(const std::byte *data) noexcept {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+template <typename T>
+void writeColumn(std::ofstream &stream, const std::vector<T> &column) {
+    stream.write(reinterpret_cast<const char *>(column.data()), static_cast<std::streamsize>(column.size() * sizeof(T)));
+}
+
+void writePadding(std::ofstream &stream, std::size_t bytes) {
+    static constexpr std::array<char, 8> kZeros{};
+    stream.write(kZeros.data(), static_cast<std::streamsize>(padded(bytes) - bytes));
+}
+
+[[nodiscard]] std::int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+[[nodiscard]] bool overlaps(const CaptureBlock &block, const CaptureQuery &query) noexcept {
+    if (block.maxTimestampNs < query.fromNs || block.minTimestampNs > query.toNs) {
+        return false;
+    }
+    return !query.comId || std::binary_search(block.comIds.begin(), block.comIds.end(), *query.comId);
+}
+
+} // namespace
+
+CaptureWriter::CaptureWriter(const std::filesystem::path &path)
+    : m_stream(path, std::ios::binary | std::ios::out | std::ios::trunc) {
+    if (!m_stream) {
+        throw std::runtime_error("Failed to open capture file: " + path.string());
+    }
+    std::array<char, kFileHeaderSize> header{};
+    std::memcpy(header.data(), kFileMagic.data(), kFileMagic.size());
+    std::memcpy(header.data() + kFileMagic.size(), &kFileVersion, sizeof(kFileVersion));
+    m_stream.write(header.data(), header.size());
+    m_timestamps.reserve(kBlockRecords);
+}
+
+CaptureWriter::~CaptureWriter() {
+    try {
+        close();
+    } catch (...) {
+    }
+}
+
+void CaptureWriter::append(std::int64_t timestampNs, CaptureDirection direction, CaptureType type,
+                           std::uint32_t comId, std::uint32_t datasetId, std::span<const std::uint8_t> payload) {
+    if (!m_stream.is_open()) {
+        throw std::logic_error("Capture file is closed");
+    }
+    m_timestamps.push_back(timestampNs);
+    m_offsets.push_back(m_blob.size());
+    m_comIds.push_back(comId);
+    m_datasetIds.push_back(datasetId);
+    m_sizes.push_back(static_cast<std::uint32_t>(payload.size()));
+    m_directions.push_back(static_cast<std::uint8_t>(direction));
+    m_types.push_back(static_cast<std::uint8_t>(type));
+    m_blob.insert(m_blob.end(), payload.begin(), payload.end());
+    if (m_timestamps.size() >= kBlockRecords || m_blob.size() >= kBlockBlobLimit) {
+        flush();
+    }
+}
+
+void CaptureWriter::flush() {
+    if (m_timestamps.empty() || !m_stream.is_open()) {
+        return;
+    }
+    std::vector<std::uint32_t> distinct = m_comIds;
+    std::sort(distinct.begin(), distinct.end());
+    distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+
+    const auto [minTs, maxTs] = std::minmax_element(m_timestamps.begin(), m_timestamps.end());
+    BlockHeader header;
+    header.records = static_cast<std::uint32_t>(m_timestamps.size());
+    header.minTimestampNs = *minTs;
+    header.maxTimestampNs = *maxTs;
+    header.comIdCount = static_cast<std::uint32_t>(distinct.size());
+    header.blobBytes = m_blob.size();
+    header.blockBytes = layoutFor(m_timestamps.size(), distinct.size(), m_blob.size()).end;
+
+    m_stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    writeColumn(m_stream, distinct);
+    writePadding(m_stream, distinct.size() * sizeof(std::uint32_t));
+    writeColumn(m_stream, m_timestamps);
+    writeColumn(m_stream, m_offsets);
+    writeColumn(m_stream, m_comIds);
+    writeColumn(m_stream, m_datasetIds);
+    writeColumn(m_stream, m_sizes);
+    writeColumn(m_stream, m_directions);
+    writeColumn(m_stream, m_types);
+    writePadding(m_stream, m_timestamps.size() * (3 * sizeof(std::uint32_t) + 2));
+    writeColumn(m_stream, m_blob);
+    writePadding(m_stream, m_blob.size());
+    m_stream.flush();
+    if (!m_stream) {
+        throw std::runtime_error("Failed to write capture block");
+    }
+
+    m_written += m_timestamps.size();
+    m_timestamps.clear();
+    m_offsets.clear();
+    m_comIds.clear();
+    m_datasetIds.clear();
+    m_sizes.clear();
+    m_directions.clear();
+    m_types.clear();
+    m_blob.clear();
+}
+
+void CaptureWriter::close() {
+    if (!m_stream.is_open()) {
+        return;
+    }
+    flush();
+    m_stream.close();
+}
+
+CaptureReader::CaptureReader(const std::filesystem::path &path) : m_path(path), m_file(path) {
+    const auto bytes = m_file.bytes();
+    if (bytes.size() < kFileHeaderSize || std::memcmp(bytes.data(), kFileMagic.data(), kFileMagic.size()) != 0) {
+        throw std::runtime_error("Not a capture file: " + path.string());
+    }
+    if (load<std::uint32_t>(bytes.data() + kFileMagic.size()) != kFileVersion) {
+        throw std::runtime_error("Unsupported capture file version: " + path.string());
+    }
+    std::size_t offset = kFileHeaderSize;
+    while (bytes.size() - offset >= sizeof(BlockHeader)) {
+        BlockHeader header;
+        std::memcpy(&header, bytes.data() + offset, sizeof(header));
+        if (header.magic != kBlockMagic || header.records == 0 || header.blobBytes > bytes.size()) {
+            break;
+        }
+        const auto layout = layoutFor(header.records, header.comIdCount, header.blobBytes);
+        if (header.blockBytes != layout.end || layout.end > bytes.size() - offset) {
+            break;
+        }
+        CaptureBlock block;
+        block.offset = offset;
+        block.records = header.records;
+        block.minTimestampNs = header.minTimestampNs;
+        block.maxTimestampNs = header.maxTimestampNs;
+        block.blobBytes = header.blobBytes;
+        block.comIds.resize(header.comIdCount);
+        std::memcpy(block.comIds.data(), bytes.data() + offset + layout.comIds,
+                    block.comIds.size() * sizeof(std::uint32_t));
+        m_records += block.records;
+        m_blocks.push_back(std::move(block));
+        offset += layout.end;
+    }
+}
+
+std::vector<std::size_t> CaptureReader::candidateBlocks(const CaptureQuery &query) const {
+    std::vector<std::size_t> indexes;
+    for (std::size_t i = 0; i < m_blocks.size(); ++i) {
+        if (overlaps(m_blocks[i], query)) {
+            indexes.push_back(i);
+        }
+    }
+    return indexes;
+}
+
+CaptureRecord CaptureReader::recordAt(const CaptureBlock &block, std::size_t index) const noexcept {
+    const std::byte *start = m_file.bytes().data() + block.offset;
+    const auto layout = layoutFor(block.records, block.comIds.size(), block.blobBytes);
+    CaptureRecord record;
+    record.timestampNs = load<std::int64_t>(start + layout.timestamps + index * sizeof(std::int64_t));
+    record.comId = load<std::uint32_t>(start + layout.comIdColumn + index * sizeof(std::uint32_t));
+    record.datasetId = load<std::uint32_t>(start + layout.datasetIds + index * sizeof(std::uint32_t));
+    record.direction = static_cast<CaptureDirection>(start[layout.directions + index]);
+    record.type = static_cast<CaptureType>(start[layout.types + index]);
+    const auto payloadOffset = load<std::uint64_t>(start + layout.offsets + index * sizeof(std::uint64_t));
+    const auto size = load<std::uint32_t>(start + layout.sizes + index * sizeof(std::uint32_t));
+    record.payload = {reinterpret_cast<const std::uint8_t *>(start + layout.blob) + payloadOffset, size};
+    return record;
+}
+
+void CaptureReader::scan(const CaptureQuery &query, const Visitor &visitor) const {
+    const std::byte *base = m_file.bytes().data();
+    for (const auto &block : m_blocks) {
+        if (!overlaps(block, query)) {
+            continue;
+        }
+        // Filter on the comId and timestamp columns first; the other columns are only read for matches.
+        const std::byte *start = base + block.offset;
+        const auto layout = layoutFor(block.records, block.comIds.size(), block.blobBytes);
+        for (std::size_t i = 0; i < block.records; ++i) {
+            const auto comId = load<std::uint32_t>(start + layout.comIdColumn + i * sizeof(std::uint32_t));
+            if (query.comId && comId != *query.comId) {
+                continue;
+            }
+            const auto timestamp = load<std::int64_t>(start + layout.timestamps + i * sizeof(std::int64_t));
+            if (timestamp < query.fromNs || timestamp > query.toNs) {
+                continue;
+            }
+            visitor(recordAt(block, i));
+        }
+    }
+}
+
+std::int64_t CaptureReader::firstTimestampNs() const noexcept {
+    if (m_blocks.empty()) {
+        return 0;
+    }
+    return std::min_element(m_blocks.begin(), m_blocks.end(), [](const auto &lhs, const auto &rhs) {
+               return lhs.minTimestampNs < rhs.minTimestampNs;
+           })->minTimestampNs;
+}
+
+bool CaptureReader::Cursor::next(CaptureRecord &record) {
+    const auto &blocks = m_reader->m_blocks;
+    while (m_block < blocks.size() && m_index >= blocks[m_block].records) {
+        ++m_block;
+        m_index = 0;
+    }
+    if (m_block >= blocks.size()) {
+        return false;
+    }
+    record = m_reader->recordAt(blocks[m_block], m_index++);
+    return true;
+}
+
+std::vector<CaptureRecord> CaptureReader::select(const CaptureQuery &query) const {
+    std::vector<CaptureRecord> records;
+    scan(query, [&](const CaptureRecord &record) { records.push_back(record); });
+    return records;
+}
+
+void TelegramCapture::onProcessDataSent(const communication::ProcessDataMessage &message) {
+    m_writer.append(nowNs(), CaptureDirection::Sent, CaptureType::ProcessData, message.comId, message.datasetId,
+                    message.payload);
+}
+
+void TelegramCapture::onMessageDataSent(const communication::MessageDataMessage &message) {
+    m_writer.append(nowNs(), CaptureDirection::Sent, CaptureType::MessageData, message.comId, message.datasetId,
+                    message.payload);
+}
+
+void TelegramCapture::onProcessDataReceived(const communication::ProcessDataMessage &message) {
+    m_writer.append(nowNs(), CaptureDirection::Received, CaptureType::ProcessData, message.comId, message.datasetId,
+                    message.payload);
+}
+
+void TelegramCapture::onMessageDataReceived(const communication::MessageDataMessage &message) {
+    m_writer.append(nowNs(), CaptureDirection::Received, CaptureType::MessageData, message.comId, message.datasetId,
+                    message.payload);
+}
+
+} // namespace trdp::simulation
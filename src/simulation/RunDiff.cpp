@@ -0,0 +1,213 @@
+#include "trdp_simulator/simulation/RunDiff.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <unordered_map>
+
+namespace trdp::simulation {
+
+namespace {
+
+struct Pending {
+    CaptureRecord record;
+    std::uint64_t sequence{0};
+    std::int64_t offsetNs{0};
+};
+
+/// Telegrams of one comId and direction waiting for a partner; at most one side is non-empty.
+struct Stream {
+    std::deque<Pending> pending[2];
+    std::uint64_t sequence[2]{0, 0};
+    TelegramDiff diff;
+};
+
+/// Entry in a side's arrival-ordered expiry queue; stale once its telegram has been matched.
+struct Arrival {
+    std::int64_t offsetNs{0};
+    Stream *stream{nullptr};
+    std::uint64_t sequence{0};
+};
+
+[[nodiscard]] std::uint64_t streamKey(const CaptureRecord &record) noexcept {
+    return (std::uint64_t{record.comId} << 8U) | static_cast<std::uint8_t>(record.direction);
+}
+
+class Differ {
+public:
+    explicit Differ(const RunDiffOptions &options, RunDiffReport &report) : m_options(options), m_report(report) {}
+
+    /// Offers the next telegram of @p side (0 = first run) at @p offsetNs into that run.
+    void offer(int side, const CaptureRecord &record, std::int64_t offsetNs) {
+        const auto [it, inserted] = m_streams.try_emplace(streamKey(record));
+        auto &stream = it->second;
+        if (inserted) {
+            stream.diff.comId = record.comId;
+            stream.diff.direction = record.direction;
+        }
+        const auto sequence = stream.sequence[side]++;
+        auto &partners = stream.pending[1 - side];
+        if (!partners.empty()) {
+            const auto partner = partners.front();
+            partners.pop_front();
+            if (side == 0) {
+                compare(stream.diff, record, sequence, offsetNs, partner.record, partner.offsetNs);
+            } else {
+                compare(stream.diff, partner.record, partner.sequence, partner.offsetNs, record, offsetNs);
+            }
+            return;
+        }
+        stream.pending[side].push_back({record, sequence, offsetNs});
+        m_arrivals[side].push_back({offsetNs, &stream, sequence});
+    }
+
+    /// Gives up on telegrams of @p side that arrived more than the match window before @p otherOffsetNs.
+    void expire(int side, std::int64_t otherOffsetNs) {
+        auto &arrivals = m_arrivals[side];
+        while (!arrivals.empty() && arrivals.front().offsetNs < otherOffsetNs - m_options.matchWindow.count()) {
+            unmatched(side, arrivals.front());
+            arrivals.pop_front();
+        }
+    }
+
+    void finish() {
+        for (int side = 0; side < 2; ++side) {
+            for (const auto &arrival : m_arrivals[side]) {
+                unmatched(side, arrival);
+            }
+            m_arrivals[side].clear();
+        }
+        for (auto &[key, stream] : m_streams) {
+            m_report.telegrams.push_back(stream.diff);
+        }
+        std::sort(m_report.telegrams.begin(), m_report.telegrams.end(), [](const auto &lhs, const auto &rhs) {
+            return lhs.comId != rhs.comId ? lhs.comId < rhs.comId : lhs.direction < rhs.direction;
+        });
+    }
+
+private:
+    void compare(TelegramDiff &diff, const CaptureRecord &a, std::uint64_t sequence, std::int64_t offsetA,
+                 const CaptureRecord &b, std::int64_t offsetB) {
+        ++diff.matched;
+        const auto shift = offsetB - offsetA;
+        diff.timingShiftNs += shift;
+        diff.timingDelta.record(std::chrono::nanoseconds{shift < 0 ? -shift : shift});
+        const auto differing = countDifferingBytes(a.payload, b.payload);
+        if (differing == 0 && a.datasetId == b.datasetId && a.type == b.type) {
+            return;
+        }
+        ++diff.changed;
+        diff.bytesDiffering += differing;
+        sample({DiffKind::Changed, a.direction, a.comId, sequence, std::chrono::nanoseconds{offsetA}, differing});
+    }
+
+    void unmatched(int side, const Arrival &arrival) {
+        auto &pending = arrival.stream->pending[side];
+        if (pending.empty() || pending.front().sequence != arrival.sequence) {
+            return;
+        }
+        const auto held = pending.front();
+        pending.pop_front();
+        auto &diff = arrival.stream->diff;
+        const auto kind = side == 0 ? DiffKind::Missing : DiffKind::Added;
+        ++(side == 0 ? diff.missing : diff.added);
+        diff.bytesDiffering += held.record.payload.size();
+        sample({kind, held.record.direction, held.record.comId, held.sequence,
+                std::chrono::nanoseconds{held.offsetNs}, held.record.payload.size()});
+    }
+
+    void sample(const DiffSample &sample) {
+        if (m_report.samples.size() < m_options.maxSamples) {
+            m_report.samples.push_back(sample);
+        }
+    }
+
+    const RunDiffOptions &m_options;
+    RunDiffReport &m_report;
+    std::unordered_map<std::uint64_t, Stream> m_streams;
+    std::deque<Arrival> m_arrivals[2];
+};
+
+} // namespace
+
+bool RunDiffReport::equivalent() const noexcept {
+    return std::all_of(telegrams.begin(), telegrams.end(), [](const TelegramDiff &diff) {
+        return diff.changed == 0 && diff.missing == 0 && diff.added == 0;
+    });
+}
+
+RunDiffReport diffCaptures(const CaptureReader &a, const CaptureReader &b, const RunDiffOptions &options) {
+    RunDiffReport report;
+    report.recordsA = a.recordCount();
+    report.recordsB = b.recordCount();
+    Differ differ{options, report};
+
+    CaptureReader::Cursor cursors[2] = {a.cursor(), b.cursor()};
+    const std::int64_t starts[2] = {a.firstTimestampNs(), b.firstTimestampNs()};
+    CaptureRecord heads[2];
+    bool live[2] = {cursors[0].next(heads[0]), cursors[1].next(heads[1])};
+    while (live[0] || live[1]) {
+        // Advance whichever run is behind so both progress through the same span of run time.
+        int side = 0;
+        if (!live[0] || (live[1] && heads[1].timestampNs - starts[1] < heads[0].timestampNs - starts[0])) {
+            side = 1;
+        }
+        const auto offset = heads[side].timestampNs - starts[side];
+        // Partners older than the match window are given up on first, so a dropped telegram is reported as missing
+        // instead of pairing the rest of its comId with the wrong partners.
+        differ.expire(1 - side, offset);
+        differ.offer(side, heads[side], offset);
+        if (!live[1 - side]) {
+            // The other run has ended: nothing left can be matched, so nothing needs to be held.
+            differ.expire(side, std::numeric_limits<std::int64_t>::max());
+        }
+        live[side] = cursors[side].next(heads[side]);
+    }
+    differ.finish();
+    return report;
+}
+
+std::size_t countDifferingBytes(std::span<const std::uint8_t> a, std::span<const std::uint8_t> b) noexcept {
+    const auto common = std::min(a.size(), b.size());
+    std::size_t differing = std::max(a.size(), b.size()) - common;
+    if (common == 0 || std::memcmp(a.data(), b.data(), common) == 0) {
+        return differing;
+    }
+    // Eight bytes per word: a byte of the XOR is non-zero exactly when its high bit survives the mask below. The
+    // resulting 0/1 lanes are summed in place and folded every 255 words, so no per-word popcount is needed.
+    constexpr std::uint64_t kLow7 = 0x7F7F7F7F7F7F7F7FULL;
+    constexpr std::uint64_t kEvenBytes = 0x00FF00FF00FF00FFULL;
+    const auto fold = [](std::uint64_t lanes) {
+        const std::uint64_t pairs = (lanes & kEvenBytes) + ((lanes >> 8U) & kEvenBytes);
+        return static_cast<std::size_t>((pairs * 0x0001000100010001ULL) >> 48U);
+    };
+    const auto flags = [](const std::uint8_t *lhs, const std::uint8_t *rhs) {
+        std::uint64_t left;
+        std::uint64_t right;
+        std::memcpy(&left, lhs, sizeof(left));
+        std::memcpy(&right, rhs, sizeof(right));
+        const std::uint64_t x = left ^ right;
+        return ((((x & kLow7) + kLow7) | x) & ~kLow7) >> 7U;
+    };
+    // Two independent accumulators keep both halves of each 16-byte step in flight.
+    std::uint64_t lanes[2] = {0, 0};
+    unsigned folded = 0;
+    std::size_t i = 0;
+    for (; i + 2 * sizeof(std::uint64_t) <= common; i += 2 * sizeof(std::uint64_t)) {
+        lanes[0] += flags(a.data() + i, b.data() + i);
+        lanes[1] += flags(a.data() + i + 8, b.data() + i + 8);
+        if (++folded == 255) {
+            differing += fold(lanes[0]) + fold(lanes[1]);
+            lanes[0] = lanes[1] = 0;
+            folded = 0;
+        }
+    }
+    differing += fold(lanes[0]) + fold(lanes[1]);
+    for (; i < common; ++i) {
+        differing += a[i] != b[i] ? 1 : 0;
+    }
+    return differing;
+}
+
+} // namespace trdp::simulation
@@ -0,0 +1,258 @@
+#include "trdp_simulator/simulation/RunIndex.hpp"
+
+#include "trdp_simulator/simulation/ManifestJournal.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+namespace trdp::simulation {
+namespace {
+
+/// Fields of a run entry; the expectations field may be missing from entries written by older versions.
+constexpr std::size_t kRunFields = 8;
+constexpr std::size_t kRequiredRunFields = 7;
+
+[[nodiscard]] std::string serialiseField(std::string value) {
+    for (char &ch : value) {
+        if (ch == '|') {
+            ch = '/';
+        } else if (ch == '\n' || ch == '\r') {
+            ch = ' ';
+        }
+    }
+    return value;
+}
+
+[[nodiscard]] std::string serialiseExpectations(const std::vector<ExpectationResult> &expectations) {
+    std::string encoded;
+    for (const auto &expectation : expectations) {
+        if (!encoded.empty()) {
+            encoded.push_back(',');
+        }
+        auto label = serialiseField(expectation.label);
+        for (char &ch : label) {
+            if (ch == ',' || ch == '=') {
+                ch = '_';
+            }
+        }
+        encoded += label + '=' + (expectation.passed ? "pass" : "fail");
+    }
+    return encoded;
+}
+
+[[nodiscard]] std::vector<ExpectationResult> parseExpectations(std::string_view encoded) {
+    std::vector<ExpectationResult> expectations;
+    while (!encoded.empty()) {
+        const auto end = encoded.find(',');
+        const auto entry = encoded.substr(0, end);
+        if (const auto pos = entry.rfind('='); pos != std::string_view::npos) {
+            expectations.push_back(
+                ExpectationResult{std::string{entry.substr(0, pos)}, entry.substr(pos + 1) == "pass", {}});
+        }
+        if (end == std::string_view::npos) {
+            break;
+        }
+        encoded.remove_prefix(end + 1);
+    }
+    return expectations;
+}
+
+[[nodiscard]] std::string cursorFor(const RunRecord &record) {
+    return record.startedAt + '|' + record.id;
+}
+
+[[nodiscard]] std::string_view truncated(std::string_view startedAt, std::size_t length) noexcept {
+    return startedAt.substr(0, length);
+}
+
+/// Decodes up to @p limit runs of [first, last) after skipping @p offset of them; reports whether any run was left.
+template <typename Iterator>
+bool collect(Iterator first, Iterator last, std::size_t offset, std::size_t limit, std::vector<RunRecord> &runs) {
+    for (; first != last && offset > 0; ++first, --offset) {
+    }
+    for (; first != last; ++first) {
+        if (limit != 0 && runs.size() == limit) {
+            return true;
+        }
+        // Indexed lines were validated when they were indexed.
+        runs.push_back(*RunIndex::decode((*first)->line));
+    }
+    return false;
+}
+
+} // namespace
+
+std::string RunIndex::encode(const RunRecord &record) {
+    return record.id + '|' + record.artefactPath.string() + '|' + record.scenarioId + '|' + record.startedAt + '|' +
+           record.completedAt + '|' + (record.success ? "1" : "0") + '|' + serialiseField(record.detail) + '|' +
+           serialiseExpectations(record.expectations);
+}
+
+std::optional<RunRecord> RunIndex::decode(std::string_view line) {
+    std::array<std::string_view, kRunFields> fields;
+    const auto count = ManifestJournal::splitFields(line, fields);
+    if (count < kRequiredRunFields || fields[0].empty()) {
+        return std::nullopt;
+    }
+    RunRecord record{};
+    record.id = fields[0];
+    record.artefactPath = fields[1];
+    record.scenarioId = fields[2];
+    record.startedAt = fields[3];
+    record.completedAt = fields[4];
+    record.success = fields[5] == "1";
+    record.detail = fields[6];
+    if (count > kRequiredRunFields) {
+        record.expectations = parseExpectations(fields[7]);
+    }
+    return record;
+}
+
+bool RunIndex::ByStart::operator()(const Entry *lhs, const Entry *rhs) const noexcept {
+    return std::tie(lhs->startedAt, lhs->id) < std::tie(rhs->startedAt, rhs->id);
+}
+
+bool RunIndex::ByStart::operator()(const Entry *lhs, const Position &rhs) const noexcept {
+    return std::tie(lhs->startedAt, lhs->id) < std::tie(rhs.startedAt, rhs.id);
+}
+
+bool RunIndex::ByStart::operator()(const Position &lhs, const Entry *rhs) const noexcept {
+    return std::tie(lhs.startedAt, lhs.id) < std::tie(rhs->startedAt, rhs->id);
+}
+
+bool RunIndex::ByStart::operator()(const Entry *lhs, const Until &rhs) const noexcept {
+    return truncated(lhs->startedAt, rhs.prefix.size()) <= rhs.prefix;
+}
+
+bool RunIndex::ByStart::operator()(const Until &lhs, const Entry *rhs) const noexcept {
+    return lhs.prefix < truncated(rhs->startedAt, lhs.prefix.size());
+}
+
+void RunIndex::upsert(std::string line) {
+    m_ownedLines.push_back(std::move(line));
+    if (!index(m_ownedLines.back())) {
+        m_ownedLines.pop_back();
+    }
+}
+
+void RunIndex::upsertView(std::string_view line) {
+    (void)index(line);
+}
+
+void RunIndex::clear() {
+    m_byScenario.clear();
+    m_all = Indexes{};
+    m_runs.clear();
+    m_ownedLines.clear();
+}
+
+std::optional<RunRecord> RunIndex::find(std::string_view id) const {
+    const auto it = m_runs.find(id);
+    return it == m_runs.end() ? std::nullopt : decode(it->second.line);
+}
+
+RunPage RunIndex::query(const RunQuery &query) const {
+    RunPage page;
+    const Indexes *scope = &m_all;
+    if (query.scenarioId) {
+        const auto it = m_byScenario.find(*query.scenarioId);
+        if (it == m_byScenario.end()) {
+            return page;
+        }
+        scope = &it->second;
+    }
+    const Ordered &ordered = query.success ? scope->byOutcome[*query.success ? 1 : 0] : scope->all;
+
+    auto first = query.startedFrom ? ordered.lower_bound(Position{*query.startedFrom, {}}) : ordered.begin();
+    auto last = query.startedUntil ? ordered.lower_bound(Until{*query.startedUntil}) : ordered.end();
+    if (query.after) {
+        const auto separator = query.after->find('|');
+        if (separator == std::string::npos) {
+            throw std::invalid_argument("Malformed run cursor: " + *query.after);
+        }
+        const Position cursor{std::string_view{*query.after}.substr(0, separator),
+                              std::string_view{*query.after}.substr(separator + 1)};
+        const ByStart less{};
+        // The cursor narrows the range from the side the previous page started at.
+        if (query.order == RunOrder::OldestFirst) {
+            const auto resume = ordered.upper_bound(cursor);
+            if (first != ordered.end() && (resume == ordered.end() || less(*first, *resume))) {
+                first = resume;
+            }
+        } else {
+            const auto resume = ordered.lower_bound(cursor);
+            if (resume != ordered.end() && (last == ordered.end() || less(*resume, *last))) {
+                last = resume;
+            }
+        }
+    }
+    if (first == ordered.end() || (last != ordered.end() && !ByStart{}(*first, *last))) {
+        return page;
+    }
+
+    if (query.limit != 0) {
+        page.runs.reserve(std::min(query.limit, ordered.size()));
+    }
+    const bool more = query.order == RunOrder::OldestFirst
+                          ? collect(first, last, query.offset, query.limit, page.runs)
+                          : collect(std::make_reverse_iterator(last), std::make_reverse_iterator(first), query.offset,
+                                    query.limit, page.runs);
+    if (more) {
+        page.nextCursor = cursorFor(page.runs.back());
+    }
+    return page;
+}
+
+void RunIndex::forEachEntry(const std::function<void(std::string_view)> &visitor) const {
+    for (const auto *entry : m_all.all) {
+        visitor(entry->line);
+    }
+}
+
+bool RunIndex::index(std::string_view line) {
+    std::array<std::string_view, kRunFields> fields;
+    if (ManifestJournal::splitFields(line, fields) < kRequiredRunFields || fields[0].empty()) {
+        return false;
+    }
+    const Entry entry{line, fields[0], fields[2], fields[3], fields[5] == "1"};
+    const auto [it, inserted] = m_runs.try_emplace(entry.id, entry);
+    if (!inserted) {
+        // The indexes order by fields of the stored entry, so it must leave them before it changes. The map key
+        // keeps viewing the replaced line, which stays alive until clear().
+        unlink(it->second);
+        it->second = entry;
+    }
+    link(it->second);
+    return true;
+}
+
+void RunIndex::link(const Entry &entry) {
+    const auto outcome = entry.success ? 1 : 0;
+    // Runs are mostly recorded and replayed in start order, where an end hint makes each insert amortised O(1).
+    const auto append = [&entry](Ordered &ordered) { ordered.insert(ordered.end(), &entry); };
+    append(m_all.all);
+    append(m_all.byOutcome[outcome]);
+    auto &scenario = m_byScenario[entry.scenarioId];
+    append(scenario.all);
+    append(scenario.byOutcome[outcome]);
+}
+
+void RunIndex::unlink(const Entry &entry) {
+    const auto outcome = entry.success ? 1 : 0;
+    m_all.all.erase(&entry);
+    m_all.byOutcome[outcome].erase(&entry);
+    const auto it = m_byScenario.find(entry.scenarioId);
+    if (it == m_byScenario.end()) {
+        return;
+    }
+    it->second.all.erase(&entry);
+    it->second.byOutcome[outcome].erase(&entry);
+    if (it->second.all.empty()) {
+        m_byScenario.erase(it);
+    }
+}
+
+} // namespace trdp::simulation
@@ -0,0 +1,119 @@
+#include "trdp_simulator/simulation/ScenarioCache.hpp"
+
+#include <utility>
+
+namespace trdp::simulation {
+namespace {
+
+/// Heap bytes of @p value; short strings live inside the object itself.
+[[nodiscard]] std::size_t stringBytes(const std::string &value) noexcept {
+    static const std::size_t inlineCapacity = std::string{}.capacity();
+    return value.capacity() > inlineCapacity ? value.capacity() + 1 : 0;
+}
+
+template <typename T> [[nodiscard]] std::size_t vectorBytes(const std::vector<T> &values) noexcept {
+    return values.capacity() * sizeof(T);
+}
+
+[[nodiscard]] std::size_t eventBytes(const ScenarioEvent &event) noexcept {
+    return stringBytes(event.label) + vectorBytes(event.payload) + stringBytes(event.timeline) +
+           stringBytes(event.field) + stringBytes(event.value);
+}
+
+[[nodiscard]] std::size_t predicateBytes(const PayloadPredicate &predicate) noexcept {
+    std::size_t bytes = predicate.field ? stringBytes(predicate.field->name) : 0;
+    if (predicate.masked) {
+        bytes += vectorBytes(predicate.masked->mask) + vectorBytes(predicate.masked->value);
+    }
+    return bytes;
+}
+
+} // namespace
+
+std::size_t scenarioFootprint(const Scenario &scenario) noexcept {
+    std::size_t bytes = sizeof(Scenario) + stringBytes(scenario.id) + stringBytes(scenario.deviceProfileId);
+    bytes += vectorBytes(scenario.events);
+    for (const auto &event : scenario.events) {
+        bytes += eventBytes(event);
+    }
+    bytes += vectorBytes(scenario.timelines);
+    for (const auto &timeline : scenario.timelines) {
+        bytes += stringBytes(timeline.name);
+    }
+    bytes += vectorBytes(scenario.triggers);
+    for (const auto &trigger : scenario.triggers) {
+        bytes += stringBytes(trigger.label) + predicateBytes(trigger.predicate) + eventBytes(trigger.action);
+    }
+    bytes += vectorBytes(scenario.expectations);
+    for (const auto &expectation : scenario.expectations) {
+        bytes += stringBytes(expectation.label) + predicateBytes(expectation.predicate);
+    }
+    return bytes + vectorBytes(scenario.faults) + vectorBytes(scenario.network);
+}
+
+ScenarioCache::ScenarioCache(std::size_t budgetBytes) {
+    m_stats.budgetBytes = budgetBytes;
+}
+
+std::shared_ptr<const Scenario> ScenarioCache::find(const std::string &checksum) {
+    const std::lock_guard lock{m_mutex};
+    const auto it = m_index.find(checksum);
+    if (it == m_index.end()) {
+        ++m_stats.misses;
+        return nullptr;
+    }
+    ++m_stats.hits;
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return it->second->scenario;
+}
+
+std::shared_ptr<const Scenario> ScenarioCache::insert(const std::string &checksum, Scenario scenario) {
+    const auto bytes = scenarioFootprint(scenario);
+    auto shared = std::make_shared<const Scenario>(std::move(scenario));
+
+    const std::lock_guard lock{m_mutex};
+    if (const auto it = m_index.find(checksum); it != m_index.end()) {
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return it->second->scenario;
+    }
+    if (bytes > m_stats.budgetBytes) {
+        return shared;
+    }
+    m_entries.push_front(Entry{checksum, shared, bytes});
+    m_index.emplace(checksum, m_entries.begin());
+    m_stats.bytes += bytes;
+    evictLocked();
+    return shared;
+}
+
+void ScenarioCache::setBudget(std::size_t budgetBytes) {
+    const std::lock_guard lock{m_mutex};
+    m_stats.budgetBytes = budgetBytes;
+    evictLocked();
+}
+
+void ScenarioCache::clear() {
+    const std::lock_guard lock{m_mutex};
+    m_entries.clear();
+    m_index.clear();
+    m_stats.bytes = 0;
+}
+
+ScenarioCacheStats ScenarioCache::stats() const {
+    const std::lock_guard lock{m_mutex};
+    auto stats = m_stats;
+    stats.entries = m_entries.size();
+    return stats;
+}
+
+void ScenarioCache::evictLocked() {
+    while (m_stats.bytes > m_stats.budgetBytes) {
+        const auto &victim = m_entries.back();
+        m_stats.bytes -= victim.bytes;
+        m_index.erase(victim.checksum);
+        m_entries.pop_back();
+        ++m_stats.evictions;
+    }
+}
+
+} // namespace trdp::simulation
@@ -22,16 +22,14 @@ Scenario ScenarioLoader::load(const std::string &scenarioId) const {
     if (!std::filesystem::exists(path)) {
         throw std::runtime_error("Scenario file not found: " + path.string());
     }
-    m_validator.validate(path);
-    return ScenarioParser::parse(path, m_repository);
+    return ScenarioParser::parse(path, m_repository, m_validator);
 }
 
 Scenario ScenarioLoader::loadFromFile(const std::filesystem::path &path) const {
     if (!std::filesystem::exists(path)) {
         throw std::runtime_error("Scenario file not found: " + path.string());
     }
-    m_validator.validate(path);
-    return ScenarioParser::parse(path, m_repository);
+    return ScenarioParser::parse(path, m_repository, m_validator);
 }
 
 } // namespace trdp::simulation
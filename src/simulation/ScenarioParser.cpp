@@ -1,10 +1,17 @@
 #include "trdp_simulator/simulation/ScenarioParser.hpp"
 
+#include "trdp_simulator/device/DeviceConfig.hpp"
 #include "trdp_simulator/device/DeviceProfileRepository.hpp"
+#include "trdp_simulator/simulation/DeviceStateStore.hpp"
+#include "trdp_simulator/simulation/PayloadMatcher.hpp"
+#include "trdp_simulator/simulation/ScenarioSchemaValidator.hpp"
+#include "trdp_simulator/simulation/ScenarioVisitor.hpp"
 #include "trdp_simulator/simulation/ScenarioYaml.hpp"
 
+#include <charconv>
 #include <filesystem>
-#include <fstream>
+#include <optional>
+#include <string_view>
 
 namespace trdp::simulation {
 namespace {
@@ -15,111 +22,549 @@ struct EventState {
     bool labelSet{false};
 };
 
-void applyField(EventState &state, const std::string &key, const std::string &value) {
+[[nodiscard]] bool parseSource(std::string_view value) {
+    if (value == "state") {
+        return true;
+    }
+    if (value == "payload") {
+        return false;
+    }
+    throw ScenarioValidationError{"Unknown event source: " + std::string{value}};
+}
+
+[[nodiscard]] ScenarioEvent::Type parseReceivedType(std::string_view value) {
+    const auto type = scenario_yaml::parseType(value);
+    if (type == ScenarioEvent::Type::StateUpdate) {
+        throw ScenarioValidationError{"Received telegram type must be pd or md: " + std::string{value}};
+    }
+    return type;
+}
+
+/// Shared checks for the device state fields of events and trigger actions.
+void validateStateFields(const ScenarioEvent &event, const std::string &context) {
+    if (event.type == ScenarioEvent::Type::StateUpdate) {
+        if (event.datasetId == 0 || event.field.empty() || event.value.empty()) {
+            throw ScenarioValidationError{context + " set requires dataset_id, field and value"};
+        }
+        if (!event.payload.empty() || event.fromState || event.generator.counter) {
+            throw ScenarioValidationError{context + " set does not take a payload, source or counter"};
+        }
+        return;
+    }
+    if (!event.field.empty() || !event.value.empty()) {
+        throw ScenarioValidationError{context + " field and value are only valid for set"};
+    }
+    if (event.fromState) {
+        if (event.type != ScenarioEvent::Type::ProcessData || event.datasetId == 0) {
+            throw ScenarioValidationError{context + " source: state requires a pd event with a dataset_id"};
+        }
+        if (!event.payload.empty() || event.generator.counter) {
+            throw ScenarioValidationError{context + " source: state does not take a payload or counter"};
+        }
+    }
+}
+
+/// Checks state writes, state publishers and named payload fields against the data sets of the scenario's device.
+void validateDeviceState(const Scenario &scenario, const device::DeviceProfileRepository &repository) {
+    const auto profile = repository.get(scenario.deviceProfileId);
+    std::optional<DeviceStateStore> state;
+    try {
+        state.emplace(device::loadDeviceConfig(profile.storedPath));
+    } catch (const std::exception &ex) {
+        throw ScenarioValidationError{"Device state unavailable for " + scenario.deviceProfileId + ": " + ex.what()};
+    }
+    const auto check = [&](const ScenarioEvent &event) {
+        try {
+            if (event.type == ScenarioEvent::Type::StateUpdate) {
+                (void)DeviceStateStore::encode(state->resolve(event.datasetId, event.field), event.value);
+            } else if (event.fromState) {
+                (void)state->layout(event.datasetId);
+            }
+        } catch (const std::exception &ex) {
+            throw ScenarioValidationError{"Event '" + event.label + "': " + ex.what()};
+        }
+    };
+    for (const auto &event : scenario.events) {
+        check(event);
+    }
+    const auto resolveField = [&](const PayloadPredicate &predicate, const std::string &context) {
+        if (!predicate.field || !predicate.field->named()) {
+            return;
+        }
+        try {
+            (void)PayloadMatcher{predicate, &*state};
+        } catch (const std::exception &ex) {
+            throw ScenarioValidationError{context + ": " + ex.what()};
+        }
+    };
+    for (const auto &trigger : scenario.triggers) {
+        check(trigger.action);
+        resolveField(trigger.predicate, "Trigger '" + trigger.label + "'");
+    }
+    for (const auto &expectation : scenario.expectations) {
+        resolveField(expectation.predicate, "Expectation '" + expectation.label + "'");
+    }
+}
+
+void applyField(EventState &state, std::string_view key, std::string_view value) {
     if (key == "type") {
         state.event.type = scenario_yaml::parseType(value);
         state.typeSet = true;
     } else if (key == "label") {
         state.event.label = value;
         state.labelSet = true;
+    } else if (key == "timeline") {
+        state.event.timeline = value;
     } else if (key == "com_id") {
-        state.event.comId = static_cast<std::uint32_t>(std::stoul(value));
+        state.event.comId = scenario_yaml::parseUnsigned<std::uint32_t>(key, value);
     } else if (key == "dataset_id") {
-        state.event.datasetId = static_cast<std::uint32_t>(std::stoul(value));
+        state.event.datasetId = scenario_yaml::parseUnsigned<std::uint32_t>(key, value);
     } else if (key == "payload") {
         state.event.payload = scenario_yaml::parsePayload(value);
+    } else if (key == "source") {
+        state.event.fromState = parseSource(value);
+    } else if (key == "field") {
+        state.event.field = value;
+    } else if (key == "value") {
+        state.event.value = value;
     } else if (key == "delay_ms") {
         state.event.delay = scenario_yaml::parseDelay(value);
+    } else if (key == "repeat") {
+        state.event.generator.repeat = scenario_yaml::parseUnsigned<std::uint32_t>(key, value);
+    } else if (key == "period_ms") {
+        state.event.generator.period = scenario_yaml::parseDelay(value);
+    } else if (key == "ramp_start_hz") {
+        state.event.generator.rampStartHz = scenario_yaml::parseUnsigned<std::uint32_t>(key, value);
+    } else if (key == "ramp_end_hz") {
+        state.event.generator.rampEndHz = scenario_yaml::parseUnsigned<std::uint32_t>(key, value);
+    } else if (key.starts_with("counter_")) {
+        auto &counter = state.event.generator.counter;
+        if (!counter) {
+            counter.emplace();
+        }
+        if (key == "counter_offset") {
+            counter->offset = scenario_yaml::parseUnsigned<std::size_t>(key, value);
+        } else if (key == "counter_width") {
+            counter->width = scenario_yaml::parseUnsigned<std::uint8_t>(key, value);
+        } else if (key == "counter_start") {
+            counter->start = scenario_yaml::parseUnsigned<std::uint64_t>(key, value);
+        } else if (key == "counter_step") {
+            counter->step = scenario_yaml::parseUnsigned<std::uint64_t>(key, value);
+        } else if (key == "counter_end") {
+            counter->end = scenario_yaml::parseUnsigned<std::uint64_t>(key, value);
+        } else {
+            throw ScenarioValidationError{"Unknown event field: " + std::string{key}};
+        }
     } else {
-        throw ScenarioValidationError{"Unknown event field: " + key};
+        throw ScenarioValidationError{"Unknown event field: " + std::string{key}};
     }
 }
 
-void finaliseEvent(const EventState &state, Scenario &scenario) {
+void finaliseEvent(EventState &state, Scenario &scenario) {
     if (!state.typeSet) {
         throw ScenarioValidationError{"Scenario event is missing a type"};
     }
     if (!state.labelSet) {
         throw ScenarioValidationError{"Scenario event is missing a label"};
     }
-    scenario.events.push_back(state.event);
+    const auto &generator = state.event.generator;
+    if (generator.repeat == 0) {
+        throw ScenarioValidationError{"Event '" + state.event.label + "' repeat must be at least 1"};
+    }
+    if ((generator.rampStartHz == 0) != (generator.rampEndHz == 0)) {
+        throw ScenarioValidationError{"Event '" + state.event.label +
+                                      "' ramp requires both ramp_start_hz and ramp_end_hz"};
+    }
+    if (generator.counter) {
+        const auto &counter = *generator.counter;
+        if (counter.width == 0 || counter.width > 8) {
+            throw ScenarioValidationError{"Event '" + state.event.label + "' counter_width must be between 1 and 8"};
+        }
+        const auto size = state.event.payload.size();
+        if (counter.width > size || counter.offset > size - counter.width) {
+            throw ScenarioValidationError{"Event '" + state.event.label + "' counter field exceeds payload size"};
+        }
+        if (counter.end && *counter.end < counter.start) {
+            throw ScenarioValidationError{"Event '" + state.event.label +
+                                          "' counter_end must not be below counter_start"};
+        }
+    }
+    validateStateFields(state.event, "Event '" + state.event.label + "'");
+    scenario.events.push_back(std::move(state.event));
 }
 
-} // namespace
+/// Named fields are compiled against the device's data sets once the whole scenario is read.
+void checkPredicate(const PayloadPredicate &predicate, const std::string &context) {
+    if (!predicate.field || !predicate.field->named()) {
+        (void)PayloadMatcher{predicate};
+    } else if (predicate.field->datasetId == 0) {
+        throw ScenarioValidationError{context + " field_name requires field_dataset_id"};
+    }
+}
 
-Scenario ScenarioParser::parse(const std::filesystem::path &path, device::DeviceProfileRepository &repository) {
-    if (!std::filesystem::exists(path)) {
-        throw ScenarioValidationError{"Scenario file not found: " + path.string()};
+bool applyPredicateField(PayloadPredicate &predicate, std::string_view key, std::string_view value) {
+    if (key == "match_offset" || key == "match_mask" || key == "match_value") {
+        auto &masked = predicate.masked;
+        if (!masked) {
+            masked.emplace();
+        }
+        if (key == "match_offset") {
+            masked->offset = scenario_yaml::parseUnsigned<std::size_t>(key, value);
+        } else if (key == "match_mask") {
+            masked->mask = scenario_yaml::parsePayload(value);
+        } else {
+            masked->value = scenario_yaml::parsePayload(value);
+        }
+        return true;
+    }
+    if (key == "field_offset" || key == "field_width" || key == "field_op" || key == "field_value" ||
+        key == "field_dataset_id" || key == "field_name") {
+        auto &field = predicate.field;
+        if (!field) {
+            field.emplace();
+        }
+        if (key == "field_offset") {
+            field->offset = scenario_yaml::parseUnsigned<std::size_t>(key, value);
+        } else if (key == "field_width") {
+            field->width = scenario_yaml::parseUnsigned<std::uint8_t>(key, value);
+        } else if (key == "field_op") {
+            field->op = scenario_yaml::parseFieldOp(value);
+        } else if (key == "field_dataset_id") {
+            field->datasetId = scenario_yaml::parseUnsigned<std::uint32_t>(key, value);
+        } else if (key == "field_name") {
+            field->name = value;
+        } else {
+            field->value = scenario_yaml::parseUnsigned<std::uint64_t>(key, value);
+        }
+        return true;
+    }
+    return false;
+}
+
+struct TriggerState {
+    ScenarioTrigger trigger{};
+    bool labelSet{false};
+    bool comIdSet{false};
+    bool typeSet{false};
+};
+
+void applyTriggerField(TriggerState &state, std::string_view key, std::string_view value) {
+    auto &trigger = state.trigger;
+    if (key == "label") {
+        trigger.label = value;
+        trigger.action.label = value;
+        state.labelSet = true;
+    } else if (key == "on_type") {
+        trigger.on = parseReceivedType(value);
+    } else if (key == "on_com_id") {
+        trigger.comId = scenario_yaml::parseUnsigned<std::uint32_t>(key, value);
+        state.comIdSet = true;
+    } else if (key == "type") {
+        trigger.action.type = scenario_yaml::parseType(value);
+        state.typeSet = true;
+    } else if (key == "com_id") {
+        trigger.action.comId = scenario_yaml::parseUnsigned<std::uint32_t>(key, value);
+    } else if (key == "dataset_id") {
+        trigger.action.datasetId = scenario_yaml::parseUnsigned<std::uint32_t>(key, value);
+    } else if (key == "payload") {
+        trigger.action.payload = scenario_yaml::parsePayload(value);
+    } else if (key == "source") {
+        trigger.action.fromState = parseSource(value);
+    } else if (key == "field") {
+        trigger.action.field = value;
+    } else if (key == "value") {
+        trigger.action.value = value;
+    } else if (key == "deadline_ms") {
+        trigger.deadline = scenario_yaml::parseDelay(value);
+    } else if (!applyPredicateField(trigger.predicate, key, value)) {
+        throw ScenarioValidationError{"Unknown trigger field: " + std::string{key}};
     }
+}
 
-    std::ifstream stream{path};
-    if (!stream) {
-        throw ScenarioValidationError{"Failed to open scenario file: " + path.string()};
+void finaliseTrigger(TriggerState &state, Scenario &scenario) {
+    if (!state.labelSet) {
+        throw ScenarioValidationError{"Scenario trigger is missing a label"};
     }
+    if (!state.comIdSet) {
+        throw ScenarioValidationError{"Trigger '" + state.trigger.label + "' is missing on_com_id"};
+    }
+    if (!state.typeSet) {
+        throw ScenarioValidationError{"Trigger '" + state.trigger.label + "' is missing an action type"};
+    }
+    // Compile once here so malformed predicates are rejected at load time rather than mid-run.
+    checkPredicate(state.trigger.predicate, "Trigger '" + state.trigger.label + "'");
+    validateStateFields(state.trigger.action, "Trigger '" + state.trigger.label + "'");
+    scenario.triggers.push_back(std::move(state.trigger));
+}
 
-    Scenario scenario{};
-    scenario.id = path.stem().string();
+struct ExpectationState {
+    ScenarioExpectation expectation{};
+    bool labelSet{false};
+    bool comIdSet{false};
+};
 
-    bool inEvents = false;
-    bool eventActive = false;
-    EventState current{};
-
-    std::string rawLine;
-    while (std::getline(stream, rawLine)) {
-        const auto trimmed = scenario_yaml::trim(rawLine);
-        if (trimmed.empty() || trimmed.starts_with('#')) {
-            continue;
-        }
-
-        if (trimmed == "events:") {
-            inEvents = true;
-            continue;
-        }
-
-        if (!inEvents) {
-            const auto [key, value] = scenario_yaml::parseKeyValue(trimmed);
-            if (key == "scenario") {
-                if (value.empty()) {
-                    throw ScenarioValidationError{"Scenario id cannot be empty"};
-                }
-                scenario.id = value;
-            } else if (key == "device") {
-                if (value.empty()) {
-                    throw ScenarioValidationError{"Scenario device cannot be empty"};
-                }
-                scenario.deviceProfileId = value;
-            } else {
-                throw ScenarioValidationError{"Unknown scenario field: " + key};
-            }
-            continue;
+void applyExpectationField(ExpectationState &state, std::string_view key, std::string_view value) {
+    auto &expectation = state.expectation;
+    if (key == "label") {
+        expectation.label = value;
+        state.labelSet = true;
+    } else if (key == "type") {
+        expectation.type = parseReceivedType(value);
+    } else if (key == "com_id") {
+        expectation.comId = scenario_yaml::parseUnsigned<std::uint32_t>(key, value);
+        state.comIdSet = true;
+    } else if (key == "min_count") {
+        expectation.minCount = scenario_yaml::parseUnsigned<std::uint32_t>(key, value);
+    } else if (key == "max_count") {
+        expectation.maxCount = scenario_yaml::parseUnsigned<std::uint32_t>(key, value);
+    } else if (key == "within_ms") {
+        expectation.window = scenario_yaml::parseDelay(value);
+    } else if (key == "cycle_ms") {
+        expectation.cycle = scenario_yaml::parseDelay(value);
+    } else if (key == "cycle_tolerance_ms") {
+        expectation.cycleTolerance = scenario_yaml::parseDelay(value);
+    } else if (!applyPredicateField(expectation.predicate, key, value)) {
+        throw ScenarioValidationError{"Unknown expectation field: " + std::string{key}};
+    }
+}
+
+void finaliseExpectation(ExpectationState &state, Scenario &scenario) {
+    if (!state.labelSet) {
+        throw ScenarioValidationError{"Scenario expectation is missing a label"};
+    }
+    if (!state.comIdSet) {
+        throw ScenarioValidationError{"Expectation '" + state.expectation.label + "' is missing com_id"};
+    }
+    const auto &expectation = state.expectation;
+    if (expectation.maxCount && *expectation.maxCount < expectation.minCount) {
+        throw ScenarioValidationError{"Expectation '" + expectation.label + "' max_count is below min_count"};
+    }
+    checkPredicate(expectation.predicate, "Expectation '" + expectation.label + "'");
+    scenario.expectations.push_back(std::move(state.expectation));
+}
+
+void applyTimelineField(ScenarioTimeline &timeline, std::string_view key, std::string_view value) {
+    if (key == "name") {
+        timeline.name = value;
+    } else {
+        throw ScenarioValidationError{"Unknown timeline field: " + std::string{key}};
+    }
+}
+
+void finaliseTimeline(ScenarioTimeline &timeline, Scenario &scenario) {
+    if (timeline.name.empty()) {
+        throw ScenarioValidationError{"Scenario timeline is missing a name"};
+    }
+    for (const auto &existing : scenario.timelines) {
+        if (existing.name == timeline.name) {
+            throw ScenarioValidationError{"Duplicate scenario timeline: " + timeline.name};
+        }
+    }
+    scenario.timelines.push_back(std::move(timeline));
+}
+
+[[nodiscard]] double parseProbability(std::string_view key, std::string_view value) {
+    // from_chars rejects the leading '+' that the YAML files may carry.
+    const auto digits = value.starts_with('+') ? value.substr(1) : value;
+    double probability = 0.0;
+    const auto *end = digits.data() + digits.size();
+    const auto [parsed, ec] = std::from_chars(digits.data(), end, probability);
+    if (digits.empty() || ec != std::errc{} || parsed != end) {
+        throw ScenarioValidationError{"Fault " + std::string{key} + " must be a number: " + std::string{value}};
+    }
+    if (!(probability >= 0.0 && probability <= 1.0)) {
+        throw ScenarioValidationError{"Fault " + std::string{key} + " must be between 0 and 1: " + std::string{value}};
+    }
+    return probability;
+}
+
+void applyFaultField(communication::FaultProfile &fault, std::string_view key, std::string_view value) {
+    if (key == "com_id") {
+        fault.comId = scenario_yaml::parseUnsigned<std::uint32_t>(key, value);
+    } else if (key == "loss") {
+        fault.loss = parseProbability(key, value);
+    } else if (key == "duplicate") {
+        fault.duplicate = parseProbability(key, value);
+    } else if (key == "reorder") {
+        fault.reorder = parseProbability(key, value);
+    } else if (key == "corrupt") {
+        fault.corrupt = parseProbability(key, value);
+    } else if (key == "delay_us") {
+        fault.delay = std::chrono::microseconds{scenario_yaml::parseUnsigned<std::uint32_t>(key, value)};
+    } else if (key == "jitter_us") {
+        fault.jitter = std::chrono::microseconds{scenario_yaml::parseUnsigned<std::uint32_t>(key, value)};
+    } else {
+        throw ScenarioValidationError{"Unknown fault field: " + std::string{key}};
+    }
+}
+
+void finaliseFault(const communication::FaultProfile &fault, Scenario &scenario) {
+    for (const auto &existing : scenario.faults) {
+        if (existing.comId == fault.comId) {
+            throw ScenarioValidationError{"Duplicate fault profile for com_id " + std::to_string(fault.comId)};
+        }
+    }
+    scenario.faults.push_back(fault);
+}
+
+[[nodiscard]] std::uint64_t parseLinkNumber(std::string_view key, std::string_view value) {
+    std::uint64_t number = 0;
+    const auto *end = value.data() + value.size();
+    const auto [parsed, ec] = std::from_chars(value.data(), end, number);
+    if (value.empty() || ec != std::errc{} || parsed != end) {
+        throw ScenarioValidationError{"Network " + std::string{key} +
+                                      " must be a non-negative integer: " + std::string{value}};
+    }
+    return number;
+}
+
+void applyLinkField(communication::LinkProfile &link, std::string_view key, std::string_view value) {
+    if (key == "com_id") {
+        link.comId = static_cast<std::uint32_t>(parseLinkNumber(key, value));
+    } else if (key == "distribution") {
+        try {
+            link.distribution = communication::parseLatencyDistribution(value);
+        } catch (const std::invalid_argument &ex) {
+            throw ScenarioValidationError{ex.what()};
+        }
+    } else if (key == "latency_us") {
+        link.latency = std::chrono::microseconds{parseLinkNumber(key, value)};
+    } else if (key == "jitter_us") {
+        link.jitter = std::chrono::microseconds{parseLinkNumber(key, value)};
+    } else if (key == "bandwidth_kbps") {
+        link.bandwidth = parseLinkNumber(key, value) * 1000;
+    } else if (key == "queue_limit") {
+        link.queueLimit = static_cast<std::size_t>(parseLinkNumber(key, value));
+    } else {
+        throw ScenarioValidationError{"Unknown network field: " + std::string{key}};
+    }
+}
+
+void finaliseLink(const communication::LinkProfile &link, Scenario &scenario) {
+    for (const auto &existing : scenario.network) {
+        if (existing.comId == link.comId) {
+            throw ScenarioValidationError{"Duplicate network link for com_id " + std::to_string(link.comId)};
         }
+    }
+    if (link.queueLimit != 0 && link.bandwidth == 0) {
+        throw ScenarioValidationError{"Network link for com_id " + std::to_string(link.comId) +
+                                      " sets queue_limit without bandwidth_kbps"};
+    }
+    scenario.network.push_back(link);
+}
 
-        if (trimmed.rfind("-", 0) == 0) {
-            if (eventActive) {
-                finaliseEvent(current, scenario);
-                current = EventState{};
+/// Builds a Scenario from the token stream of its file, checking each item once it ends.
+class ScenarioBuilder final : public ScenarioVisitor {
+public:
+    explicit ScenarioBuilder(Scenario &scenario) : m_scenario(scenario) {}
+
+    void headerField(std::string_view key, std::string_view value) override {
+        if (key == "scenario") {
+            if (value.empty()) {
+                throw ScenarioValidationError{"Scenario id cannot be empty"};
             }
-            eventActive = true;
-            const auto afterDash = scenario_yaml::trim(trimmed.substr(1));
-            if (!afterDash.empty()) {
-                const auto [key, value] = scenario_yaml::parseKeyValue(afterDash);
-                applyField(current, key, value);
+            m_scenario.id = value;
+        } else if (key == "device") {
+            if (value.empty()) {
+                throw ScenarioValidationError{"Scenario device cannot be empty"};
             }
-            continue;
+            m_scenario.deviceProfileId = value;
+        } else if (key == "seed") {
+            m_scenario.seed = scenario_yaml::parseUnsigned<std::uint64_t>(key, value);
+        } else {
+            throw ScenarioValidationError{"Unknown scenario field: " + std::string{key}};
         }
+    }
 
-        if (!eventActive) {
-            throw ScenarioValidationError{"Event field defined outside of list: " + trimmed};
+    void section(std::string_view name) override {
+        finaliseItem();
+        if (name == "events") {
+            m_section = Section::Events;
+        } else if (name == "triggers") {
+            m_section = Section::Triggers;
+        } else if (name == "expect") {
+            m_section = Section::Expectations;
+        } else if (name == "timelines") {
+            m_section = Section::Timelines;
+        } else if (name == "faults") {
+            m_section = Section::Faults;
+        } else {
+            m_section = Section::Network;
         }
+    }
+
+    void item(std::size_t line) override {
+        finaliseItem();
+        m_itemActive = true;
+        m_itemLine = line;
+    }
 
-        const auto [key, value] = scenario_yaml::parseKeyValue(trimmed);
-        applyField(current, key, value);
+    void itemField(std::string_view key, std::string_view value) override {
+        if (m_section == Section::Events) {
+            applyField(m_event, key, value);
+        } else if (m_section == Section::Triggers) {
+            applyTriggerField(m_trigger, key, value);
+        } else if (m_section == Section::Expectations) {
+            applyExpectationField(m_expectation, key, value);
+        } else if (m_section == Section::Timelines) {
+            applyTimelineField(m_timeline, key, value);
+        } else if (m_section == Section::Faults) {
+            applyFaultField(m_fault, key, value);
+        } else {
+            applyLinkField(m_link, key, value);
+        }
     }
 
-    if (eventActive) {
-        finaliseEvent(current, scenario);
+    void end() override { finaliseItem(); }
+
+private:
+    enum class Section { Events, Triggers, Expectations, Timelines, Faults, Network };
+
+    void finaliseItem() {
+        if (!m_itemActive) {
+            return;
+        }
+        try {
+            if (m_section == Section::Events) {
+                finaliseEvent(m_event, m_scenario);
+                m_event = EventState{};
+            } else if (m_section == Section::Triggers) {
+                finaliseTrigger(m_trigger, m_scenario);
+                m_trigger = TriggerState{};
+            } else if (m_section == Section::Expectations) {
+                finaliseExpectation(m_expectation, m_scenario);
+                m_expectation = ExpectationState{};
+            } else if (m_section == Section::Timelines) {
+                finaliseTimeline(m_timeline, m_scenario);
+                m_timeline = ScenarioTimeline{};
+            } else if (m_section == Section::Faults) {
+                finaliseFault(m_fault, m_scenario);
+                m_fault = communication::FaultProfile{};
+            } else {
+                finaliseLink(m_link, m_scenario);
+                m_link = communication::LinkProfile{};
+            }
+        } catch (const ScenarioValidationError &ex) {
+            // Item checks run once the item has ended, so they point at its leading '-'.
+            throw ScenarioValidationError{ex.what(), m_itemLine};
+        }
+        m_itemActive = false;
     }
 
+    Scenario &m_scenario;
+    Section m_section{Section::Events};
+    bool m_itemActive{false};
+    std::size_t m_itemLine{0};
+    EventState m_event{};
+    TriggerState m_trigger{};
+    ExpectationState m_expectation{};
+    ScenarioTimeline m_timeline{};
+    communication::FaultProfile m_fault{};
+    communication::LinkProfile m_link{};
+};
+
+/// Checks that need the whole scenario and the device repository.
+void finaliseScenario(Scenario &scenario, const device::DeviceProfileRepository &repository) {
     if (scenario.deviceProfileId.empty()) {
         throw ScenarioValidationError{"Scenario does not reference a device profile"};
     }
@@ -132,6 +577,34 @@ Scenario ScenarioParser::parse(const std::filesystem::path &path, device::Device
         throw ScenarioValidationError{"Scenario does not contain any events"};
     }
 
+    if (usesDeviceState(scenario)) {
+        validateDeviceState(scenario, repository);
+    }
+}
+
+} // namespace
+
+Scenario ScenarioParser::parse(const std::filesystem::path &path, device::DeviceProfileRepository &repository) {
+    const auto file = mapScenarioFile(path);
+    Scenario scenario{};
+    scenario.id = path.stem().string();
+    ScenarioBuilder builder{scenario};
+    visitScenario(file.text(), {&builder});
+    finaliseScenario(scenario, repository);
+    return scenario;
+}
+
+Scenario ScenarioParser::parse(const std::filesystem::path &path, device::DeviceProfileRepository &repository,
+                               const ScenarioSchemaValidator &schema) {
+    const auto file = mapScenarioFile(path);
+    Scenario scenario{};
+    scenario.id = path.stem().string();
+    // The schema sees every token before the builder, so a file with a single error reports it exactly as
+    // validate() followed by parse() would.
+    auto checker = schema.checker(false);
+    ScenarioBuilder builder{scenario};
+    visitScenario(file.text(), {&checker, &builder});
+    finaliseScenario(scenario, repository);
     return scenario;
 }
 
@@ -1,152 +1,294 @@
 #include "trdp_simulator/simulation/ScenarioRepository.hpp"
 
 #include "trdp_simulator/device/DeviceProfileRepository.hpp"
+#include "trdp_simulator/simulation/BlobStore.hpp"
+#include "trdp_simulator/simulation/CompiledScenario.hpp"
+#include "trdp_simulator/simulation/ContentHash.hpp"
 #include "trdp_simulator/simulation/ScenarioParser.hpp"
 #include "trdp_simulator/simulation/ScenarioSchemaValidator.hpp"
 
+#include <array>
 #include <chrono>
 #include <cctype>
-#include <fstream>
 #include <iomanip>
 #include <sstream>
 #include <stdexcept>
+#include <string_view>
+#include <system_error>
 #include <vector>
 
 namespace trdp::simulation {
 namespace {
 
-[[nodiscard]] std::string trim(std::string value) {
-    const auto first = value.find_first_not_of(" \t\r\n");
-    if (first == std::string::npos) {
-        return {};
-    }
-    const auto last = value.find_last_not_of(" \t\r\n");
-    return value.substr(first, last - first + 1);
-}
-
-[[nodiscard]] std::vector<std::string> split(const std::string &line, char delim) {
-    std::vector<std::string> tokens;
-    std::stringstream ss{line};
-    std::string token;
-    while (std::getline(ss, token, delim)) {
-        tokens.emplace_back(std::move(token));
-    }
-    return tokens;
+[[nodiscard]] std::string manifestEntry(const ScenarioRecord &record) {
+    return record.id + '|' + record.storedPath.string() + '|' + record.deviceProfileId + '|' + record.checksum + '|' +
+           record.createdAt + '|' + record.updatedAt;
 }
 
-[[nodiscard]] std::string serialiseField(std::string value) {
-    for (char &ch : value) {
-        if (ch == '|') {
-            ch = '/';
-        } else if (ch == '\n' || ch == '\r') {
-            ch = ' ';
-        }
-    }
-    return value;
+constexpr std::size_t kManifestFields = 6;
+
+[[nodiscard]] ScenarioRecord decodeRecord(std::string_view line) {
+    std::array<std::string_view, kManifestFields> fields;
+    (void)ManifestJournal::splitFields(line, fields);
+    ScenarioRecord record{};
+    record.id = fields[0];
+    record.storedPath = fields[1];
+    record.deviceProfileId = fields[2];
+    record.checksum = fields[3];
+    record.createdAt = fields[4];
+    record.updatedAt = fields[5];
+    return record;
 }
 
 } // namespace
 
 ScenarioRepository::ScenarioRepository(std::filesystem::path root, device::DeviceProfileRepository &deviceRepository,
-                                       ScenarioSchemaValidator &schemaValidator)
-    : m_root(std::move(root)), m_manifestPath(m_root / "manifest.db"), m_runManifestPath(m_root / "runs.db"),
-      m_deviceRepository(deviceRepository), m_schemaValidator(schemaValidator) {
+                                       ScenarioSchemaValidator &schemaValidator, std::size_t cacheBudgetBytes,
+                                       ManifestJournal::Options journalOptions)
+    : m_root(std::move(root)),
+      m_manifest(m_root / "manifest.db", "id|storedPath|deviceProfileId|checksum|createdAt|updatedAt", journalOptions),
+      m_runManifest(m_root / "runs.db", "id|artefactPath|scenarioId|startedAt|completedAt|success|detail|expectations",
+                    journalOptions),
+      m_deviceRepository(deviceRepository), m_schemaValidator(schemaValidator), m_cache(cacheBudgetBytes) {
     std::filesystem::create_directories(m_root);
-    loadManifest();
-    loadRunManifest();
 }
 
-std::string ScenarioRepository::importScenario(const std::filesystem::path &path) {
-    m_schemaValidator.validate(path);
-    const Scenario scenario = ScenarioParser::parse(path, m_deviceRepository);
-
-    auto candidateId = sanitiseId(scenario.id);
-    if (candidateId.empty()) {
-        candidateId = "scenario";
-    }
+RunPage ScenarioRepository::queryRuns(const RunQuery &query) const {
+    ensureRunManifest();
+    return m_runs.query(query);
+}
 
-    std::string uniqueId = candidateId;
+std::string ScenarioRepository::importScenario(const std::filesystem::path &path) {
+    ensureManifest();
+    const Scenario scenario = ScenarioParser::parse(path, m_deviceRepository, m_schemaValidator);
+    const auto uniqueId = storageId(scenario);
 
     const auto storedPath = m_root / (uniqueId + ".yaml");
     if (storedPath.has_parent_path()) {
         std::filesystem::create_directories(storedPath.parent_path());
     }
-    std::filesystem::copy_file(path, storedPath, std::filesystem::copy_options::overwrite_existing);
-
-    const auto checksum = computeChecksum(storedPath);
+    const auto checksum =
+        m_blobs != nullptr ? m_blobs->storeFile(path, storedPath) : copyFileWithChecksum(path, storedPath);
     const auto timestamp = isoTimestamp();
+    compile(storedPath, scenario, checksum);
+
+    auto record = findRecord(uniqueId).value_or(ScenarioRecord{});
+    record.id = uniqueId;
+    record.deviceProfileId = scenario.deviceProfileId;
+    record.storedPath = storedPath;
+    record.checksum = checksum;
+    if (record.createdAt.empty()) {
+        record.createdAt = timestamp;
+    }
+    record.updatedAt = timestamp;
+
+    m_manifest.append(manifestEntry(record));
+    m_manifestLines.erase(uniqueId);
+    m_records.insert_or_assign(uniqueId, std::move(record));
+    if (m_manifest.compactionDue(m_records.size() + m_manifestLines.size())) {
+        compactManifest();
+    }
+    return uniqueId;
+}
 
-    auto it = m_records.find(uniqueId);
-    if (it == m_records.end()) {
-        ScenarioRecord record{};
-        record.id = uniqueId;
-        record.deviceProfileId = scenario.deviceProfileId;
+std::vector<ImportOutcome> ScenarioRepository::importScenarios(std::span<const std::filesystem::path> paths,
+                                                               std::size_t threads) {
+    ensureManifest();
+    // Everything but the renames and the manifest runs in parallel, on files stored and compiled under a staging
+    // name: two files with the same scenario id must reach their final name in order.
+    std::vector<ImportOutcome> outcomes(paths.size());
+    std::vector<ScenarioRecord> staged(paths.size());
+    parallelFor(paths.size(), threads, [&](std::size_t i) {
+        auto &outcome = outcomes[i];
+        auto &file = staged[i];
+        outcome.source = paths[i];
+        file.storedPath = importStagingPath(m_root, ".staging.yaml");
+        try {
+            const Scenario scenario = ScenarioParser::parse(outcome.source, m_deviceRepository, m_schemaValidator);
+            file.deviceProfileId = scenario.deviceProfileId;
+            file.checksum = m_blobs != nullptr ? m_blobs->storeFile(outcome.source, file.storedPath)
+                                               : copyFileWithChecksum(outcome.source, file.storedPath);
+            compile(file.storedPath, scenario, file.checksum);
+            outcome.id = storageId(scenario);
+        } catch (const std::exception &ex) {
+            outcome.error = ex.what();
+            std::error_code ignored;
+            std::filesystem::remove(file.storedPath, ignored);
+        }
+    });
+
+    const auto timestamp = isoTimestamp();
+    std::unordered_map<std::string, ScenarioRecord> imported;
+    std::vector<std::string> entries;
+    for (std::size_t i = 0; i < outcomes.size(); ++i) {
+        auto &outcome = outcomes[i];
+        if (!outcome.ok()) {
+            continue;
+        }
+        const auto &file = staged[i];
+        auto compiledPath = file.storedPath;
+        compiledPath.replace_extension(kCompiledScenarioExtension);
+        const auto storedPath = m_root / (outcome.id + ".yaml");
+        std::error_code error;
+        std::filesystem::rename(file.storedPath, storedPath, error);
+        if (error) {
+            outcome.error = "Failed to store " + storedPath.string() + ": " + error.message();
+            outcome.id.clear();
+            std::filesystem::remove(file.storedPath, error);
+            std::filesystem::remove(compiledPath, error);
+            continue;
+        }
+        // Without a compiled copy the scenario is parsed and compiled on its first load instead.
+        auto compiledTarget = storedPath;
+        compiledTarget.replace_extension(kCompiledScenarioExtension);
+        std::filesystem::rename(compiledPath, compiledTarget, error);
+
+        const auto previous = imported.find(outcome.id);
+        auto record = previous != imported.end() ? previous->second : findRecord(outcome.id).value_or(ScenarioRecord{});
+        record.id = outcome.id;
+        record.deviceProfileId = file.deviceProfileId;
         record.storedPath = storedPath;
-        record.checksum = checksum;
-        record.createdAt = timestamp;
-        record.updatedAt = timestamp;
-        m_records.insert_or_assign(uniqueId, std::move(record));
-    } else {
-        it->second.deviceProfileId = scenario.deviceProfileId;
-        it->second.storedPath = storedPath;
-        it->second.checksum = checksum;
-        if (it->second.createdAt.empty()) {
-            it->second.createdAt = timestamp;
+        record.checksum = file.checksum;
+        if (record.createdAt.empty()) {
+            record.createdAt = timestamp;
         }
-        it->second.updatedAt = timestamp;
+        record.updatedAt = timestamp;
+        entries.push_back(manifestEntry(record));
+        imported.insert_or_assign(outcome.id, std::move(record));
+    }
+    if (entries.empty()) {
+        return outcomes;
     }
 
-    persistManifest();
-    return uniqueId;
+    m_manifest.append(entries);
+    for (auto &[id, record] : imported) {
+        m_manifestLines.erase(id);
+        m_records.insert_or_assign(id, std::move(record));
+    }
+    if (m_manifest.compactionDue(m_records.size() + m_manifestLines.size())) {
+        compactManifest();
+    }
+    return outcomes;
 }
 
 bool ScenarioRepository::exists(const std::string &id) const {
-    return m_records.find(id) != m_records.end();
+    ensureManifest();
+    return m_records.contains(id) || m_manifestLines.contains(id);
 }
 
 ScenarioRecord ScenarioRepository::get(const std::string &id) const {
-    const auto it = m_records.find(id);
-    if (it == m_records.end()) {
+    ensureManifest();
+    auto record = findRecord(id);
+    if (!record) {
         throw std::out_of_range("Unknown scenario: " + id);
     }
-    return it->second;
+    return std::move(*record);
 }
 
 std::vector<ScenarioRecord> ScenarioRepository::list() const {
+    ensureManifest();
     std::vector<ScenarioRecord> records;
-    records.reserve(m_records.size());
+    records.reserve(m_records.size() + m_manifestLines.size());
     for (const auto &[_, record] : m_records) {
         records.push_back(record);
     }
+    for (const auto &[_, line] : m_manifestLines) {
+        records.push_back(decodeRecord(line));
+    }
     return records;
 }
 
 Scenario ScenarioRepository::load(const std::string &id) const {
-    const auto it = m_records.find(id);
-    if (it == m_records.end()) {
+    return *loadShared(id);
+}
+
+std::shared_ptr<const Scenario> ScenarioRepository::loadShared(const std::string &id) const {
+    ensureManifest();
+    const auto found = findRecord(id);
+    if (!found) {
         throw std::out_of_range("Unknown scenario: " + id);
     }
-    m_schemaValidator.validate(it->second.storedPath);
-    return ScenarioParser::parse(it->second.storedPath, m_deviceRepository);
+    const auto &record = *found;
+    const auto checksum = record.checksum.empty() ? fileChecksum(record.storedPath) : record.checksum;
+    if (auto cached = m_cache.find(checksum)) {
+        return cached;
+    }
+    if (auto compiled = loadCompiled(record, checksum)) {
+        return m_cache.insert(checksum, std::move(*compiled));
+    }
+    auto scenario = ScenarioParser::parse(record.storedPath, m_deviceRepository, m_schemaValidator);
+    compile(record.storedPath, scenario, checksum);
+    return m_cache.insert(checksum, std::move(scenario));
 }
 
 Scenario ScenarioRepository::loadRunScenario(const std::string &runId) const {
-    const auto it = m_runs.find(runId);
-    if (it == m_runs.end()) {
+    return *loadRunScenarioShared(runId);
+}
+
+std::shared_ptr<const Scenario> ScenarioRepository::loadRunScenarioShared(const std::string &runId) const {
+    ensureRunManifest();
+    const auto run = m_runs.find(runId);
+    if (!run) {
         throw std::out_of_range("Unknown run identifier: " + runId);
     }
-    const auto scenarioPath = it->second.artefactPath / "scenario.yaml";
-    m_schemaValidator.validate(scenarioPath);
-    return ScenarioParser::parse(scenarioPath, m_deviceRepository);
+    // Run artefacts carry no checksum in the manifest; hashing the file is still far cheaper than parsing it.
+    const auto scenarioPath = run->artefactPath / "scenario.yaml";
+    return loadCached(scenarioPath, fileChecksum(scenarioPath));
+}
+
+std::shared_ptr<const Scenario> ScenarioRepository::loadCached(const std::filesystem::path &path,
+                                                               const std::string &checksum) const {
+    if (auto cached = m_cache.find(checksum)) {
+        return cached;
+    }
+    return m_cache.insert(checksum, ScenarioParser::parse(path, m_deviceRepository, m_schemaValidator));
+}
+
+std::optional<Scenario> ScenarioRepository::loadCompiled(const ScenarioRecord &record,
+                                                         const std::string &checksum) const {
+    auto path = record.storedPath;
+    path.replace_extension(kCompiledScenarioExtension);
+    if (!std::filesystem::exists(path)) {
+        return std::nullopt;
+    }
+    try {
+        const CompiledScenario compiled{path};
+        if (compiled.checksum() != checksum) {
+            return std::nullopt;
+        }
+        auto scenario = compiled.toScenario();
+        // The YAML was validated when it was compiled; only its device can have gone away since. Parsing it
+        // again then reports the error.
+        if (!m_deviceRepository.exists(scenario.deviceProfileId)) {
+            return std::nullopt;
+        }
+        return scenario;
+    } catch (const std::runtime_error &) {
+        return std::nullopt;
+    }
+}
+
+void ScenarioRepository::compile(const std::filesystem::path &storedPath, const Scenario &scenario,
+                                 const std::string &checksum) const {
+    auto path = storedPath;
+    path.replace_extension(kCompiledScenarioExtension);
+    try {
+        writeCompiledScenario(path, scenario, checksum);
+    } catch (const std::runtime_error &) {
+        // The YAML stays authoritative; a store that cannot hold the compiled copy just parses on every load.
+        std::error_code ignored;
+        std::filesystem::remove(path, ignored);
+    }
 }
 
 void ScenarioRepository::exportScenario(const std::string &id, const std::filesystem::path &destination) const {
-    const auto it = m_records.find(id);
-    if (it == m_records.end()) {
+    ensureManifest();
+    const auto found = findRecord(id);
+    if (!found) {
         throw std::out_of_range("Unknown scenario: " + id);
     }
 
-    const auto &record = it->second;
+    const auto &record = *found;
     std::filesystem::path target = destination;
     if (std::filesystem::is_directory(destination)) {
         target /= record.storedPath.filename();
@@ -179,124 +321,133 @@ void ScenarioRepository::exportScenario(const std::string &id, const std::filesy
 }
 
 void ScenarioRepository::recordRun(RunRecord record) {
-    if (record.id.empty()) {
-        throw std::invalid_argument("Run identifier cannot be empty");
+    std::vector<RunRecord> records;
+    records.push_back(std::move(record));
+    recordRuns(std::move(records));
+}
+
+void ScenarioRepository::recordRuns(std::vector<RunRecord> records) {
+    std::vector<std::string> entries;
+    entries.reserve(records.size());
+    for (auto &record : records) {
+        if (record.id.empty()) {
+            throw std::invalid_argument("Run identifier cannot be empty");
+        }
+        if (record.startedAt.empty()) {
+            record.startedAt = isoTimestamp();
+        }
+        if (record.completedAt.empty()) {
+            record.completedAt = record.startedAt;
+        }
+        entries.push_back(RunIndex::encode(record));
     }
-    if (record.startedAt.empty()) {
-        record.startedAt = isoTimestamp();
+    m_runManifest.append(entries);
+    if (!m_runManifestReplayed) {
+        // Nothing has read the run catalogue yet; whatever does replays these entries from the journal. Until the
+        // journal is long enough to compact there is no reason to read it here.
+        if (m_runManifest.journalEntries() < m_runManifest.options().compactAfter) {
+            return;
+        }
+        ensureRunManifest();
+    } else {
+        for (auto &entry : entries) {
+            m_runs.upsert(std::move(entry));
+        }
     }
-    if (record.completedAt.empty()) {
-        record.completedAt = record.startedAt;
+    if (m_runManifest.compactionDue(m_runs.size())) {
+        compactRunManifest();
     }
-    m_runs.insert_or_assign(record.id, record);
-    persistRunManifest();
+}
+
+void ScenarioRepository::compactManifests() {
+    compactManifest();
+    compactRunManifest();
 }
 
 std::vector<RunRecord> ScenarioRepository::listRuns() const {
-    std::vector<RunRecord> runs;
-    runs.reserve(m_runs.size());
-    for (const auto &[_, record] : m_runs) {
-        runs.push_back(record);
-    }
-    return runs;
+    ensureRunManifest();
+    RunQuery query;
+    query.order = RunOrder::OldestFirst;
+    return m_runs.query(query).runs;
 }
 
 std::vector<RunRecord> ScenarioRepository::listRunsForScenario(const std::string &scenarioId) const {
-    std::vector<RunRecord> runs;
-    for (const auto &[_, record] : m_runs) {
-        if (record.scenarioId == scenarioId) {
-            runs.push_back(record);
-        }
-    }
-    return runs;
+    ensureRunManifest();
+    RunQuery query;
+    query.scenarioId = scenarioId;
+    query.order = RunOrder::OldestFirst;
+    return m_runs.query(query).runs;
 }
 
 RunRecord ScenarioRepository::getRun(const std::string &id) const {
-    const auto it = m_runs.find(id);
-    if (it == m_runs.end()) {
+    ensureRunManifest();
+    auto run = m_runs.find(id);
+    if (!run) {
         throw std::out_of_range("Unknown run identifier: " + id);
     }
-    return it->second;
+    return std::move(*run);
 }
 
-void ScenarioRepository::loadManifest() {
-    m_records.clear();
-    if (!std::filesystem::exists(m_manifestPath)) {
-        return;
-    }
+void ScenarioRepository::ensureManifest() const {
+    std::call_once(m_manifestLoaded, [this] { loadManifest(); });
+}
 
-    std::ifstream stream{m_manifestPath};
-    std::string line;
-    while (std::getline(stream, line)) {
-        line = trim(line);
-        if (line.empty() || line.starts_with('#')) {
-            continue;
-        }
-        const auto tokens = split(line, '|');
-        if (tokens.size() < 6) {
-            continue;
-        }
-        ScenarioRecord record{};
-        record.id = tokens[0];
-        record.storedPath = tokens[1];
-        record.deviceProfileId = tokens[2];
-        record.checksum = tokens[3];
-        record.createdAt = tokens[4];
-        record.updatedAt = tokens[5];
-        if (!record.id.empty()) {
-            m_records.insert_or_assign(record.id, std::move(record));
+void ScenarioRepository::loadManifest() const {
+    m_manifestLines.clear();
+    // Only the id is split off here; lines stay in the journal's mappings until a record is asked for.
+    m_manifest.replay([this](std::string_view line) {
+        std::array<std::string_view, 1> id;
+        if (ManifestJournal::splitFields(line, id) >= kManifestFields && !id[0].empty()) {
+            m_manifestLines.insert_or_assign(id[0], line);
         }
+    });
+}
+
+std::optional<ScenarioRecord> ScenarioRepository::findRecord(const std::string &id) const {
+    if (const auto it = m_records.find(id); it != m_records.end()) {
+        return it->second;
+    }
+    if (const auto it = m_manifestLines.find(id); it != m_manifestLines.end()) {
+        return decodeRecord(it->second);
     }
+    return std::nullopt;
 }
 
-void ScenarioRepository::persistManifest() const {
-    std::ofstream stream{m_manifestPath, std::ios::trunc};
-    stream << "# id|storedPath|deviceProfileId|checksum|createdAt|updatedAt\n";
+void ScenarioRepository::compactManifest() {
+    ensureManifest();
+    std::vector<std::string> entries;
+    entries.reserve(m_records.size() + m_manifestLines.size());
     for (const auto &[_, record] : m_records) {
-        stream << record.id << '|' << record.storedPath.string() << '|' << record.deviceProfileId << '|' << record.checksum
-               << '|' << record.createdAt << '|' << record.updatedAt << '\n';
+        entries.push_back(manifestEntry(record));
+    }
+    for (const auto &[_, line] : m_manifestLines) {
+        entries.emplace_back(line);
     }
+    m_manifest.compact(entries);
 }
 
-void ScenarioRepository::loadRunManifest() {
+void ScenarioRepository::ensureRunManifest() const {
+    std::call_once(m_runManifestLoaded, [this] { loadRunManifest(); });
+}
+
+void ScenarioRepository::loadRunManifest() const {
     m_runs.clear();
-    if (!std::filesystem::exists(m_runManifestPath)) {
-        return;
-    }
+    m_runManifestReplayed = true;
+    // Runs are indexed in place; a record is decoded only when a query returns it.
+    m_runManifest.replay([this](std::string_view line) { m_runs.upsertView(line); });
+}
 
-    std::ifstream stream{m_runManifestPath};
-    std::string line;
-    while (std::getline(stream, line)) {
-        line = trim(line);
-        if (line.empty() || line.starts_with('#')) {
-            continue;
-        }
-        const auto tokens = split(line, '|');
-        if (tokens.size() < 7) {
-            continue;
-        }
-        RunRecord record{};
-        record.id = tokens[0];
-        record.artefactPath = tokens[1];
-        record.scenarioId = tokens[2];
-        record.startedAt = tokens[3];
-        record.completedAt = tokens[4];
-        record.success = tokens[5] == "1";
-        record.detail = tokens[6];
-        if (!record.id.empty()) {
-            m_runs.insert_or_assign(record.id, std::move(record));
-        }
-    }
+void ScenarioRepository::compactRunManifest() {
+    ensureRunManifest();
+    std::vector<std::string> entries;
+    entries.reserve(m_runs.size());
+    m_runs.forEachEntry([&entries](std::string_view line) { entries.emplace_back(line); });
+    m_runManifest.compact(entries);
 }
 
-void ScenarioRepository::persistRunManifest() const {
-    std::ofstream stream{m_runManifestPath, std::ios::trunc};
-    stream << "# id|artefactPath|scenarioId|startedAt|completedAt|success|detail\n";
-    for (const auto &[_, record] : m_runs) {
-        stream << record.id << '|' << record.artefactPath.string() << '|' << record.scenarioId << '|' << record.startedAt
-               << '|' << record.completedAt << '|' << (record.success ? "1" : "0") << '|' << serialiseField(record.detail)
-               << '\n';
-    }
+std::string ScenarioRepository::storageId(const Scenario &scenario) {
+    auto id = sanitiseId(scenario.id);
+    return id.empty() ? "scenario" : id;
 }
 
 std::string ScenarioRepository::sanitiseId(std::string candidate) {
@@ -312,27 +463,6 @@ std::string ScenarioRepository::sanitiseId(std::string candidate) {
     return result;
 }
 
-std::string ScenarioRepository::computeChecksum(const std::filesystem::path &path) {
-    std::ifstream stream{path, std::ios::binary};
-    if (!stream) {
-        throw std::runtime_error("Failed to open scenario file for checksum: " + path.string());
-    }
-    constexpr std::uint64_t fnvOffset = 1469598103934665603ull;
-    constexpr std::uint64_t fnvPrime = 1099511628211ull;
-    std::uint64_t hash = fnvOffset;
-    char buffer[4096];
-    while (stream.read(buffer, sizeof(buffer)) || stream.gcount() > 0) {
-        const std::streamsize count = stream.gcount();
-        for (std::streamsize i = 0; i < count; ++i) {
-            hash ^= static_cast<unsigned char>(buffer[i]);
-            hash *= fnvPrime;
-        }
-    }
-    std::ostringstream oss;
-    oss << std::hex << std::setw(16) << std::setfill('0') << hash;
-    return oss.str();
-}
-
 std::string ScenarioRepository::isoTimestamp() {
     const auto now = std::chrono::system_clock::now();
     const auto time = std::chrono::system_clock::to_time_t(now);
@@ -2,9 +2,10 @@
 
 #include "trdp_simulator/simulation/ScenarioYaml.hpp"
 
+#include <algorithm>
 #include <cctype>
+#include <cstdint>
 #include <fstream>
-#include <regex>
 #include <sstream>
 #include <stdexcept>
 
@@ -24,42 +25,24 @@ namespace {
     return tokens;
 }
 
-void ensureRequiredFields(const std::set<std::string> &required, const std::set<std::string> &present,
-                          const std::string &context) {
-    for (const auto &field : required) {
-        if (!present.contains(field)) {
-            throw ScenarioValidationError{"Missing required " + context + " field: " + field};
-        }
+/// FNV-1a over @p text, started from a seed so the field table can search for a collision-free one.
+[[nodiscard]] std::uint64_t hashField(std::string_view text, std::uint64_t seed) noexcept {
+    std::uint64_t hash = 1469598103934665603ULL ^ (seed * 0x9E3779B97F4A7C15ULL);
+    for (const char ch : text) {
+        hash ^= static_cast<unsigned char>(ch);
+        hash *= 1099511628211ULL;
     }
+    return hash ^ (hash >> 29U);
 }
 
-void validateEventField(const std::string &key, const std::string &value, const std::set<std::string> &numericFields,
-                        const std::set<std::string> &allowedTypeValues) {
-    if (key == "type") {
-        if (!allowedTypeValues.contains(value)) {
-            std::ostringstream oss;
-            oss << "Event type '" << value << "' not permitted";
-            throw ScenarioValidationError{oss.str()};
-        }
-        (void)scenario_yaml::parseType(value);
-        return;
-    }
-    if (numericFields.contains(key)) {
-        if (value.empty()) {
-            throw ScenarioValidationError{"Numeric event field '" + key + "' cannot be empty"};
-        }
-        for (char ch : value) {
-            if (!std::isdigit(static_cast<unsigned char>(ch))) {
-                throw ScenarioValidationError{"Numeric event field '" + key + "' contains non-digit characters"};
-            }
-        }
-        return;
-    }
-    if (key == "payload") {
-        (void)scenario_yaml::parsePayload(value);
-        return;
-    }
-    (void)scenario_yaml::parseKeyValue(key + ": " + value);
+[[nodiscard]] bool isScenarioId(std::string_view value) noexcept {
+    return !value.empty() && std::all_of(value.begin(), value.end(), [](unsigned char ch) {
+        return std::isalnum(ch) != 0 || ch == '_' || ch == '-';
+    });
+}
+
+[[nodiscard]] bool isDigits(std::string_view value) noexcept {
+    return std::all_of(value.begin(), value.end(), [](unsigned char ch) { return std::isdigit(ch) != 0; });
 }
 
 } // namespace
@@ -81,6 +64,25 @@ void ScenarioSchemaValidator::loadSchema() {
         throw std::runtime_error("Failed to open scenario schema: " + m_schemaPath.string());
     }
 
+    struct SectionFields {
+        std::string context{};
+        std::set<std::string> required{};
+        std::set<std::string> allowed{};
+        std::set<std::string> numeric{};
+    };
+    // List sections and the singular name used by their schema keys (required_<name>_fields, ...).
+    std::map<std::string, SectionFields> sections = {
+        {"events", SectionFields{.context = "event"}},
+        {"triggers", SectionFields{.context = "trigger"}},
+        {"expect", SectionFields{.context = "expectation"}},
+        {"timelines", SectionFields{.context = "timeline"}},
+        {"faults", SectionFields{.context = "fault"}},
+        {"network", SectionFields{.context = "link"}},
+    };
+    std::set<std::string> requiredScenarioFields;
+    std::set<std::string> allowedScenarioFields;
+    std::set<std::string> eventTypeValues;
+
     std::string line;
     while (std::getline(stream, line)) {
         const auto trimmed = scenario_yaml::trim(line);
@@ -89,134 +91,280 @@ void ScenarioSchemaValidator::loadSchema() {
         }
         const auto [key, rawValue] = scenario_yaml::parseKeyValue(trimmed);
         const auto values = splitList(rawValue);
+        std::set<std::string> fields(values.begin(), values.end());
         if (key == "required_scenario_fields") {
-            m_requiredScenarioFields = std::set<std::string>(values.begin(), values.end());
-        } else if (key == "allowed_scenario_fields") {
-            m_allowedScenarioFields = std::set<std::string>(values.begin(), values.end());
-        } else if (key == "required_event_fields") {
-            m_requiredEventFields = std::set<std::string>(values.begin(), values.end());
-        } else if (key == "allowed_event_fields") {
-            m_allowedEventFields = std::set<std::string>(values.begin(), values.end());
-        } else if (key == "enum_event_type") {
-            m_eventTypeValues = std::set<std::string>(values.begin(), values.end());
-        } else if (key == "numeric_event_fields") {
-            m_numericEventFields = std::set<std::string>(values.begin(), values.end());
+            requiredScenarioFields = std::move(fields);
+            continue;
+        }
+        if (key == "allowed_scenario_fields") {
+            allowedScenarioFields = std::move(fields);
+            continue;
+        }
+        if (key == "enum_event_type") {
+            eventTypeValues = std::move(fields);
+            continue;
+        }
+        for (auto &[_, section] : sections) {
+            if (key == "required_" + section.context + "_fields") {
+                section.required = std::move(fields);
+                break;
+            }
+            if (key == "allowed_" + section.context + "_fields") {
+                section.allowed = std::move(fields);
+                break;
+            }
+            if (key == "numeric_" + section.context + "_fields") {
+                section.numeric = std::move(fields);
+                break;
+            }
         }
     }
 
-    if (m_allowedScenarioFields.empty()) {
-        m_allowedScenarioFields = {"scenario", "device"};
+    if (allowedScenarioFields.empty()) {
+        allowedScenarioFields = {"scenario", "device", "seed"};
     }
-    if (m_requiredScenarioFields.empty()) {
-        m_requiredScenarioFields = {"scenario", "device"};
+    if (requiredScenarioFields.empty()) {
+        requiredScenarioFields = {"scenario", "device"};
     }
-    if (m_allowedEventFields.empty()) {
-        m_allowedEventFields = {"type", "label", "com_id", "dataset_id", "payload", "delay_ms"};
+    if (eventTypeValues.empty()) {
+        eventTypeValues = {"pd", "md", "set"};
     }
-    if (m_requiredEventFields.empty()) {
-        m_requiredEventFields = {"type", "label"};
+    auto &events = sections.at("events");
+    if (events.allowed.empty()) {
+        events.allowed = {"type", "label", "timeline", "com_id", "dataset_id", "payload", "source", "field",
+                          "value", "delay_ms", "repeat", "period_ms", "ramp_start_hz", "ramp_end_hz",
+                          "counter_offset", "counter_width", "counter_start", "counter_step", "counter_end"};
     }
-    if (m_eventTypeValues.empty()) {
-        m_eventTypeValues = {"pd", "md"};
+    if (events.required.empty()) {
+        events.required = {"type", "label"};
+    }
+    auto &triggers = sections.at("triggers");
+    if (triggers.allowed.empty()) {
+        triggers.allowed = {"label", "on_type", "on_com_id", "match_offset", "match_mask", "match_value",
+                            "field_offset", "field_width", "field_op", "field_value", "field_dataset_id",
+                            "field_name", "type", "com_id", "dataset_id", "payload", "source", "field", "value",
+                            "deadline_ms"};
+    }
+    if (triggers.required.empty()) {
+        triggers.required = {"label", "on_com_id", "type"};
+    }
+    auto &expect = sections.at("expect");
+    if (expect.allowed.empty()) {
+        expect.allowed = {"label", "type", "com_id", "min_count", "max_count", "within_ms", "match_offset",
+                          "match_mask", "match_value", "field_offset", "field_width", "field_op", "field_value",
+                          "field_dataset_id", "field_name", "cycle_ms", "cycle_tolerance_ms"};
+    }
+    if (expect.required.empty()) {
+        expect.required = {"label", "com_id"};
+    }
+    auto &timelines = sections.at("timelines");
+    if (timelines.allowed.empty()) {
+        timelines.allowed = {"name"};
+    }
+    if (timelines.required.empty()) {
+        timelines.required = {"name"};
+    }
+    auto &faults = sections.at("faults");
+    if (faults.allowed.empty()) {
+        faults.allowed = {"com_id", "loss", "duplicate", "reorder", "corrupt", "delay_us", "jitter_us"};
+    }
+    if (faults.numeric.empty()) {
+        faults.numeric = {"com_id", "delay_us", "jitter_us"};
+    }
+    auto &network = sections.at("network");
+    if (network.allowed.empty()) {
+        network.allowed = {"com_id", "distribution", "latency_us", "jitter_us", "bandwidth_kbps", "queue_limit"};
+    }
+    if (network.numeric.empty()) {
+        network.numeric = {"com_id", "latency_us", "jitter_us", "bandwidth_kbps", "queue_limit"};
     }
-}
 
-void ScenarioSchemaValidator::validate(const std::filesystem::path &scenarioPath) const {
-    if (!std::filesystem::exists(scenarioPath)) {
-        throw ScenarioValidationError{"Scenario file not found: " + scenarioPath.string()};
+    // Compile every field name to a bit, in alphabetical order so that the lowest missing bit is the field the
+    // set-based checks used to report first. Names are found through a hash table searched for a seed that gives
+    // each name its own slot, so a lookup is one hash, one probe and one compare.
+    std::set<std::string> names{requiredScenarioFields.begin(), requiredScenarioFields.end()};
+    names.insert(allowedScenarioFields.begin(), allowedScenarioFields.end());
+    for (const auto &[_, section] : sections) {
+        names.insert(section.required.begin(), section.required.end());
+        names.insert(section.allowed.begin(), section.allowed.end());
+        names.insert(section.numeric.begin(), section.numeric.end());
+    }
+    if (names.size() > FieldSet{}.size()) {
+        throw std::runtime_error("Scenario schema names more than " + std::to_string(FieldSet{}.size()) + " fields");
+    }
+    m_fieldNames.assign(names.begin(), names.end());
+    const auto place = [this](std::size_t slots, std::uint64_t seed) {
+        m_fieldSlots.assign(slots, -1);
+        for (std::size_t bit = 0; bit < m_fieldNames.size(); ++bit) {
+            auto &slot = m_fieldSlots[hashField(m_fieldNames[bit], seed) & (slots - 1)];
+            if (slot >= 0) {
+                return false;
+            }
+            slot = static_cast<std::int16_t>(bit);
+        }
+        m_fieldSeed = seed;
+        return true;
+    };
+    std::size_t slots = 16;
+    while (slots < 2 * m_fieldNames.size()) {
+        slots *= 2;
+    }
+    for (bool placed = false; !placed; slots *= 2) {
+        for (std::uint64_t seed = 0; seed < 256 && !placed; ++seed) {
+            placed = place(slots, seed);
+        }
     }
 
-    std::ifstream stream{scenarioPath};
-    if (!stream) {
-        throw ScenarioValidationError{"Failed to open scenario file: " + scenarioPath.string()};
+    m_requiredScenarioFields = compile(requiredScenarioFields);
+    m_allowedScenarioFields = compile(allowedScenarioFields);
+    m_eventTypeValues.assign(eventTypeValues.begin(), eventTypeValues.end());
+    m_sections.clear();
+    for (const auto &[name, section] : sections) {
+        m_sections.emplace(name, ItemSchema{section.context, compile(section.required), compile(section.allowed),
+                                            compile(section.numeric)});
     }
+}
 
-    bool inEvents = false;
-    bool eventActive = false;
-    std::set<std::string> scenarioFields;
-    std::set<std::string> eventFields;
-    std::size_t eventCount = 0;
+int ScenarioSchemaValidator::fieldBit(std::string_view field) const noexcept {
+    const auto bit = m_fieldSlots[hashField(field, m_fieldSeed) & (m_fieldSlots.size() - 1)];
+    return bit >= 0 && m_fieldNames[static_cast<std::size_t>(bit)] == field ? bit : -1;
+}
 
-    std::regex scenarioIdPattern{"^[A-Za-z0-9_-]+$"};
+ScenarioSchemaValidator::FieldSet ScenarioSchemaValidator::compile(const std::set<std::string> &fields) const {
+    FieldSet set;
+    for (const auto &field : fields) {
+        set.set(static_cast<std::size_t>(fieldBit(field)));
+    }
+    return set;
+}
 
-    std::string rawLine;
-    while (std::getline(stream, rawLine)) {
-        const auto trimmed = scenario_yaml::trim(rawLine);
-        if (trimmed.empty() || trimmed.starts_with('#')) {
-            continue;
+void ScenarioSchemaValidator::ensureRequired(const FieldSet &required, const FieldSet &present,
+                                             const std::string &context) const {
+    const auto missing = required & ~present;
+    if (missing.none()) {
+        return;
+    }
+    for (std::size_t bit = 0;; ++bit) {
+        if (missing.test(bit)) {
+            throw ScenarioValidationError{"Missing required " + context + " field: " + m_fieldNames[bit]};
         }
+    }
+}
 
-        if (trimmed == "events:") {
-            inEvents = true;
-            continue;
-        }
+void ScenarioSchemaValidator::validate(const std::filesystem::path &scenarioPath) const {
+    const auto file = mapScenarioFile(scenarioPath);
+    auto check = checker();
+    visitScenario(file.text(), {&check});
+}
 
-        if (!inEvents) {
-            const auto [key, value] = scenario_yaml::parseKeyValue(trimmed);
-            if (!m_allowedScenarioFields.contains(key) && key != "events") {
-                throw ScenarioValidationError{"Unknown scenario field: " + key};
-            }
-            scenarioFields.insert(key);
-            if (key == "scenario") {
-                if (value.empty()) {
-                    throw ScenarioValidationError{"Scenario id cannot be empty"};
-                }
-                if (!std::regex_match(value, scenarioIdPattern)) {
-                    throw ScenarioValidationError{"Scenario id contains invalid characters"};
-                }
-            } else if (key == "device") {
-                if (value.empty()) {
-                    throw ScenarioValidationError{"Scenario device cannot be empty"};
-                }
-            }
-            continue;
-        }
+ScenarioSchemaValidator::Checker::Checker(const ScenarioSchemaValidator &schema, bool parseValues)
+    : m_schema(schema), m_parseValues(parseValues) {}
 
-        if (trimmed.rfind('-', 0) == 0) {
-            if (eventActive) {
-                ensureRequiredFields(m_requiredEventFields, eventFields, "event");
-                eventFields.clear();
-            }
-            eventActive = true;
-            ++eventCount;
-            const auto afterDash = scenario_yaml::trim(trimmed.substr(1));
-            if (!afterDash.empty()) {
-                const auto [key, value] = scenario_yaml::parseKeyValue(afterDash);
-                if (!m_allowedEventFields.contains(key)) {
-                    throw ScenarioValidationError{"Unknown event field: " + key};
-                }
-                validateEventField(key, value, m_numericEventFields, m_eventTypeValues);
-                eventFields.insert(key);
-            }
-            continue;
+void ScenarioSchemaValidator::Checker::headerField(std::string_view key, std::string_view value) {
+    const auto bit = m_schema.fieldBit(key);
+    if ((bit < 0 || !m_schema.m_allowedScenarioFields.test(static_cast<std::size_t>(bit))) && key != "events") {
+        throw ScenarioValidationError{"Unknown scenario field: " + std::string{key}};
+    }
+    if (bit >= 0) {
+        m_scenarioFields.set(static_cast<std::size_t>(bit));
+    }
+    if (key == "scenario") {
+        if (value.empty()) {
+            throw ScenarioValidationError{"Scenario id cannot be empty"};
         }
-
-        if (!eventActive) {
-            throw ScenarioValidationError{"Event field defined outside of list: " + trimmed};
+        if (!isScenarioId(value)) {
+            throw ScenarioValidationError{"Scenario id contains invalid characters"};
         }
-
-        const auto [key, value] = scenario_yaml::parseKeyValue(trimmed);
-        if (!m_allowedEventFields.contains(key)) {
-            throw ScenarioValidationError{"Unknown event field: " + key};
+    } else if (key == "device") {
+        if (value.empty()) {
+            throw ScenarioValidationError{"Scenario device cannot be empty"};
+        }
+    } else if (key == "seed") {
+        if (value.empty() || !isDigits(value)) {
+            throw ScenarioValidationError{"Scenario seed must be a non-negative integer"};
         }
-        validateEventField(key, value, m_numericEventFields, m_eventTypeValues);
-        eventFields.insert(key);
     }
+}
 
-    if (!inEvents) {
-        throw ScenarioValidationError{"Scenario must declare an events list"};
+void ScenarioSchemaValidator::Checker::section(std::string_view name) {
+    finaliseItem();
+    const auto it = m_schema.m_sections.find(name);
+    if (it == m_schema.m_sections.end()) {
+        throw ScenarioValidationError{"Unknown scenario section: " + std::string{name}};
+    }
+    m_section = &it->second;
+    m_sawEvents = m_sawEvents || it->first == "events";
+}
+
+void ScenarioSchemaValidator::Checker::item(std::size_t line) {
+    finaliseItem();
+    m_itemActive = true;
+    m_itemLine = line;
+    if (m_section->context == "event") {
+        ++m_eventCount;
     }
+}
 
-    if (eventActive) {
-        ensureRequiredFields(m_requiredEventFields, eventFields, "event");
+void ScenarioSchemaValidator::Checker::itemField(std::string_view key, std::string_view value) {
+    const auto bit = m_schema.fieldBit(key);
+    if (bit < 0 || !m_section->allowed.test(static_cast<std::size_t>(bit))) {
+        throw ScenarioValidationError{"Unknown " + m_section->context + " field: " + std::string{key}};
     }
+    m_itemFields.set(static_cast<std::size_t>(bit));
 
-    if (eventCount == 0) {
+    if (key == "type" || key == "on_type") {
+        const auto &types = m_schema.m_eventTypeValues;
+        if (std::find(types.begin(), types.end(), value) == types.end()) {
+            throw ScenarioValidationError{"Event type '" + std::string{value} + "' not permitted"};
+        }
+        if (m_parseValues) {
+            (void)scenario_yaml::parseType(value);
+        }
+        return;
+    }
+    if (m_section->numeric.test(static_cast<std::size_t>(bit))) {
+        if (value.empty()) {
+            throw ScenarioValidationError{"Numeric " + m_section->context + " field '" + std::string{key} +
+                                          "' cannot be empty"};
+        }
+        if (!isDigits(value)) {
+            throw ScenarioValidationError{"Numeric " + m_section->context + " field '" + std::string{key} +
+                                          "' contains non-digit characters"};
+        }
+        return;
+    }
+    if (!m_parseValues) {
+        return;
+    }
+    if (key == "payload" || key == "match_mask" || key == "match_value") {
+        (void)scenario_yaml::parsePayload(value);
+    } else if (key == "field_op") {
+        (void)scenario_yaml::parseFieldOp(value);
+    }
+}
+
+void ScenarioSchemaValidator::Checker::end() {
+    if (!m_sawEvents) {
+        throw ScenarioValidationError{"Scenario must declare an events list"};
+    }
+    finaliseItem();
+    if (m_eventCount == 0) {
         throw ScenarioValidationError{"Scenario does not contain any events"};
     }
+    m_schema.ensureRequired(m_schema.m_requiredScenarioFields, m_scenarioFields, "scenario");
+}
 
-    ensureRequiredFields(m_requiredScenarioFields, scenarioFields, "scenario");
+void ScenarioSchemaValidator::Checker::finaliseItem() {
+    if (!m_itemActive) {
+        return;
+    }
+    try {
+        m_schema.ensureRequired(m_section->required, m_itemFields, m_section->context);
+    } catch (const ScenarioValidationError &ex) {
+        throw ScenarioValidationError{ex.what(), m_itemLine};
+    }
+    m_itemFields.reset();
+    m_itemActive = false;
 }
 
 } // namespace trdp::simulation
-
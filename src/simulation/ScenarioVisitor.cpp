@@ -0,0 +1,112 @@
+#include "trdp_simulator/simulation/ScenarioVisitor.hpp"
+
+#include "trdp_simulator/simulation/ScenarioParser.hpp"
+#include "trdp_simulator/simulation/ScenarioYaml.hpp"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <string>
+
+namespace trdp::simulation {
+namespace {
+
+struct Section {
+    std::string_view name;
+    /// What one list item of the section is called in error messages.
+    std::string_view item;
+};
+
+constexpr std::array<Section, 6> kSections{{{"events", "Event"},
+                                            {"triggers", "Trigger"},
+                                            {"expect", "Expectation"},
+                                            {"timelines", "Timeline"},
+                                            {"faults", "Fault"},
+                                            {"network", "Network link"}}};
+
+} // namespace
+
+MappedFile mapScenarioFile(const std::filesystem::path &path) {
+    if (!std::filesystem::exists(path)) {
+        throw ScenarioValidationError{"Scenario file not found: " + path.string()};
+    }
+    try {
+        return MappedFile{path};
+    } catch (const std::runtime_error &) {
+        throw ScenarioValidationError{"Failed to open scenario file: " + path.string()};
+    }
+}
+
+void visitScenario(std::string_view text, std::initializer_list<ScenarioVisitor *> visitors) {
+    const Section *current = nullptr;
+    bool itemActive = false;
+    std::size_t lineNumber = 0;
+
+    const auto handleLine = [&](std::string_view trimmed) {
+        if (trimmed.ends_with(':')) {
+            const auto name = trimmed.substr(0, trimmed.size() - 1);
+            const auto section = std::find_if(kSections.begin(), kSections.end(),
+                                              [name](const Section &candidate) { return candidate.name == name; });
+            if (section != kSections.end()) {
+                for (auto *visitor : visitors) {
+                    visitor->section(name);
+                }
+                current = &*section;
+                itemActive = false;
+                return;
+            }
+        }
+
+        if (current == nullptr) {
+            const auto [key, value] = scenario_yaml::splitKeyValue(trimmed);
+            for (auto *visitor : visitors) {
+                visitor->headerField(key, value);
+            }
+            return;
+        }
+
+        if (trimmed.starts_with('-')) {
+            const auto afterDash = scenario_yaml::trimView(trimmed.substr(1));
+            for (auto *visitor : visitors) {
+                visitor->item(lineNumber);
+            }
+            itemActive = true;
+            if (!afterDash.empty()) {
+                const auto [key, value] = scenario_yaml::splitKeyValue(afterDash);
+                for (auto *visitor : visitors) {
+                    visitor->itemField(key, value);
+                }
+            }
+            return;
+        }
+
+        if (!itemActive) {
+            throw ScenarioValidationError{std::string{current->item} + " field defined outside of list: " +
+                                          std::string{trimmed}};
+        }
+        const auto [key, value] = scenario_yaml::splitKeyValue(trimmed);
+        for (auto *visitor : visitors) {
+            visitor->itemField(key, value);
+        }
+    };
+
+    for (std::size_t next = 0; next < text.size();) {
+        const auto end = std::min(text.find('\n', next), text.size());
+        const auto trimmed = scenario_yaml::trimView(text.substr(next, end - next));
+        next = end + 1;
+        ++lineNumber;
+        if (trimmed.empty() || trimmed.starts_with('#')) {
+            continue;
+        }
+        try {
+            handleLine(trimmed);
+        } catch (const ScenarioValidationError &ex) {
+            throw ScenarioValidationError{ex.what(), ex.line() != 0 ? ex.line() : lineNumber};
+        }
+    }
+    for (auto *visitor : visitors) {
+        visitor->end();
+    }
+}
+
+} // namespace trdp::simulation
@@ -1,13 +1,20 @@
 #include "trdp_simulator/simulation/ScenarioYaml.hpp"
 
+#include "trdp_simulator/simulation/HexCodec.hpp"
+
+#include <charconv>
 #include <sstream>
 #include <stdexcept>
 
 namespace trdp::simulation::scenario_yaml {
 
 std::string trim(std::string value) {
+    return std::string{trimView(value)};
+}
+
+std::string_view trimView(std::string_view value) noexcept {
     const auto first = value.find_first_not_of(" \t\r\n");
-    if (first == std::string::npos) {
+    if (first == std::string_view::npos) {
         return {};
     }
     const auto last = value.find_last_not_of(" \t\r\n");
@@ -15,29 +22,49 @@ std::string trim(std::string value) {
 }
 
 std::pair<std::string, std::string> parseKeyValue(const std::string &line) {
+    const auto [key, value] = splitKeyValue(line);
+    return {std::string{key}, std::string{value}};
+}
+
+std::pair<std::string_view, std::string_view> splitKeyValue(std::string_view line) {
     const auto pos = line.find(':');
-    if (pos == std::string::npos) {
-        throw ScenarioValidationError{"Invalid line (missing ':'): " + line};
+    if (pos == std::string_view::npos) {
+        throw ScenarioValidationError{"Invalid line (missing ':'): " + std::string{line}};
     }
-    auto key = trim(line.substr(0, pos));
-    auto value = trim(line.substr(pos + 1));
+    const auto key = trimView(line.substr(0, pos));
+    auto value = trimView(line.substr(pos + 1));
     if (!value.empty() && value.front() == '"' && value.back() == '"') {
         value = value.substr(1, value.size() - 2);
     }
-    return {std::move(key), std::move(value)};
+    return {key, value};
 }
 
-ScenarioEvent::Type parseType(const std::string &token) {
+ScenarioEvent::Type parseType(std::string_view token) {
     if (token == "pd") {
         return ScenarioEvent::Type::ProcessData;
     }
     if (token == "md") {
         return ScenarioEvent::Type::MessageData;
     }
-    throw ScenarioValidationError{"Unknown event type: " + token};
+    if (token == "set") {
+        return ScenarioEvent::Type::StateUpdate;
+    }
+    throw ScenarioValidationError{"Unknown event type: " + std::string{token}};
 }
 
-std::vector<std::uint8_t> parsePayload(const std::string &value) {
+const char *typeName(ScenarioEvent::Type type) noexcept {
+    switch (type) {
+    case ScenarioEvent::Type::ProcessData:
+        return "pd";
+    case ScenarioEvent::Type::MessageData:
+        return "md";
+    case ScenarioEvent::Type::StateUpdate:
+        return "set";
+    }
+    return "pd";
+}
+
+std::vector<std::uint8_t> parsePayload(std::string_view value) {
     if (value.empty()) {
         return {};
     }
@@ -45,33 +72,83 @@ std::vector<std::uint8_t> parsePayload(const std::string &value) {
         if ((value.size() - 2) % 2 != 0) {
             throw ScenarioValidationError{"Hex payload must contain an even number of characters"};
         }
-        std::vector<std::uint8_t> payload;
-        const auto hex = value.substr(2);
-        payload.reserve(hex.size() / 2);
-        for (std::size_t i = 0; i < hex.size(); i += 2) {
-            const auto byteStr = hex.substr(i, 2);
-            const auto byte = static_cast<std::uint8_t>(std::stoul(byteStr, nullptr, 16));
-            payload.push_back(byte);
+        const auto digits = value.substr(2);
+        std::vector<std::uint8_t> payload(digits.size() / 2);
+        if (const auto decoded = hex::decode(digits, payload.data()); decoded != digits.size()) {
+            const auto bad = digits.substr(decoded & ~std::size_t{1}, 2);
+            throw ScenarioValidationError{"Invalid hex payload byte: " + std::string{bad}};
         }
         return payload;
     }
     return std::vector<std::uint8_t>(value.begin(), value.end());
 }
 
-std::chrono::milliseconds parseDelay(const std::string &value) {
+std::chrono::milliseconds parseDelay(std::string_view value) {
     if (value.empty()) {
         return std::chrono::milliseconds{0};
     }
-    return std::chrono::milliseconds{std::stoll(value)};
+    std::int64_t milliseconds = 0;
+    const auto *end = value.data() + value.size();
+    const auto [parsed, ec] = std::from_chars(value.data(), end, milliseconds);
+    if (ec != std::errc{} || parsed != end) {
+        throw ScenarioValidationError{"Invalid duration in milliseconds: " + std::string{value}};
+    }
+    return std::chrono::milliseconds{milliseconds};
+}
+
+FieldMatch::Op parseFieldOp(std::string_view token) {
+    if (token == "eq") {
+        return FieldMatch::Op::Equal;
+    }
+    if (token == "ne") {
+        return FieldMatch::Op::NotEqual;
+    }
+    if (token == "lt") {
+        return FieldMatch::Op::Less;
+    }
+    if (token == "le") {
+        return FieldMatch::Op::LessEqual;
+    }
+    if (token == "gt") {
+        return FieldMatch::Op::Greater;
+    }
+    if (token == "ge") {
+        return FieldMatch::Op::GreaterEqual;
+    }
+    throw ScenarioValidationError{"Unknown field operator: " + std::string{token}};
+}
+
+const char *fieldOpName(FieldMatch::Op op) noexcept {
+    switch (op) {
+    case FieldMatch::Op::Equal:
+        return "eq";
+    case FieldMatch::Op::NotEqual:
+        return "ne";
+    case FieldMatch::Op::Less:
+        return "lt";
+    case FieldMatch::Op::LessEqual:
+        return "le";
+    case FieldMatch::Op::Greater:
+        return "gt";
+    case FieldMatch::Op::GreaterEqual:
+        return "ge";
+    }
+    return "eq";
 }
 
 std::string describeEvent(const ScenarioEvent &event) {
     std::ostringstream oss;
-    oss << (event.type == ScenarioEvent::Type::ProcessData ? "pd" : "md");
+    oss << typeName(event.type);
     oss << "::" << event.label;
     oss << "::comId=" << event.comId;
     oss << "::dataset=" << event.datasetId;
-    oss << "::bytes=" << event.payload.size();
+    if (event.type == ScenarioEvent::Type::StateUpdate) {
+        oss << "::field=" << event.field << "::value=" << event.value;
+    } else if (event.fromState) {
+        oss << "::source=state";
+    } else {
+        oss << "::bytes=" << event.payload.size();
+    }
     oss << "::delayMs=" << event.delay.count();
     return oss.str();
 }
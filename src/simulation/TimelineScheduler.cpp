@@ -0,0 +1,125 @@
+#include "trdp_simulator/simulation/TimelineScheduler.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace trdp::simulation {
+namespace {
+
+struct LaterDeadline {
+    template <typename Entry>
+    bool operator()(const Entry &lhs, const Entry &rhs) const noexcept {
+        if (lhs.deadline != rhs.deadline) {
+            return lhs.deadline > rhs.deadline;
+        }
+        return lhs.sequence > rhs.sequence;
+    }
+};
+
+} // namespace
+
+std::vector<TimelinePlan> planTimelines(const Scenario &scenario) {
+    std::vector<TimelinePlan> plans;
+    std::unordered_map<std::string, std::size_t> index;
+    plans.push_back(TimelinePlan{{}, {}});
+    index.emplace(std::string{}, 0);
+    for (const auto &timeline : scenario.timelines) {
+        if (index.emplace(timeline.name, plans.size()).second) {
+            plans.push_back(TimelinePlan{timeline.name, {}});
+        }
+    }
+    for (const auto &event : scenario.events) {
+        auto [it, inserted] = index.emplace(event.timeline, plans.size());
+        if (inserted) {
+            plans.push_back(TimelinePlan{event.timeline, {}});
+        }
+        plans[it->second].events.push_back(event);
+    }
+    std::erase_if(plans, [](const TimelinePlan &plan) { return plan.events.empty(); });
+    return plans;
+}
+
+TimelineTask::TimelineTask(TimelineTask &&other) noexcept : m_handle(std::exchange(other.m_handle, {})) {}
+
+TimelineTask &TimelineTask::operator=(TimelineTask &&other) noexcept {
+    if (this != &other) {
+        if (m_handle) {
+            m_handle.destroy();
+        }
+        m_handle = std::exchange(other.m_handle, {});
+    }
+    return *this;
+}
+
+TimelineTask::~TimelineTask() {
+    if (m_handle) {
+        m_handle.destroy();
+    }
+}
+
+TimelineTask::Handle TimelineTask::release() noexcept {
+    return std::exchange(m_handle, {});
+}
+
+TimelineScheduler::~TimelineScheduler() {
+    destroyPending();
+}
+
+void TimelineScheduler::spawn(TimelineTask task) {
+    schedule(task.release(), Clock::time_point::min());
+}
+
+void TimelineScheduler::schedule(TimelineTask::Handle handle, Clock::time_point deadline) {
+    m_ready.push_back(Entry{deadline, m_sequence++, handle});
+    std::push_heap(m_ready.begin(), m_ready.end(), LaterDeadline{});
+}
+
+void TimelineScheduler::run(const IdleHook &idle) {
+    while (!m_ready.empty()) {
+        const auto deadline = m_ready.front().deadline;
+        if (deadline > Clock::now()) {
+            if (idle) {
+                idle(deadline);
+            } else {
+                std::this_thread::sleep_until(deadline);
+            }
+        }
+        std::pop_heap(m_ready.begin(), m_ready.end(), LaterDeadline{});
+        const auto handle = m_ready.back().handle;
+        m_ready.pop_back();
+
+        ++m_switches;
+        handle.resume();
+        if (handle.done()) {
+            const auto exception = handle.promise().exception;
+            handle.destroy();
+            if (exception) {
+                destroyPending();
+                std::rethrow_exception(exception);
+            }
+        }
+    }
+}
+
+void TimelineScheduler::destroyPending() noexcept {
+    for (const auto &entry : m_ready) {
+        entry.handle.destroy();
+    }
+    m_ready.clear();
+}
+
+TimelineTask playTimeline(TimelineScheduler &scheduler, const TimelinePlan &plan,
+                          TimelineScheduler::Clock::time_point start, const TimelineEmitter &emit) {
+    EventStream stream{plan.events};
+    EventEmission emission{};
+    auto due = start;
+    while (stream.next(emission)) {
+        due += emission.gap;
+        co_await scheduler.sleepUntil(due);
+        emit(plan, emission);
+    }
+}
+
+} // namespace trdp::simulation
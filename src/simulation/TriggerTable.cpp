@@ -0,0 +1,25 @@
+#include "trdp_simulator/simulation/TriggerTable.hpp"
+
+namespace trdp::simulation {
+
+TriggerTable::TriggerTable(const std::vector<ScenarioTrigger> &triggers, const DeviceStateStore *state) {
+    for (const auto &trigger : triggers) {
+        m_rules[trigger.comId].push_back(Rule{&trigger, PayloadMatcher{trigger.predicate, state}});
+    }
+}
+
+void TriggerTable::evaluate(ScenarioEvent::Type type, std::uint32_t comId, std::span<const std::uint8_t> payload,
+                            std::chrono::steady_clock::time_point receivedAt,
+                            std::vector<TriggerReaction> &fired) const {
+    const auto it = m_rules.find(comId);
+    if (it == m_rules.end()) {
+        return;
+    }
+    for (const auto &rule : it->second) {
+        if (rule.trigger->on == type && rule.matcher.matches(payload)) {
+            fired.push_back(TriggerReaction{rule.trigger, receivedAt});
+        }
+    }
+}
+
+} // namespace trdp::simulation
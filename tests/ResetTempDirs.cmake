@@ -0,0 +1,6 @@
+# Recreates ROOT with one empty directory per test named in TESTS (comma-separated).
+file(REMOVE_RECURSE "${ROOT}")
+string(REPLACE "," ";" test_names "${TESTS}")
+foreach(test_name IN LISTS test_names)
+    file(MAKE_DIRECTORY "${ROOT}/${test_name}")
+endforeach()
@@ -0,0 +1,104 @@
+#include "trdp_simulator/device/DeviceProfileRepository.hpp"
+#include "trdp_simulator/device/XmlValidator.hpp"
+#include "trdp_simulator/simulation/BlobStore.hpp"
+#include "trdp_simulator/simulation/ContentHash.hpp"
+
+#include <cassert>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+using trdp::simulation::BlobStore;
+
+namespace {
+
+std::filesystem::path uniqueTempDir() {
+    auto dir = std::filesystem::temp_directory_path() / ("trdp-blob-store-test" + std::to_string(std::rand()));
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+std::string readFile(const std::filesystem::path &path) {
+    std::ifstream stream{path, std::ios::binary};
+    return {std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+}
+
+void writeFile(const std::filesystem::path &path, const std::string &contents) {
+    std::ofstream stream{path, std::ios::binary | std::ios::trunc};
+    stream << contents;
+}
+
+} // namespace
+
+int main() {
+    const auto dir = uniqueTempDir();
+    BlobStore blobs{dir / "blobs"};
+    writeFile(dir / "source.yaml", "scenario: demo\n");
+
+    // Identical contents share one blob, held through a hard link per owner.
+    const auto first = blobs.storeFile(dir / "source.yaml", dir / "a.yaml");
+    const auto second = blobs.storeContents("scenario: demo\n", dir / "b.yaml");
+    assert(first == second && first == trdp::simulation::fileChecksum(dir / "source.yaml"));
+    assert(blobs.references(first) == 2);
+    assert(std::filesystem::equivalent(dir / "a.yaml", blobs.pathFor(first)));
+    assert(readFile(dir / "b.yaml") == "scenario: demo\n");
+
+    // Replacing an owner's file releases its reference and leaves the other owner's contents alone.
+    const auto changed = blobs.storeContents("scenario: changed\n", dir / "b.yaml");
+    assert(changed != first && blobs.references(first) == 1 && blobs.references(changed) == 1);
+    assert(readFile(dir / "a.yaml") == "scenario: demo\n");
+    (void)trdp::simulation::copyFileWithChecksum(dir / "source.yaml", dir / "b.yaml");
+    assert(readFile(blobs.pathFor(changed)) == "scenario: changed\n");
+
+    // Only blobs nobody links to are collected.
+    const auto collected = blobs.collect();
+    assert(collected.blobs == 1 && collected.bytes == std::string{"scenario: changed\n"}.size());
+    assert(!std::filesystem::exists(blobs.pathFor(changed)));
+    assert(blobs.references(first) == 1);
+    std::filesystem::remove(dir / "a.yaml");
+    assert(blobs.collect().blobs == 1 && !std::filesystem::exists(blobs.pathFor(first)));
+    assert(blobs.references(first) == 0);
+
+    // A blob whose checksum matches but whose bytes differ is never shared, even at the same size.
+    writeFile(dir / "other.yaml", "scenario: other\n");
+    const auto clash = blobs.pathFor(trdp::simulation::fileChecksum(dir / "other.yaml"));
+    std::filesystem::create_directories(clash.parent_path());
+    writeFile(clash, "scenario: OTHER\n");
+    const auto rejects = [&](auto store) {
+        try {
+            store();
+        } catch (const std::runtime_error &) {
+            return true;
+        }
+        return false;
+    };
+    assert(rejects([&] { (void)blobs.storeFile(dir / "other.yaml", dir / "c.yaml"); }));
+    assert(rejects([&] { (void)blobs.storeContents("scenario: other\n", dir / "c.yaml"); }));
+    assert(!std::filesystem::exists(dir / "c.yaml"));
+    std::filesystem::remove(clash);
+    for (const auto &entry : std::filesystem::directory_iterator{blobs.root()}) {
+        assert(!entry.path().filename().string().starts_with("staging-"));
+    }
+
+    // Registering the same profile under two repositories stores it once.
+    const auto repoRoot = std::filesystem::path(__FILE__).parent_path().parent_path();
+    trdp::device::XmlValidator validator{repoRoot / "resources/trdp/trdp-config.xsd"};
+    trdp::device::DeviceProfileRepository devices{dir / "devices", validator};
+    trdp::device::DeviceProfileRepository otherDevices{dir / "other-devices", validator};
+    devices.attachBlobStore(&blobs);
+    otherDevices.attachBlobStore(&blobs);
+    const auto id = devices.registerProfile(repoRoot / "resources/trdp/device1.xml");
+    const auto otherId = otherDevices.registerProfile(repoRoot / "resources/trdp/device1.xml");
+    const auto record = devices.get(id);
+    assert(blobs.references(record.checksum) == 2);
+    assert(std::filesystem::equivalent(record.storedPath, otherDevices.get(otherId).storedPath));
+    // A duplicate registration drops the link it made while hashing.
+    assert(devices.registerProfile(repoRoot / "resources/trdp/device1.xml") == id);
+    assert(blobs.references(record.checksum) == 2);
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
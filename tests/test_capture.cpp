@@ -0,0 +1,154 @@
+#include "trdp_simulator/communication/Wrapper.hpp"
+#include "trdp_simulator/simulation/Engine.hpp"
+#include "trdp_simulator/simulation/RunCapture.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using trdp::simulation::CaptureDirection;
+using trdp::simulation::CaptureQuery;
+using trdp::simulation::CaptureReader;
+using trdp::simulation::CaptureType;
+using trdp::simulation::CaptureWriter;
+
+namespace {
+
+std::filesystem::path tempDir(const std::string &name) {
+    auto dir = std::filesystem::temp_directory_path() / std::filesystem::path{name + std::to_string(std::rand())};
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+constexpr std::uint32_t kRecords = 3 * CaptureWriter::kBlockRecords + 100;
+
+/// Record i is stamped i microseconds; comId 1001 only appears in the first block and in every 7th record.
+std::uint32_t comIdFor(std::uint32_t i) {
+    if (i < CaptureWriter::kBlockRecords && i % 2 == 0) {
+        return 1001;
+    }
+    return i % 7 == 0 ? 2001 : 1002;
+}
+
+} // namespace
+
+int main() {
+    const auto dir = tempDir("capture-");
+    const auto path = dir / "capture.trc";
+    {
+        CaptureWriter writer{path};
+        for (std::uint32_t i = 0; i < kRecords; ++i) {
+            const std::vector<std::uint8_t> payload(i % 5, static_cast<std::uint8_t>(i));
+            writer.append(std::int64_t{i} * 1000, i % 3 == 0 ? CaptureDirection::Received : CaptureDirection::Sent,
+                          i % 4 == 0 ? CaptureType::MessageData : CaptureType::ProcessData, comIdFor(i), i, payload);
+        }
+        assert(writer.recordCount() == kRecords);
+    }
+
+    {
+        CaptureReader reader{path};
+        assert(reader.recordCount() == kRecords);
+        assert(reader.blocks().size() == 4);
+        assert(reader.blocks()[1].minTimestampNs == std::int64_t{CaptureWriter::kBlockRecords} * 1000);
+        assert((reader.blocks()[0].comIds == std::vector<std::uint32_t>{1001, 1002, 2001}));
+
+        const auto all = reader.select({});
+        assert(all.size() == kRecords);
+        for (std::uint32_t i = 0; i < kRecords; ++i) {
+            const auto &record = all[i];
+            assert(record.timestampNs == std::int64_t{i} * 1000);
+            assert(record.comId == comIdFor(i) && record.datasetId == i);
+            assert(record.direction == (i % 3 == 0 ? CaptureDirection::Received : CaptureDirection::Sent));
+            assert(record.type == (i % 4 == 0 ? CaptureType::MessageData : CaptureType::ProcessData));
+            assert(record.payload.size() == i % 5);
+            for (const auto byte : record.payload) {
+                assert(byte == static_cast<std::uint8_t>(i));
+            }
+        }
+
+        // The comId index rules out every block but the first.
+        CaptureQuery byComId;
+        byComId.comId = 1001;
+        assert(reader.candidateBlocks(byComId) == std::vector<std::size_t>{0});
+        assert(reader.select(byComId).size() == CaptureWriter::kBlockRecords / 2);
+
+        // The time index limits a window to the blocks it overlaps.
+        CaptureQuery window;
+        window.comId = 2001;
+        window.fromNs = std::int64_t{CaptureWriter::kBlockRecords + 10} * 1000;
+        window.toNs = std::int64_t{CaptureWriter::kBlockRecords + 80} * 1000;
+        assert(reader.candidateBlocks(window) == std::vector<std::size_t>{1});
+        const auto windowed = reader.select(window);
+        assert(windowed.size() == 10);
+        for (const auto &record : windowed) {
+            assert(record.comId == 2001 && record.timestampNs >= window.fromNs && record.timestampNs <= window.toNs);
+        }
+
+        CaptureQuery unknown;
+        unknown.comId = 42;
+        assert(reader.candidateBlocks(unknown).empty());
+    }
+
+    {
+        // A block cut short ends the capture; the complete blocks before it stay readable.
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+        CaptureReader reader{path};
+        assert(reader.blocks().size() == 3);
+        assert(reader.recordCount() == 3 * CaptureWriter::kBlockRecords);
+    }
+
+    {
+        const auto bogus = dir / "bogus.trc";
+        { std::ofstream{bogus} << "not a capture at all"; }
+        bool threw = false;
+        try {
+            CaptureReader reader{bogus};
+        } catch (const std::runtime_error &) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    {
+        // Engine runs capture what they send and what comes back over the loopback.
+        trdp::communication::Wrapper wrapper{"capture-endpoint"};
+        const auto runRoot = dir / "runs";
+        trdp::simulation::SimulationEngine engine{wrapper, runRoot};
+        trdp::simulation::Scenario scenario{};
+        scenario.id = "capture-smoke";
+        scenario.deviceProfileId = "loopback";
+        scenario.events = {
+            {trdp::simulation::ScenarioEvent::Type::ProcessData, "pd", 1001, 1001, {0x01, 0x02},
+             std::chrono::milliseconds{0}},
+            {trdp::simulation::ScenarioEvent::Type::MessageData, "md", 2001, 2001, {0x03}, std::chrono::milliseconds{0}},
+        };
+        engine.loadScenario(std::move(scenario));
+        engine.run();
+
+        std::filesystem::path capturePath;
+        for (const auto &entry : std::filesystem::directory_iterator{runRoot}) {
+            capturePath = entry.path() / trdp::simulation::kCaptureFileName;
+        }
+        CaptureReader reader{capturePath};
+        const auto records = reader.select({});
+        assert(records.size() == 4);
+        assert(records[0].direction == CaptureDirection::Sent && records[0].comId == 1001);
+        assert(records[0].payload.size() == 2 && records[0].payload[1] == 0x02);
+        std::size_t received = 0;
+        for (std::size_t i = 0; i < records.size(); ++i) {
+            received += records[i].direction == CaptureDirection::Received ? 1 : 0;
+            assert(i == 0 || records[i].timestampNs >= records[i - 1].timestampNs);
+        }
+        assert(received == 2);
+    }
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,172 @@
+#include "trdp_simulator/simulation/CompiledScenario.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using trdp::simulation::CompiledScenario;
+using trdp::simulation::FieldMatch;
+using trdp::simulation::MaskedMatch;
+using trdp::simulation::PayloadCounter;
+using trdp::simulation::Scenario;
+using trdp::simulation::ScenarioEvent;
+using trdp::simulation::ScenarioExpectation;
+using trdp::simulation::ScenarioTrigger;
+
+namespace {
+
+std::filesystem::path tempDir(const std::string &name) {
+    auto dir = std::filesystem::temp_directory_path() / std::filesystem::path{name + std::to_string(std::rand())};
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+std::vector<char> readAll(const std::filesystem::path &path) {
+    std::ifstream stream{path, std::ios::binary};
+    return {std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+}
+
+Scenario richScenario() {
+    using std::chrono::milliseconds;
+    Scenario scenario{};
+    scenario.id = "door control";
+    scenario.deviceProfileId = "device1";
+    scenario.seed = 0xC0FFEE;
+    scenario.events.push_back({ScenarioEvent::Type::ProcessData, "open", 1001, 1001, {0xDE, 0xAD}, milliseconds{5}});
+    auto &generated = scenario.events.emplace_back(
+        ScenarioEvent{ScenarioEvent::Type::ProcessData, "status", 1002, 1002, {1, 2, 3, 4}, milliseconds{0}});
+    generated.generator.repeat = 50;
+    generated.generator.period = milliseconds{10};
+    generated.generator.rampStartHz = 10;
+    generated.generator.rampEndHz = 100;
+    generated.generator.counter = PayloadCounter{2, 2, 7, 3, 300};
+    generated.timeline = "doors";
+    auto &state = scenario.events.emplace_back();
+    state.type = ScenarioEvent::Type::StateUpdate;
+    state.label = "open";
+    state.datasetId = 1001;
+    state.field = "speed[1]";
+    state.value = "42";
+    scenario.events.push_back({ScenarioEvent::Type::MessageData, "", 2001, 0, {}, milliseconds{1}});
+    scenario.timelines.push_back({"doors"});
+
+    ScenarioTrigger trigger{};
+    trigger.label = "echo";
+    trigger.on = ScenarioEvent::Type::MessageData;
+    trigger.comId = 2002;
+    trigger.predicate.masked = MaskedMatch{1, {0xF0}, {0x10}};
+    trigger.action = ScenarioEvent{ScenarioEvent::Type::ProcessData, "echo", 1003, 1003, {9}, milliseconds{2}};
+    trigger.deadline = milliseconds{20};
+    scenario.triggers.push_back(trigger);
+
+    ScenarioExpectation expectation{};
+    expectation.label = "heard";
+    expectation.comId = 1001;
+    expectation.minCount = 2;
+    expectation.maxCount = 9;
+    expectation.window = milliseconds{500};
+    expectation.predicate.field = FieldMatch{0, 2, FieldMatch::Op::GreaterEqual, 256};
+    expectation.cycle = milliseconds{100};
+    expectation.cycleTolerance = milliseconds{5};
+    scenario.expectations.push_back(expectation);
+
+    trdp::communication::FaultProfile fault{};
+    fault.comId = 1001;
+    fault.loss = 0.25;
+    fault.corrupt = 0.5;
+    fault.jitter = std::chrono::microseconds{300};
+    scenario.faults.push_back(fault);
+    trdp::communication::LinkProfile link{};
+    link.comId = 1002;
+    link.distribution = trdp::communication::LatencyDistribution::Pareto;
+    link.latency = std::chrono::microseconds{1500};
+    link.bandwidth = 10'000'000;
+    link.queueLimit = 64;
+    scenario.network.push_back(link);
+    return scenario;
+}
+
+} // namespace
+
+int main() {
+    const auto dir = tempDir("compiled-scenario-");
+    const auto first = dir / "door.tsc";
+    trdp::simulation::writeCompiledScenario(first, richScenario(), "0123456789abcdef");
+
+    const CompiledScenario compiled{first};
+    assert(compiled.checksum() == "0123456789abcdef");
+    assert(compiled.eventCount() == 4);
+    assert(compiled.string(0).empty());
+
+    const auto loaded = compiled.toScenario();
+    assert(loaded.id == "door control" && loaded.deviceProfileId == "device1" && loaded.seed == 0xC0FFEE);
+    assert(loaded.events.size() == 4);
+    assert(loaded.events[0].label == "open" && loaded.events[0].payload == (std::vector<std::uint8_t>{0xDE, 0xAD}));
+    assert(loaded.events[0].delay == std::chrono::milliseconds{5});
+    const auto &generator = loaded.events[1].generator;
+    assert(generator.repeat == 50 && generator.period == std::chrono::milliseconds{10} && generator.ramped());
+    assert(generator.counter && generator.counter->offset == 2 && generator.counter->width == 2);
+    assert(generator.counter->start == 7 && generator.counter->step == 3 && generator.counter->end == 300U);
+    assert(loaded.events[1].timeline == "doors");
+    assert(loaded.events[2].type == ScenarioEvent::Type::StateUpdate && loaded.events[2].field == "speed[1]");
+    assert(loaded.events[2].value == "42" && loaded.events[2].payload.empty());
+    assert(loaded.events[3].type == ScenarioEvent::Type::MessageData && !loaded.events[3].generator.counter);
+    assert(loaded.timelines.size() == 1 && loaded.timelines[0].name == "doors");
+
+    assert(loaded.triggers.size() == 1);
+    const auto &trigger = loaded.triggers[0];
+    assert(trigger.on == ScenarioEvent::Type::MessageData && trigger.comId == 2002);
+    assert(trigger.predicate.masked && trigger.predicate.masked->offset == 1 && !trigger.predicate.field);
+    assert(trigger.predicate.masked->mask[0] == 0xF0 && trigger.predicate.masked->value[0] == 0x10);
+    assert(trigger.action.label == "echo" && trigger.action.payload[0] == 9);
+    assert(trigger.deadline == std::chrono::milliseconds{20});
+
+    assert(loaded.expectations.size() == 1);
+    const auto &expectation = loaded.expectations[0];
+    assert(expectation.minCount == 2 && expectation.maxCount == 9U);
+    assert(expectation.predicate.field && expectation.predicate.field->op == FieldMatch::Op::GreaterEqual);
+    assert(expectation.predicate.field->value == 256 && expectation.cycleTolerance == std::chrono::milliseconds{5});
+
+    assert(loaded.faults.size() == 1 && loaded.faults[0].loss == 0.25 && loaded.faults[0].corrupt == 0.5);
+    assert(loaded.faults[0].jitter == std::chrono::microseconds{300});
+    assert(loaded.network.size() == 1);
+    assert(loaded.network[0].distribution == trdp::communication::LatencyDistribution::Pareto);
+    assert(loaded.network[0].bandwidth == 10'000'000 && loaded.network[0].queueLimit == 64);
+
+    // Compiling the loaded scenario again reproduces the file byte for byte.
+    const auto second = dir / "again.tsc";
+    trdp::simulation::writeCompiledScenario(second, loaded, "0123456789abcdef");
+    assert(readAll(first) == readAll(second));
+    assert(!std::filesystem::exists(dir / "again.tsc.tmp"));
+
+    const auto expectFailure = [](const std::filesystem::path &path) {
+        bool threw = false;
+        try {
+            (void)CompiledScenario{path}.toScenario();
+        } catch (const std::runtime_error &) {
+            threw = true;
+        }
+        assert(threw);
+    };
+    const auto bytes = readAll(first);
+    {
+        std::ofstream truncated{dir / "truncated.tsc", std::ios::binary};
+        truncated.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 8));
+    }
+    expectFailure(dir / "truncated.tsc");
+    {
+        std::ofstream yaml{dir / "door.yaml"};
+        yaml << "scenario: door\n";
+    }
+    expectFailure(dir / "door.yaml");
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,217 @@
+#include "trdp_simulator/communication/Fabric.hpp"
+#include "trdp_simulator/communication/LatencyHistogram.hpp"
+#include "trdp_simulator/communication/MpscQueue.hpp"
+#include "trdp_simulator/device/DeviceConfig.hpp"
+#include "trdp_simulator/simulation/ConsistRunner.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using trdp::communication::Fabric;
+using trdp::communication::FabricFrame;
+using trdp::communication::LatencyHistogram;
+using trdp::communication::MpscQueue;
+using trdp::device::loadDeviceConfig;
+using trdp::simulation::ConsistMember;
+using trdp::simulation::ConsistOptions;
+using trdp::simulation::ConsistRunner;
+using trdp::simulation::loadConsistDefinition;
+using trdp::simulation::Scenario;
+using trdp::simulation::ScenarioEvent;
+
+namespace {
+
+std::filesystem::path deviceXmlPath() {
+    const auto repoRoot = std::filesystem::path(__FILE__).parent_path().parent_path();
+    return repoRoot / "resources/trdp/device1.xml";
+}
+
+std::filesystem::path tempDir(const std::string &name) {
+    auto dir = std::filesystem::temp_directory_path() / std::filesystem::path{name + std::to_string(std::rand())};
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+ConsistMember makeMember(std::size_t index, std::size_t count,
+                         ScenarioEvent::Type type = ScenarioEvent::Type::ProcessData) {
+    ConsistMember member{};
+    member.endpoint = "car" + std::to_string(index);
+    Scenario scenario{};
+    scenario.id = member.endpoint;
+    scenario.deviceProfileId = "device1";
+    ScenarioEvent event{type, "status", static_cast<std::uint32_t>(5000 + index), 1001, {0x01, 0x02},
+                        std::chrono::milliseconds{0}};
+    event.generator.repeat = 5;
+    event.generator.period = std::chrono::milliseconds{1};
+    scenario.events.push_back(event);
+    member.scenario = std::make_shared<const Scenario>(std::move(scenario));
+    member.subscriptions = {static_cast<std::uint32_t>(5000 + (index + 1) % count)};
+    return member;
+}
+
+} // namespace
+
+int main() {
+    {
+        MpscQueue<std::uint64_t> queue{1000};
+        assert(queue.capacity() == 1024);
+        constexpr std::uint64_t kProducers = 4;
+        constexpr std::uint64_t kPerProducer = 20000;
+        std::vector<std::thread> producers;
+        for (std::uint64_t p = 0; p < kProducers; ++p) {
+            producers.emplace_back([&queue, p] {
+                for (std::uint64_t i = 0; i < kPerProducer; ++i) {
+                    while (!queue.tryPush(p * kPerProducer + i)) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        std::vector<std::uint64_t> next(kProducers, 0);
+        std::uint64_t popped = 0;
+        std::uint64_t value = 0;
+        while (popped < kProducers * kPerProducer) {
+            if (!queue.tryPop(value)) {
+                std::this_thread::yield();
+                continue;
+            }
+            const auto producer = value / kPerProducer;
+            assert(value % kPerProducer == next[producer]);
+            ++next[producer];
+            ++popped;
+        }
+        for (auto &producer : producers) {
+            producer.join();
+        }
+        assert(!queue.tryPop(value));
+    }
+
+    {
+        LatencyHistogram histogram;
+        for (int i = 1; i <= 1000; ++i) {
+            histogram.record(std::chrono::microseconds{i});
+        }
+        assert(histogram.count() == 1000);
+        assert(histogram.max() == std::chrono::microseconds{1000});
+        const auto p50 = histogram.percentile(0.5).count();
+        assert(p50 >= 500'000 && p50 <= 535'000);
+        assert(histogram.percentile(1.0) == std::chrono::microseconds{1000});
+        LatencyHistogram other;
+        other.record(std::chrono::milliseconds{5});
+        histogram.merge(other);
+        assert(histogram.count() == 1001);
+        assert(histogram.max() == std::chrono::milliseconds{5});
+    }
+
+    {
+        const auto config = loadDeviceConfig(deviceXmlPath());
+        assert(config.hostName == "device1");
+        assert(config.telegrams.size() == 1);
+        assert(config.telegrams.front().comId == 1001);
+        assert(config.telegrams.front().datasetId == 1001);
+        assert(config.telegrams.front().subscribed && config.telegrams.front().published);
+        assert((config.subscriptions() == std::vector<std::uint32_t>{1001}));
+    }
+
+    {
+        Fabric fabric{2};
+        const auto a = fabric.attach("a", {100});
+        const auto b = fabric.attach("b", {100, 200});
+        const auto c = fabric.attach("c", {});
+        fabric.seal();
+        FabricFrame frame{};
+        frame.source = a;
+        frame.comId = 100;
+        assert(fabric.send(frame) == 1);
+        frame.source = c;
+        assert(fabric.send(frame) == 2);
+        frame.comId = 300;
+        assert(fabric.send(frame) == 0);
+        frame.comId = 200;
+        assert(fabric.send(frame) == 0);
+        assert(fabric.dropped() == 1);
+        FabricFrame received{};
+        assert(fabric.receive(a, received) && received.source == c);
+        assert(!fabric.receive(a, received));
+        assert(fabric.receive(b, received) && received.source == a);
+        assert(fabric.receive(b, received) && received.source == c);
+        assert(!fabric.receive(c, received));
+    }
+
+    {
+        constexpr std::size_t kMembers = 20;
+        ConsistOptions options{};
+        options.shards = 3;
+        ConsistRunner runner{options};
+        for (std::size_t i = 0; i < kMembers; ++i) {
+            runner.addMember(makeMember(i, kMembers));
+        }
+        const auto report = runner.run();
+        assert(report.success());
+        assert(report.shards.size() == 3);
+        std::uint64_t sent = 0;
+        std::uint64_t received = 0;
+        std::size_t members = 0;
+        for (const auto &shard : report.shards) {
+            sent += shard.sent;
+            received += shard.received;
+            members += shard.members;
+            assert(shard.wallTime.count() > 0);
+        }
+        assert(members == kMembers);
+        assert(sent == kMembers * 5);
+        assert(received == kMembers * 5);
+        assert(report.latency.count() == kMembers * 5);
+        assert(report.dropped == 0);
+    }
+
+    {
+        ConsistOptions options{};
+        options.shards = 1;
+        ConsistRunner runner{options};
+        runner.addMember(makeMember(0, 2));
+        runner.addMember(makeMember(1, 2, ScenarioEvent::Type::MessageData));
+        auto member = makeMember(2, 2, ScenarioEvent::Type::MessageData);
+        member.subscriptions.clear();
+        runner.addMember(std::move(member));
+        const auto report = runner.run();
+        assert(!report.success());
+        // The unanswered MD send fails member 2 alone; its shard mates still play their whole timeline.
+        assert(report.shards.front().failures.empty());
+        assert(report.members.size() == 3);
+        assert(report.members[0].endpoint == "car0" && report.members[0].failures.empty());
+        assert(report.members[2].failures.size() == 1);
+        assert(report.shards.front().sent >= 5);
+    }
+
+    {
+        const auto path = tempDir("consist-def-") / "train.yaml";
+        {
+            std::ofstream file{path};
+            file << "consist: train-7\n";
+            file << "shards: 2\n";
+            file << "members:\n";
+            file << "  - scenario: doors\n";
+            file << "    endpoint: car1-doors\n";
+            file << "  - scenario: brakes\n";
+        }
+        const auto definition = loadConsistDefinition(path);
+        assert(definition.id == "train-7");
+        assert(definition.shards == 2);
+        assert(definition.members.size() == 2);
+        assert(definition.members[0].endpoint == "car1-doors");
+        assert(definition.members[1].endpoint == "brakes");
+    }
+
+    return 0;
+}
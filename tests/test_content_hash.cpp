@@ -0,0 +1,85 @@
+#include "trdp_simulator/simulation/ContentHash.hpp"
+
+#include <cassert>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+using trdp::simulation::copyFileWithChecksum;
+using trdp::simulation::fileChecksum;
+using trdp::simulation::Xxh64;
+
+namespace {
+
+std::filesystem::path uniqueTempDir() {
+    auto dir = std::filesystem::temp_directory_path() / ("trdp-content-hash-test" + std::to_string(std::rand()));
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+std::string readFile(const std::filesystem::path &path) {
+    std::ifstream stream{path, std::ios::binary};
+    return {std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+}
+
+} // namespace
+
+int main() {
+    // Reference values of XXH64 with seed 0.
+    assert(Xxh64::hash("") == 0xEF46DB3751D8E999ull);
+    assert(Xxh64::hash("a") == 0xD24EC4F1A98C6E5Bull);
+    assert(Xxh64::hash("abc") == 0x44BC2CF5AD770999ull);
+    assert(Xxh64::hash("Nobody inspects the spammish repetition") == 0xFBCEA83C8A378BF1ull);
+
+    // Splitting the input at any point gives the same digest.
+    std::string text;
+    for (int i = 0; i < 300; ++i) {
+        text.push_back(static_cast<char>('a' + i * 7 % 26));
+    }
+    const auto whole = Xxh64::hash(text);
+    for (std::size_t split = 0; split <= text.size(); split += 13) {
+        Xxh64 hasher;
+        hasher.update(std::string_view{text}.substr(0, split));
+        hasher.update(std::string_view{text}.substr(split));
+        assert(hasher.digest() == whole);
+    }
+    assert(Xxh64::hash(text, 1) != whole);
+
+    const auto dir = uniqueTempDir();
+    const auto source = dir / "source.yaml";
+    {
+        std::ofstream stream{source, std::ios::binary};
+        for (int i = 0; i < 1000; ++i) {
+            stream << text;
+        }
+    }
+    const auto copy = dir / "copy.yaml";
+    {
+        std::ofstream stale{copy};
+        stale << "replaced";
+    }
+    const auto checksum = copyFileWithChecksum(source, copy);
+    assert(checksum.size() == 22 && checksum.starts_with("xxh64:"));
+    assert(checksum == fileChecksum(source));
+    assert(readFile(copy) == readFile(source));
+
+    const auto empty = dir / "empty.yaml";
+    std::ofstream{empty}.close();
+    assert(copyFileWithChecksum(empty, dir / "empty-copy.yaml") == "xxh64:ef46db3751d8e999");
+    assert(std::filesystem::file_size(dir / "empty-copy.yaml") == 0);
+
+    bool threw = false;
+    try {
+        (void)copyFileWithChecksum(source, source);
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    assert(threw && std::filesystem::file_size(source) == text.size() * 1000);
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -1,12 +1,18 @@
 #include "trdp_simulator/device/DeviceProfileRepository.hpp"
 #include "trdp_simulator/device/XmlValidator.hpp"
 
+#include <atomic>
 #include <cassert>
+#include <cstdint>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
 
 using trdp::device::DeviceProfileRepository;
 using trdp::device::DeviceProfileRecord;
@@ -25,6 +31,22 @@ std::filesystem::path uniqueTempDir() {
     return dir;
 }
 
+/// Checksum as versions before XXH64 recorded it: FNV-1a, 16 hex digits.
+std::string fnv1a(const std::filesystem::path &path) {
+    std::ifstream stream{path, std::ios::binary};
+    std::uint64_t hash = 1469598103934665603ull;
+    for (auto it = std::istreambuf_iterator<char>{stream}; it != std::istreambuf_iterator<char>{}; ++it) {
+        hash ^= static_cast<unsigned char>(*it);
+        hash *= 1099511628211ull;
+    }
+    std::ostringstream oss;
+    oss << std::hex;
+    oss.width(16);
+    oss.fill('0');
+    oss << hash;
+    return oss.str();
+}
+
 } // namespace
 
 int main() {
@@ -43,8 +65,24 @@ int main() {
     assert(!record.checksum.empty());
     assert(!record.validatedAt.empty());
 
+    assert(record.checksum.starts_with("xxh64:"));
+
     const auto sameId = repository.registerProfile(validXml);
     assert(sameId == profileId);
+    // The copy made while hashing the duplicate is removed again.
+    assert(!std::filesystem::exists(root / (profileId + "-2.xml")));
+
+    // Profiles registered by earlier versions carry an FNV-1a checksum and are still recognised.
+    const auto legacyRoot = uniqueTempDir();
+    std::filesystem::copy_file(validXml, legacyRoot / "legacy.xml");
+    {
+        std::ofstream manifest{legacyRoot / "manifest.db"};
+        manifest << "legacy|" << (legacyRoot / "legacy.xml").string() << '|' << validXml.string() << '|'
+                 << fnv1a(validXml) << "|2024-01-01T00:00:00Z\n";
+    }
+    DeviceProfileRepository legacyRepository{legacyRoot, validator};
+    assert(legacyRepository.registerProfile(validXml) == "legacy");
+    assert(legacyRepository.list().size() == 1);
 
     // Invalid XML should throw and not create a profile
     const auto invalidPath = root / "invalid.xml";
@@ -61,6 +99,66 @@ int main() {
     assert(threw);
     assert(!repository.exists("invalid"));
 
+    {
+        // Contexts go back to a pool: a rejected file leaves no errors behind, and threads validate concurrently.
+        const auto undeclaredPath = root / "undeclared.xml";
+        std::ofstream{undeclaredPath} << "<undeclared/>\n";
+        const auto rejected = validator.validate(undeclaredPath);
+        assert(!rejected.success && rejected.message.find("undeclared") != std::string::npos);
+        assert(validator.validate(validXml).success);
+        std::atomic<int> mismatches{0};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < 25; ++i) {
+                    const bool valid = (i + t) % 2 == 0;
+                    if (validator.validate(valid ? validXml : undeclaredPath).success != valid) {
+                        ++mismatches;
+                    }
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        assert(mismatches == 0);
+    }
+
+    {
+        // A batch registers new files in order, maps duplicates to the registered profile and fails files alone.
+        const auto sourceDir = uniqueTempDir();
+        std::filesystem::copy_file(validXml, sourceDir / "a-copy.xml");
+        std::filesystem::copy_file(invalidPath, sourceDir / "b-invalid.xml");
+        std::filesystem::copy_file(validXml, sourceDir / "c-variant.xml");
+        {
+            std::ofstream variant{sourceDir / "c-variant.xml", std::ios::app};
+            variant << "<!-- variant -->\n";
+        }
+        std::filesystem::copy_file(sourceDir / "c-variant.xml", sourceDir / "d-variant-copy.xml");
+        const auto files = trdp::simulation::importFiles(sourceDir, {".xml"});
+        assert(files.size() == 4);
+
+        const auto outcomes = repository.registerProfiles(files, 4);
+        assert(outcomes.size() == 4);
+        assert(outcomes[0].ok() && outcomes[0].id == profileId);
+        assert(!outcomes[1].ok() && outcomes[1].error.starts_with("XML validation failed"));
+        assert(outcomes[2].ok() && outcomes[2].id == "c-variant");
+        assert(outcomes[3].ok() && outcomes[3].id == "c-variant");
+        assert(repository.list().size() == 2);
+        for (const auto &entry : std::filesystem::directory_iterator{root}) {
+            assert(entry.path().extension() != ".staging");
+        }
+        // Concurrent imports into one root must never share a staging file.
+        const auto staging = trdp::simulation::importStagingPath(root, ".staging");
+        assert(staging.parent_path() == root && staging.extension() == ".staging");
+        assert(trdp::simulation::importStagingPath(root, ".staging") != staging);
+
+        // One manifest write covers the batch.
+        DeviceProfileRepository reopened{root, validator};
+        assert(reopened.exists("c-variant"));
+        assert(reopened.get("c-variant").checksum == repository.get("c-variant").checksum);
+    }
+
     return 0;
 }
 
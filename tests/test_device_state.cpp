@@ -0,0 +1,244 @@
+#include "trdp_simulator/communication/SeqlockBuffer.hpp"
+#include "trdp_simulator/communication/TelegramObserver.hpp"
+#include "trdp_simulator/communication/Wrapper.hpp"
+#include "trdp_simulator/device/DatasetLayout.hpp"
+#include "trdp_simulator/device/DeviceConfig.hpp"
+#include "trdp_simulator/device/DeviceProfileRepository.hpp"
+#include "trdp_simulator/device/XmlValidator.hpp"
+#include "trdp_simulator/simulation/DeviceStateStore.hpp"
+#include "trdp_simulator/simulation/Engine.hpp"
+#include "trdp_simulator/simulation/ScenarioRepository.hpp"
+#include "trdp_simulator/simulation/ScenarioSchemaValidator.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using trdp::communication::ProcessDataMessage;
+using trdp::communication::SeqlockBuffer;
+using trdp::communication::TelegramObserver;
+using trdp::communication::Wrapper;
+using trdp::device::DatasetLayout;
+using trdp::device::DeviceProfileRepository;
+using trdp::device::XmlValidator;
+using trdp::simulation::DeviceStateStore;
+using trdp::simulation::Scenario;
+using trdp::simulation::ScenarioEvent;
+using trdp::simulation::ScenarioRepository;
+using trdp::simulation::ScenarioSchemaValidator;
+using trdp::simulation::ScenarioValidationError;
+using trdp::simulation::SimulationEngine;
+
+namespace {
+
+std::filesystem::path resourcePath(const std::string &relative) {
+    const auto repoRoot = std::filesystem::path(__FILE__).parent_path().parent_path();
+    return repoRoot / "resources" / relative;
+}
+
+std::filesystem::path tempDir(const std::string &name) {
+    auto dir = std::filesystem::temp_directory_path() / std::filesystem::path{name + std::to_string(std::rand())};
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+class PayloadCapture final : public TelegramObserver {
+public:
+    void onProcessDataReceived(const ProcessDataMessage &message) override { payloads.push_back(message.payload); }
+
+    std::vector<std::vector<std::uint8_t>> payloads;
+};
+
+template <typename Exception, typename Fn>
+bool throws(Fn &&fn) {
+    try {
+        fn();
+    } catch (const Exception &) {
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+int main() {
+    {
+        SeqlockBuffer buffer{11};
+        buffer.write(6, std::vector<std::uint8_t>{0xAA, 0xBB, 0xCC, 0xDD});
+        std::vector<std::uint8_t> out(11);
+        assert(buffer.read(out) == 2);
+        assert((out == std::vector<std::uint8_t>{0, 0, 0, 0, 0, 0, 0xAA, 0xBB, 0xCC, 0xDD, 0}));
+        assert(buffer.version() == 2);
+        assert(throws<std::out_of_range>([&] { buffer.write(8, std::vector<std::uint8_t>(4)); }));
+    }
+
+    {
+        // A reader must never observe a half-written update spanning two words.
+        SeqlockBuffer buffer{16};
+        std::atomic<bool> done{false};
+        std::thread writer{[&] {
+            for (std::uint8_t value = 1; value < 200; ++value) {
+                buffer.write(4, std::vector<std::uint8_t>(8, value));
+            }
+            done = true;
+        }};
+        std::vector<std::uint8_t> out(16);
+        while (!done.load()) {
+            buffer.read(out);
+            for (std::size_t i = 5; i < 12; ++i) {
+                assert(out[i] == out[4]);
+            }
+        }
+        writer.join();
+        buffer.read(out);
+        assert(out[4] == 199 && out[11] == 199);
+    }
+
+    const auto config = trdp::device::loadDeviceConfig(resourcePath("trdp/device1.xml"));
+    assert(config.datasets.size() == 4);
+    {
+        const auto layout = DatasetLayout::compile(config, 1001);
+        assert(layout.name() == "testDS1001");
+        assert(layout.size() == 16);
+        const auto *u32 = layout.find("u32");
+        assert(u32 != nullptr && u32->offset == 4 && u32->size == 4);
+        assert(layout.find("missing") == nullptr);
+
+        const auto arrays = DatasetLayout::compile(config, 1002);
+        assert(arrays.size() == 16 * (1 + 2 + 4 + 8));
+        assert(arrays.find("au64")->offset == 16 * (1 + 2 + 4));
+        assert(DatasetLayout::compile(config, 1003).size() == 4 + 4 + 8);
+
+        auto nested = config;
+        nested.datasets.push_back({"outer", 2000, {{"flag", 1, 1}, {"inner", 1001, 2}}});
+        const auto outer = DatasetLayout::compile(nested, 2000);
+        assert(outer.size() == 1 + 2 * 16);
+        assert(outer.find("inner[1].u16")->offset == 1 + 16 + 2);
+        nested.datasets.push_back({"loop", 2001, {{"self", 2001, 1}}});
+        assert(throws<std::runtime_error>([&] { (void)DatasetLayout::compile(nested, 2001); }));
+    }
+
+    {
+        DeviceStateStore state{config};
+        assert(state.contains(1004) && !state.contains(9999));
+        state.set(1001, "u16", "0x1234");
+        state.set(1001, "u8_B", "255");
+        state.set(1002, "au16[3]", "7");
+        state.set(1004, "i8", "-2");
+        state.set(1004, "r32", "1.5");
+        state.set(1004, "b", "true");
+
+        std::vector<std::uint8_t> payload;
+        state.snapshot(1001, payload);
+        assert(payload.size() == 16);
+        assert(payload[1] == 0xFF && payload[2] == 0x12 && payload[3] == 0x34);
+        state.snapshot(1002, payload);
+        assert(payload[16 + 3 * 2] == 0 && payload[16 + 3 * 2 + 1] == 7);
+
+        const auto &layout = state.layout(1004);
+        state.snapshot(1004, payload);
+        assert(payload[layout.find("i8")->offset] == 0xFE);
+        const auto r32 = layout.find("r32")->offset;
+        assert(payload[r32] == 0x3F && payload[r32 + 1] == 0xC0);
+        assert(payload[layout.find("b")->offset] == 1);
+
+        assert(throws<std::out_of_range>([&] { (void)state.resolve(1001, "nope"); }));
+        assert(throws<std::out_of_range>([&] { (void)state.resolve(1002, "au8[16]"); }));
+        assert(throws<std::invalid_argument>([&] { state.set(1001, "u8_A", "256"); }));
+        assert(throws<std::invalid_argument>([&] { state.set(1004, "i8", "-129"); }));
+        assert(throws<std::invalid_argument>([&] { state.set(1004, "b", "yes"); }));
+    }
+
+    XmlValidator xmlValidator{resourcePath("trdp/trdp-config.xsd")};
+    DeviceProfileRepository deviceRepository{tempDir("state-dev-"), xmlValidator};
+    const auto deviceId = deviceRepository.registerProfile(resourcePath("trdp/device1.xml"));
+    ScenarioSchemaValidator scenarioValidator{resourcePath("scenarios/scenario.schema.yaml")};
+    ScenarioRepository repository{tempDir("state-scenarios-"), deviceRepository, scenarioValidator};
+
+    const auto sourceDir = tempDir("state-src-");
+    const auto scenarioPath = sourceDir / "door-state.yaml";
+    {
+        std::ofstream file{scenarioPath};
+        file << "scenario: door-state\n";
+        file << "device: " << deviceId << "\n";
+        file << "events:\n";
+        file << "  - type: pd\n";
+        file << "    label: door-status\n";
+        file << "    com_id: 1001\n";
+        file << "    dataset_id: 1001\n";
+        file << "    source: state\n";
+        file << "  - type: set\n";
+        file << "    label: door-open\n";
+        file << "    dataset_id: 1001\n";
+        file << "    field: u16\n";
+        file << "    value: 513\n";
+        file << "  - type: pd\n";
+        file << "    label: door-status\n";
+        file << "    com_id: 1001\n";
+        file << "    dataset_id: 1001\n";
+        file << "    source: state\n";
+        file << "triggers:\n";
+        file << "  - label: latch\n";
+        file << "    on_com_id: 1001\n";
+        file << "    field_offset: 2\n";
+        file << "    field_width: 2\n";
+        file << "    field_value: 513\n";
+        file << "    type: set\n";
+        file << "    dataset_id: 1001\n";
+        file << "    field: u8_A\n";
+        file << "    value: 1\n";
+    }
+    const auto id = repository.importScenario(scenarioPath);
+    Scenario scenario = repository.load(id);
+    assert(scenario.events[0].fromState);
+    assert(scenario.events[1].type == ScenarioEvent::Type::StateUpdate);
+    assert(scenario.triggers.front().action.field == "u8_A");
+
+    DeviceStateStore state{config};
+    Wrapper wrapper{"state-endpoint"};
+    PayloadCapture capture;
+    wrapper.addObserver(capture);
+    SimulationEngine engine{wrapper, tempDir("state-runs-"), &repository};
+    engine.loadScenario(scenario);
+    engine.attachDeviceState(nullptr);
+    assert(throws<std::logic_error>([&] { engine.run(); }));
+    engine.attachDeviceState(&state);
+    engine.run();
+    wrapper.removeObserver(capture);
+
+    assert(capture.payloads.size() == 2);
+    assert(capture.payloads[0] == std::vector<std::uint8_t>(16, 0));
+    assert(capture.payloads[1][2] == 0x02 && capture.payloads[1][3] == 0x01);
+    std::vector<std::uint8_t> payload;
+    state.snapshot(1001, payload);
+    assert(payload[0] == 1);
+
+    const auto replayed = repository.loadRunScenario(repository.listRunsForScenario(id).front().id);
+    assert(replayed.events[1].field == "u16" && replayed.events[1].value == "513");
+    assert(replayed.events[2].fromState);
+    assert(replayed.triggers.front().action.type == ScenarioEvent::Type::StateUpdate);
+
+    const auto badPath = sourceDir / "bad-state.yaml";
+    {
+        std::ofstream file{badPath};
+        file << "scenario: bad-state\n";
+        file << "device: " << deviceId << "\n";
+        file << "events:\n";
+        file << "  - type: set\n";
+        file << "    label: typo\n";
+        file << "    dataset_id: 1001\n";
+        file << "    field: u17\n";
+        file << "    value: 1\n";
+    }
+    assert(throws<ScenarioValidationError>([&] { (void)repository.importScenario(badPath); }));
+
+    return 0;
+}
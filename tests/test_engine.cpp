@@ -11,6 +11,7 @@
 #include <cstddef>
 #include <cstdlib>
 #include <filesystem>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -104,5 +105,25 @@ int main() {
     assert(std::filesystem::exists(run.artefactPath / "diagnostics.log"));
     assert(std::filesystem::exists(run.artefactPath / "metadata.yaml"));
 
+    Wrapper generatorWrapper{"generator-endpoint"};
+    std::vector<std::uint8_t> sequence;
+    generatorWrapper.registerProcessDataHandler(
+        [&sequence](const trdp::communication::ProcessDataMessage &message) { sequence.push_back(message.payload[1]); });
+    SimulationEngine generatorEngine{generatorWrapper, runRoot, &repository};
+
+    Scenario generated{};
+    generated.id = "generator-smoke";
+    generated.deviceProfileId = "loopback";
+    ScenarioEvent heartbeat{ScenarioEvent::Type::ProcessData, "heartbeat", 1001, 1001, {0xAA, 0x00},
+                            std::chrono::milliseconds{0}};
+    heartbeat.generator.repeat = 5;
+    heartbeat.generator.period = std::chrono::milliseconds{1};
+    heartbeat.generator.counter = trdp::simulation::PayloadCounter{1, 1, 10, 5, std::nullopt};
+    generated.events = {heartbeat};
+
+    generatorEngine.loadScenario(std::move(generated));
+    generatorEngine.run();
+    assert((sequence == std::vector<std::uint8_t>{10, 15, 20, 25, 30}));
+
     return 0;
 }
@@ -0,0 +1,171 @@
+#include "trdp_simulator/communication/Wrapper.hpp"
+#include "trdp_simulator/device/DeviceProfileRepository.hpp"
+#include "trdp_simulator/device/XmlValidator.hpp"
+#include "trdp_simulator/simulation/Engine.hpp"
+#include "trdp_simulator/simulation/ExpectationMonitor.hpp"
+#include "trdp_simulator/simulation/ScenarioRepository.hpp"
+#include "trdp_simulator/simulation/ScenarioSchemaValidator.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using trdp::communication::Wrapper;
+using trdp::device::DeviceProfileRepository;
+using trdp::device::XmlValidator;
+using trdp::simulation::ExpectationMonitor;
+using trdp::simulation::FieldMatch;
+using trdp::simulation::Scenario;
+using trdp::simulation::ScenarioEvent;
+using trdp::simulation::ScenarioExpectation;
+using trdp::simulation::ScenarioRepository;
+using trdp::simulation::ScenarioSchemaValidator;
+using trdp::simulation::SimulationEngine;
+
+namespace {
+
+std::filesystem::path deviceSchemaPath() {
+    const auto repoRoot = std::filesystem::path(__FILE__).parent_path().parent_path();
+    return repoRoot / "resources/trdp/trdp-config.xsd";
+}
+
+std::filesystem::path scenarioSchemaPath() {
+    const auto repoRoot = std::filesystem::path(__FILE__).parent_path().parent_path();
+    return repoRoot / "resources/scenarios/scenario.schema.yaml";
+}
+
+std::filesystem::path tempDir(const std::string &name) {
+    auto dir = std::filesystem::temp_directory_path() / std::filesystem::path{name + std::to_string(std::rand())};
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+std::string readFile(const std::filesystem::path &path) {
+    std::ifstream stream{path};
+    std::ostringstream oss;
+    oss << stream.rdbuf();
+    return oss.str();
+}
+
+} // namespace
+
+int main() {
+    using namespace std::chrono_literals;
+
+    {
+        std::vector<ScenarioExpectation> expectations(3);
+        expectations[0].label = "speed-window";
+        expectations[0].comId = 1001;
+        expectations[0].minCount = 2;
+        expectations[0].maxCount = 2;
+        expectations[0].window = 50ms;
+        expectations[0].predicate.field = FieldMatch{0, 1, FieldMatch::Op::LessEqual, 100};
+        expectations[1].label = "cyclic";
+        expectations[1].comId = 1001;
+        expectations[1].minCount = 0;
+        expectations[1].cycle = 20ms;
+        expectations[1].cycleTolerance = 5ms;
+        expectations[2].label = "md-reply";
+        expectations[2].type = ScenarioEvent::Type::MessageData;
+        expectations[2].comId = 1001;
+
+        ExpectationMonitor monitor{expectations};
+        const auto start = std::chrono::steady_clock::now();
+        monitor.start(start);
+        const std::vector<std::uint8_t> slow{40};
+        monitor.observe(ScenarioEvent::Type::ProcessData, 1001, slow, start + 10ms);
+        monitor.observe(ScenarioEvent::Type::ProcessData, 1001, slow, start + 30ms);
+        monitor.observe(ScenarioEvent::Type::ProcessData, 1001, slow, start + 80ms);
+        monitor.observe(ScenarioEvent::Type::ProcessData, 4242, slow, start + 81ms);
+
+        const auto results = monitor.results();
+        assert(results.size() == 3);
+        assert(results[0].passed);
+        assert(results[0].detail.find("received=3 in_window=2") != std::string::npos);
+        assert(!results[1].passed);
+        assert(results[1].detail.find("cycle_violations=1") != std::string::npos);
+        assert(results[1].detail.find("max_cycle_deviation_us=30000") != std::string::npos);
+        assert(!results[2].passed);
+
+        const std::vector<std::uint8_t> fast{200};
+        monitor.observe(ScenarioEvent::Type::ProcessData, 1001, fast, start + 100ms);
+        assert(!monitor.results()[0].passed);
+    }
+
+    XmlValidator xmlValidator{deviceSchemaPath()};
+    DeviceProfileRepository deviceRepository{tempDir("expect-dev-"), xmlValidator};
+    const auto deviceId = deviceRepository.registerProfile(deviceSchemaPath().parent_path() / "device1.xml");
+    ScenarioSchemaValidator scenarioValidator{scenarioSchemaPath()};
+    const auto repositoryRoot = tempDir("expect-scenarios-");
+    ScenarioRepository repository{repositoryRoot, deviceRepository, scenarioValidator};
+
+    const auto scenarioPath = tempDir("expect-src-") / "brake-status.yaml";
+    {
+        std::ofstream file{scenarioPath};
+        file << "scenario: brake-status\n";
+        file << "device: " << deviceId << "\n";
+        file << "events:\n";
+        file << "  - type: pd\n";
+        file << "    label: brake-status\n";
+        file << "    com_id: 1001\n";
+        file << "    payload: 0x0010\n";
+        file << "    repeat: 3\n";
+        file << "    period_ms: 1\n";
+        file << "expect:\n";
+        file << "  - label: status-published\n";
+        file << "    com_id: 1001\n";
+        file << "    min_count: 3\n";
+        file << "    field_offset: 0\n";
+        file << "    field_width: 2\n";
+        file << "    field_op: eq\n";
+        file << "    field_value: 16\n";
+        file << "  - label: reply-missing\n";
+        file << "    type: md\n";
+        file << "    com_id: 2001\n";
+    }
+
+    const auto id = repository.importScenario(scenarioPath);
+    Scenario scenario = repository.load(id);
+    assert(scenario.expectations.size() == 2);
+    assert(scenario.expectations.front().predicate.field.has_value());
+
+    Wrapper wrapper{"expect-endpoint"};
+    SimulationEngine engine{wrapper, tempDir("expect-runs-"), &repository};
+    engine.loadScenario(std::move(scenario));
+    engine.run();
+
+    const auto &results = engine.expectationResults();
+    assert(results.size() == 2);
+    assert(results[0].passed);
+    assert(!results[1].passed);
+
+    const auto runs = repository.listRunsForScenario(id);
+    assert(runs.size() == 1);
+    assert(!runs.front().success);
+    assert(runs.front().detail.find("reply-missing") != std::string::npos);
+    assert(runs.front().expectations.size() == 2);
+    const auto metadata = readFile(runs.front().artefactPath / "metadata.yaml");
+    assert(metadata.find("success: false") != std::string::npos);
+    assert(metadata.find("  - label: status-published\n    passed: true") != std::string::npos);
+    assert(metadata.find("  - label: reply-missing\n    passed: false") != std::string::npos);
+
+    const auto replayed = repository.loadRunScenario(runs.front().id);
+    assert(replayed.expectations.size() == 2);
+    assert(replayed.expectations.front().minCount == 3);
+
+    ScenarioRepository reloaded{repositoryRoot, deviceRepository, scenarioValidator};
+    const auto persisted = reloaded.listRunsForScenario(id);
+    assert(persisted.size() == 1);
+    assert(persisted.front().expectations.size() == 2);
+    assert(persisted.front().expectations[0].passed);
+    assert(!persisted.front().expectations[1].passed);
+
+    return 0;
+}
@@ -0,0 +1,274 @@
+#include "trdp_simulator/communication/FaultInjectingAdapter.hpp"
+#include "trdp_simulator/communication/TimingWheel.hpp"
+#include "trdp_simulator/communication/Wrapper.hpp"
+#include "trdp_simulator/device/DeviceProfileRepository.hpp"
+#include "trdp_simulator/device/XmlValidator.hpp"
+#include "trdp_simulator/simulation/Engine.hpp"
+#include "trdp_simulator/simulation/ScenarioRepository.hpp"
+#include "trdp_simulator/simulation/ScenarioSchemaValidator.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using trdp::communication::FaultInjectingAdapter;
+using trdp::communication::FaultProfile;
+using trdp::communication::MessageDataAck;
+using trdp::communication::MessageDataHandler;
+using trdp::communication::MessageDataMessage;
+using trdp::communication::MessageDataStatus;
+using trdp::communication::ProcessDataHandler;
+using trdp::communication::ProcessDataMessage;
+using trdp::communication::StackAdapter;
+using trdp::communication::TimingWheel;
+using trdp::communication::Wrapper;
+using trdp::device::DeviceProfileRepository;
+using trdp::device::XmlValidator;
+using trdp::simulation::Scenario;
+using trdp::simulation::ScenarioRepository;
+using trdp::simulation::ScenarioSchemaValidator;
+using trdp::simulation::ScenarioValidationError;
+using trdp::simulation::SimulationEngine;
+
+namespace {
+
+std::filesystem::path resourcePath(const std::string &relative) {
+    const auto repoRoot = std::filesystem::path(__FILE__).parent_path().parent_path();
+    return repoRoot / "resources" / relative;
+}
+
+std::filesystem::path tempDir(const std::string &name) {
+    auto dir = std::filesystem::temp_directory_path() / std::filesystem::path{name + std::to_string(std::rand())};
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+/// Records what reaches the wire.
+class RecordingAdapter final : public StackAdapter {
+public:
+    void openSession(const std::string &) override {}
+    void closeSession() override {}
+    void registerProcessDataHandler(ProcessDataHandler) override {}
+    void registerMessageDataHandler(MessageDataHandler) override {}
+    void publishProcessData(const ProcessDataMessage &message) override { published.push_back(message); }
+    MessageDataAck sendMessageData(const MessageDataMessage &message) override {
+        sent.push_back(message);
+        return {};
+    }
+    void poll() override {}
+
+    std::vector<ProcessDataMessage> published;
+    std::vector<MessageDataMessage> sent;
+};
+
+ProcessDataMessage telegram(std::uint32_t comId, std::uint8_t index) {
+    return ProcessDataMessage{"t", comId, comId, {index, 0x00, 0xFF, 0x55}};
+}
+
+std::vector<std::vector<std::uint8_t>> wire(const RecordingAdapter &adapter, std::uint32_t comId) {
+    std::vector<std::vector<std::uint8_t>> payloads;
+    for (const auto &message : adapter.published) {
+        if (message.comId == comId) {
+            payloads.push_back(message.payload);
+        }
+    }
+    return payloads;
+}
+
+} // namespace
+
+int main() {
+    using namespace std::chrono_literals;
+
+    {
+        const auto origin = std::chrono::steady_clock::now();
+        TimingWheel<int> wheel{1ms, 8, origin};
+        wheel.schedule(origin + 3ms, 3);
+        wheel.schedule(origin + 1ms, 1);
+        wheel.schedule(origin + 20ms, 20);
+        wheel.schedule(origin + 3ms, 4);
+        std::vector<int> fired;
+        const auto collect = [&](int &&value) { fired.push_back(value); };
+        assert(wheel.advance(origin, collect) == 0);
+        assert(wheel.advance(origin + 3ms, collect) == 3);
+        assert((fired == std::vector<int>{1, 3, 4}));
+        // Deadline 20ms shares a slot with 4ms (8 slots) but must wait for its own round.
+        assert(wheel.advance(origin + 5ms, collect) == 0);
+        wheel.schedule(origin + 12ms, 12);
+        wheel.schedule(origin, 0);
+        assert(wheel.advance(origin + 6ms, collect) == 1);
+        assert(fired.back() == 0);
+        // A jump over several revolutions still fires in deadline order.
+        assert(wheel.advance(origin + 100ms, collect) == 2);
+        assert((fired == std::vector<int>{1, 3, 4, 0, 12, 20}));
+        wheel.schedule(origin + 500ms, 500);
+        assert(wheel.drain(collect) == 1 && wheel.empty());
+    }
+
+    {
+        auto inner = std::make_shared<RecordingAdapter>();
+        FaultInjectingAdapter adapter{inner, {FaultProfile{1001, 1.0}}, 7};
+        adapter.publishProcessData(telegram(1001, 1));
+        adapter.publishProcessData(telegram(2002, 2));
+        assert(inner->published.size() == 1 && inner->published.front().comId == 2002);
+        assert(adapter.stats().dropped == 1);
+        const auto ack = adapter.sendMessageData(MessageDataMessage{"md", 1001, 1001, {1}});
+        assert(ack.status == MessageDataStatus::Timeout);
+        assert(inner->sent.empty());
+        assert((std::invoke([] {
+            try {
+                FaultInjectingAdapter invalid{std::make_shared<RecordingAdapter>(), {FaultProfile{1, 1.5}}, 0};
+            } catch (const std::invalid_argument &) {
+                return true;
+            }
+            return false;
+        })));
+    }
+
+    {
+        // The same seed reproduces the same wire sequence, also when other comIds interleave differently.
+        const FaultProfile mixed{1001, 0.2, 0.2, 0.2, 0.3};
+        const FaultProfile other{2002, 0.5};
+        const auto play = [&](std::uint64_t seed, bool interleave) {
+            auto inner = std::make_shared<RecordingAdapter>();
+            FaultInjectingAdapter adapter{inner, {mixed, other}, seed};
+            for (std::uint8_t i = 0; i < 200; ++i) {
+                adapter.publishProcessData(telegram(1001, i));
+                if (interleave && i % 3 == 0) {
+                    adapter.publishProcessData(telegram(2002, i));
+                }
+            }
+            adapter.closeSession();
+            return std::make_pair(wire(*inner, 1001), adapter.stats());
+        };
+        const auto [first, stats] = play(42, true);
+        const auto [again, statsAgain] = play(42, false);
+        assert(first == again);
+        assert(statsAgain.duplicated > 0 && statsAgain.reordered > 0 && statsAgain.corrupted > 0);
+        assert(first.size() == 200 - statsAgain.dropped + statsAgain.duplicated);
+        assert(play(43, true).first != first);
+    }
+
+    {
+        // ComIds falling back to the comId 0 profile each get their own generator as well.
+        const FaultProfile wildcard{0, 0.2, 0.2, 0.2, 0.3};
+        const auto play = [&](bool interleave) {
+            auto inner = std::make_shared<RecordingAdapter>();
+            FaultInjectingAdapter adapter{inner, {wildcard}, 42};
+            for (std::uint8_t i = 0; i < 200; ++i) {
+                adapter.publishProcessData(telegram(1001, i));
+                if (interleave) {
+                    adapter.publishProcessData(telegram(2002, i));
+                }
+            }
+            adapter.closeSession();
+            return wire(*inner, 1001);
+        };
+        assert(play(true) == play(false));
+    }
+
+    {
+        auto inner = std::make_shared<RecordingAdapter>();
+        FaultInjectingAdapter adapter{inner, {FaultProfile{0, 0.0, 0.0, 0.0, 0.0, 5ms, 0us}}, 1};
+        adapter.publishProcessData(telegram(1001, 1));
+        adapter.poll();
+        assert(inner->published.empty());
+        assert(adapter.pending() == 1 && adapter.stats().delayed == 1);
+        std::this_thread::sleep_for(6ms);
+        adapter.poll();
+        assert(inner->published.size() == 1 && adapter.pending() == 0);
+        adapter.publishProcessData(telegram(1001, 2));
+        adapter.closeSession();
+        assert(inner->published.size() == 2);
+    }
+
+    XmlValidator xmlValidator{resourcePath("trdp/trdp-config.xsd")};
+    DeviceProfileRepository deviceRepository{tempDir("faults-dev-"), xmlValidator};
+    const auto deviceId = deviceRepository.registerProfile(resourcePath("trdp/device1.xml"));
+    ScenarioSchemaValidator scenarioValidator{resourcePath("scenarios/scenario.schema.yaml")};
+    ScenarioRepository repository{tempDir("faults-scenarios-"), deviceRepository, scenarioValidator};
+
+    const auto sourceDir = tempDir("faults-src-");
+    const auto scenarioPath = sourceDir / "lossy-doors.yaml";
+    {
+        std::ofstream file{scenarioPath};
+        file << "scenario: lossy-doors\n";
+        file << "device: " << deviceId << "\n";
+        file << "seed: 1234\n";
+        file << "events:\n";
+        file << "  - type: pd\n";
+        file << "    label: door-status\n";
+        file << "    com_id: 1001\n";
+        file << "    payload: 0x01\n";
+        file << "    repeat: 50\n";
+        file << "faults:\n";
+        file << "  - com_id: 1001\n";
+        file << "    loss: 0.25\n";
+        file << "    duplicate: 0.1\n";
+        file << "    delay_us: 2000\n";
+        file << "    jitter_us: 1500\n";
+    }
+    const auto id = repository.importScenario(scenarioPath);
+    Scenario scenario = repository.load(id);
+    assert(scenario.seed == 1234);
+    assert(scenario.faults.size() == 1);
+    assert(scenario.faults.front().loss == 0.25);
+    assert(scenario.faults.front().delay == 2ms);
+    assert(scenario.faults.front().jitter == 1500us);
+
+    const auto runOnce = [&](const Scenario &source) {
+        auto faults = std::make_shared<FaultInjectingAdapter>(trdp::communication::makeLoopbackStackAdapter(),
+                                                              source.faults, source.seed);
+        std::uint64_t received = 0;
+        Wrapper wrapper{"faults-endpoint", faults};
+        wrapper.registerProcessDataHandler([&](const ProcessDataMessage &) { ++received; });
+        SimulationEngine engine{wrapper, tempDir("faults-runs-"), &repository};
+        engine.loadScenario(source);
+        engine.run();
+        assert(received == 50 - faults->stats().dropped + faults->stats().duplicated);
+        return faults->stats();
+    };
+    const auto stats = runOnce(scenario);
+    assert(stats.dropped > 0 && stats.delayed > 0);
+
+    const auto replayed = repository.loadRunScenario(repository.listRunsForScenario(id).front().id);
+    assert(replayed.seed == 1234);
+    assert(replayed.faults.size() == 1 && replayed.faults.front().loss == 0.25);
+    // Fault timing shares the microsecond unit of network links, so sub-millisecond jitter survives the run record.
+    assert(replayed.faults.front().jitter == 1500us);
+    const auto replayStats = runOnce(replayed);
+    assert(replayStats.dropped == stats.dropped && replayStats.duplicated == stats.duplicated);
+
+    const auto badPath = sourceDir / "bad-faults.yaml";
+    {
+        std::ofstream file{badPath};
+        file << "scenario: bad-faults\n";
+        file << "device: " << deviceId << "\n";
+        file << "events:\n";
+        file << "  - type: pd\n";
+        file << "    label: door-status\n";
+        file << "faults:\n";
+        file << "  - com_id: 1001\n";
+        file << "    loss: 1.5\n";
+    }
+    bool rejected = false;
+    try {
+        (void)repository.importScenario(badPath);
+    } catch (const ScenarioValidationError &) {
+        rejected = true;
+    }
+    assert(rejected);
+
+    return 0;
+}
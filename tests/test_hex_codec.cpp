@@ -0,0 +1,65 @@
+#include "trdp_simulator/simulation/HexCodec.hpp"
+#include "trdp_simulator/simulation/ScenarioYaml.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace hex = trdp::simulation::hex;
+
+int main() {
+    assert(hex::kernelSupported(hex::Kernel::Scalar));
+    assert(hex::kernelSupported(hex::activeKernel()));
+
+    std::vector<std::uint8_t> bytes(300);
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<std::uint8_t>(i * 151 + 7);
+    }
+
+    for (const auto kernel : {hex::Kernel::Scalar, hex::Kernel::Sse2, hex::Kernel::Avx2}) {
+        if (!hex::kernelSupported(kernel)) {
+            continue;
+        }
+        // Lengths around every vector width, so the scalar tails are exercised too.
+        for (std::size_t size = 0; size <= 100; ++size) {
+            const std::span<const std::uint8_t> input{bytes.data(), size};
+            std::string digits(2 * size, '?');
+            hex::encode(input, digits.data(), kernel);
+            assert(digits == hex::encode(input));
+
+            std::vector<std::uint8_t> decoded(size);
+            assert(hex::decode(digits, decoded.data(), kernel) == digits.size());
+            assert(std::equal(decoded.begin(), decoded.end(), input.begin()));
+        }
+        std::string mixed = "00ff7FaBcD09e1F2" + hex::encode(bytes);
+        std::vector<std::uint8_t> decoded(mixed.size() / 2);
+        assert(hex::decode(mixed, decoded.data(), kernel) == mixed.size());
+        assert(decoded[1] == 0xFF && decoded[2] == 0x7F && decoded[3] == 0xAB && decoded[4] == 0xCD);
+
+        // Every invalid digit is pinpointed, and the bytes before it are decoded.
+        for (const std::size_t bad : {0U, 1U, 17U, 31U, 32U, 63U, 64U, 299U}) {
+            for (const char ch : {'g', 'G', '/', ':', '@', '`', ' ', '\x80', '\xC6'}) {
+                auto digits = hex::encode(bytes);
+                digits[bad] = ch;
+                std::vector<std::uint8_t> partial(bytes.size());
+                assert(hex::decode(digits, partial.data(), kernel) == bad);
+                assert(std::equal(partial.begin(), partial.begin() + bad / 2, bytes.begin()));
+            }
+        }
+        assert(hex::decode("abc", decoded.data(), kernel) == 2 && decoded[0] == 0xAB);
+    }
+
+    using trdp::simulation::ScenarioValidationError;
+    assert(trdp::simulation::scenario_yaml::parsePayload("0X0a0B") == (std::vector<std::uint8_t>{0x0A, 0x0B}));
+    bool threw = false;
+    try {
+        (void)trdp::simulation::scenario_yaml::parsePayload("0x00112233445566778899aabbccddeeff0g");
+    } catch (const ScenarioValidationError &ex) {
+        threw = std::string{ex.what()} == "Invalid hex payload byte: 0g";
+    }
+    assert(threw);
+    return 0;
+}
@@ -0,0 +1,134 @@
+#include "trdp_simulator/communication/NetworkEmulationAdapter.hpp"
+#include "trdp_simulator/communication/Wrapper.hpp"
+#include "trdp_simulator/device/DeviceConfig.hpp"
+#include "trdp_simulator/simulation/LoadGenerator.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using trdp::communication::LatencyDistribution;
+using trdp::communication::LinkProfile;
+using trdp::communication::NetworkEmulationAdapter;
+using trdp::communication::Wrapper;
+using trdp::simulation::LoadGenerator;
+using trdp::simulation::LoadOptions;
+using trdp::simulation::LoadTarget;
+
+namespace {
+
+std::filesystem::path resourcePath(const std::string &relative) {
+    const auto repoRoot = std::filesystem::path(__FILE__).parent_path().parent_path();
+    return repoRoot / "resources" / relative;
+}
+
+std::filesystem::path tempDir(const std::string &name) {
+    auto dir = std::filesystem::temp_directory_path() / std::filesystem::path{name + std::to_string(std::rand())};
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+LoadOptions quickOptions() {
+    using namespace std::chrono_literals;
+    LoadOptions options;
+    options.targets = {LoadTarget{1001, 1001, 16}, LoadTarget{1002, 1002, 4}};
+    options.startRate = 1000.0;
+    options.maxRate = 16000.0;
+    options.stepDuration = 100ms;
+    options.drainTime = 20ms;
+    options.refineSteps = 2;
+    return options;
+}
+
+} // namespace
+
+int main() {
+    {
+        const auto config = trdp::device::loadDeviceConfig(resourcePath("trdp/device1.xml"));
+        const auto targets = trdp::simulation::loadTargets(config);
+        assert(!targets.empty());
+        for (const auto &target : targets) {
+            assert(target.payloadSize >= trdp::simulation::kLoadHeaderSize);
+        }
+        trdp::device::DeviceConfig empty;
+        bool threw = false;
+        try {
+            (void)trdp::simulation::loadTargets(empty);
+        } catch (const std::runtime_error &) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    {
+        // Over the loopback every offered telegram comes straight back: the ramp reaches its maximum.
+        Wrapper wrapper{"load-loopback"};
+        wrapper.setTelegramTracing(false);
+        auto options = quickOptions();
+        options.mdShare = 0.25;
+        LoadGenerator generator{wrapper, options};
+        const auto report = generator.run();
+        assert(report.steps.size() == 5);
+        for (const auto &step : report.steps) {
+            assert(step.sent > 0 && step.received == step.sent && step.mdFailures == 0);
+            assert(step.sustainable);
+        }
+        assert(report.knee && *report.knee == 4);
+        assert(report.maxSustainableRate() > 15000.0);
+        assert(!wrapper.isOpen());
+        assert(wrapper.telemetry().size() == 2);
+
+        const auto path = trdp::simulation::writeLoadReport(tempDir("load-runs-"), "device 1", report);
+        assert(path.filename() == "load-report.yaml");
+        assert(path.parent_path().filename().string().rfind("load-device1-", 0) == 0);
+        std::ifstream stream{path};
+        std::stringstream contents;
+        contents << stream.rdbuf();
+        assert(contents.str().find("steps:\n  - offered_rate: 1000.0\n") != std::string::npos);
+        assert(contents.str().find("knee:\n  offered_rate: 16000.0\n") != std::string::npos);
+        assert(contents.str().find("max_sustainable_rate: ") != std::string::npos);
+    }
+
+    {
+        // A link serialising 16-byte telegrams at about 5600/s with a short queue saturates between 4000 and 8000.
+        using namespace std::chrono_literals;
+        const auto bits = (16 + NetworkEmulationAdapter::kWireOverhead) * 8;
+        LinkProfile link{0, LatencyDistribution::Constant, 100us, 0us, bits * 5600, 32};
+        auto network = std::make_shared<NetworkEmulationAdapter>(trdp::communication::makeLoopbackStackAdapter(),
+                                                                 std::vector<LinkProfile>{link}, 1);
+        Wrapper wrapper{"load-link", network};
+        wrapper.setTelegramTracing(false);
+        auto options = quickOptions();
+        options.targets = {LoadTarget{1001, 1001, 16}};
+        LoadGenerator generator{wrapper, options};
+        const auto report = generator.run();
+        assert(report.knee);
+        const auto &knee = report.steps[*report.knee];
+        assert(knee.offeredRate >= 4000.0 && knee.offeredRate < 5600.0);
+        assert(report.steps[3].offeredRate == 8000.0 && !report.steps[3].sustainable);
+        assert(report.steps[3].loss() > 0.2);
+        assert(report.steps.size() == 6);
+    }
+
+    {
+        Wrapper wrapper;
+        auto options = quickOptions();
+        options.maxRate = 10.0;
+        bool threw = false;
+        try {
+            LoadGenerator generator{wrapper, options};
+        } catch (const std::invalid_argument &) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    return 0;
+}
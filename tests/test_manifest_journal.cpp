@@ -0,0 +1,152 @@
+#include "trdp_simulator/device/DeviceProfileRepository.hpp"
+#include "trdp_simulator/device/XmlValidator.hpp"
+#include "trdp_simulator/simulation/ManifestJournal.hpp"
+#include "trdp_simulator/simulation/ScenarioRepository.hpp"
+#include "trdp_simulator/simulation/ScenarioSchemaValidator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using trdp::simulation::ManifestJournal;
+using trdp::simulation::RunRecord;
+using trdp::simulation::ScenarioRepository;
+
+namespace {
+
+std::filesystem::path tempDir(const std::string &name) {
+    auto dir = std::filesystem::temp_directory_path() / std::filesystem::path{name + std::to_string(std::rand())};
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+std::vector<std::string> replayAll(ManifestJournal &journal) {
+    std::vector<std::string> lines;
+    journal.replay([&](std::string_view line) { lines.emplace_back(line); });
+    return lines;
+}
+
+std::size_t lineCount(const std::filesystem::path &path) {
+    std::ifstream stream{path};
+    return static_cast<std::size_t>(
+        std::count(std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}, '\n'));
+}
+
+RunRecord run(int index) {
+    RunRecord record{};
+    record.id = "run-" + std::to_string(index);
+    record.scenarioId = index % 2 == 0 ? "even" : "odd";
+    record.artefactPath = "/tmp/runs/run-" + std::to_string(index);
+    record.success = index % 3 != 0;
+    record.detail = "pass";
+    return record;
+}
+
+} // namespace
+
+int main() {
+    const auto dir = tempDir("manifest-journal-");
+    const ManifestJournal::Options options{false, 4};
+    {
+        ManifestJournal journal{dir / "m.db", "key|value", options};
+        assert(replayAll(journal).empty());
+        journal.append(std::string{"a|1"});
+        const std::vector<std::string> batch{"b|2", "a|3"};
+        journal.append(batch);
+        assert(journal.journalEntries() == 3 && !journal.compactionDue(2));
+        assert(!std::filesystem::exists(dir / "m.db"));
+    }
+    {
+        // A crash mid-append leaves a partial last line, which replay drops and trims away.
+        { std::ofstream{dir / "m.db.journal", std::ios::app} << "c|tor"; }
+        ManifestJournal journal{dir / "m.db", "key|value", options};
+        assert((replayAll(journal) == std::vector<std::string>{"a|1", "b|2", "a|3"}));
+        journal.append(std::string{"c|4"});
+        assert(journal.compactionDue(3) && !journal.compactionDue(5));
+        const std::vector<std::string> live{"a|3", "b|2", "c|4"};
+        journal.compact(live);
+        assert(journal.journalEntries() == 0 && !std::filesystem::exists(dir / "m.db.journal"));
+        assert(!std::filesystem::exists(dir / "m.db.tmp"));
+        journal.append(std::string{"d|5"});
+    }
+    {
+        ManifestJournal journal{dir / "m.db", "key|value", options};
+        assert((replayAll(journal) == std::vector<std::string>{"a|3", "b|2", "c|4", "d|5"}));
+        assert(journal.journalEntries() == 1);
+    }
+    {
+        // Appending before any replay still drops a torn last line first instead of extending it.
+        { std::ofstream{dir / "m.db.journal", std::ios::app} << "e|to"; }
+        {
+            ManifestJournal journal{dir / "m.db", "key|value", options};
+            journal.append(std::string{"e|6"});
+        }
+        ManifestJournal journal{dir / "m.db", "key|value", options};
+        assert((replayAll(journal) == std::vector<std::string>{"a|3", "b|2", "c|4", "d|5", "e|6"}));
+    }
+    {
+        std::array<std::string_view, 3> fields;
+        assert(ManifestJournal::splitFields("  a|b||d \r", fields) == 4);
+        assert(fields[0] == "a" && fields[1] == "b" && fields[2].empty());
+        assert(ManifestJournal::splitFields(" \t", fields) == 0);
+    }
+
+    // Runs recorded through the repository survive a reopen; the run manifest is compacted as the journal grows
+    // instead of being rewritten per run.
+    const auto repoRoot = std::filesystem::path(__FILE__).parent_path().parent_path();
+    trdp::device::XmlValidator validator{repoRoot / "resources/trdp/trdp-config.xsd"};
+    trdp::device::DeviceProfileRepository devices{dir / "devices", validator};
+    trdp::simulation::ScenarioSchemaValidator schema{repoRoot / "resources/scenarios/scenario.schema.yaml"};
+    const auto root = dir / "scenarios";
+    const ManifestJournal::Options repositoryOptions{false, 16};
+    {
+        ScenarioRepository repository{root, devices, schema, 0, repositoryOptions};
+        for (int i = 0; i < 10; ++i) {
+            repository.recordRun(run(i));
+        }
+        assert(!std::filesystem::exists(root / "runs.db") && lineCount(root / "runs.db.journal") == 10);
+        std::vector<RunRecord> batch;
+        for (int i = 10; i < 100; ++i) {
+            batch.push_back(run(i));
+        }
+        repository.recordRuns(std::move(batch));
+        assert(std::filesystem::exists(root / "runs.db") && !std::filesystem::exists(root / "runs.db.journal"));
+        auto rerun = run(5);
+        rerun.success = false;
+        rerun.detail = "retried";
+        repository.recordRun(rerun);
+        assert(lineCount(root / "runs.db.journal") == 1);
+    }
+    {
+        ScenarioRepository repository{root, devices, schema, 0, repositoryOptions};
+        assert(repository.listRuns().size() == 100);
+        assert(repository.listRunsForScenario("odd").size() == 50);
+        assert(!repository.getRun("run-5").success && repository.getRun("run-5").detail == "retried");
+        assert(repository.getRun("run-99").artefactPath == "/tmp/runs/run-99");
+        repository.compactManifests();
+        assert(lineCount(root / "runs.db") == 101 && !std::filesystem::exists(root / "runs.db.journal"));
+    }
+    {
+        // Recording before anything reads the catalogue only appends; the first read replays the new run too.
+        ScenarioRepository repository{root, devices, schema, 0, repositoryOptions};
+        repository.recordRun(run(100));
+        assert(lineCount(root / "runs.db.journal") == 1);
+        assert(repository.listRuns().size() == 101 && repository.getRun("run-100").scenarioId == "even");
+    }
+
+    // Device profiles are read from the manifest on first use, not when the repository is opened.
+    trdp::device::DeviceProfileRepository lazyDevices{dir / "lazy-devices", validator};
+    { std::ofstream{dir / "lazy-devices" / "manifest.db"} << "late|/tmp/late.xml|/src/late.xml|00|2024-01-01\n"; }
+    assert(lazyDevices.exists("late") && lazyDevices.get("late").storedPath == "/tmp/late.xml");
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,260 @@
+#include "trdp_simulator/communication/NetworkEmulationAdapter.hpp"
+#include "trdp_simulator/device/DeviceProfileRepository.hpp"
+#include "trdp_simulator/device/XmlValidator.hpp"
+#include "trdp_simulator/simulation/Engine.hpp"
+#include "trdp_simulator/simulation/ScenarioRepository.hpp"
+#include "trdp_simulator/simulation/ScenarioSchemaValidator.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using trdp::communication::LatencyDistribution;
+using trdp::communication::LinkProfile;
+using trdp::communication::MessageDataAck;
+using trdp::communication::MessageDataHandler;
+using trdp::communication::MessageDataMessage;
+using trdp::communication::NetworkEmulationAdapter;
+using trdp::communication::ProcessDataHandler;
+using trdp::communication::ProcessDataMessage;
+using trdp::communication::StackAdapter;
+using trdp::device::DeviceProfileRepository;
+using trdp::device::XmlValidator;
+using trdp::simulation::Scenario;
+using trdp::simulation::ScenarioRepository;
+using trdp::simulation::ScenarioSchemaValidator;
+using trdp::simulation::ScenarioValidationError;
+
+namespace {
+
+using Clock = NetworkEmulationAdapter::Clock;
+using namespace std::chrono_literals;
+
+std::filesystem::path resourcePath(const std::string &relative) {
+    const auto repoRoot = std::filesystem::path(__FILE__).parent_path().parent_path();
+    return repoRoot / "resources" / relative;
+}
+
+std::filesystem::path tempDir(const std::string &name) {
+    auto dir = std::filesystem::temp_directory_path() / std::filesystem::path{name + std::to_string(std::rand())};
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+/// Records which telegrams reached the wire and when (the time of the release() that delivered them).
+class RecordingAdapter final : public StackAdapter {
+public:
+    void openSession(const std::string &) override {}
+    void closeSession() override {}
+    void registerProcessDataHandler(ProcessDataHandler) override {}
+    void registerMessageDataHandler(MessageDataHandler) override {}
+    void publishProcessData(const ProcessDataMessage &message) override {
+        published.push_back(message.payload);
+        deliveredAt.push_back(now);
+    }
+    MessageDataAck sendMessageData(const MessageDataMessage &) override { return {}; }
+    void poll() override {}
+
+    Clock::time_point now{};
+    std::vector<std::vector<std::uint8_t>> published;
+    std::vector<Clock::time_point> deliveredAt;
+};
+
+struct Delivery {
+    std::vector<std::vector<std::uint8_t>> order;
+    std::vector<std::chrono::microseconds> delays;
+};
+
+/// Sends @p count telegrams at once and releases them in 10 us steps; returns the delivery order and delays.
+Delivery deliver(const LinkProfile &link, std::uint64_t seed, int count) {
+    auto inner = std::make_shared<RecordingAdapter>();
+    NetworkEmulationAdapter network{inner, {link}, seed};
+    const auto start = Clock::now();
+    for (int i = 0; i < count; ++i) {
+        const std::vector<std::uint8_t> index{static_cast<std::uint8_t>(i >> 8), static_cast<std::uint8_t>(i)};
+        network.transmit(ProcessDataMessage{"t", link.comId, link.comId, index}, start);
+    }
+    for (inner->now = start; network.inFlight() > 0; inner->now += 10us) {
+        network.release(inner->now);
+    }
+    Delivery result{inner->published, {}};
+    for (const auto at : inner->deliveredAt) {
+        result.delays.push_back(std::chrono::duration_cast<std::chrono::microseconds>(at - start));
+    }
+    return result;
+}
+
+/// Delay of every telegram by send index.
+std::vector<std::chrono::microseconds> byIndex(const Delivery &delivery) {
+    std::vector<std::chrono::microseconds> delays(delivery.order.size());
+    for (std::size_t i = 0; i < delivery.order.size(); ++i) {
+        const auto &index = delivery.order[i];
+        delays.at(static_cast<std::size_t>(index[0] << 8 | index[1])) = delivery.delays[i];
+    }
+    return delays;
+}
+
+bool sameDelays(const Delivery &lhs, const Delivery &rhs) {
+    const auto left = byIndex(lhs);
+    const auto right = byIndex(rhs);
+    for (std::size_t i = 0; i < left.size(); ++i) {
+        if (left[i] - right[i] > 40us || right[i] - left[i] > 40us) {
+            return false;
+        }
+    }
+    return left.size() == right.size();
+}
+
+std::vector<std::vector<std::uint8_t>> sorted(std::vector<std::vector<std::uint8_t>> values) {
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+double mean(const std::vector<std::chrono::microseconds> &values) {
+    double sum = 0.0;
+    for (const auto value : values) {
+        sum += static_cast<double>(value.count());
+    }
+    return sum / static_cast<double>(values.size());
+}
+
+} // namespace
+
+int main() {
+    {
+        const auto constant = deliver(LinkProfile{1001, LatencyDistribution::Constant, 500us}, 1, 10).delays;
+        assert(constant.size() == 10);
+        for (const auto delay : constant) {
+            assert(delay >= 500us && delay < 530us);
+        }
+    }
+
+    {
+        // 19 payload bytes plus framing overhead are 1000 bits: one telegram per millisecond at 1 Mbit/s.
+        auto inner = std::make_shared<RecordingAdapter>();
+        LinkProfile link{0, LatencyDistribution::Constant, 100us, 0us, 1'000'000, 3};
+        NetworkEmulationAdapter network{inner, {link}, 1};
+        const auto start = Clock::now();
+        for (std::uint8_t i = 0; i < 5; ++i) {
+            network.transmit(ProcessDataMessage{"t", 2002, 2002, std::vector<std::uint8_t>(19, i)}, start);
+        }
+        assert(network.stats().queueDrops == 2);
+        assert(network.stats().peakQueueDepth == 3);
+        assert(network.inFlight() == 3);
+        inner->now = start + 1050us;
+        assert(network.release(inner->now) == 0);
+        inner->now = start + 1150us;
+        assert(network.release(inner->now) == 1);
+        // Once the first telegram has left the queue there is room for one more.
+        network.transmit(ProcessDataMessage{"t", 2002, 2002, std::vector<std::uint8_t>(19, 9)}, inner->now);
+        assert(network.stats().queueDrops == 2);
+        inner->now = start + 4150us;
+        assert(network.release(inner->now) == 3);
+        assert(inner->published.size() == 4);
+        assert(inner->published[2].front() == 2 && inner->published[3].front() == 9);
+        assert(network.inFlight() == 0);
+    }
+
+    {
+        const LinkProfile normal{1001, LatencyDistribution::Normal, 2000us, 300us};
+        // The same seed draws the same delay for every telegram, up to the timing wheel resolution.
+        const auto first = deliver(normal, 42, 4000);
+        assert(sameDelays(first, deliver(normal, 42, 4000)));
+        assert(!sameDelays(first, deliver(normal, 43, 4000)));
+        assert(first.order != sorted(first.order));
+        assert(mean(first.delays) > 1950.0 && mean(first.delays) < 2050.0);
+
+        const LinkProfile pareto{1001, LatencyDistribution::Pareto, 1000us, 400us};
+        const auto tail = deliver(pareto, 7, 4000).delays;
+        for (const auto delay : tail) {
+            assert(delay >= 1000us);
+        }
+        assert(mean(tail) > 1300.0 && mean(tail) < 1500.0);
+    }
+
+    {
+        // Unlisted comIds pass straight through, and close delivers what is still in flight.
+        auto inner = std::make_shared<RecordingAdapter>();
+        NetworkEmulationAdapter network{inner, {LinkProfile{1001, LatencyDistribution::Constant, 10ms}}, 0};
+        network.publishProcessData(ProcessDataMessage{"t", 1001, 1001, {1}});
+        network.publishProcessData(ProcessDataMessage{"t", 3003, 3003, {2}});
+        assert(inner->published.size() == 1 && inner->published.front().front() == 2);
+        network.closeSession();
+        assert(inner->published.size() == 2 && inner->published.back().front() == 1);
+        assert(network.stats().delivered == 2);
+    }
+
+    XmlValidator xmlValidator{resourcePath("trdp/trdp-config.xsd")};
+    DeviceProfileRepository deviceRepository{tempDir("network-dev-"), xmlValidator};
+    const auto deviceId = deviceRepository.registerProfile(resourcePath("trdp/device1.xml"));
+    ScenarioSchemaValidator scenarioValidator{resourcePath("scenarios/scenario.schema.yaml")};
+    ScenarioRepository repository{tempDir("network-scenarios-"), deviceRepository, scenarioValidator};
+
+    const auto sourceDir = tempDir("network-src-");
+    const auto writeScenario = [&](const std::string &name, const std::string &distribution) {
+        const auto path = sourceDir / (name + ".yaml");
+        std::ofstream file{path};
+        file << "scenario: " << name << "\n";
+        file << "device: " << deviceId << "\n";
+        file << "seed: 99\n";
+        file << "events:\n";
+        file << "  - type: pd\n";
+        file << "    label: door-status\n";
+        file << "    com_id: 1001\n";
+        file << "    payload: 0x01\n";
+        file << "    repeat: 20\n";
+        file << "network:\n";
+        file << "  - com_id: 0\n";
+        file << "    distribution: " << distribution << "\n";
+        file << "    latency_us: 800\n";
+        file << "    jitter_us: 150\n";
+        file << "    bandwidth_kbps: 100000\n";
+        file << "    queue_limit: 64\n";
+        return path;
+    };
+
+    const auto id = repository.importScenario(writeScenario("congested-etb", "normal"));
+    const Scenario scenario = repository.load(id);
+    assert(scenario.network.size() == 1);
+    const auto &link = scenario.network.front();
+    assert(link.comId == 0 && link.distribution == LatencyDistribution::Normal);
+    assert(link.latency == 800us && link.jitter == 150us);
+    assert(link.bandwidth == 100'000'000 && link.queueLimit == 64);
+
+    {
+        auto network = std::make_shared<NetworkEmulationAdapter>(trdp::communication::makeLoopbackStackAdapter(),
+                                                                 scenario.network, scenario.seed);
+        std::uint64_t received = 0;
+        trdp::communication::Wrapper wrapper{"network-endpoint", network};
+        wrapper.registerProcessDataHandler([&](const ProcessDataMessage &) { ++received; });
+        trdp::simulation::SimulationEngine engine{wrapper, tempDir("network-runs-"), &repository};
+        engine.loadScenario(scenario);
+        engine.run();
+        assert(received == 20);
+        assert(network->stats().delivered == 20 && network->stats().queueDrops == 0);
+    }
+
+    const auto replayed = repository.loadRunScenario(repository.listRunsForScenario(id).front().id);
+    assert(replayed.network.size() == 1);
+    assert(replayed.network.front().distribution == LatencyDistribution::Normal);
+    assert(replayed.network.front().bandwidth == link.bandwidth);
+    assert(replayed.network.front().queueLimit == link.queueLimit);
+
+    bool rejected = false;
+    try {
+        (void)repository.importScenario(writeScenario("lognormal-etb", "lognormal"));
+    } catch (const ScenarioValidationError &) {
+        rejected = true;
+    }
+    assert(rejected);
+
+    return 0;
+}
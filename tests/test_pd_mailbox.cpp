@@ -0,0 +1,99 @@
+#include "trdp_simulator/communication/PdMailbox.hpp"
+#include "trdp_simulator/communication/Wrapper.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using trdp::communication::PdMailbox;
+using trdp::communication::PdSample;
+using trdp::communication::ProcessDataMessage;
+using trdp::communication::Wrapper;
+
+int main() {
+    using namespace std::chrono_literals;
+
+    {
+        PdMailbox mailbox{{1001, 1002, 1001}, 4};
+        assert((mailbox.comIds() == std::vector<std::uint32_t>{1001, 1002}));
+
+        PdSample sample;
+        assert(!mailbox.snapshot(4242, sample));
+        assert(mailbox.snapshot(1002, sample));
+        assert(sample.sequence == 0 && sample.payload.empty());
+
+        const auto receivedAt = std::chrono::steady_clock::now();
+        mailbox.update(1001, std::vector<std::uint8_t>{1, 2, 3}, receivedAt);
+        mailbox.update(4242, std::vector<std::uint8_t>{9}, receivedAt);
+        assert(mailbox.snapshot(1001, sample));
+        assert(sample.comId == 1001 && sample.sequence == 1);
+        assert((sample.payload == std::vector<std::uint8_t>{1, 2, 3}));
+        assert(sample.receivedAt == receivedAt);
+        assert(!sample.truncated);
+
+        mailbox.update(1001, std::vector<std::uint8_t>{5, 6, 7, 8, 9, 10}, receivedAt + 1ms);
+        assert(mailbox.snapshot(1001, sample));
+        assert(sample.sequence == 2);
+        assert((sample.payload == std::vector<std::uint8_t>{5, 6, 7, 8}));
+        assert(sample.truncated);
+    }
+
+    {
+        // Readers on other threads must always see a payload and sequence from the same update.
+        PdMailbox mailbox{{1001}, 64};
+        std::atomic<bool> done{false};
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 3; ++r) {
+            readers.emplace_back([&] {
+                PdSample sample;
+                std::uint64_t last = 0;
+                while (!done.load()) {
+                    assert(mailbox.snapshot(1001, sample));
+                    assert(sample.sequence >= last);
+                    last = sample.sequence;
+                    if (sample.sequence == 0) {
+                        continue;
+                    }
+                    assert(sample.payload.size() == 1 + sample.sequence % 64);
+                    for (const auto byte : sample.payload) {
+                        assert(byte == static_cast<std::uint8_t>(sample.sequence));
+                    }
+                }
+            });
+        }
+        const auto start = std::chrono::steady_clock::now();
+        for (std::uint64_t sequence = 1; sequence <= 20000; ++sequence) {
+            const std::vector<std::uint8_t> payload(1 + sequence % 64, static_cast<std::uint8_t>(sequence));
+            mailbox.update(1001, payload, start);
+        }
+        done = true;
+        for (auto &reader : readers) {
+            reader.join();
+        }
+        PdSample sample;
+        assert(mailbox.snapshot(1001, sample));
+        assert(sample.sequence == 20000);
+    }
+
+    {
+        PdMailbox mailbox{{1001}};
+        Wrapper wrapper{"mailbox-endpoint"};
+        wrapper.addObserver(mailbox);
+        wrapper.open();
+        wrapper.publishProcessData(ProcessDataMessage{"status", 1001, 1001, {0x0A, 0x0B}});
+        wrapper.publishProcessData(ProcessDataMessage{"other", 2002, 2002, {0x01}});
+        wrapper.poll();
+        wrapper.close();
+        wrapper.removeObserver(mailbox);
+
+        PdSample sample;
+        assert(mailbox.snapshot(1001, sample));
+        assert(sample.sequence == 1);
+        assert((sample.payload == std::vector<std::uint8_t>{0x0A, 0x0B}));
+    }
+
+    return 0;
+}
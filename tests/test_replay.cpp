@@ -0,0 +1,124 @@
+#include "trdp_simulator/communication/Wrapper.hpp"
+#include "trdp_simulator/simulation/Engine.hpp"
+#include "trdp_simulator/simulation/RunCapture.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using trdp::simulation::CaptureDirection;
+using trdp::simulation::CaptureReader;
+using trdp::simulation::CaptureType;
+using trdp::simulation::CaptureWriter;
+using trdp::simulation::Scenario;
+using trdp::simulation::ScenarioEvent;
+using trdp::simulation::SimulationEngine;
+
+namespace {
+
+std::filesystem::path tempDir(const std::string &name) {
+    auto dir = std::filesystem::temp_directory_path() / std::filesystem::path{name + std::to_string(std::rand())};
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+constexpr std::int64_t kMillisecond = 1'000'000;
+
+Scenario nominalScenario(const std::string &id) {
+    Scenario scenario{};
+    scenario.id = id;
+    scenario.deviceProfileId = "loopback";
+    scenario.events = {{ScenarioEvent::Type::ProcessData, "nominal", 9001, 9001, {0xEE}, std::chrono::milliseconds{0}}};
+    return scenario;
+}
+
+std::filesystem::path runDirectory(const std::filesystem::path &root, const std::string &scenarioId) {
+    for (const auto &entry : std::filesystem::directory_iterator{root}) {
+        if (entry.path().filename().string().rfind(scenarioId + '-', 0) == 0) {
+            return entry.path();
+        }
+    }
+    assert(false && "run directory not found");
+    std::abort();
+}
+
+} // namespace
+
+int main() {
+    const auto dir = tempDir("replay-");
+    const auto recorded = dir / "recorded.trc";
+    {
+        // Irregular gaps that the nominal scenario delays could not express; receptions are not replayed.
+        const std::int64_t start = std::int64_t{1'700'000'000} * 1'000 * kMillisecond;
+        CaptureWriter writer{recorded};
+        writer.append(start, CaptureDirection::Sent, CaptureType::ProcessData, 1001, 1001, std::vector<std::uint8_t>{1});
+        writer.append(start + kMillisecond / 10, CaptureDirection::Received, CaptureType::ProcessData, 1001, 1001,
+                      std::vector<std::uint8_t>{1});
+        writer.append(start + 23 * kMillisecond + 300'000, CaptureDirection::Sent, CaptureType::MessageData, 2001, 2001,
+                      std::vector<std::uint8_t>{2, 3});
+        writer.append(start + 27 * kMillisecond, CaptureDirection::Sent, CaptureType::ProcessData, 1002, 1002,
+                      std::vector<std::uint8_t>{4});
+        writer.append(start + 61 * kMillisecond + 700'000, CaptureDirection::Sent, CaptureType::ProcessData, 1001,
+                      1001, std::vector<std::uint8_t>{5});
+    }
+
+    const auto runs = dir / "runs";
+    trdp::communication::Wrapper wrapper{"replay-endpoint"};
+    SimulationEngine engine{wrapper, runs};
+    engine.loadScenario(nominalScenario("replayed"));
+    engine.replayCapture(recorded);
+    engine.run();
+
+    const auto &timing = engine.replayTiming();
+    assert(timing.has_value());
+    assert(timing->telegrams == 4);
+    assert(timing->source == recorded.string());
+    assert(timing->recordedSpan == std::chrono::nanoseconds{61 * kMillisecond + 700'000});
+    assert(timing->replayedSpan >= timing->recordedSpan);
+    assert(timing->replayedSpan < timing->recordedSpan + std::chrono::milliseconds{20});
+    assert(timing->gapError.count() == 3 && timing->lateness.count() == 4);
+    assert(timing->gapError.max() < std::chrono::milliseconds{20});
+
+    const auto replayRun = runDirectory(runs, "replayed");
+    assert(std::filesystem::exists(replayRun / "replay.yaml"));
+    {
+        // The replay's own capture repeats the recorded sends, in order and at the recorded offsets.
+        const CaptureReader replayed{replayRun / trdp::simulation::kCaptureFileName};
+        std::vector<trdp::simulation::CaptureRecord> sent;
+        replayed.scan({}, [&](const auto &record) {
+            if (record.direction == CaptureDirection::Sent) {
+                sent.push_back(record);
+            }
+        });
+        assert(sent.size() == 4);
+        assert(sent[0].comId == 1001 && sent[1].comId == 2001 && sent[2].comId == 1002 && sent[3].comId == 1001);
+        assert(sent[1].type == CaptureType::MessageData && sent[1].payload.size() == 2 && sent[1].payload[1] == 3);
+        const auto offset = sent[3].timestampNs - sent[0].timestampNs;
+        assert(offset >= 61 * kMillisecond && offset < 81 * kMillisecond);
+        assert(replayed.select({.comId = 9001}).empty());
+    }
+
+    // The replay is a one-off: the next run plays the scenario events again.
+    engine.loadScenario(nominalScenario("nominal"));
+    engine.run();
+    assert(!engine.replayTiming().has_value());
+    const CaptureReader nominal{runDirectory(runs, "nominal") / trdp::simulation::kCaptureFileName};
+    assert(nominal.select({.comId = 9001}).size() == 2);
+
+    bool threw = false;
+    try {
+        engine.replayCapture(dir / "missing.trc");
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
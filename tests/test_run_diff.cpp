@@ -0,0 +1,169 @@
+#include "trdp_simulator/simulation/RunCapture.hpp"
+#include "trdp_simulator/simulation/RunDiff.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using trdp::simulation::CaptureDirection;
+using trdp::simulation::CaptureReader;
+using trdp::simulation::CaptureType;
+using trdp::simulation::CaptureWriter;
+using trdp::simulation::DiffKind;
+using trdp::simulation::RunDiffOptions;
+using trdp::simulation::TelegramDiff;
+
+namespace {
+
+std::filesystem::path tempDir(const std::string &name) {
+    auto dir = std::filesystem::temp_directory_path() / std::filesystem::path{name + std::to_string(std::rand())};
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+constexpr std::int64_t kMillisecond = 1'000'000;
+constexpr std::uint32_t kCycles = 1000;
+
+struct Variant {
+    std::int64_t startNs{0};
+    std::int64_t shiftNs{0};
+    bool changePayload{false};
+    bool dropReception{false};
+    bool addComId{false};
+    std::uint32_t cycles{kCycles};
+};
+
+/// A run publishing comId 1001 every millisecond and receiving comId 1002 half a millisecond later.
+void writeRun(const std::filesystem::path &path, const Variant &variant) {
+    CaptureWriter writer{path};
+    for (std::uint32_t i = 0; i < variant.cycles; ++i) {
+        const auto at = variant.startNs + std::int64_t{i} * kMillisecond;
+        std::vector<std::uint8_t> payload(40);
+        for (std::size_t b = 0; b < payload.size(); ++b) {
+            payload[b] = static_cast<std::uint8_t>(i + b);
+        }
+        if (variant.changePayload && i == 10) {
+            payload[3] ^= 0xFF;
+            payload[37] ^= 0x01;
+        }
+        writer.append(at + (i == 0 ? 0 : variant.shiftNs), CaptureDirection::Sent, CaptureType::ProcessData, 1001,
+                      1001, payload);
+        if (!(variant.dropReception && i == 500)) {
+            writer.append(at + kMillisecond / 2 + variant.shiftNs, CaptureDirection::Received,
+                          CaptureType::ProcessData, 1002, 1002, payload);
+        }
+        if (variant.addComId && i % 100 == 0) {
+            writer.append(at + kMillisecond / 4, CaptureDirection::Sent, CaptureType::MessageData, 3001, 3001, payload);
+        }
+    }
+}
+
+const TelegramDiff &find(const trdp::simulation::RunDiffReport &report, std::uint32_t comId) {
+    for (const auto &diff : report.telegrams) {
+        if (diff.comId == comId) {
+            return diff;
+        }
+    }
+    assert(false && "comId not in report");
+    std::abort();
+}
+
+} // namespace
+
+int main() {
+    {
+        using trdp::simulation::countDifferingBytes;
+        const std::vector<std::uint8_t> a(67, 0x5A);
+        auto b = a;
+        assert(countDifferingBytes(a, b) == 0);
+        b[0] = 0;
+        b[8] = 0xDA; // only the high bit differs
+        b[63] = 0x5B;
+        b[66] = 0;
+        assert(countDifferingBytes(a, b) == 4);
+        assert(countDifferingBytes(a, std::span<const std::uint8_t>{b}.first(60)) == 7 + 2);
+        assert(countDifferingBytes({}, a) == a.size());
+    }
+
+    const auto dir = tempDir("run-diff-");
+    const auto baseline = dir / "a.trc";
+    writeRun(baseline, Variant{1'000 * kMillisecond});
+
+    {
+        // Same traffic recorded an hour later is equivalent: offsets are taken from the start of each run.
+        const auto later = dir / "later.trc";
+        writeRun(later, Variant{3'600'000 * kMillisecond});
+        const auto report = diffCaptures(CaptureReader{baseline}, CaptureReader{later});
+        assert(report.equivalent());
+        assert(report.recordsA == 2 * kCycles && report.recordsB == 2 * kCycles);
+        assert(report.telegrams.size() == 2);
+        assert(find(report, 1001).matched == kCycles && find(report, 1001).timingDelta.max().count() == 0);
+        assert(report.samples.empty());
+    }
+
+    {
+        const auto changed = dir / "changed.trc";
+        writeRun(changed, Variant{5 * kMillisecond, 100'000, true, true, true});
+        const CaptureReader a{baseline};
+        const CaptureReader b{changed};
+        RunDiffOptions options;
+        options.matchWindow = std::chrono::microseconds{400};
+        const auto report = diffCaptures(a, b, options);
+        assert(!report.equivalent());
+
+        const auto &published = find(report, 1001);
+        assert(published.matched == kCycles && published.changed == 1 && published.bytesDiffering == 2);
+        // Every cycle but the first is 100 us late.
+        assert(published.timingShiftNs == std::int64_t{kCycles - 1} * 100'000);
+        assert(published.timingDelta.max() >= std::chrono::microseconds{100});
+
+        // The dropped reception is reported once; the cycles after it still pair with their own counterpart. The
+        // changed publication comes back changed as well.
+        const auto &received = find(report, 1002);
+        assert(received.missing == 1 && received.added == 0 && received.changed == 1);
+        assert(received.matched == kCycles - 1);
+
+        const auto &added = find(report, 3001);
+        assert(added.added == kCycles / 100 && added.matched == 0);
+        assert(report.telegrams.size() == 3);
+
+        bool sawChange = false;
+        bool sawMissing = false;
+        for (const auto &sample : report.samples) {
+            if (sample.kind == DiffKind::Changed && sample.comId == 1001) {
+                sawChange = sample.sequence == 10 && sample.bytesDiffering == 2;
+                assert(sample.offset == std::chrono::milliseconds{10});
+            }
+            if (sample.kind == DiffKind::Missing) {
+                sawMissing = sample.comId == 1002 && sample.sequence == 500;
+                assert(sample.direction == CaptureDirection::Received);
+            }
+        }
+        assert(sawChange && sawMissing);
+        assert(report.samples.size() == 3 + kCycles / 100);
+
+        options.maxSamples = 1;
+        assert(diffCaptures(a, b, options).samples.size() == 1);
+    }
+
+    {
+        // A run cut short: everything after its end is missing.
+        const auto truncated = dir / "truncated.trc";
+        Variant variant{1'000 * kMillisecond};
+        variant.cycles = kCycles / 2;
+        writeRun(truncated, variant);
+        const auto report = diffCaptures(CaptureReader{baseline}, CaptureReader{truncated});
+        assert(find(report, 1001).matched == kCycles / 2 && find(report, 1001).missing == kCycles / 2);
+        assert(find(report, 1002).missing == kCycles / 2);
+        const auto reverse = diffCaptures(CaptureReader{truncated}, CaptureReader{baseline});
+        assert(find(reverse, 1001).added == kCycles / 2 && find(reverse, 1001).missing == 0);
+    }
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
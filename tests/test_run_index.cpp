@@ -0,0 +1,131 @@
+#include "trdp_simulator/simulation/RunIndex.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using trdp::simulation::RunIndex;
+using trdp::simulation::RunOrder;
+using trdp::simulation::RunPage;
+using trdp::simulation::RunQuery;
+using trdp::simulation::RunRecord;
+
+namespace {
+
+/// Run @p index of scenario "even" or "odd", started on 2024-05-0<1 + index / 10> at second index % 10.
+RunRecord run(int index) {
+    RunRecord record{};
+    record.id = "run-" + std::to_string(index);
+    record.scenarioId = index % 2 == 0 ? "even" : "odd";
+    char startedAt[32];
+    std::snprintf(startedAt, sizeof(startedAt), "2024-05-0%dT12:00:0%dZ", 1 + index / 10, index % 10);
+    record.startedAt = startedAt;
+    record.success = index % 3 != 0;
+    return record;
+}
+
+std::vector<std::string> ids(const RunPage &page) {
+    std::vector<std::string> result;
+    for (const auto &record : page.runs) {
+        result.push_back(record.id);
+    }
+    return result;
+}
+
+} // namespace
+
+int main() {
+    RunIndex index;
+    // Insert out of start order; the indexes order by startedAt regardless.
+    for (int i = 29; i >= 0; --i) {
+        index.upsert(run(i));
+    }
+    assert(index.size() == 30);
+
+    RunQuery all;
+    all.order = RunOrder::OldestFirst;
+    const auto everything = index.query(all);
+    assert(everything.runs.size() == 30 && !everything.nextCursor);
+    assert(everything.runs.front().id == "run-0" && everything.runs.back().id == "run-29");
+
+    RunQuery newest;
+    newest.limit = 3;
+    assert((ids(index.query(newest)) == std::vector<std::string>{"run-29", "run-28", "run-27"}));
+
+    // Filters combine: failed runs of "odd" on 2024-05-02 (the until bound covers the whole day).
+    RunQuery filtered;
+    filtered.scenarioId = "odd";
+    filtered.success = false;
+    filtered.startedFrom = "2024-05-02";
+    filtered.startedUntil = "2024-05-02";
+    filtered.order = RunOrder::OldestFirst;
+    assert((ids(index.query(filtered)) == std::vector<std::string>{"run-15"}));
+
+    RunQuery window;
+    window.startedFrom = "2024-05-01T12:00:08Z";
+    window.startedUntil = "2024-05-02T12:00:01Z";
+    window.order = RunOrder::OldestFirst;
+    assert((ids(index.query(window)) == std::vector<std::string>{"run-8", "run-9", "run-10", "run-11"}));
+
+    RunQuery offset = all;
+    offset.offset = 28;
+    assert((ids(index.query(offset)) == std::vector<std::string>{"run-28", "run-29"}));
+
+    // Cursor pagination visits every match exactly once, in both orders.
+    for (const auto order : {RunOrder::OldestFirst, RunOrder::NewestFirst}) {
+        RunQuery paged;
+        paged.scenarioId = "even";
+        paged.order = order;
+        paged.limit = 4;
+        std::vector<std::string> seen;
+        for (;;) {
+            const auto page = index.query(paged);
+            assert(page.runs.size() <= 4);
+            const auto pageIds = ids(page);
+            seen.insert(seen.end(), pageIds.begin(), pageIds.end());
+            if (!page.nextCursor) {
+                break;
+            }
+            paged.after = page.nextCursor;
+        }
+        assert(seen.size() == 15);
+        assert(seen.front() == (order == RunOrder::OldestFirst ? "run-0" : "run-28"));
+        assert(seen.back() == (order == RunOrder::OldestFirst ? "run-28" : "run-0"));
+    }
+
+    // Re-recording a run moves it between indexes.
+    auto retried = run(3);
+    retried.success = true;
+    retried.scenarioId = "even";
+    retried.startedAt = "2024-06-01T00:00:00Z";
+    index.upsert(retried);
+    assert(index.size() == 30);
+    RunQuery evenPassed;
+    evenPassed.scenarioId = "even";
+    evenPassed.success = true;
+    evenPassed.limit = 1;
+    assert(index.query(evenPassed).runs.front().id == "run-3");
+    RunQuery odd;
+    odd.scenarioId = "odd";
+    assert(index.query(odd).runs.size() == 14);
+
+    RunQuery unknown;
+    unknown.scenarioId = "missing";
+    assert(index.query(unknown).runs.empty());
+
+    RunQuery malformed;
+    malformed.after = "no-separator";
+    bool threw = false;
+    try {
+        (void)index.query(malformed);
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    assert(threw);
+
+    index.clear();
+    assert(index.size() == 0 && index.query(all).runs.empty());
+    return 0;
+}
@@ -1,19 +1,27 @@
 #include "trdp_simulator/device/DeviceProfileRepository.hpp"
 #include "trdp_simulator/device/XmlValidator.hpp"
+#include "trdp_simulator/simulation/EventStream.hpp"
 #include "trdp_simulator/simulation/ScenarioLoader.hpp"
+#include "trdp_simulator/simulation/ScenarioParser.hpp"
 #include "trdp_simulator/simulation/ScenarioSchemaValidator.hpp"
 
 #include <cassert>
+#include <chrono>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <string>
+#include <vector>
 
 using trdp::device::DeviceProfileRepository;
 using trdp::device::XmlValidator;
+using trdp::simulation::EventEmission;
+using trdp::simulation::EventStream;
 using trdp::simulation::Scenario;
 using trdp::simulation::ScenarioLoader;
+using trdp::simulation::ScenarioParser;
 using trdp::simulation::ScenarioSchemaValidator;
+using trdp::simulation::ScenarioValidationError;
 
 namespace {
 
@@ -65,6 +73,158 @@ int main() {
     assert(scenario.events.front().label == "command");
     assert(scenario.events.front().payload.size() == 2);
 
+    const auto generatorPath = scenarioRoot / "soak.yaml";
+    std::ofstream generatorFile{generatorPath};
+    generatorFile << "scenario: soak\n";
+    generatorFile << "device: " << deviceId << "\n";
+    generatorFile << "events:\n";
+    generatorFile << "  - type: pd\n";
+    generatorFile << "    label: heartbeat\n";
+    generatorFile << "    com_id: 1001\n";
+    generatorFile << "    payload: 0x00000000\n";
+    generatorFile << "    repeat: 100000\n";
+    generatorFile << "    ramp_start_hz: 10\n";
+    generatorFile << "    ramp_end_hz: 100\n";
+    generatorFile << "    counter_offset: 2\n";
+    generatorFile << "    counter_width: 2\n";
+    generatorFile << "    counter_start: 254\n";
+    generatorFile << "    counter_end: 256\n";
+    generatorFile.close();
+
+    const Scenario soak = loader.load("soak");
+    assert(soak.events.size() == 1);
+    assert(soak.events.front().generator.repeat == 100000);
+    assert(soak.events.front().generator.counter.has_value());
+
+    EventStream stream{soak.events};
+    EventEmission emission{};
+    std::size_t emitted = 0;
+    while (stream.next(emission)) {
+        const auto &payload = *emission.payload;
+        const unsigned counter = (static_cast<unsigned>(payload[2]) << 8) | payload[3];
+        assert(counter == 254 + (emission.iteration % 3));
+        if (emission.iteration == 1) {
+            // The first ramped gap runs at ramp_start_hz.
+            assert(emission.gap == std::chrono::microseconds{100000});
+        } else if (emission.iteration == 99999) {
+            assert(emission.gap == std::chrono::microseconds{10000});
+        }
+        ++emitted;
+    }
+    assert(emitted == 100000);
+
+    const auto badCounterPath = scenarioRoot / "bad-counter.yaml";
+    std::ofstream badCounter{badCounterPath};
+    badCounter << "scenario: bad-counter\n";
+    badCounter << "device: " << deviceId << "\n";
+    badCounter << "events:\n";
+    badCounter << "  - type: pd\n";
+    badCounter << "    label: overflow\n";
+    badCounter << "    payload: 0x00\n";
+    badCounter << "    counter_offset: 0\n";
+    badCounter << "    counter_width: 2\n";
+    badCounter.close();
+
+    bool counterThrew = false;
+    try {
+        (void)loader.loadFromFile(badCounterPath);
+    } catch (const ScenarioValidationError &ex) {
+        // Checks made when an item ends point at the item's leading '-'.
+        counterThrew = std::string{ex.what()} == "Event 'overflow' counter field exceeds payload size" &&
+                       ex.line() == 4;
+    }
+    assert(counterThrew);
+
+    {
+        // An offset near SIZE_MAX must not wrap around the payload size check.
+        const auto hugeOffsetPath = scenarioRoot / "huge-offset.yaml";
+        std::ofstream hugeOffset{hugeOffsetPath};
+        hugeOffset << "scenario: huge-offset\ndevice: " << deviceId << "\nevents:\n";
+        hugeOffset << "  - type: pd\n    label: wrap\n    payload: 0x0000\n";
+        hugeOffset << "    counter_offset: 18446744073709551615\n    counter_width: 2\n";
+        hugeOffset.close();
+        bool offsetThrew = false;
+        try {
+            (void)loader.loadFromFile(hugeOffsetPath);
+        } catch (const ScenarioValidationError &ex) {
+            offsetThrew = std::string{ex.what()} == "Event 'wrap' counter field exceeds payload size";
+        }
+        assert(offsetThrew);
+
+        // With two emissions the single gap runs at the start rate.
+        trdp::simulation::ScenarioEvent pair{};
+        pair.generator.repeat = 2;
+        pair.generator.rampStartHz = 10;
+        pair.generator.rampEndHz = 100;
+        assert(trdp::simulation::generatorGap(pair, 1) == std::chrono::microseconds{100000});
+    }
+
+    {
+        // Field errors keep their message and carry the line they were read on, CRLF line endings included.
+        const auto badFieldPath = scenarioRoot / "bad-field.yaml";
+        std::ofstream badField{badFieldPath, std::ios::binary};
+        badField << "scenario: bad-field\r\n# comment\r\ndevice: " << deviceId << "\r\n\r\nevents:\r\n";
+        badField << "  - type: pd\r\n    label: ok\r\n    com_id: 4294967296\r\n";
+        badField.close();
+        bool fieldThrew = false;
+        try {
+            (void)ScenarioParser::parse(badFieldPath, repository);
+        } catch (const ScenarioValidationError &ex) {
+            fieldThrew = std::string{ex.what()} == "Numeric field 'com_id' is out of range: 4294967296" &&
+                         ex.line() == 8;
+        }
+        assert(fieldThrew);
+
+        std::ofstream{badFieldPath, std::ios::binary} << "scenario: bad-field\r\ndevice: " << deviceId
+                                                      << "\r\nevents:\r\n  - type: pd\r\n    label: \"quoted\"\r\n";
+        const auto parsed = ScenarioParser::parse(badFieldPath, repository);
+        assert(parsed.events.size() == 1 && parsed.events.front().label == "quoted");
+    }
+
+    {
+        // Validating while parsing reports what validating and then parsing reported, at the same line. (With several
+        // errors in one file the one-pass load reports the first in file order instead of schema errors first.)
+        const auto errorOf = [](const auto &load) {
+            try {
+                (void)load();
+            } catch (const ScenarioValidationError &ex) {
+                return std::string{ex.what()} + " @" + std::to_string(ex.line());
+            }
+            return std::string{};
+        };
+        const std::string header = "scenario: broken\ndevice: " + deviceId + "\n";
+        const std::string event = "  - type: pd\n    label: a\n";
+        const std::vector<std::string> documents = {
+            header,
+            "scenario: bad id\ndevice: " + deviceId + "\nevents:\n" + event,
+            "device: " + deviceId + "\nevents:\n" + event,
+            header + "colour: red\nevents:\n" + event,
+            header + "events:\n  - type: pd\n",
+            header + "events:\n" + event + "    com_id: 12a\n",
+            header + "events:\n" + event + "    payload: 0x0g\n",
+            header + "events:\n" + event + "    type: xx\n",
+            header + "events:\n" + event + "    bogus: 1\n",
+            header + "events:\n" + event + "    counter_width: 9\n    payload: 0x00\n",
+            header + "events:\n" + event + "triggers:\n  - label: t\n    on_com_id: 1\n",
+            header + "events:\n" + event + "expect:\n  - label: e\n    com_id: 1\n    field_op: zz\n",
+            header + "events:\n" + event + "faults:\n  - loss: 2\n",
+            header + "label: a\nevents:\n",
+            header + "events:\n    label: a\n",
+            header + "events:\n  - type pd\n",
+        };
+        const auto path = scenarioRoot / "broken.yaml";
+        for (const auto &document : documents) {
+            std::ofstream{path} << document;
+            const auto twoPass = errorOf([&] {
+                scenarioValidator.validate(path);
+                return ScenarioParser::parse(path, repository);
+            });
+            const auto onePass = errorOf([&] { return ScenarioParser::parse(path, repository, scenarioValidator); });
+            assert(!twoPass.empty());
+            assert(onePass == twoPass);
+        }
+    }
+
     const auto adhocPath = repoRoot / "adhoc.yaml";
     std::ofstream adhoc{adhocPath};
     adhoc << "scenario: adhoc\n";
@@ -77,6 +77,55 @@ int main() {
     const auto updatedId = repository.importScenario(updatedScenario);
     assert(updatedId == storedId);
 
+    {
+        // Loads are cached by content: repeats share one parsed scenario, a re-import with new content misses.
+        const auto before = repository.cacheStats();
+        const auto shared = repository.loadShared(storedId);
+        assert(shared->events.front().payload.front() == 0x0A);
+        assert(repository.loadShared(storedId) == shared);
+        assert(repository.load(storedId).events.front().payload.front() == 0x0A);
+        const auto stats = repository.cacheStats();
+        assert(stats.misses == before.misses + 1 && stats.hits == before.hits + 2);
+        assert(stats.entries == 2 && stats.bytes > 0 && stats.bytes <= stats.budgetBytes);
+
+        // Evicted scenarios stay valid for their holders; a zero budget disables caching.
+        repository.setCacheBudget(stats.bytes / 2);
+        assert(repository.cacheStats().entries == 1 && repository.cacheStats().evictions == 1);
+        repository.setCacheBudget(0);
+        assert(repository.cacheStats().entries == 0 && shared->id == "door");
+        assert(repository.loadShared(storedId) != shared);
+        assert(repository.cacheStats().entries == 0);
+        repository.setCacheBudget(trdp::simulation::ScenarioCache::kDefaultBudgetBytes);
+    }
+
+    {
+        // Imports leave a compiled copy next to the YAML; a fresh repository loads it without parsing the YAML.
+        const auto compiledPath = scenarioRoot / "door.tsc";
+        assert(std::filesystem::exists(compiledPath));
+        const auto yaml = repository.get(storedId).storedPath;
+        std::filesystem::copy_file(yaml, scenarioRoot / "door.yaml.bak");
+        {
+            std::ofstream broken{yaml, std::ios::trunc};
+            broken << "not: a scenario\n";
+        }
+        ScenarioRepository reopened{scenarioRoot, deviceRepository, scenarioValidator};
+        assert(reopened.load(storedId).events.front().payload.front() == 0x0A);
+
+        // Without a fresh compiled copy the YAML is parsed again, and the copy rewritten.
+        ScenarioRepository rebuilt{scenarioRoot, deviceRepository, scenarioValidator};
+        std::filesystem::remove(compiledPath);
+        bool threw = false;
+        try {
+            (void)rebuilt.load(storedId);
+        } catch (const std::exception &) {
+            threw = true;
+        }
+        assert(threw);
+        std::filesystem::rename(scenarioRoot / "door.yaml.bak", yaml);
+        assert(rebuilt.load(storedId).events.front().payload.front() == 0x0A);
+        assert(std::filesystem::exists(compiledPath));
+    }
+
     const auto exportPath = tempDir("scenario-export-") / "door_copy.yaml";
     repository.exportScenario(storedId, exportPath);
     assert(std::filesystem::exists(exportPath));
@@ -115,6 +164,59 @@ int main() {
     assert(!runs.empty());
     assert(runs.front().id == runRecord.id);
 
+    {
+        // Runs with an empty detail survive a reload, in the current layout and in the seven-column one used before
+        // the expectations column. That layout ended with the detail, and the old reader dropped such lines.
+        const auto legacyRoot = tempDir("scenario-legacy-runs-");
+        {
+            std::ofstream manifest{legacyRoot / "runs.db"};
+            manifest << "# id|artefactPath|scenarioId|startedAt|completedAt|success|detail\n";
+            manifest << "legacy-run|/tmp/legacy|door|2023-01-01T00:00:00Z|2023-01-01T00:00:01Z|1|\n";
+        }
+        ScenarioRepository legacy{legacyRoot, deviceRepository, scenarioValidator};
+        RunRecord current = runRecord;
+        current.id = "current-run";
+        legacy.recordRun(current);
+
+        ScenarioRepository reopened{legacyRoot, deviceRepository, scenarioValidator};
+        const auto reloaded = reopened.listRuns();
+        assert(reloaded.size() == 2);
+        assert(reopened.getRun("legacy-run").detail.empty() && reopened.getRun("legacy-run").success);
+        assert(reopened.getRun("current-run").detail.empty());
+    }
+
+    {
+        // A directory imports as one batch: failed files are reported alone, and a later file wins a shared id.
+        const auto sourceDir = tempDir("scenario-bulk-src-");
+        std::filesystem::create_directories(sourceDir / "nested");
+        writeScenario(sourceDir / "alpha.yaml", deviceId, "0x01");
+        writeScenario(sourceDir / "beta.yml", deviceId, "0x02");
+        writeScenario(sourceDir / "ghost.yaml", "missing-device", "0x03");
+        writeScenario(sourceDir / "nested" / "alpha.yaml", deviceId, "0x04");
+        std::ofstream{sourceDir / "notes.txt"} << "not a scenario\n";
+        const auto files = trdp::simulation::importFiles(sourceDir, {".yaml", ".yml"});
+        assert(files.size() == 4);
+
+        const auto bulkRoot = tempDir("scenario-bulk-store-");
+        ScenarioRepository bulk{bulkRoot, deviceRepository, scenarioValidator};
+        const auto outcomes = bulk.importScenarios(files, 4);
+        assert(outcomes.size() == 4);
+        assert(outcomes[0].ok() && outcomes[0].id == "alpha");
+        assert(outcomes[1].ok() && outcomes[1].id == "beta");
+        assert(!outcomes[2].ok() && outcomes[2].id.empty() && outcomes[2].source == files[2]);
+        assert(outcomes[3].ok() && outcomes[3].id == "alpha");
+        assert(bulk.list().size() == 2);
+        assert(bulk.load("alpha").events.front().payload.front() == 0x04);
+        assert(std::filesystem::exists(bulkRoot / "alpha.tsc"));
+        for (const auto &entry : std::filesystem::directory_iterator{bulkRoot}) {
+            assert(entry.path().filename().string().find("staging") == std::string::npos);
+        }
+
+        ScenarioRepository reopened{bulkRoot, deviceRepository, scenarioValidator};
+        assert(reopened.list().size() == 2);
+        assert(reopened.load("beta").events.front().payload.front() == 0x02);
+    }
+
     return 0;
 }
 
@@ -4,6 +4,7 @@
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <string>
 
 using trdp::simulation::ScenarioSchemaValidator;
 using trdp::simulation::ScenarioValidationError;
@@ -63,5 +64,46 @@ int main() {
     }
     assert(threw);
 
+    {
+        // A stray field names the section it appeared in.
+        const auto strayPath = workingDir / "stray.yaml";
+        std::ofstream stray{strayPath};
+        stray << "scenario: stray\ndevice: dev\ntriggers:\n    label: orphan\n";
+        stray.close();
+        std::string message;
+        try {
+            validator.validate(strayPath);
+        } catch (const ScenarioValidationError &ex) {
+            message = ex.what();
+        }
+        assert(message == "Trigger field defined outside of list: label: orphan");
+    }
+
+    {
+        // Visitors driven by other readers can name a section the schema does not know.
+        auto checker = validator.checker();
+        std::string message;
+        try {
+            checker.section("unknown");
+        } catch (const ScenarioValidationError &ex) {
+            message = ex.what();
+        }
+        assert(message == "Unknown scenario section: unknown");
+    }
+
+    {
+        // Numeric field errors name the section's item rather than always an event.
+        auto checker = validator.checker();
+        std::string message;
+        try {
+            checker.section("faults");
+            checker.item(1);
+            checker.itemField("delay_us", "5ms");
+        } catch (const ScenarioValidationError &ex) {
+            message = ex.what();
+        }
+        assert(message == "Numeric fault field 'delay_us' contains non-digit characters");
+    }
+
     return 0;
 }
@@ -0,0 +1,245 @@
+#include "trdp_simulator/communication/Wrapper.hpp"
+#include "trdp_simulator/device/DeviceProfileRepository.hpp"
+#include "trdp_simulator/device/XmlValidator.hpp"
+#include "trdp_simulator/simulation/Engine.hpp"
+#include "trdp_simulator/simulation/EventStream.hpp"
+#include "trdp_simulator/simulation/ScenarioParser.hpp"
+#include "trdp_simulator/simulation/ScenarioRepository.hpp"
+#include "trdp_simulator/simulation/ScenarioSchemaValidator.hpp"
+#include "trdp_simulator/simulation/TimelineScheduler.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using trdp::communication::Wrapper;
+using trdp::device::DeviceProfileRepository;
+using trdp::device::XmlValidator;
+using trdp::simulation::planTimelines;
+using trdp::simulation::Scenario;
+using trdp::simulation::ScenarioEvent;
+using trdp::simulation::ScenarioRepository;
+using trdp::simulation::ScenarioSchemaValidator;
+using trdp::simulation::ScenarioValidationError;
+using trdp::simulation::SimulationEngine;
+using trdp::simulation::TimelineScheduler;
+using trdp::simulation::TimelineTask;
+
+namespace {
+
+std::filesystem::path deviceSchemaPath() {
+    const auto repoRoot = std::filesystem::path(__FILE__).parent_path().parent_path();
+    return repoRoot / "resources/trdp/trdp-config.xsd";
+}
+
+std::filesystem::path scenarioSchemaPath() {
+    const auto repoRoot = std::filesystem::path(__FILE__).parent_path().parent_path();
+    return repoRoot / "resources/scenarios/scenario.schema.yaml";
+}
+
+std::filesystem::path tempDir(const std::string &name) {
+    auto dir = std::filesystem::temp_directory_path() / std::filesystem::path{name + std::to_string(std::rand())};
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+std::string readFile(const std::filesystem::path &path) {
+    std::ifstream stream{path};
+    std::ostringstream oss;
+    oss << stream.rdbuf();
+    return oss.str();
+}
+
+TimelineTask record(TimelineScheduler &scheduler, TimelineScheduler::Clock::time_point start,
+                    std::vector<std::chrono::milliseconds> offsets, int id, std::vector<int> &order) {
+    for (const auto offset : offsets) {
+        co_await scheduler.sleepUntil(start + offset);
+        order.push_back(id);
+    }
+}
+
+TimelineTask failing(TimelineScheduler &scheduler) {
+    co_await scheduler.sleepUntil(TimelineScheduler::Clock::time_point{});
+    throw std::runtime_error("timeline failed");
+}
+
+TimelineTask counting(TimelineScheduler &scheduler, int events, std::uint64_t &total) {
+    for (int i = 0; i < events; ++i) {
+        co_await scheduler.sleepUntil(TimelineScheduler::Clock::time_point{});
+        ++total;
+    }
+}
+
+} // namespace
+
+int main() {
+    using namespace std::chrono_literals;
+
+    {
+        TimelineScheduler scheduler;
+        std::vector<int> order;
+        const auto start = TimelineScheduler::Clock::now();
+        scheduler.spawn(record(scheduler, start, {0ms, 20ms}, 1, order));
+        scheduler.spawn(record(scheduler, start, {10ms, 30ms}, 2, order));
+        scheduler.spawn(record(scheduler, start, {0ms, 30ms}, 3, order));
+        scheduler.run();
+        assert((order == std::vector<int>{1, 3, 2, 1, 3, 2}));
+        assert(TimelineScheduler::Clock::now() - start >= 30ms);
+    }
+
+    {
+        TimelineScheduler scheduler;
+        std::uint64_t total = 0;
+        for (int i = 0; i < 5000; ++i) {
+            scheduler.spawn(counting(scheduler, 10, total));
+        }
+        scheduler.run();
+        assert(total == 50000);
+        assert(scheduler.switches() == 5000 * 11);
+    }
+
+    {
+        TimelineScheduler scheduler;
+        std::uint64_t total = 0;
+        scheduler.spawn(counting(scheduler, 1000, total));
+        scheduler.spawn(failing(scheduler));
+        bool threw = false;
+        try {
+            scheduler.run();
+        } catch (const std::runtime_error &ex) {
+            threw = std::string{ex.what()} == "timeline failed";
+        }
+        assert(threw);
+        assert(total < 1000);
+    }
+
+    {
+        Scenario scenario{};
+        scenario.deviceProfileId = "consist";
+        scenario.timelines = {{"brakes"}, {"idle"}};
+        scenario.events.resize(4);
+        scenario.events[0].timeline = "doors";
+        scenario.events[1].timeline = "brakes";
+        scenario.events[2].label = "main";
+        scenario.events[3].timeline = "doors";
+        const auto plans = planTimelines(scenario);
+        assert(plans.size() == 3);
+        assert(plans[0].name.empty() && plans[0].events.size() == 1);
+        assert(plans[1].name == "brakes" && plans[1].events.size() == 1);
+        assert(plans[2].name == "doors" && plans[2].events.size() == 2);
+    }
+
+    XmlValidator xmlValidator{deviceSchemaPath()};
+    DeviceProfileRepository deviceRepository{tempDir("timeline-dev-"), xmlValidator};
+    const auto deviceId = deviceRepository.registerProfile(deviceSchemaPath().parent_path() / "device1.xml");
+    ScenarioSchemaValidator scenarioValidator{scenarioSchemaPath()};
+    ScenarioRepository repository{tempDir("timeline-scenarios-"), deviceRepository, scenarioValidator};
+
+    const auto sourceDir = tempDir("timeline-src-");
+    const auto scenarioPath = sourceDir / "consist.yaml";
+    {
+        std::ofstream file{scenarioPath};
+        file << "scenario: consist\n";
+        file << "device: " << deviceId << "\n";
+        file << "timelines:\n";
+        file << "  - name: doors\n";
+        file << "  - name: brakes\n";
+        file << "events:\n";
+        file << "  - type: pd\n";
+        file << "    label: door-a\n";
+        file << "    timeline: doors\n";
+        file << "    com_id: 1001\n";
+        file << "  - type: pd\n";
+        file << "    label: door-b\n";
+        file << "    timeline: doors\n";
+        file << "    com_id: 1001\n";
+        file << "    delay_ms: 20\n";
+        file << "  - type: pd\n";
+        file << "    label: brake-a\n";
+        file << "    timeline: brakes\n";
+        file << "    com_id: 1002\n";
+        file << "    delay_ms: 10\n";
+        file << "  - type: pd\n";
+        file << "    label: brake-b\n";
+        file << "    timeline: brakes\n";
+        file << "    com_id: 1002\n";
+        file << "    delay_ms: 20\n";
+    }
+
+    const auto id = repository.importScenario(scenarioPath);
+    Scenario scenario = repository.load(id);
+    assert(scenario.timelines.size() == 2);
+    assert(scenario.timelines[1].name == "brakes");
+    assert(scenario.events[2].timeline == "brakes");
+
+    Wrapper wrapper{"timeline-endpoint"};
+    SimulationEngine engine{wrapper, tempDir("timeline-runs-"), &repository};
+    engine.loadScenario(std::move(scenario));
+    engine.run();
+
+    const auto runs = repository.listRunsForScenario(id);
+    assert(runs.size() == 1);
+    const auto events = readFile(runs.front().artefactPath / "events.log");
+    const auto doorA = events.find("door-a");
+    const auto brakeA = events.find("brake-a");
+    const auto doorB = events.find("door-b");
+    const auto brakeB = events.find("brake-b");
+    assert(doorA < brakeA && brakeA < doorB && doorB < brakeB && brakeB != std::string::npos);
+    assert(events.find("::timeline=brakes") != std::string::npos);
+
+    const auto replayed = repository.loadRunScenario(runs.front().id);
+    assert(replayed.timelines.size() == 2);
+    assert(replayed.events[0].timeline == "doors");
+
+    const auto duplicatePath = sourceDir / "duplicate.yaml";
+    {
+        std::ofstream file{duplicatePath};
+        file << "scenario: duplicate\n";
+        file << "device: " << deviceId << "\n";
+        file << "timelines:\n";
+        file << "  - name: doors\n";
+        file << "  - name: doors\n";
+        file << "events:\n";
+        file << "  - type: pd\n";
+        file << "    label: door-a\n";
+    }
+    bool rejected = false;
+    try {
+        (void)repository.importScenario(duplicatePath);
+    } catch (const ScenarioValidationError &) {
+        rejected = true;
+    }
+    assert(rejected);
+
+    {
+        // Timelines are per function only; other devices run as consist members.
+        const auto foreignPath = sourceDir / "foreign.yaml";
+        std::ofstream file{foreignPath};
+        file << "scenario: foreign\n";
+        file << "device: " << deviceId << "\n";
+        file << "timelines:\n";
+        file << "  - name: brakes\n";
+        file << "    device: " << deviceId << "\n";
+        file << "events:\n";
+        file << "  - type: pd\n";
+        file << "    label: brake-a\n";
+        file.close();
+        bool refused = false;
+        try {
+            (void)repository.importScenario(foreignPath);
+        } catch (const ScenarioValidationError &ex) {
+            refused = std::string{ex.what()} == "Unknown timeline field: device";
+        }
+        assert(refused);
+    }
+
+    return 0;
+}
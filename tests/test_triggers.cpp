@@ -0,0 +1,259 @@
+#include "trdp_simulator/communication/Wrapper.hpp"
+#include "trdp_simulator/device/DeviceConfig.hpp"
+#include "trdp_simulator/device/DeviceProfileRepository.hpp"
+#include "trdp_simulator/device/XmlValidator.hpp"
+#include "trdp_simulator/simulation/DeviceStateStore.hpp"
+#include "trdp_simulator/simulation/Engine.hpp"
+#include "trdp_simulator/simulation/PayloadMatcher.hpp"
+#include "trdp_simulator/simulation/ScenarioParser.hpp"
+#include "trdp_simulator/simulation/ScenarioRepository.hpp"
+#include "trdp_simulator/simulation/ScenarioSchemaValidator.hpp"
+#include "trdp_simulator/simulation/TriggerTable.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using trdp::communication::MessageDataMessage;
+using trdp::communication::Wrapper;
+using trdp::device::DeviceProfileRepository;
+using trdp::device::XmlValidator;
+using trdp::simulation::DeviceStateStore;
+using trdp::simulation::FieldMatch;
+using trdp::simulation::MaskedMatch;
+using trdp::simulation::PayloadMatcher;
+using trdp::simulation::PayloadPredicate;
+using trdp::simulation::Scenario;
+using trdp::simulation::ScenarioEvent;
+using trdp::simulation::ScenarioRepository;
+using trdp::simulation::ScenarioSchemaValidator;
+using trdp::simulation::ScenarioTrigger;
+using trdp::simulation::ScenarioValidationError;
+using trdp::simulation::SimulationEngine;
+using trdp::simulation::TriggerReaction;
+using trdp::simulation::TriggerTable;
+
+namespace {
+
+std::filesystem::path deviceSchemaPath() {
+    const auto repoRoot = std::filesystem::path(__FILE__).parent_path().parent_path();
+    return repoRoot / "resources/trdp/trdp-config.xsd";
+}
+
+std::filesystem::path scenarioSchemaPath() {
+    const auto repoRoot = std::filesystem::path(__FILE__).parent_path().parent_path();
+    return repoRoot / "resources/scenarios/scenario.schema.yaml";
+}
+
+std::filesystem::path tempDir(const std::string &name) {
+    auto dir = std::filesystem::temp_directory_path() / std::filesystem::path{name + std::to_string(std::rand())};
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+std::string readFile(const std::filesystem::path &path) {
+    std::ifstream stream{path};
+    std::ostringstream oss;
+    oss << stream.rdbuf();
+    return oss.str();
+}
+
+} // namespace
+
+int main() {
+    {
+        PayloadPredicate predicate{};
+        predicate.masked = MaskedMatch{1, {0xF0}, {0x10}};
+        predicate.field = FieldMatch{2, 2, FieldMatch::Op::GreaterEqual, 0x0100};
+        const PayloadMatcher matcher{predicate};
+        const std::vector<std::uint8_t> hit{0x00, 0x1F, 0x01, 0x00};
+        const std::vector<std::uint8_t> maskMiss{0x00, 0x2F, 0x01, 0x00};
+        const std::vector<std::uint8_t> fieldMiss{0x00, 0x1F, 0x00, 0xFF};
+        const std::vector<std::uint8_t> tooShort{0x00, 0x1F};
+        assert(matcher.matches(hit));
+        assert(!matcher.matches(maskMiss));
+        assert(!matcher.matches(fieldMiss));
+        assert(!matcher.matches(tooShort));
+
+        // Offsets near SIZE_MAX must not wrap around the bounds check.
+        PayloadPredicate farMask{};
+        farMask.masked = MaskedMatch{SIZE_MAX, {0xFF}, {0x00}};
+        assert(!PayloadMatcher{farMask}.matches(hit));
+        PayloadPredicate farField{};
+        farField.field = FieldMatch{SIZE_MAX - 1, 4, FieldMatch::Op::Equal, 0};
+        assert(!PayloadMatcher{farField}.matches(hit));
+
+        PayloadPredicate mismatched{};
+        mismatched.masked = MaskedMatch{0, {0xFF, 0xFF}, {0x01}};
+        bool threw = false;
+        try {
+            (void)PayloadMatcher{mismatched};
+        } catch (const ScenarioValidationError &) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    {
+        std::vector<ScenarioTrigger> triggers(2);
+        triggers[0].label = "pd-only";
+        triggers[0].comId = 1001;
+        triggers[1].label = "md-only";
+        triggers[1].on = ScenarioEvent::Type::MessageData;
+        triggers[1].comId = 1001;
+        const TriggerTable table{triggers};
+        std::vector<TriggerReaction> fired;
+        const std::vector<std::uint8_t> payload{0x01};
+        table.evaluate(ScenarioEvent::Type::ProcessData, 1001, payload, std::chrono::steady_clock::now(), fired);
+        table.evaluate(ScenarioEvent::Type::ProcessData, 4242, payload, std::chrono::steady_clock::now(), fired);
+        assert(fired.size() == 1);
+        assert(fired.front().trigger->label == "pd-only");
+    }
+
+    {
+        // Named fields take their offset, size and type from the device's data set layout.
+        DeviceStateStore state{trdp::device::loadDeviceConfig(deviceSchemaPath().parent_path() / "device1.xml")};
+        state.set(1004, "u16", "513");
+        state.set(1004, "i8", "-2");
+        state.set(1004, "r32", "1.5");
+        std::vector<std::uint8_t> payload;
+        state.snapshot(1004, payload);
+        const auto named = [&](const char *name, FieldMatch::Op op, std::uint64_t value) {
+            PayloadPredicate predicate{};
+            predicate.field = FieldMatch{};
+            predicate.field->datasetId = 1004;
+            predicate.field->name = name;
+            predicate.field->op = op;
+            predicate.field->value = value;
+            return PayloadMatcher{predicate, &state}.matches(payload);
+        };
+        assert(named("u16", FieldMatch::Op::Equal, 513));
+        assert(named("i8", FieldMatch::Op::Less, 0));
+        assert(named("r32", FieldMatch::Op::Greater, 1) && named("r32", FieldMatch::Op::Less, 2));
+        assert(!named("r32", FieldMatch::Op::Equal, 1));
+
+        PayloadPredicate unknown{};
+        unknown.field = FieldMatch{};
+        unknown.field->datasetId = 1004;
+        unknown.field->name = "missing";
+        bool threw = false;
+        try {
+            (void)PayloadMatcher{unknown, &state};
+        } catch (const std::out_of_range &) {
+            threw = true;
+        }
+        assert(threw);
+        threw = false;
+        try {
+            (void)PayloadMatcher{unknown};
+        } catch (const ScenarioValidationError &) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    XmlValidator xmlValidator{deviceSchemaPath()};
+    DeviceProfileRepository deviceRepository{tempDir("trigger-dev-"), xmlValidator};
+    const auto deviceId = deviceRepository.registerProfile(deviceSchemaPath().parent_path() / "device1.xml");
+    ScenarioSchemaValidator scenarioValidator{scenarioSchemaPath()};
+    ScenarioRepository repository{tempDir("trigger-scenarios-"), deviceRepository, scenarioValidator};
+
+    const auto scenarioPath = tempDir("trigger-src-") / "door-interlock.yaml";
+    {
+        std::ofstream file{scenarioPath};
+        file << "scenario: door-interlock\n";
+        file << "device: " << deviceId << "\n";
+        file << "events:\n";
+        file << "  - type: pd\n";
+        file << "    label: door-open\n";
+        file << "    com_id: 1001\n";
+        file << "    payload: 0x01\n";
+        file << "  - type: pd\n";
+        file << "    label: door-closed\n";
+        file << "    com_id: 1001\n";
+        file << "    payload: 0x00\n";
+        file << "triggers:\n";
+        file << "  - label: hold-brake\n";
+        file << "    on_com_id: 1001\n";
+        file << "    match_offset: 0\n";
+        file << "    match_mask: 0xFF\n";
+        file << "    match_value: 0x01\n";
+        file << "    type: md\n";
+        file << "    com_id: 2001\n";
+        file << "    payload: 0x7B\n";
+        file << "    deadline_ms: 5\n";
+    }
+
+    const auto id = repository.importScenario(scenarioPath);
+    Scenario scenario = repository.load(id);
+    assert(scenario.triggers.size() == 1);
+    assert(scenario.triggers.front().predicate.masked.has_value());
+
+    Wrapper wrapper{"trigger-endpoint"};
+    std::vector<std::uint32_t> reactions;
+    wrapper.registerMessageDataHandler(
+        [&reactions](const MessageDataMessage &message) { reactions.push_back(message.comId); });
+    SimulationEngine engine{wrapper, tempDir("trigger-runs-"), &repository};
+    engine.loadScenario(std::move(scenario));
+    engine.run();
+
+    assert((reactions == std::vector<std::uint32_t>{2001}));
+    const auto runs = repository.listRunsForScenario(id);
+    assert(runs.size() == 1);
+    const auto triggerLog = readFile(runs.front().artefactPath / "triggers.log");
+    assert(triggerLog.find("hold-brake") != std::string::npos);
+    assert(triggerLog.find("latency_us=") != std::string::npos);
+    const auto metadata = readFile(runs.front().artefactPath / "metadata.yaml");
+    assert(metadata.find("  reactions: 1") != std::string::npos);
+
+    const auto replayed = repository.loadRunScenario(runs.front().id);
+    assert(replayed.triggers.size() == 1);
+    assert(replayed.triggers.front().action.comId == 2001);
+
+    {
+        const auto namedPath = tempDir("trigger-named-") / "named.yaml";
+        const auto writeNamed = [&](const std::string &field) {
+            std::ofstream file{namedPath};
+            file << "scenario: named\n";
+            file << "device: " << deviceId << "\n";
+            file << "events:\n";
+            file << "  - type: pd\n";
+            file << "    label: status\n";
+            file << "    com_id: 1001\n";
+            file << "triggers:\n";
+            file << "  - label: overspeed\n";
+            file << "    on_com_id: 1001\n";
+            file << "    field_dataset_id: 1001\n";
+            file << "    field_name: " << field << "\n";
+            file << "    field_op: gt\n";
+            file << "    field_value: 80\n";
+            file << "    type: md\n";
+            file << "    com_id: 2001\n";
+        };
+        writeNamed("u16");
+        const auto namedId = repository.importScenario(namedPath);
+        const auto loaded = repository.load(namedId);
+        const auto &field = *loaded.triggers.front().predicate.field;
+        assert(field.named() && field.datasetId == 1001 && field.name == "u16");
+        assert(trdp::simulation::usesDeviceState(loaded));
+
+        writeNamed("speed");
+        std::string message;
+        try {
+            (void)repository.importScenario(namedPath);
+        } catch (const ScenarioValidationError &ex) {
+            message = ex.what();
+        }
+        assert(message == "Trigger 'overspeed': Data set 1001 has no field 'speed'");
+    }
+
+    return 0;
+}